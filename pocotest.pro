@@ -90,6 +90,34 @@ SOURCES += \
     src/toastnotification.cpp \
     src/toastmanager.cpp \
     src/thememanager.cpp \
+    src/n2kreceiveworker.cpp \
+    src/n2ktimestamp.cpp \
+    src/capturestore.cpp \
+    src/capturebudget.cpp \
+    src/capturefile.cpp \
+    src/capturefilter.cpp \
+    src/capturequery.cpp \
+    src/capturequeryworker.cpp \
+    src/capturesearchindex.cpp \
+    src/capturetimeindex.cpp \
+    src/pgnlogparser.cpp \
+    src/pgnlogloader.cpp \
+    src/pgnlogmodel.cpp \
+    src/searchhighlightdelegate.cpp \
+    src/trafficstats.cpp \
+    src/trafficstatsmodel.cpp \
+    src/trafficstatsdialog.cpp \
+    src/signalseries.cpp \
+    src/signalplotwidget.cpp \
+    src/signalplotdialog.cpp \
+    src/livecapture.cpp \
+    src/capturetrigger.cpp \
+    src/capturetriggerdialog.cpp \
+    src/capturediff.cpp \
+    src/capturediffdialog.cpp \
+    src/capturesegment.cpp \
+    src/capturerecorder.cpp \
+    src/capturerecorderdialog.cpp \
     components/external/NMEA2000/src/NMEA2000.cpp \
     components/external/NMEA2000/src/N2kTimer.cpp \
     components/external/NMEA2000/src/N2kMsg.cpp \
@@ -101,7 +129,8 @@ SOURCES += \
 
 # Platform-specific sources
 !wasm {
-    SOURCES += components/external/NMEA2000_socketCAN/NMEA2000_SocketCAN.cpp
+    SOURCES += components/external/NMEA2000_socketCAN/NMEA2000_SocketCAN.cpp \
+        src/socketcantimestamped.cpp
 } else {
     SOURCES += wasm-dev/NMEA2000_WASM.cpp
 }
@@ -123,10 +152,41 @@ HEADERS += \
     src/instanceconflictanalyzer.h \
     src/toastnotification.h \
     src/toastmanager.h \
-    src/thememanager.h
+    src/thememanager.h \
+    src/n2kreceiveworker.h \
+    src/n2ktimestamp.h \
+    src/capturestore.h \
+    src/capturebudget.h \
+    src/capturefile.h \
+    src/capturefilter.h \
+    src/capturequery.h \
+    src/capturequeryworker.h \
+    src/capturesearchindex.h \
+    src/capturetimeindex.h \
+    src/pgnlogparser.h \
+    src/pgnlogloader.h \
+    src/pgnlogmodel.h \
+    src/searchhighlightdelegate.h \
+    src/trafficstats.h \
+    src/trafficstatsmodel.h \
+    src/trafficstatsdialog.h \
+    src/signalseries.h \
+    src/signalplotwidget.h \
+    src/signalplotdialog.h \
+    src/livecapture.h \
+    src/capturetrigger.h \
+    src/capturetriggerdialog.h \
+    src/capturediff.h \
+    src/capturediffdialog.h \
+    src/capturesegment.h \
+    src/capturerecorder.h \
+    src/capturerecorderdialog.h \
+    src/spscring.h
 
 # Platform-specific headers
-wasm {
+!wasm {
+    HEADERS += src/socketcantimestamped.h
+} else {
     HEADERS += wasm-dev/NMEA2000_WASM.h
 }
 
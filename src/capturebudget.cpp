@@ -0,0 +1,116 @@
+#include "capturebudget.h"
+#include "capturestore.h"
+#include "pgnlogmodel.h"
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include <QDebug>
+
+int CaptureBudget::rowsToEvict(const CaptureStore& store) const
+{
+    if (!isActive() || store.isEmpty()) {
+        return 0;
+    }
+
+    const int rows = store.size();
+
+    switch (limit) {
+    case MessageCount:
+        if (rows > value) {
+            return rows - int(value * EVICT_TARGET_PERCENT / 100);
+        }
+        return 0;
+
+    case Megabytes: {
+        const qint64 maxBytes = value * 1024 * 1024;
+        qint64 bytes = store.retainedBytes();
+        if (bytes <= maxBytes) {
+            return 0;
+        }
+        const qint64 targetBytes = maxBytes * EVICT_TARGET_PERCENT / 100;
+        int evict = 0;
+        while (evict < rows && bytes > targetBytes) {
+            bytes -= store.rowBytes(evict);
+            evict++;
+        }
+        return evict;
+    }
+
+    case Minutes: {
+        const qint64 maxSpanNs = value * 60LL * 1000000000LL;
+        const N2kTimestamp newest = store.timestamp(rows - 1);
+        if (!newest.isValid() || newest.nsecsSince(store.timestamp(0)) <= maxSpanNs) {
+            return 0;
+        }
+        const qint64 targetSpanNs = maxSpanNs * EVICT_TARGET_PERCENT / 100;
+        int evict = 0;
+        while (evict < rows - 1 && newest.nsecsSince(store.timestamp(evict)) > targetSpanNs) {
+            evict++;
+        }
+        return evict;
+    }
+
+    case Unlimited:
+        break;
+    }
+    return 0;
+}
+
+CaptureSpillWriter::CaptureSpillWriter()
+    : m_spilledCount(0)
+{
+}
+
+CaptureSpillWriter::~CaptureSpillWriter()
+{
+    if (m_file.isOpen()) {
+        m_stream.flush();
+        m_file.close();
+    }
+}
+
+QString CaptureSpillWriter::spillDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/spill";
+}
+
+bool CaptureSpillWriter::open()
+{
+    QDir().mkpath(spillDirectory());
+
+    QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
+    m_file.setFileName(QString("%1/nmea2000_spill_%2.pgnlog").arg(spillDirectory(), timestamp));
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "Could not open capture spill file" << m_file.fileName() << ":" << m_file.errorString();
+        return false;
+    }
+    m_stream.setDevice(&m_file);
+
+    m_stream << "# NMEA2000 PGN Message Log\n";
+    m_stream << "# Generated by Lumitec Poco Tester\n";
+    m_stream << "# Format Version: 1.1\n";
+    m_stream << "# Spilled from live capture started " << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss") << "\n";
+    m_stream << "#\n";
+    m_stream << "# Format: TIMESTAMP | PGN | PRIORITY | SOURCE | DESTINATION | LENGTH | RAW_DATA | RX_TIME_NS\n";
+    m_stream << "#\n";
+    return true;
+}
+
+bool CaptureSpillWriter::writeRows(const CaptureStore& store, int count)
+{
+    if (!m_file.isOpen() && !open()) {
+        return false;
+    }
+
+    count = qMin(count, store.size());
+    for (int row = 0; row < count; row++) {
+        m_stream << PGNLogModel::logRecordLine(store, row) << "\n";
+    }
+    m_stream.flush();
+    if (m_stream.status() != QTextStream::Ok) {
+        return false;
+    }
+
+    m_spilledCount += count;
+    return true;
+}
@@ -0,0 +1,78 @@
+#ifndef CAPTUREBUDGET_H
+#define CAPTUREBUDGET_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QFile>
+#include <QTextStream>
+
+class CaptureStore;
+
+/**
+ * @brief Limit on how much of a live capture is kept in memory.
+ *
+ * The budget can be expressed as a message count, a size in megabytes or a
+ * time span in minutes. When it is exceeded the overflow policy decides what
+ * happens: the oldest messages are dropped (ring behaviour), capture stops,
+ * or the oldest messages are written to a spill file before being dropped.
+ */
+struct CaptureBudget
+{
+    enum Limit {
+        Unlimited = 0,
+        MessageCount,
+        Megabytes,
+        Minutes
+    };
+
+    enum OverflowPolicy {
+        DropOldest = 0,
+        StopCapture,
+        SpillToDisk
+    };
+
+    Limit limit = Unlimited;
+    qint64 value = 0;
+    OverflowPolicy policy = DropOldest;
+
+    bool isActive() const { return limit != Unlimited && value > 0; }
+
+    // Number of oldest rows to remove to bring the store back under budget.
+    // Evicts down to EVICT_TARGET_PERCENT of the limit so eviction happens in chunks
+    // rather than once per message. Returns 0 while within budget.
+    int rowsToEvict(const CaptureStore& store) const;
+
+    static const int EVICT_TARGET_PERCENT = 94;
+};
+
+/**
+ * @brief Appends evicted capture rows to a text log file on disk.
+ *
+ * The file is written in the same format as "Save Log...", so a spilled
+ * capture can be opened again with "Load Log...". It is created on the first
+ * write in the application data directory.
+ */
+class CaptureSpillWriter
+{
+public:
+    CaptureSpillWriter();
+    ~CaptureSpillWriter();
+
+    // Write the first count rows of the store
+    bool writeRows(const CaptureStore& store, int count);
+
+    QString fileName() const { return m_file.fileName(); }
+    QString errorString() const { return m_file.errorString(); }
+    qint64 spilledCount() const { return m_spilledCount; }
+
+    static QString spillDirectory();
+
+private:
+    bool open();
+
+    QFile m_file;
+    QTextStream m_stream;
+    qint64 m_spilledCount;
+};
+
+#endif // CAPTUREBUDGET_H
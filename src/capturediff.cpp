@@ -0,0 +1,435 @@
+#include "capturediff.h"
+#include "capturestore.h"
+#include "dbcdecoder.h"
+#include <QElapsedTimer>
+#include <QMap>
+#include <algorithm>
+
+static const quint32 PGN_ISO_ACKNOWLEDGEMENT = 59392;
+static const quint32 PGN_ISO_REQUEST = 59904;
+static const quint32 PGN_GROUP_FUNCTION = 126208;
+static const quint8 GROUP_FUNCTION_REQUEST = 0;
+static const quint8 GROUP_FUNCTION_COMMAND = 1;
+static const quint8 GROUP_FUNCTION_ACKNOWLEDGE = 2;
+
+static qint64 rowTimeNs(const CaptureStore& store, int row)
+{
+    return store.monotonicNs(row) != 0 ? store.monotonicNs(row) : store.wallNs(row);
+}
+
+// 24-bit little-endian PGN at the given payload offset
+static quint32 payloadPgn(const unsigned char* data, int offset)
+{
+    return quint32(data[offset]) | (quint32(data[offset + 1]) << 8) | (quint32(data[offset + 2]) << 16);
+}
+
+qint64 CaptureDiff::PgnEntry::meanIntervalNs(int side) const
+{
+    return count[side] > 1 ? (lastNs[side] - firstNs[side]) / (count[side] - 1) : -1;
+}
+
+bool CaptureDiff::FieldEntry::differs() const
+{
+    if (values[Left].size() != values[Right].size()) {
+        return true;
+    }
+    QStringList left = values[Left];
+    QStringList right = values[Right];
+    left.sort();
+    right.sort();
+    return left != right;
+}
+
+CaptureDiff::CaptureDiff()
+{
+    clear();
+}
+
+void CaptureDiff::clear()
+{
+    m_roles.clear();
+    m_pgnEntries.clear();
+    m_pgnIndex.clear();
+    m_fieldEntries.clear();
+    m_fieldIndex.clear();
+    m_latencyEntries.clear();
+    m_latencyIndex.clear();
+    for (int side = 0; side < SIDES; side++) {
+        m_sides[side] = SideState();
+        m_messageCount[side] = 0;
+    }
+    m_elapsedMs = 0;
+}
+
+void CaptureDiff::compare(const Input& left, const Input& right, DBCDecoder* decoder)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+    const Input inputs[SIDES] = { left, right };
+    assignRoles(inputs);
+    for (int side = 0; side < SIDES; side++) {
+        scan(side, inputs[side], decoder);
+    }
+    rankOrder();
+
+    for (const FieldEntry& field : m_fieldEntries) {
+        PgnEntry& entry = m_pgnEntries[field.pgnEntry];
+        if (entry.isInBoth() && field.differs()) {
+            entry.fieldDifferences++;
+        }
+    }
+
+    m_elapsedMs = timer.elapsed();
+}
+
+void CaptureDiff::assignRoles(const Input* inputs)
+{
+    // Messages sent per address; addresses only ever addressed count as zero
+    QMap<quint8, int> counts[SIDES];
+    for (int side = 0; side < SIDES; side++) {
+        const CaptureStore* store = inputs[side].store;
+        for (int row = 0; store && row < store->size(); row++) {
+            counts[side][store->source(row)]++;
+            if (store->destination(row) != 0xFF && !counts[side].contains(store->destination(row))) {
+                counts[side].insert(store->destination(row), 0);
+            }
+        }
+    }
+
+    auto addRole = [&](int leftAddress, int rightAddress) {
+        Role role;
+        const int addresses[SIDES] = { leftAddress, rightAddress };
+        for (int side = 0; side < SIDES; side++) {
+            if (addresses[side] < 0) {
+                continue;
+            }
+            const quint8 address = quint8(addresses[side]);
+            role.address[side] = address;
+            role.name[side] = inputs[side].deviceNames.value(address);
+            role.messages[side] = counts[side].value(address);
+            m_sides[side].roleOfAddress.insert(address, quint16(m_roles.size()));
+            counts[side].remove(address);
+        }
+        m_roles.append(role);
+    };
+
+    // An address in both captures is the same role
+    const QList<quint8> leftAddresses = counts[Left].keys();
+    for (quint8 address : leftAddresses) {
+        if (counts[Right].contains(address)) {
+            addRole(address, address);
+        }
+    }
+
+    // Then devices with the same name
+    const QList<quint8> unmatched = counts[Left].keys();
+    for (quint8 leftAddress : unmatched) {
+        const QString name = inputs[Left].deviceNames.value(leftAddress);
+        if (name.isEmpty()) {
+            continue;
+        }
+        for (auto it = counts[Right].constBegin(); it != counts[Right].constEnd(); ++it) {
+            if (inputs[Right].deviceNames.value(it.key()).compare(name, Qt::CaseInsensitive) == 0) {
+                addRole(leftAddress, it.key());
+                break;
+            }
+        }
+    }
+
+    // The rest pair up by how busy they are - the device under test is usually the busiest
+    QVector<QPair<int, quint8>> remaining[SIDES];
+    for (int side = 0; side < SIDES; side++) {
+        for (auto it = counts[side].constBegin(); it != counts[side].constEnd(); ++it) {
+            remaining[side].append(qMakePair(-it.value(), it.key()));
+        }
+        std::sort(remaining[side].begin(), remaining[side].end());
+    }
+    const int pairs = qMax(remaining[Left].size(), remaining[Right].size());
+    for (int i = 0; i < pairs; i++) {
+        addRole(i < remaining[Left].size() ? remaining[Left][i].second : -1,
+                i < remaining[Right].size() ? remaining[Right][i].second : -1);
+    }
+}
+
+void CaptureDiff::scan(int side, const Input& input, DBCDecoder* decoder)
+{
+    const CaptureStore* store = input.store;
+    if (!store || store->isEmpty()) {
+        return;
+    }
+    m_messageCount[side] = store->size();
+    const qint64 startNs = rowTimeNs(*store, 0);
+
+    for (int row = 0; row < store->size(); row++) {
+        const qint64 timeNs = rowTimeNs(*store, row) - startNs;
+        const quint32 pgn = store->pgn(row);
+        const quint16 sourceRole = m_sides[side].roleOfAddress.value(store->source(row));
+        const quint16 targetRole = destinationRole(side, store->destination(row));
+
+        const quint64 key = (quint64(pgn) << 32) | (quint64(sourceRole) << 16) | targetRole;
+        auto found = m_pgnIndex.constFind(key);
+        int index;
+        if (found == m_pgnIndex.constEnd()) {
+            index = m_pgnEntries.size();
+            PgnEntry entry;
+            entry.pgn = pgn;
+            entry.sourceRole = sourceRole;
+            entry.destinationRole = targetRole;
+            entry.name = decoder ? decoder->getCleanMessageName(pgn) : QString();
+            m_pgnEntries.append(entry);
+            m_pgnIndex.insert(key, index);
+        } else {
+            index = found.value();
+        }
+
+        PgnEntry& entry = m_pgnEntries[index];
+        if (entry.count[side]++ == 0) {
+            entry.firstNs[side] = timeNs;
+            entry.firstRow[side] = row;
+        }
+        entry.lastNs[side] = timeNs;
+
+        // A repeat carries the payload of the change row before it, which was decoded already
+        if (!store->isRepeat(row)) {
+            addFieldValues(side, index, *store, row, decoder);
+        }
+
+        trackResponse(side, *store, row, timeNs, sourceRole);
+        trackRequest(side, *store, row, timeNs, sourceRole, targetRole);
+    }
+}
+
+void CaptureDiff::addFieldValues(int side, int entryIndex, const CaptureStore& store, int row, DBCDecoder* decoder)
+{
+    QSet<QByteArray>& decoded = m_sides[side].decodedPayloads[entryIndex];
+    const QByteArray payload(reinterpret_cast<const char*>(store.payload(row)), store.length(row));
+    if (decoded.contains(payload)) {
+        return;
+    }
+    if (decoded.size() >= MAX_DECODED_PAYLOADS) {
+        // A stream of changing measurements - its values were sampled, not all collected
+        PgnEntry& entry = m_pgnEntries[entryIndex];
+        if (!entry.decodeLimited[side]) {
+            entry.decodeLimited[side] = true;
+            for (int field : entry.fields) {
+                m_fieldEntries[field].truncated[side] = true;
+            }
+        }
+        return;
+    }
+    decoded.insert(payload);
+
+    auto addValue = [&](const QString& name, const QString& value) {
+        const QPair<int, QString> key(entryIndex, name);
+        auto found = m_fieldIndex.constFind(key);
+        int fieldIndex;
+        if (found == m_fieldIndex.constEnd()) {
+            fieldIndex = m_fieldEntries.size();
+            FieldEntry field;
+            field.pgnEntry = entryIndex;
+            field.name = name;
+            m_fieldEntries.append(field);
+            m_fieldIndex.insert(key, fieldIndex);
+            m_pgnEntries[entryIndex].fields.append(fieldIndex);
+        } else {
+            fieldIndex = found.value();
+        }
+
+        FieldEntry& field = m_fieldEntries[fieldIndex];
+        if (field.values[side].contains(value)) {
+            return;
+        }
+        if (field.values[side].size() >= MAX_FIELD_VALUES) {
+            field.truncated[side] = true;
+            return;
+        }
+        field.values[side].append(value);
+    };
+
+    DecodedMessage message = decoder ? decoder->decodeMessage(store.message(row)) : DecodedMessage();
+    if (!decoder || !message.isDecoded) {
+        addValue("Payload", QString::fromLatin1(payload.toHex(' ').toUpper()));
+        return;
+    }
+    for (const DecodedSignal& signal : message.signalList) {
+        if (signal.name.contains("Reserved", Qt::CaseInsensitive)) {
+            continue;
+        }
+        addValue(signal.name, decoder->formatSignalValue(signal));
+    }
+}
+
+void CaptureDiff::trackRequest(int side, const CaptureStore& store, int row, qint64 timeNs,
+                               quint16 sourceRole, quint16 targetRole)
+{
+    const quint32 pgn = store.pgn(row);
+    const unsigned char* data = store.payload(row);
+    bool groupFunction;
+    quint32 requestedPgn;
+
+    if (pgn == PGN_ISO_REQUEST && store.length(row) >= 3) {
+        groupFunction = false;
+        requestedPgn = payloadPgn(data, 0);
+    } else if (pgn == PGN_GROUP_FUNCTION && store.length(row) >= 4
+               && (data[0] == GROUP_FUNCTION_REQUEST || data[0] == GROUP_FUNCTION_COMMAND)) {
+        groupFunction = true;
+        requestedPgn = payloadPgn(data, 1);
+    } else {
+        return;
+    }
+
+    // Anyone may answer a broadcast request
+    const quint16 responderRole = targetRole == BROADCAST_ROLE ? quint16(ANY_ROLE) : targetRole;
+    const int entry = latencyEntry(pgn, requestedPgn, sourceRole, responderRole);
+    m_latencyEntries[entry].requests[side]++;
+    m_sides[side].pendingRequests[pendingKey(groupFunction, responderRole, requestedPgn)]
+        .append(PendingRequest{timeNs, entry});
+}
+
+void CaptureDiff::trackResponse(int side, const CaptureStore& store, int row, qint64 timeNs, quint16 sourceRole)
+{
+    QHash<quint64, QVector<PendingRequest>>& pending = m_sides[side].pendingRequests;
+    if (pending.isEmpty()) {
+        return;
+    }
+
+    const quint32 pgn = store.pgn(row);
+    const unsigned char* data = store.payload(row);
+    bool groupFunction = false;
+    quint32 answeredPgn = pgn;
+
+    if (pgn == PGN_GROUP_FUNCTION) {
+        if (store.length(row) < 4 || data[0] != GROUP_FUNCTION_ACKNOWLEDGE) {
+            return;
+        }
+        groupFunction = true;
+        answeredPgn = payloadPgn(data, 1);
+    } else if (pgn == PGN_ISO_ACKNOWLEDGEMENT && store.length(row) >= 8) {
+        // A NACK answers the request too
+        answeredPgn = payloadPgn(data, 5);
+    }
+
+    const quint64 keys[] = { pendingKey(groupFunction, sourceRole, answeredPgn),
+                             pendingKey(groupFunction, ANY_ROLE, answeredPgn) };
+    for (quint64 key : keys) {
+        auto it = pending.find(key);
+        if (it == pending.end()) {
+            continue;
+        }
+        for (const PendingRequest& request : it.value()) {
+            LatencyEntry& entry = m_latencyEntries[request.latencyEntry];
+            const qint64 latencyNs = timeNs - request.timeNs;
+            entry.answered[side]++;
+            entry.totalNs[side] += latencyNs;
+            if (entry.minNs[side] < 0 || latencyNs < entry.minNs[side]) {
+                entry.minNs[side] = latencyNs;
+            }
+            entry.maxNs[side] = qMax(entry.maxNs[side], latencyNs);
+        }
+        pending.erase(it);
+    }
+}
+
+int CaptureDiff::latencyEntry(quint32 requestPgn, quint32 responsePgn, quint16 requesterRole, quint16 responderRole)
+{
+    const QPair<quint64, quint32> key((quint64(requestPgn) << 32) | responsePgn,
+                                      (quint32(requesterRole) << 16) | responderRole);
+    auto found = m_latencyIndex.constFind(key);
+    if (found != m_latencyIndex.constEnd()) {
+        return found.value();
+    }
+
+    LatencyEntry entry;
+    entry.requestPgn = requestPgn;
+    entry.responsePgn = responsePgn;
+    entry.requesterRole = requesterRole;
+    entry.responderRole = responderRole;
+    m_latencyEntries.append(entry);
+    m_latencyIndex.insert(key, m_latencyEntries.size() - 1);
+    return m_latencyEntries.size() - 1;
+}
+
+void CaptureDiff::rankOrder()
+{
+    for (int side = 0; side < SIDES; side++) {
+        QVector<QPair<int, int>> firstRows;  // (first row, entry) of the buckets both captures have
+        for (int i = 0; i < m_pgnEntries.size(); i++) {
+            if (m_pgnEntries[i].isInBoth()) {
+                firstRows.append(qMakePair(m_pgnEntries[i].firstRow[side], i));
+            }
+        }
+        std::sort(firstRows.begin(), firstRows.end());
+        for (int rank = 0; rank < firstRows.size(); rank++) {
+            m_pgnEntries[firstRows[rank].second].order[side] = rank;
+        }
+    }
+}
+
+quint16 CaptureDiff::destinationRole(int side, quint8 destination) const
+{
+    if (destination == 0xFF) {
+        return BROADCAST_ROLE;
+    }
+    return m_sides[side].roleOfAddress.value(destination);
+}
+
+QString CaptureDiff::roleName(quint16 role) const
+{
+    if (role == BROADCAST_ROLE) {
+        return "Broadcast";
+    }
+    if (role == ANY_ROLE) {
+        return "Any";
+    }
+    if (role >= m_roles.size()) {
+        return QString();
+    }
+
+    const Role& entry = m_roles[role];
+    QStringList parts;
+    for (int side = 0; side < SIDES; side++) {
+        if (entry.address[side] < 0) {
+            parts << "-";
+            continue;
+        }
+        const QString address = QString("0x%1").arg(QString::number(entry.address[side], 16).toUpper().rightJustified(2, '0'));
+        parts << (entry.name[side].isEmpty() ? address : QString("%1 (%2)").arg(entry.name[side], address));
+    }
+    if (parts[Left] == parts[Right]) {
+        return parts[Left];
+    }
+    return parts.join(" / ");
+}
+
+int CaptureDiff::onlyIn(int side) const
+{
+    int count = 0;
+    for (const PgnEntry& entry : m_pgnEntries) {
+        if (entry.isPresent(side) && !entry.isInBoth()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int CaptureDiff::fieldDifferenceCount() const
+{
+    int count = 0;
+    for (const PgnEntry& entry : m_pgnEntries) {
+        count += entry.fieldDifferences;
+    }
+    return count;
+}
+
+int CaptureDiff::orderDifferenceCount() const
+{
+    int count = 0;
+    for (const PgnEntry& entry : m_pgnEntries) {
+        if (entry.orderDiffers()) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,157 @@
+#ifndef CAPTUREDIFF_H
+#define CAPTUREDIFF_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QPair>
+#include <QByteArray>
+
+class CaptureStore;
+class DBCDecoder;
+
+/**
+ * @brief Structural comparison of two captures, such as the same enumeration
+ * run against two devices.
+ *
+ * Source addresses are first mapped to roles that both captures share: an
+ * address seen in both is its own role, then sources are paired by device name
+ * and finally by message count, so the device under test lines up even when it
+ * claimed a different address. Messages are then bucketed by (PGN, source role,
+ * destination role) in a hash, and decoded fields are aligned by name within
+ * each bucket. Only distinct payloads are decoded, which keeps large logs to a
+ * single pass plus a decode per new payload.
+ *
+ * The result lists PGNs present in one capture only, differing field values,
+ * the first-seen order and timing of every bucket, and the latency from an ISO
+ * request or group function to its answer, side by side.
+ */
+class CaptureDiff
+{
+public:
+    enum Side {
+        Left = 0,
+        Right = 1
+    };
+
+    static const int SIDES = 2;
+    static const quint16 BROADCAST_ROLE = 0xFFFF;
+    static const quint16 ANY_ROLE = 0xFFFE;         // Answer to a broadcast request, from whoever responds
+    // Distinct values kept per field and side, and distinct payloads decoded per bucket and side
+    static const int MAX_FIELD_VALUES = 16;
+    static const int MAX_DECODED_PAYLOADS = 256;
+
+    struct Input {
+        const CaptureStore* store = nullptr;
+        QHash<quint8, QString> deviceNames;
+    };
+
+    struct Role {
+        int address[SIDES] = { -1, -1 };   // -1 when the role only exists in the other capture
+        QString name[SIDES];
+        int messages[SIDES] = { 0, 0 };
+    };
+
+    // Messages of one (PGN, source role, destination role) bucket
+    struct PgnEntry {
+        quint32 pgn = 0;
+        quint16 sourceRole = 0;
+        quint16 destinationRole = 0;
+        QString name;
+        int count[SIDES] = { 0, 0 };
+        qint64 firstNs[SIDES] = { -1, -1 };   // Relative to the first message of the capture
+        qint64 lastNs[SIDES] = { -1, -1 };
+        int firstRow[SIDES] = { -1, -1 };
+        int order[SIDES] = { -1, -1 };        // First-seen rank among the buckets both captures have
+        bool decodeLimited[SIDES] = { false, false };
+        QVector<int> fields;                  // Field entries of this bucket
+        int fieldDifferences = 0;
+
+        bool isPresent(int side) const { return count[side] > 0; }
+        bool isInBoth() const { return count[Left] > 0 && count[Right] > 0; }
+        bool orderDiffers() const { return isInBoth() && order[Left] != order[Right]; }
+        // Mean time between messages, -1 with fewer than two
+        qint64 meanIntervalNs(int side) const;
+    };
+
+    struct FieldEntry {
+        int pgnEntry = 0;
+        QString name;
+        QStringList values[SIDES];     // Distinct values in first-seen order
+        bool truncated[SIDES] = { false, false };
+
+        bool differs() const;
+    };
+
+    struct LatencyEntry {
+        quint32 requestPgn = 0;        // 59904 or 126208
+        quint32 responsePgn = 0;       // Requested PGN, or 126208 for group functions
+        quint16 requesterRole = 0;
+        quint16 responderRole = 0;
+        int requests[SIDES] = { 0, 0 };
+        int answered[SIDES] = { 0, 0 };
+        qint64 minNs[SIDES] = { -1, -1 };
+        qint64 maxNs[SIDES] = { -1, -1 };
+        qint64 totalNs[SIDES] = { 0, 0 };
+
+        qint64 meanNs(int side) const { return answered[side] > 0 ? totalNs[side] / answered[side] : -1; }
+    };
+
+    CaptureDiff();
+
+    void compare(const Input& left, const Input& right, DBCDecoder* decoder);
+    void clear();
+
+    const QVector<Role>& roles() const { return m_roles; }
+    const QVector<PgnEntry>& pgnEntries() const { return m_pgnEntries; }
+    const QVector<FieldEntry>& fieldEntries() const { return m_fieldEntries; }
+    const QVector<LatencyEntry>& latencyEntries() const { return m_latencyEntries; }
+
+    QString roleName(quint16 role) const;
+    int messageCount(int side) const { return m_messageCount[side]; }
+    int onlyIn(int side) const;
+    int fieldDifferenceCount() const;
+    int orderDifferenceCount() const;
+    qint64 elapsedMs() const { return m_elapsedMs; }
+
+private:
+    struct PendingRequest {
+        qint64 timeNs;
+        int latencyEntry;
+    };
+
+    struct SideState {
+        QHash<quint8, quint16> roleOfAddress;
+        QHash<int, QSet<QByteArray>> decodedPayloads;               // PGN entry -> payloads already decoded
+        QHash<quint64, QVector<PendingRequest>> pendingRequests;    // pendingKey() -> requests not answered yet
+    };
+
+    void assignRoles(const Input* inputs);
+    void scan(int side, const Input& input, DBCDecoder* decoder);
+    void addFieldValues(int side, int entry, const CaptureStore& store, int row, DBCDecoder* decoder);
+    void trackRequest(int side, const CaptureStore& store, int row, qint64 timeNs, quint16 sourceRole, quint16 destinationRole);
+    void trackResponse(int side, const CaptureStore& store, int row, qint64 timeNs, quint16 sourceRole);
+    void rankOrder();
+    int latencyEntry(quint32 requestPgn, quint32 responsePgn, quint16 requesterRole, quint16 responderRole);
+    quint16 destinationRole(int side, quint8 destination) const;
+    static quint64 pendingKey(bool groupFunction, quint16 responderRole, quint32 pgn)
+    {
+        return (quint64(responderRole) << 48) | (groupFunction ? (quint64(1) << 32) : 0) | pgn;
+    }
+
+    QVector<Role> m_roles;
+    QVector<PgnEntry> m_pgnEntries;
+    QHash<quint64, int> m_pgnIndex;                // (PGN << 32 | source role << 16 | destination role) -> entry
+    QVector<FieldEntry> m_fieldEntries;
+    QHash<QPair<int, QString>, int> m_fieldIndex;  // (PGN entry, field name) -> field entry
+    QVector<LatencyEntry> m_latencyEntries;
+    QHash<QPair<quint64, quint32>, int> m_latencyIndex;  // (request PGN << 32 | response PGN, roles) -> entry
+    SideState m_sides[SIDES];
+    int m_messageCount[SIDES];
+    qint64 m_elapsedMs;
+};
+
+#endif // CAPTUREDIFF_H
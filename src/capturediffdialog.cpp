@@ -0,0 +1,412 @@
+#include "capturediffdialog.h"
+#include "dbcdecoder.h"
+#include "pgnlogloader.h"
+#include "toastmanager.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGridLayout>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QCheckBox>
+#include <QLabel>
+#include <QProgressBar>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QFileInfo>
+
+static QString sideName(int side)
+{
+    return side == CaptureDiff::Left ? QString("A") : QString("B");
+}
+
+CaptureDiffDialog::CaptureDiffDialog(QWidget* parent)
+    : QDialog(parent)
+    , m_loadFailed(false)
+{
+    m_dbcDecoder = new DBCDecoder(this);
+
+    setupUI();
+
+    setWindowTitle("Compare Captures");
+    setModal(false);
+    resize(1200, 700);
+}
+
+CaptureDiffDialog::~CaptureDiffDialog()
+{
+    stopLoaders();
+}
+
+void CaptureDiffDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+
+    QGridLayout* fileLayout = new QGridLayout();
+    for (int side = 0; side < CaptureDiff::SIDES; side++) {
+        m_fileEdits[side] = new QLineEdit();
+        m_fileEdits[side]->setPlaceholderText("Log file (.pgnlog)");
+        m_browseButtons[side] = new QPushButton("Browse...");
+        fileLayout->addWidget(new QLabel(QString("Capture %1:").arg(sideName(side))), side, 0);
+        fileLayout->addWidget(m_fileEdits[side], side, 1);
+        fileLayout->addWidget(m_browseButtons[side], side, 2);
+        connect(m_browseButtons[side], &QPushButton::clicked, this, [this, side]() {
+            onBrowseClicked(side);
+        });
+    }
+    mainLayout->addLayout(fileLayout);
+
+    QHBoxLayout* controlLayout = new QHBoxLayout();
+    m_summaryLabel = new QLabel();
+    m_summaryLabel->setStyleSheet("font-weight: bold; padding: 5px;");
+    m_loadProgressBar = new QProgressBar();
+    m_loadProgressBar->setRange(0, 100);
+    m_loadProgressBar->setMaximumWidth(200);
+    m_loadProgressBar->setVisible(false);
+    m_differencesOnlyCheckBox = new QCheckBox("Differences only");
+    m_differencesOnlyCheckBox->setChecked(true);
+    m_compareButton = new QPushButton("Compare");
+    controlLayout->addWidget(m_summaryLabel);
+    controlLayout->addWidget(m_loadProgressBar);
+    controlLayout->addStretch();
+    controlLayout->addWidget(m_differencesOnlyCheckBox);
+    controlLayout->addWidget(m_compareButton);
+    mainLayout->addLayout(controlLayout);
+
+    auto makeTable = [](const QStringList& headers) {
+        QTableWidget* table = new QTableWidget(0, headers.size());
+        table->setHorizontalHeaderLabels(headers);
+        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        table->setSelectionBehavior(QAbstractItemView::SelectRows);
+        table->setAlternatingRowColors(true);
+        table->verticalHeader()->setVisible(false);
+        table->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+        table->horizontalHeader()->setStretchLastSection(true);
+        return table;
+    };
+
+    m_pgnTable = makeTable({"Status", "PGN", "Name", "Source", "Destination",
+                            "Count A", "Count B", "First A (ms)", "First B (ms)", "Order A", "Order B",
+                            "Interval A (ms)", "Interval B (ms)", "Field Diffs"});
+    m_fieldTable = makeTable({"PGN", "Name", "Source", "Destination", "Field", "Values A", "Values B"});
+    m_latencyTable = makeTable({"Request", "PGN", "Requester", "Responder",
+                                "Requests A", "Answered A", "Mean A (ms)", "Max A (ms)",
+                                "Requests B", "Answered B", "Mean B (ms)", "Max B (ms)"});
+
+    m_tabs = new QTabWidget();
+    m_tabs->addTab(m_pgnTable, "PGNs");
+    m_tabs->addTab(m_fieldTable, "Fields");
+    m_tabs->addTab(m_latencyTable, "Response Latency");
+    mainLayout->addWidget(m_tabs);
+
+    connect(m_compareButton, &QPushButton::clicked, this, &CaptureDiffDialog::onCompareClicked);
+    connect(m_differencesOnlyCheckBox, &QCheckBox::toggled, this, &CaptureDiffDialog::populateTables);
+}
+
+void CaptureDiffDialog::onBrowseClicked(int side)
+{
+    QString fileName = QFileDialog::getOpenFileName(
+        this,
+        QString("Load Capture %1").arg(sideName(side)),
+        m_fileEdits[side]->text(),
+        "PGN Log Files (*.pgnlog);;Text Files (*.txt);;All Files (*)"
+    );
+
+    if (!fileName.isEmpty()) {
+        m_fileEdits[side]->setText(fileName);
+    }
+}
+
+void CaptureDiffDialog::onCompareClicked()
+{
+    for (int side = 0; side < CaptureDiff::SIDES; side++) {
+        if (m_fileEdits[side]->text().trimmed().isEmpty()) {
+            ToastManager::instance()->showError(QString("Choose a log file for capture %1").arg(sideName(side)), this);
+            return;
+        }
+    }
+
+    stopLoaders();
+    m_diff.clear();
+    populateTables();
+    m_loadFailed = false;
+    m_compareButton->setEnabled(false);
+    m_summaryLabel->setText("Loading...");
+    m_loadProgressBar->setValue(0);
+    m_loadProgressBar->setVisible(true);
+
+    for (int side = 0; side < CaptureDiff::SIDES; side++) {
+        startLoader(side);
+    }
+}
+
+void CaptureDiffDialog::startLoader(int side)
+{
+    m_stores[side].clear();
+    m_deviceNames[side].clear();
+    m_progress[side] = 0;
+
+    PGNLogLoader* loader = new PGNLogLoader(m_fileEdits[side]->text().trimmed(), this);
+    m_loaders[side] = loader;
+    connect(loader, &PGNLogLoader::chunksAvailable, this, [this, side]() {
+        onLoaderChunksAvailable(side);
+    }, Qt::QueuedConnection);
+    connect(loader, &PGNLogLoader::progressChanged, this, [this, side](int percent) {
+        m_progress[side] = percent;
+        updateProgress();
+    }, Qt::QueuedConnection);
+    connect(loader, &PGNLogLoader::loadFinished, this, [this, side](bool success) {
+        onLoaderFinished(side, success);
+    }, Qt::QueuedConnection);
+#ifdef WASM_BUILD
+    // No threads in the browser - parse here, the queued signals are delivered afterwards
+    loader->load();
+#else
+    loader->start();
+#endif
+}
+
+void CaptureDiffDialog::onLoaderChunksAvailable(int side)
+{
+    PGNLogLoader* loader = m_loaders[side];
+    if (!loader) {
+        return;
+    }
+
+    // Acknowledge before draining so a chunk queued meanwhile triggers a new notification
+    loader->acknowledgeNotification();
+
+    if (m_deviceNames[side].isEmpty() && loader->isBinaryCapture()) {
+        m_deviceNames[side] = loader->deviceNames();
+    }
+
+    CaptureStore chunk;
+    while (loader->takeChunk(chunk)) {
+        m_stores[side].reserve(m_stores[side].size() + chunk.size());
+        for (int row = 0; row < chunk.size(); row++) {
+            m_stores[side].appendFrom(chunk, row);
+        }
+    }
+}
+
+void CaptureDiffDialog::onLoaderFinished(int side, bool success)
+{
+    PGNLogLoader* loader = m_loaders[side];
+    if (!loader) {
+        return;
+    }
+
+    // Pick up anything queued after the last notification
+    onLoaderChunksAvailable(side);
+
+    const QString errorString = loader->errorString();
+    loader->deleteLater();
+    m_loaders[side] = nullptr;
+
+    if (!success) {
+        m_loadFailed = true;
+        ToastManager::instance()->showError(
+            QString("Could not load capture %1: %2").arg(sideName(side), errorString), this);
+    }
+
+    for (PGNLogLoader* pending : m_loaders) {
+        if (pending) {
+            return;
+        }
+    }
+
+    m_loadProgressBar->setVisible(false);
+    m_compareButton->setEnabled(true);
+    if (m_loadFailed) {
+        m_summaryLabel->clear();
+        return;
+    }
+
+    CaptureDiff::Input inputs[CaptureDiff::SIDES];
+    for (int i = 0; i < CaptureDiff::SIDES; i++) {
+        inputs[i].store = &m_stores[i];
+        inputs[i].deviceNames = m_deviceNames[i];
+    }
+    m_diff.compare(inputs[CaptureDiff::Left], inputs[CaptureDiff::Right], m_dbcDecoder);
+
+    // The diff keeps what it reports - the loaded rows are not needed any more
+    for (CaptureStore& store : m_stores) {
+        store.clear();
+    }
+    populateTables();
+}
+
+void CaptureDiffDialog::stopLoaders()
+{
+    for (PGNLogLoader*& loader : m_loaders) {
+        if (!loader) {
+            continue;
+        }
+        // The destructor cancels and waits for the thread
+        disconnect(loader, nullptr, this, nullptr);
+        delete loader;
+        loader = nullptr;
+    }
+    m_loadProgressBar->setVisible(false);
+    m_compareButton->setEnabled(true);
+}
+
+void CaptureDiffDialog::updateProgress()
+{
+    int total = 0;
+    for (int percent : m_progress) {
+        total += percent;
+    }
+    m_loadProgressBar->setValue(total / CaptureDiff::SIDES);
+}
+
+void CaptureDiffDialog::populateTables()
+{
+    populatePgnTable();
+    populateFieldTable();
+    populateLatencyTable();
+
+    if (m_diff.pgnEntries().isEmpty()) {
+        m_summaryLabel->clear();
+        return;
+    }
+    m_summaryLabel->setText(QString("%1 / %2 msgs | Only in A: %3 PGNs | Only in B: %4 PGNs | "
+                                    "Field differences: %5 | Order changes: %6 | Compared in %7 ms")
+                                .arg(m_diff.messageCount(CaptureDiff::Left))
+                                .arg(m_diff.messageCount(CaptureDiff::Right))
+                                .arg(m_diff.onlyIn(CaptureDiff::Left))
+                                .arg(m_diff.onlyIn(CaptureDiff::Right))
+                                .arg(m_diff.fieldDifferenceCount())
+                                .arg(m_diff.orderDifferenceCount())
+                                .arg(m_diff.elapsedMs()));
+}
+
+void CaptureDiffDialog::populatePgnTable()
+{
+    const bool differencesOnly = m_differencesOnlyCheckBox->isChecked();
+    m_pgnTable->setSortingEnabled(false);
+    m_pgnTable->setRowCount(0);
+
+    for (const CaptureDiff::PgnEntry& entry : m_diff.pgnEntries()) {
+        QStringList status;
+        if (!entry.isPresent(CaptureDiff::Right)) {
+            status << "Only in A";
+        } else if (!entry.isPresent(CaptureDiff::Left)) {
+            status << "Only in B";
+        } else {
+            if (entry.fieldDifferences > 0) {
+                status << "Fields";
+            }
+            if (entry.orderDiffers()) {
+                status << "Order";
+            }
+            if (entry.count[CaptureDiff::Left] != entry.count[CaptureDiff::Right]) {
+                status << "Count";
+            }
+        }
+        if (differencesOnly && status.isEmpty()) {
+            continue;
+        }
+
+        const int row = m_pgnTable->rowCount();
+        m_pgnTable->insertRow(row);
+        int column = 0;
+        m_pgnTable->setItem(row, column++, item(status.isEmpty() ? QString("Same") : status.join(", ")));
+        m_pgnTable->setItem(row, column++, item(entry.pgn));
+        m_pgnTable->setItem(row, column++, item(entry.name));
+        m_pgnTable->setItem(row, column++, item(m_diff.roleName(entry.sourceRole)));
+        m_pgnTable->setItem(row, column++, item(m_diff.roleName(entry.destinationRole)));
+        for (int side = 0; side < CaptureDiff::SIDES; side++) {
+            m_pgnTable->setItem(row, column++, item(entry.count[side]));
+        }
+        for (int side = 0; side < CaptureDiff::SIDES; side++) {
+            m_pgnTable->setItem(row, column++, item(milliseconds(entry.firstNs[side])));
+        }
+        for (int side = 0; side < CaptureDiff::SIDES; side++) {
+            m_pgnTable->setItem(row, column++, item(entry.order[side] >= 0 ? QVariant(entry.order[side] + 1) : QVariant()));
+        }
+        for (int side = 0; side < CaptureDiff::SIDES; side++) {
+            m_pgnTable->setItem(row, column++, item(milliseconds(entry.meanIntervalNs(side))));
+        }
+        m_pgnTable->setItem(row, column++, item(entry.fieldDifferences));
+    }
+
+    m_pgnTable->setSortingEnabled(true);
+    m_pgnTable->resizeColumnsToContents();
+}
+
+void CaptureDiffDialog::populateFieldTable()
+{
+    const bool differencesOnly = m_differencesOnlyCheckBox->isChecked();
+    m_fieldTable->setSortingEnabled(false);
+    m_fieldTable->setRowCount(0);
+
+    for (const CaptureDiff::FieldEntry& field : m_diff.fieldEntries()) {
+        const CaptureDiff::PgnEntry& entry = m_diff.pgnEntries()[field.pgnEntry];
+        // Fields of a PGN only one capture has are covered by the PGN table
+        if (!entry.isInBoth() || (differencesOnly && !field.differs())) {
+            continue;
+        }
+
+        const int row = m_fieldTable->rowCount();
+        m_fieldTable->insertRow(row);
+        int column = 0;
+        m_fieldTable->setItem(row, column++, item(entry.pgn));
+        m_fieldTable->setItem(row, column++, item(entry.name));
+        m_fieldTable->setItem(row, column++, item(m_diff.roleName(entry.sourceRole)));
+        m_fieldTable->setItem(row, column++, item(m_diff.roleName(entry.destinationRole)));
+        m_fieldTable->setItem(row, column++, item(field.name));
+        for (int side = 0; side < CaptureDiff::SIDES; side++) {
+            QString values = field.values[side].join(" | ");
+            if (field.truncated[side]) {
+                values += " | ...";
+            }
+            m_fieldTable->setItem(row, column++, item(values));
+        }
+    }
+
+    m_fieldTable->setSortingEnabled(true);
+    m_fieldTable->resizeColumnsToContents();
+}
+
+void CaptureDiffDialog::populateLatencyTable()
+{
+    m_latencyTable->setSortingEnabled(false);
+    m_latencyTable->setRowCount(0);
+
+    for (const CaptureDiff::LatencyEntry& entry : m_diff.latencyEntries()) {
+        const int row = m_latencyTable->rowCount();
+        m_latencyTable->insertRow(row);
+        int column = 0;
+        m_latencyTable->setItem(row, column++, item(entry.requestPgn == 59904 ? QString("ISO Request") : QString("Group Function")));
+        m_latencyTable->setItem(row, column++, item(entry.responsePgn));
+        m_latencyTable->setItem(row, column++, item(m_diff.roleName(entry.requesterRole)));
+        m_latencyTable->setItem(row, column++, item(m_diff.roleName(entry.responderRole)));
+        for (int side = 0; side < CaptureDiff::SIDES; side++) {
+            m_latencyTable->setItem(row, column++, item(entry.requests[side]));
+            m_latencyTable->setItem(row, column++, item(entry.answered[side]));
+            m_latencyTable->setItem(row, column++, item(milliseconds(entry.meanNs(side))));
+            m_latencyTable->setItem(row, column++, item(milliseconds(entry.maxNs[side])));
+        }
+    }
+
+    m_latencyTable->setSortingEnabled(true);
+    m_latencyTable->resizeColumnsToContents();
+}
+
+QTableWidgetItem* CaptureDiffDialog::item(const QVariant& value)
+{
+    // Numbers stay numbers so the columns sort numerically
+    QTableWidgetItem* tableItem = new QTableWidgetItem();
+    tableItem->setData(Qt::DisplayRole, value);
+    return tableItem;
+}
+
+QVariant CaptureDiffDialog::milliseconds(qint64 ns)
+{
+    if (ns < 0) {
+        return QVariant();
+    }
+    return qRound64(double(ns) / 1000.0) / 1000.0;
+}
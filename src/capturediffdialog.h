@@ -0,0 +1,74 @@
+#ifndef CAPTUREDIFFDIALOG_H
+#define CAPTUREDIFFDIALOG_H
+
+#include <QDialog>
+#include <QHash>
+#include <QString>
+#include "capturestore.h"
+#include "capturediff.h"
+
+class QLineEdit;
+class QPushButton;
+class QCheckBox;
+class QLabel;
+class QProgressBar;
+class QTabWidget;
+class QTableWidget;
+class QTableWidgetItem;
+class DBCDecoder;
+class PGNLogLoader;
+
+/**
+ * @brief Compares two log files with CaptureDiff.
+ *
+ * Both files are loaded through PGNLogLoader in parallel; the comparison runs
+ * once both are in and is shown as PGN, field and latency tables with the two
+ * captures side by side.
+ */
+class CaptureDiffDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit CaptureDiffDialog(QWidget* parent = nullptr);
+    ~CaptureDiffDialog();
+
+private slots:
+    void onBrowseClicked(int side);
+    void onCompareClicked();
+    void onLoaderChunksAvailable(int side);
+    void onLoaderFinished(int side, bool success);
+    void populateTables();
+
+private:
+    void setupUI();
+    void startLoader(int side);
+    void stopLoaders();
+    void updateProgress();
+    void populatePgnTable();
+    void populateFieldTable();
+    void populateLatencyTable();
+    static QTableWidgetItem* item(const QVariant& value);
+    static QVariant milliseconds(qint64 ns);
+
+    DBCDecoder* m_dbcDecoder;
+    CaptureDiff m_diff;
+    CaptureStore m_stores[CaptureDiff::SIDES];
+    QHash<quint8, QString> m_deviceNames[CaptureDiff::SIDES];
+    PGNLogLoader* m_loaders[CaptureDiff::SIDES] = { nullptr, nullptr };
+    int m_progress[CaptureDiff::SIDES] = { 0, 0 };
+    bool m_loadFailed;
+
+    QLineEdit* m_fileEdits[CaptureDiff::SIDES];
+    QPushButton* m_browseButtons[CaptureDiff::SIDES];
+    QPushButton* m_compareButton;
+    QCheckBox* m_differencesOnlyCheckBox;
+    QProgressBar* m_loadProgressBar;
+    QLabel* m_summaryLabel;
+    QTabWidget* m_tabs;
+    QTableWidget* m_pgnTable;
+    QTableWidget* m_fieldTable;
+    QTableWidget* m_latencyTable;
+};
+
+#endif // CAPTUREDIFFDIALOG_H
@@ -0,0 +1,349 @@
+#include "capturefile.h"
+#include "capturestore.h"
+#include <QFile>
+#include <QtEndian>
+#include <QDebug>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+// Records are encoded and written in chunks to bound the temporary buffer
+const int WRITE_CHUNK_RECORDS = 16384;
+
+template <typename T>
+void appendLE(QByteArray& out, T value)
+{
+    char bytes[sizeof(T)];
+    qToLittleEndian<T>(value, bytes);
+    out.append(bytes, sizeof(T));
+}
+
+// Bounds-checked little-endian reader over a mapped or loaded file
+struct ByteReader
+{
+    const uchar* data;
+    qint64 size;
+    qint64 pos;
+    bool ok;
+
+    ByteReader(const uchar* d, qint64 s) : data(d), size(s), pos(0), ok(true) {}
+
+    bool has(qint64 count) const { return ok && count >= 0 && pos + count <= size; }
+
+    template <typename T>
+    T read()
+    {
+        if (!has(sizeof(T))) {
+            ok = false;
+            return T(0);
+        }
+        T value = qFromLittleEndian<T>(data + pos);
+        pos += sizeof(T);
+        return value;
+    }
+
+    const uchar* take(qint64 count)
+    {
+        if (!has(count)) {
+            ok = false;
+            return nullptr;
+        }
+        const uchar* p = data + pos;
+        pos += count;
+        return p;
+    }
+};
+
+bool fail(QString* errorString, const QString& message)
+{
+    if (errorString) {
+        *errorString = message;
+    }
+    return false;
+}
+
+} // namespace
+
+QByteArray CaptureFile::magic()
+{
+    return QByteArray("N2KPGNLG", 8);
+}
+
+QByteArray CaptureFile::trailerMagic()
+{
+    return QByteArray("N2KIDX02", 8);
+}
+
+bool CaptureFile::isCaptureFile(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return file.read(8) == magic();
+}
+
+void CaptureFile::encodeRecord(const CaptureStore& store, int row, uchar* record)
+{
+    qToLittleEndian<qint64>(store.wallNs(row), record + REC_WALL_NS);
+    qToLittleEndian<qint64>(store.monotonicNs(row), record + REC_MONOTONIC_NS);
+    qToLittleEndian<quint32>(store.pgn(row), record + REC_PGN);
+    qToLittleEndian<quint32>(store.payloadOffset(row), record + REC_PAYLOAD_OFFSET);
+    record[REC_PRIORITY] = store.priority(row);
+    record[REC_SOURCE] = store.source(row);
+    record[REC_DESTINATION] = store.destination(row);
+    record[REC_LENGTH] = store.length(row);
+    record[REC_FLAGS] = store.flags(row);
+    memset(record + REC_FLAGS + 1, 0, RECORD_SIZE - REC_FLAGS - 1);
+}
+
+bool CaptureFile::decodeRecord(const uchar* record, const uchar* payload, quint64 payloadSize, CaptureStore& store)
+{
+    const quint32 payloadOffset = qFromLittleEndian<quint32>(record + REC_PAYLOAD_OFFSET);
+    const quint8 length = record[REC_LENGTH];
+    if (quint64(payloadOffset) + length > payloadSize) {
+        return false;
+    }
+
+    store.appendRaw(qFromLittleEndian<quint32>(record + REC_PGN),
+                    record[REC_PRIORITY],
+                    record[REC_SOURCE],
+                    record[REC_DESTINATION],
+                    payload + payloadOffset, length,
+                    qFromLittleEndian<qint64>(record + REC_WALL_NS),
+                    qFromLittleEndian<qint64>(record + REC_MONOTONIC_NS),
+                    record[REC_FLAGS]);
+    return true;
+}
+
+bool CaptureFile::save(const QString& fileName, const CaptureStore& store,
+                       const QHash<quint8, QString>& deviceNames, QString* errorString)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return fail(errorString, file.errorString());
+    }
+
+    const int count = store.size();
+
+    // Header with the device-name table, sorted by address so saves are reproducible
+    QByteArray header = magic();
+    appendLE<quint16>(header, FORMAT_VERSION);
+    appendLE<quint16>(header, RECORD_SIZE);
+    appendLE<quint32>(header, 0);
+    appendLE<quint64>(header, quint64(count));
+
+    QList<quint8> addresses = deviceNames.keys();
+    std::sort(addresses.begin(), addresses.end());
+    appendLE<quint16>(header, quint16(addresses.size()));
+    for (quint8 address : addresses) {
+        QByteArray name = deviceNames.value(address).toUtf8().left(0xFFFF);
+        appendLE<quint8>(header, address);
+        appendLE<quint16>(header, quint16(name.size()));
+        header.append(name);
+    }
+    if (file.write(header) != header.size()) {
+        return fail(errorString, file.errorString());
+    }
+
+    // Fixed-size records straight from the store columns
+    QByteArray chunk;
+    for (int start = 0; start < count; start += WRITE_CHUNK_RECORDS) {
+        const int n = qMin(WRITE_CHUNK_RECORDS, count - start);
+        chunk.resize(qsizetype(n) * RECORD_SIZE);
+        uchar* rec = reinterpret_cast<uchar*>(chunk.data());
+        for (int row = start; row < start + n; row++, rec += RECORD_SIZE) {
+            encodeRecord(store, row, rec);
+        }
+        if (file.write(chunk) != chunk.size()) {
+            return fail(errorString, file.errorString());
+        }
+    }
+
+    // Payload arena as a single block - record offsets already point into it
+    const QByteArray& payload = store.payloadArena();
+    QByteArray payloadHeader;
+    appendLE<quint64>(payloadHeader, quint64(payload.size()));
+    if (file.write(payloadHeader) != payloadHeader.size() || file.write(payload) != payload.size()) {
+        return fail(errorString, file.errorString());
+    }
+
+    // Sparse time/PGN index
+    const quint64 indexOffset = quint64(file.pos());
+    QByteArray index;
+    const int blockCount = (count + INDEX_BLOCK_RECORDS - 1) / INDEX_BLOCK_RECORDS;
+    appendLE<quint32>(index, quint32(blockCount));
+    QVector<quint32> pgns;
+    for (int first = 0; first < count; first += INDEX_BLOCK_RECORDS) {
+        const int last = qMin(first + INDEX_BLOCK_RECORDS, count) - 1;
+        pgns.clear();
+        for (int row = first; row <= last; row++) {
+            pgns.append(store.pgn(row));
+        }
+        std::sort(pgns.begin(), pgns.end());
+        pgns.erase(std::unique(pgns.begin(), pgns.end()), pgns.end());
+
+        appendLE<quint32>(index, quint32(first));
+        appendLE<qint64>(index, store.wallNs(first));
+        appendLE<qint64>(index, store.wallNs(last));
+        appendLE<quint16>(index, quint16(pgns.size()));
+        for (quint32 pgn : pgns) {
+            appendLE<quint32>(index, pgn);
+        }
+    }
+    appendLE<quint64>(index, indexOffset);
+    index.append(trailerMagic());
+    if (file.write(index) != index.size()) {
+        return fail(errorString, file.errorString());
+    }
+
+    file.close();
+    if (file.error() != QFileDevice::NoError) {
+        return fail(errorString, file.errorString());
+    }
+    return true;
+}
+
+CaptureFileReader::CaptureFileReader()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_records(nullptr)
+    , m_recordSize(0)
+    , m_recordCount(0)
+    , m_payload(nullptr)
+    , m_payloadSize(0)
+{
+}
+
+CaptureFileReader::~CaptureFileReader()
+{
+    close();
+}
+
+void CaptureFileReader::close()
+{
+    m_file.close();  // Also unmaps
+    m_contents.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_records = nullptr;
+    m_recordCount = 0;
+    m_payload = nullptr;
+    m_payloadSize = 0;
+    m_deviceNames.clear();
+    m_index.clear();
+}
+
+bool CaptureFileReader::open(const QString& fileName, QString* errorString)
+{
+    close();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(errorString, m_file.errorString());
+    }
+
+    // Map the file when possible, otherwise fall back to reading it into memory
+    m_size = m_file.size();
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        m_contents = m_file.readAll();
+        m_data = reinterpret_cast<const uchar*>(m_contents.constData());
+        m_size = m_contents.size();
+    }
+
+    ByteReader in(m_data, m_size);
+    const uchar* fileMagic = in.take(8);
+    if (!fileMagic || memcmp(fileMagic, CaptureFile::magic().constData(), 8) != 0) {
+        return fail(errorString, "Not a binary PGN capture file");
+    }
+
+    const quint16 version = in.read<quint16>();
+    m_recordSize = in.read<quint16>();
+    in.read<quint32>();
+    m_recordCount = in.read<quint64>();
+    if (!in.ok || version != CaptureFile::FORMAT_VERSION) {
+        return fail(errorString, QString("Unsupported capture format version %1").arg(version));
+    }
+    // Later revisions may append fields to a record, so only require the ones we know
+    if (m_recordSize < CaptureFile::RECORD_SIZE) {
+        return fail(errorString, QString("Invalid capture record size %1").arg(m_recordSize));
+    }
+    if (m_recordCount > quint64(INT_MAX)) {
+        return fail(errorString, "Capture file has too many records");
+    }
+
+    const quint16 deviceCount = in.read<quint16>();
+    for (int i = 0; i < deviceCount && in.ok; i++) {
+        const quint8 address = in.read<quint8>();
+        const quint16 nameLength = in.read<quint16>();
+        const uchar* name = in.take(nameLength);
+        if (name) {
+            m_deviceNames.insert(address, QString::fromUtf8(reinterpret_cast<const char*>(name), nameLength));
+        }
+    }
+
+    m_records = in.take(qint64(m_recordCount) * m_recordSize);
+    m_payloadSize = in.read<quint64>();
+    m_payload = in.take(qint64(m_payloadSize));
+    if (!in.ok) {
+        return fail(errorString, "Capture file is truncated");
+    }
+
+    readIndex();
+    return true;
+}
+
+void CaptureFileReader::readIndex()
+{
+    // The index is optional - a file without a valid trailer still loads
+    const qint64 trailerSize = CaptureFile::TRAILER_SIZE;
+    if (m_size < trailerSize ||
+        memcmp(m_data + m_size - 8, CaptureFile::trailerMagic().constData(), 8) != 0) {
+        return;
+    }
+
+    const quint64 indexOffset = qFromLittleEndian<quint64>(m_data + m_size - trailerSize);
+    if (indexOffset >= quint64(m_size - trailerSize)) {
+        return;
+    }
+
+    ByteReader in(m_data, m_size - trailerSize);
+    in.pos = qint64(indexOffset);
+    const quint32 blockCount = in.read<quint32>();
+    QVector<CaptureFile::IndexBlock> blocks;
+    for (quint32 b = 0; b < blockCount && in.ok; b++) {
+        CaptureFile::IndexBlock block;
+        block.firstRecord = in.read<quint32>();
+        block.firstWallNs = in.read<qint64>();
+        block.lastWallNs = in.read<qint64>();
+        const quint16 pgnCount = in.read<quint16>();
+        for (int p = 0; p < pgnCount && in.ok; p++) {
+            block.pgns.append(in.read<quint32>());
+        }
+        blocks.append(block);
+    }
+
+    if (in.ok) {
+        m_index = blocks;
+    } else {
+        qWarning() << "Ignoring damaged index in capture file" << m_file.fileName();
+    }
+}
+
+bool CaptureFileReader::readRecords(qint64 first, int count, CaptureStore& store, QString* errorString)
+{
+    if (first < 0 || count < 0 || quint64(first) + quint64(count) > m_recordCount) {
+        return fail(errorString, "Record range is outside the capture file");
+    }
+
+    const uchar* rec = m_records + first * m_recordSize;
+    for (int i = 0; i < count; i++, rec += m_recordSize) {
+        if (!CaptureFile::decodeRecord(rec, m_payload, m_payloadSize, store)) {
+            return fail(errorString, QString("Capture record %1 points outside the payload data").arg(first + i));
+        }
+    }
+    return true;
+}
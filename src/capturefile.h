@@ -0,0 +1,117 @@
+#ifndef CAPTUREFILE_H
+#define CAPTUREFILE_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QHash>
+#include <QVector>
+#include <QFile>
+#include <QByteArray>
+
+class CaptureStore;
+
+/**
+ * @brief Binary .pgnlog capture file (format version 2).
+ *
+ * Saving copies the capture store columns into fixed-size records and writes
+ * the payload arena as one block, so a large capture saves at close to disk
+ * speed. All integers are little-endian.
+ *
+ *   Header    magic "N2KPGNLG", u16 version, u16 record size, u32 reserved,
+ *             u64 record count, u16 device count, then per device:
+ *             u8 address, u16 name length, UTF-8 name
+ *   Records   record count x RECORD_SIZE bytes (see the offsets below)
+ *   Payloads  u64 byte count, then the payload bytes of every record
+ *   Index     u32 block count, per block of INDEX_BLOCK_RECORDS records:
+ *             u32 first record, i64 first wall ns, i64 last wall ns,
+ *             u16 PGN count, u32 distinct PGNs
+ *   Trailer   u64 offset of the index, magic "N2KIDX02"
+ *
+ * PGNLogLoader reads only the index blocks that overlap a requested time
+ * range.
+ *
+ * The text log (format 1.1) remains available as an export option.
+ */
+class CaptureFile
+{
+public:
+    static const quint16 FORMAT_VERSION = 2;
+    static const int RECORD_SIZE = 32;
+    static const int INDEX_BLOCK_RECORDS = 4096;
+    static const int TRAILER_SIZE = 16;
+
+    // Byte offsets within a record
+    static const int REC_WALL_NS = 0;        // i64
+    static const int REC_MONOTONIC_NS = 8;   // i64
+    static const int REC_PGN = 16;           // u32
+    static const int REC_PAYLOAD_OFFSET = 20; // u32, relative to the payload block
+    static const int REC_PRIORITY = 24;      // u8
+    static const int REC_SOURCE = 25;        // u8
+    static const int REC_DESTINATION = 26;   // u8
+    static const int REC_LENGTH = 27;        // u8
+    static const int REC_FLAGS = 28;         // u8, CaptureStore::RowFlag
+
+    // One entry of the sparse time/PGN index
+    struct IndexBlock {
+        quint32 firstRecord = 0;
+        qint64 firstWallNs = 0;
+        qint64 lastWallNs = 0;
+        QVector<quint32> pgns;  // Sorted, distinct PGNs in the block
+    };
+
+    // True when the file starts with the binary capture magic
+    static bool isCaptureFile(const QString& fileName);
+
+    static bool save(const QString& fileName, const CaptureStore& store,
+                     const QHash<quint8, QString>& deviceNames, QString* errorString = nullptr);
+
+    static QByteArray magic();
+    static QByteArray trailerMagic();
+
+    // Record encoding shared with the segment format - payload offsets are the store's own
+    static void encodeRecord(const CaptureStore& store, int row, uchar* record);
+    // Append one record whose payload lies in payload[0, payloadSize). False when it points outside
+    static bool decodeRecord(const uchar* record, const uchar* payload, quint64 payloadSize, CaptureStore& store);
+};
+
+/**
+ * @brief Reads a binary capture file in record ranges.
+ *
+ * open() maps the file and validates the header, device table and section
+ * sizes; records are then decoded on demand with readRecords(), so a loader
+ * can hand the first rows to the view before the rest of the file is read.
+ */
+class CaptureFileReader
+{
+public:
+    CaptureFileReader();
+    ~CaptureFileReader();
+
+    bool open(const QString& fileName, QString* errorString = nullptr);
+    void close();
+
+    qint64 recordCount() const { return qint64(m_recordCount); }
+    qint64 fileSize() const { return m_size; }
+    const QHash<quint8, QString>& deviceNames() const { return m_deviceNames; }
+    const QVector<CaptureFile::IndexBlock>& index() const { return m_index; }
+
+    // Append count records starting at first to store
+    bool readRecords(qint64 first, int count, CaptureStore& store, QString* errorString = nullptr);
+
+private:
+    void readIndex();
+
+    QFile m_file;
+    QByteArray m_contents;  // Only used when the file cannot be mapped
+    const uchar* m_data;
+    qint64 m_size;
+    const uchar* m_records;
+    quint16 m_recordSize;
+    quint64 m_recordCount;
+    const uchar* m_payload;
+    quint64 m_payloadSize;
+    QHash<quint8, QString> m_deviceNames;
+    QVector<CaptureFile::IndexBlock> m_index;
+};
+
+#endif // CAPTUREFILE_H
@@ -0,0 +1,101 @@
+#include "capturefilter.h"
+#include "capturestore.h"
+#include <algorithm>
+
+bool CaptureFilter::matches(quint32 pgn, quint8 src, quint8 dst) const
+{
+    if (ignoredPgns.contains(pgn)) {
+        return false;
+    }
+
+    const bool sourceMatch = !sourceActive || src == source;
+    const bool destMatch = !destinationActive || dst == destination;
+    if (sourceActive && destinationActive) {
+        return useAndLogic ? sourceMatch && destMatch : sourceMatch || destMatch;
+    }
+    return sourceMatch && destMatch;
+}
+
+void CaptureFilter::evaluate(const CaptureStore& store, int first, int count, QVector<quint8>& selection) const
+{
+    selection.resize(count);
+    if (count <= 0) {
+        return;
+    }
+
+    quint8* sel = selection.data();
+    const quint8* src = store.sourceData() + first;
+    const quint8* dst = store.destinationData() + first;
+    const quint32* pgn = store.pgnData() + first;
+
+    // Source/destination conditions
+    if (sourceActive && destinationActive) {
+        const quint8 s = source;
+        const quint8 d = destination;
+        if (useAndLogic) {
+            for (int i = 0; i < count; i++) {
+                sel[i] = quint8((src[i] == s) & (dst[i] == d));
+            }
+        } else {
+            for (int i = 0; i < count; i++) {
+                sel[i] = quint8((src[i] == s) | (dst[i] == d));
+            }
+        }
+    } else if (sourceActive) {
+        const quint8 s = source;
+        for (int i = 0; i < count; i++) {
+            sel[i] = quint8(src[i] == s);
+        }
+    } else if (destinationActive) {
+        const quint8 d = destination;
+        for (int i = 0; i < count; i++) {
+            sel[i] = quint8(dst[i] == d);
+        }
+    } else {
+        std::fill(sel, sel + count, quint8(1));
+    }
+
+    // Ignored PGNs
+    if (ignoredPgns.size() <= MAX_PGN_COMPARE_PASSES) {
+        for (quint32 ignored : ignoredPgns) {
+            for (int i = 0; i < count; i++) {
+                sel[i] &= quint8(pgn[i] != ignored);
+            }
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            if (sel[i] && ignoredPgns.contains(pgn[i])) {
+                sel[i] = 0;
+            }
+        }
+    }
+
+    // Repeats of an unchanged payload
+    if (changesOnly) {
+        const quint8* flags = store.flagsData() + first;
+        for (int i = 0; i < count; i++) {
+            sel[i] &= quint8(!(flags[i] & CaptureStore::RepeatFlag));
+        }
+    }
+
+    // The query only runs on rows the cheap conditions kept
+    if (query) {
+        query->prepare(store, first, count);
+        for (int i = 0; i < count; i++) {
+            if (sel[i] && !query->matches(store, first + i)) {
+                sel[i] = 0;
+            }
+        }
+    }
+}
+
+void CaptureFilter::appendSelectedRows(const QVector<quint8>& selection, int first, QVector<int>& rows)
+{
+    const quint8* sel = selection.constData();
+    const int count = selection.size();
+    for (int i = 0; i < count; i++) {
+        if (sel[i]) {
+            rows.append(first + i);
+        }
+    }
+}
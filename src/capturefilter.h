@@ -0,0 +1,59 @@
+#ifndef CAPTUREFILTER_H
+#define CAPTUREFILTER_H
+
+#include <QtGlobal>
+#include <QSet>
+#include <QVector>
+#include <QSharedPointer>
+#include "capturequery.h"
+
+class CaptureStore;
+
+/**
+ * @brief Source/destination/PGN filter of the PGN log.
+ *
+ * matches() checks a single message as it arrives. evaluate() applies the
+ * filter to a range of capture store rows column by column - one tight compare
+ * loop per active condition over the raw arrays, which the compiler turns into
+ * SIMD code - and produces a selection bitmap with one byte per row.
+ *
+ * An optional CaptureQuery narrows the view further. It only applies in
+ * evaluate(), so it never drops live traffic from the capture. So does
+ * changesOnly, which hides the rows the store marked as repeats.
+ */
+struct CaptureFilter
+{
+    bool sourceActive = false;
+    quint8 source = 0;
+    bool destinationActive = false;
+    quint8 destination = 0;
+    bool useAndLogic = true;        // How source and destination conditions combine when both are active
+    QSet<quint32> ignoredPgns;      // Empty when PGN filtering is disabled
+    QSharedPointer<CaptureQuery> query;
+    bool changesOnly = false;       // Hide repeated payloads
+
+    bool isActive() const { return sourceActive || destinationActive || !ignoredPgns.isEmpty() || query || changesOnly; }
+    bool matches(quint32 pgn, quint8 src, quint8 dst) const;
+
+    bool operator==(const CaptureFilter& other) const
+    {
+        return sourceActive == other.sourceActive && source == other.source &&
+               destinationActive == other.destinationActive && destination == other.destination &&
+               useAndLogic == other.useAndLogic && ignoredPgns == other.ignoredPgns &&
+               queryText() == other.queryText() && changesOnly == other.changesOnly;
+    }
+    bool operator!=(const CaptureFilter& other) const { return !(*this == other); }
+    QString queryText() const { return query ? query->text() : QString(); }
+
+    // selection[i] is 1 when store row first + i passes the filter. The rows are
+    // prepared for the query first, so ranges must be evaluated in capture order
+    void evaluate(const CaptureStore& store, int first, int count, QVector<quint8>& selection) const;
+
+    // Append the store rows of the set selection entries to rows
+    static void appendSelectedRows(const QVector<quint8>& selection, int first, QVector<int>& rows);
+
+    // Above this many ignored PGNs a hash lookup per row beats one compare pass per PGN
+    static const int MAX_PGN_COMPARE_PASSES = 32;
+};
+
+#endif // CAPTUREFILTER_H
@@ -0,0 +1,599 @@
+#include "capturequery.h"
+#include "capturestore.h"
+#include "dbcdecoder.h"
+#include <QHash>
+#include <QSet>
+#include <QVariant>
+#include <QRegularExpression>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Same matching as DBCDecoder::findSignals - case, spaces and underscores don't count
+QString normalizedName(QString name)
+{
+    return name.remove(QChar('_')).remove(QChar(' ')).toLower();
+}
+
+// Value of the field named key in the custom decoder output for a row
+bool customField(DBCDecoder* decoder, const CaptureStore& store, int row, const QString& key, QVariant& value)
+{
+    const DecodedMessage decoded = decoder->decodeMessage(store.message(row));
+    if (!decoded.isDecoded) {
+        return false;
+    }
+    for (const DecodedSignal& field : decoded.signalList) {
+        if (field.isValid && normalizedName(field.name) == key) {
+            value = field.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Number shown for a decoded value - formatted text such as "42 (16.5%)" starts with it
+bool numericValue(const QVariant& value, double& number)
+{
+    static const QRegularExpression leadingNumber("^\\s*([-+]?\\d+(?:\\.\\d+)?)");
+
+    bool ok = false;
+    if (value.userType() != QMetaType::QString) {
+        number = value.toDouble(&ok);
+        return ok;
+    }
+    const QRegularExpressionMatch match = leadingNumber.match(value.toString());
+    if (match.hasMatch()) {
+        number = match.captured(1).toDouble(&ok);
+    }
+    return ok;
+}
+
+} // namespace
+
+// Recursive-descent parser that turns query text into predicates
+class CaptureQuery::Parser
+{
+public:
+    Parser(DBCDecoder* decoder, CaptureQuery* query) : m_decoder(decoder), m_query(query), m_pos(0) {}
+
+    Predicate parse(const QString& text);
+    QString error() const { return m_error; }
+
+private:
+    struct Token {
+        enum Type { End, Number, Identifier, String, Operator };
+        Type type = End;
+        QString text;
+        double number = 0.0;
+        int position = 0;
+    };
+
+    // Value of an operand for a row; false when the row has no such value
+    typedef std::function<bool(const CaptureStore& store, int row, double& value)> Operand;
+
+    // PGNs compared on the output of their custom decoder instead of a DBC layout
+    struct CustomFields {
+        QSet<quint32> pgns;
+        DBCDecoder* decoder = nullptr;
+        QString key;  // Normalized signal name
+    };
+
+    enum Comparison { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual };
+
+    bool tokenize(const QString& text);
+    Predicate parseWithin();
+    Predicate parseOr();
+    Predicate parseAnd();
+    Predicate parseUnary();
+    Predicate parseComparison();
+    Predicate parseSignalString(const QString& name, const QList<QPair<unsigned long, DBCSignal>>& definitions,
+                                const CustomFields& custom, Comparison comparison, const QString& value);
+    bool parseDuration(qint64& ns);
+    bool parseNumber(double& value);
+
+    const Token& peek() const { return m_tokens[m_pos]; }
+    const Token& take() { return m_tokens[m_pos < m_tokens.size() - 1 ? m_pos++ : m_pos]; }
+    bool acceptOperator(const char* op);
+    bool acceptKeyword(const char* keyword);
+    Predicate fail(const QString& message);
+
+    DBCDecoder* m_decoder;
+    CaptureQuery* m_query;
+    QVector<Token> m_tokens;
+    int m_pos;
+    QString m_error;
+};
+
+CaptureQuery::Predicate CaptureQuery::Parser::parse(const QString& text)
+{
+    if (!tokenize(text)) {
+        return Predicate();
+    }
+    if (peek().type == Token::End) {
+        return fail("Empty query");
+    }
+
+    Predicate predicate = parseWithin();
+    if (predicate && peek().type != Token::End) {
+        return fail(QString("Unexpected '%1' at position %2").arg(peek().text).arg(peek().position + 1));
+    }
+    return predicate;
+}
+
+bool CaptureQuery::Parser::tokenize(const QString& text)
+{
+    static const char* const operators[] = {
+        "==", "!=", "<=", ">=", "&&", "||", "<", ">", "=", "!", "(", ")", "[", "]", "-"
+    };
+
+    const int n = text.size();
+    int i = 0;
+    while (i < n) {
+        const QChar c = text[i];
+        if (c.isSpace()) {
+            i++;
+            continue;
+        }
+
+        Token token;
+        token.position = i;
+        const int start = i;
+        if (c.isDigit() || (c == QChar('.') && i + 1 < n && text[i + 1].isDigit())) {
+            // Numbers - a unit directly after one ("5s") becomes its own identifier
+            bool ok = false;
+            if (c == QChar('0') && i + 1 < n && (text[i + 1] == QChar('x') || text[i + 1] == QChar('X'))) {
+                i += 2;
+                while (i < n && (text[i].isDigit() || QString("abcdefABCDEF").contains(text[i]))) {
+                    i++;
+                }
+                token.number = double(text.mid(start + 2, i - start - 2).toULongLong(&ok, 16));
+            } else {
+                while (i < n && (text[i].isDigit() || text[i] == QChar('.'))) {
+                    i++;
+                }
+                token.number = text.mid(start, i - start).toDouble(&ok);
+            }
+            if (!ok) {
+                m_error = QString("Invalid number '%1'").arg(text.mid(start, i - start));
+                return false;
+            }
+            token.type = Token::Number;
+        } else if (c.isLetter() || c == QChar('_')) {
+            while (i < n && (text[i].isLetterOrNumber() || text[i] == QChar('_') || text[i] == QChar('.'))) {
+                i++;
+            }
+            token.type = Token::Identifier;
+        } else if (c == QChar('"') || c == QChar('\'')) {
+            i++;
+            while (i < n && text[i] != c) {
+                i++;
+            }
+            if (i >= n) {
+                m_error = QString("Unterminated string at position %1").arg(start + 1);
+                return false;
+            }
+            i++;
+            token.type = Token::String;
+        } else {
+            for (const char* op : operators) {
+                const int length = int(strlen(op));
+                if (text.mid(i, length) == QLatin1String(op)) {
+                    i += length;
+                    token.type = Token::Operator;
+                    break;
+                }
+            }
+            if (token.type != Token::Operator) {
+                m_error = QString("Unexpected '%1' at position %2").arg(c).arg(i + 1);
+                return false;
+            }
+        }
+
+        token.text = token.type == Token::String ? text.mid(start + 1, i - start - 2) : text.mid(start, i - start);
+        m_tokens.append(token);
+    }
+
+    Token end;
+    end.position = n;
+    m_tokens.append(end);
+    return true;
+}
+
+CaptureQuery::Predicate CaptureQuery::Parser::parseWithin()
+{
+    Predicate target = parseOr();
+    while (target && acceptKeyword("within")) {
+        qint64 span = 0;
+        if (!parseDuration(span)) {
+            return Predicate();
+        }
+        if (!acceptKeyword("of")) {
+            return fail(QString("Expected 'of' at position %1").arg(peek().position + 1));
+        }
+
+        // Windows inside the anchor are registered while it is parsed, so they come first
+        QSharedPointer<TimeWindow> window(new TimeWindow);
+        window->anchor = parseOr();
+        if (!window->anchor) {
+            return Predicate();
+        }
+        m_query->m_windows.append(window);
+
+        target = [target, window, span](const CaptureStore& store, int row) {
+            if (!target(store, row)) {
+                return false;
+            }
+            const qint64 time = store.wallNs(row);
+            const QVector<qint64>& times = window->anchorTimes;
+            auto nearest = std::lower_bound(times.constBegin(), times.constEnd(), time - span);
+            return nearest != times.constEnd() && *nearest <= time + span;
+        };
+    }
+    return target;
+}
+
+CaptureQuery::Predicate CaptureQuery::Parser::parseOr()
+{
+    Predicate left = parseAnd();
+    while (left && (acceptOperator("||") || acceptKeyword("or"))) {
+        Predicate right = parseAnd();
+        if (!right) {
+            return Predicate();
+        }
+        left = [left, right](const CaptureStore& store, int row) {
+            return left(store, row) || right(store, row);
+        };
+    }
+    return left;
+}
+
+CaptureQuery::Predicate CaptureQuery::Parser::parseAnd()
+{
+    Predicate left = parseUnary();
+    while (left && (acceptOperator("&&") || acceptKeyword("and"))) {
+        Predicate right = parseUnary();
+        if (!right) {
+            return Predicate();
+        }
+        left = [left, right](const CaptureStore& store, int row) {
+            return left(store, row) && right(store, row);
+        };
+    }
+    return left;
+}
+
+CaptureQuery::Predicate CaptureQuery::Parser::parseUnary()
+{
+    if (acceptOperator("!") || acceptKeyword("not")) {
+        Predicate operand = parseUnary();
+        if (!operand) {
+            return Predicate();
+        }
+        return [operand](const CaptureStore& store, int row) {
+            return !operand(store, row);
+        };
+    }
+
+    if (acceptOperator("(")) {
+        Predicate inner = parseWithin();
+        if (inner && !acceptOperator(")")) {
+            return fail(QString("Expected ')' at position %1").arg(peek().position + 1));
+        }
+        return inner;
+    }
+
+    return parseComparison();
+}
+
+CaptureQuery::Predicate CaptureQuery::Parser::parseComparison()
+{
+    const Token& nameToken = take();
+    if (nameToken.type != Token::Identifier) {
+        return fail(QString("Expected a field or signal name at position %1").arg(nameToken.position + 1));
+    }
+    const QString name = nameToken.text.toLower();
+
+    Operand operand;
+    bool isSignal = false;
+    QList<QPair<unsigned long, DBCSignal>> definitions;
+    CustomFields custom;
+    if (name == "pgn") {
+        operand = [](const CaptureStore& store, int row, double& value) {
+            value = store.pgn(row);
+            return true;
+        };
+    } else if (name == "src" || name == "source") {
+        operand = [](const CaptureStore& store, int row, double& value) {
+            value = store.source(row);
+            return true;
+        };
+    } else if (name == "dst" || name == "dest" || name == "destination") {
+        operand = [](const CaptureStore& store, int row, double& value) {
+            value = store.destination(row);
+            return true;
+        };
+    } else if (name == "prio" || name == "priority") {
+        operand = [](const CaptureStore& store, int row, double& value) {
+            value = store.priority(row);
+            return true;
+        };
+    } else if (name == "len" || name == "length") {
+        operand = [](const CaptureStore& store, int row, double& value) {
+            value = store.length(row);
+            return true;
+        };
+    } else if (name == "sent") {
+        operand = [](const CaptureStore& store, int row, double& value) {
+            value = store.isSent(row) ? 1 : 0;
+            return true;
+        };
+    } else if (name == "data") {
+        double index = 0;
+        if (!acceptOperator("[") || !parseNumber(index) || !acceptOperator("]")) {
+            return m_error.isEmpty() ? fail(QString("Expected data[<byte>] at position %1").arg(nameToken.position + 1))
+                                     : Predicate();
+        }
+        const int byte = int(index);
+        operand = [byte](const CaptureStore& store, int row, double& value) {
+            if (byte < 0 || byte >= store.length(row)) {
+                return false;
+            }
+            value = store.payload(row)[byte];
+            return true;
+        };
+    } else {
+        // A signal, resolved once to its DBC definition in every PGN that carries it. PGNs
+        // with a custom decoder are compared on what that decoder shows instead
+        QString signalName = nameToken.text;
+        if (signalName.startsWith("decoded.", Qt::CaseInsensitive)) {
+            signalName = signalName.mid(8);
+        }
+        if (m_decoder) {
+            for (unsigned long pgn : m_decoder->getCustomDecoderPGNs()) {
+                custom.pgns.insert(quint32(pgn));
+            }
+            for (const auto& definition : m_decoder->findSignals(signalName)) {
+                if (!custom.pgns.contains(quint32(definition.first))) {
+                    definitions.append(definition);
+                }
+            }
+        }
+        if (definitions.isEmpty() && custom.pgns.isEmpty()) {
+            return fail(QString("Unknown field or signal '%1'").arg(nameToken.text));
+        }
+        isSignal = true;
+        if (!custom.pgns.isEmpty()) {
+            custom.decoder = m_query->customDecoder();
+            custom.key = normalizedName(signalName);
+        }
+
+        QHash<quint32, DBCSignalLayout> byPgn;
+        for (const auto& definition : definitions) {
+            byPgn.insert(quint32(definition.first), DBCSignalLayout::compile(definition.second));
+        }
+        operand = [byPgn, custom](const CaptureStore& store, int row, double& value) {
+            if (custom.pgns.contains(store.pgn(row))) {
+                QVariant field;
+                return customField(custom.decoder, store, row, custom.key, field) && numericValue(field, value);
+            }
+            auto it = byPgn.constFind(store.pgn(row));
+            if (it == byPgn.constEnd()) {
+                return false;
+            }
+            double rawValue = 0.0;
+            return it.value().value(DBCSignalLayout::frameWord(store.payload(row), store.length(row)), rawValue, value);
+        };
+    }
+
+    Comparison comparison;
+    if (acceptOperator("==") || acceptOperator("=")) {
+        comparison = Equal;
+    } else if (acceptOperator("!=")) {
+        comparison = NotEqual;
+    } else if (acceptOperator("<=")) {
+        comparison = LessEqual;
+    } else if (acceptOperator(">=")) {
+        comparison = GreaterEqual;
+    } else if (acceptOperator("<")) {
+        comparison = Less;
+    } else if (acceptOperator(">")) {
+        comparison = Greater;
+    } else {
+        // A bare name tests for a present, non-zero value
+        return [operand](const CaptureStore& store, int row) {
+            double value = 0.0;
+            return operand(store, row, value) && value != 0.0;
+        };
+    }
+
+    if (peek().type == Token::String) {
+        const QString text = take().text;
+        if (!isSignal || (comparison != Equal && comparison != NotEqual)) {
+            return fail(QString("Only signals can be compared with '%1', using == or !=").arg(text));
+        }
+        return parseSignalString(nameToken.text, definitions, custom, comparison, text);
+    }
+
+    double literal = 0.0;
+    if (!parseNumber(literal)) {
+        return Predicate();
+    }
+
+    return [operand, comparison, literal](const CaptureStore& store, int row) {
+        double value = 0.0;
+        if (!operand(store, row, value)) {
+            return false;
+        }
+        switch (comparison) {
+        case Equal:        return value == literal;
+        case NotEqual:     return value != literal;
+        case Less:         return value < literal;
+        case LessEqual:    return value <= literal;
+        case Greater:      return value > literal;
+        case GreaterEqual: return value >= literal;
+        }
+        return false;
+    };
+}
+
+CaptureQuery::Predicate CaptureQuery::Parser::parseSignalString(const QString& name,
+                                                                 const QList<QPair<unsigned long, DBCSignal>>& definitions,
+                                                                 const CustomFields& custom,
+                                                                 Comparison comparison, const QString& value)
+{
+    // Enumerated signals compare by the raw value whose description matches
+    QHash<quint32, QPair<DBCSignalLayout, int>> byPgn;
+    for (const auto& definition : definitions) {
+        const QMap<int, QString>& descriptions = definition.second.valueDescriptions;
+        for (auto it = descriptions.constBegin(); it != descriptions.constEnd(); ++it) {
+            if (it.value().compare(value, Qt::CaseInsensitive) == 0) {
+                byPgn.insert(quint32(definition.first), qMakePair(DBCSignalLayout::compile(definition.second), it.key()));
+                break;
+            }
+        }
+    }
+    if (byPgn.isEmpty() && custom.pgns.isEmpty()) {
+        return fail(QString("Signal '%1' has no value '%2'").arg(name, value));
+    }
+
+    // Custom decoders show the text itself
+    const bool equal = comparison == Equal;
+    return [byPgn, custom, equal, value](const CaptureStore& store, int row) {
+        if (custom.pgns.contains(store.pgn(row))) {
+            QVariant field;
+            if (!customField(custom.decoder, store, row, custom.key, field)) {
+                return false;
+            }
+            return (field.toString().trimmed().compare(value, Qt::CaseInsensitive) == 0) == equal;
+        }
+        auto it = byPgn.constFind(store.pgn(row));
+        if (it == byPgn.constEnd()) {
+            return false;
+        }
+        double rawValue = 0.0;
+        double scaledValue = 0.0;
+        const quint64 frame = DBCSignalLayout::frameWord(store.payload(row), store.length(row));
+        if (!it.value().first.value(frame, rawValue, scaledValue)) {
+            return false;
+        }
+        return (int(rawValue) == it.value().second) == equal;
+    };
+}
+
+bool CaptureQuery::Parser::parseDuration(qint64& ns)
+{
+    double amount = 0.0;
+    if (!parseNumber(amount)) {
+        return false;
+    }
+
+    // Seconds unless a unit follows
+    double scale = 1e9;
+    if (peek().type == Token::Identifier && peek().text.compare("of", Qt::CaseInsensitive) != 0) {
+        const QString unit = take().text.toLower();
+        if (unit == "us") {
+            scale = 1e3;
+        } else if (unit == "ms") {
+            scale = 1e6;
+        } else if (unit == "s" || unit == "sec") {
+            scale = 1e9;
+        } else if (unit == "min" || unit == "m") {
+            scale = 60e9;
+        } else {
+            fail(QString("Unknown time unit '%1'").arg(unit));
+            return false;
+        }
+    }
+    ns = qint64(amount * scale);
+    return true;
+}
+
+bool CaptureQuery::Parser::parseNumber(double& value)
+{
+    const bool negative = acceptOperator("-");
+    const Token& token = take();
+    if (token.type != Token::Number) {
+        fail(QString("Expected a number at position %1").arg(token.position + 1));
+        return false;
+    }
+    value = negative ? -token.number : token.number;
+    return true;
+}
+
+bool CaptureQuery::Parser::acceptOperator(const char* op)
+{
+    if (peek().type == Token::Operator && peek().text == QLatin1String(op)) {
+        take();
+        return true;
+    }
+    return false;
+}
+
+bool CaptureQuery::Parser::acceptKeyword(const char* keyword)
+{
+    if (peek().type == Token::Identifier && peek().text.compare(QLatin1String(keyword), Qt::CaseInsensitive) == 0) {
+        take();
+        return true;
+    }
+    return false;
+}
+
+CaptureQuery::Predicate CaptureQuery::Parser::fail(const QString& message)
+{
+    // Keep the first error - it is the one closest to the problem
+    if (m_error.isEmpty()) {
+        m_error = message;
+    }
+    return Predicate();
+}
+
+QSharedPointer<CaptureQuery> CaptureQuery::compile(const QString& text, DBCDecoder* decoder, QString* errorString)
+{
+    QSharedPointer<CaptureQuery> query(new CaptureQuery);
+    query->m_text = text.trimmed();
+
+    Parser parser(decoder, query.data());
+    query->m_predicate = parser.parse(query->m_text);
+    if (!query->m_predicate) {
+        if (errorString) {
+            *errorString = parser.error();
+        }
+        return QSharedPointer<CaptureQuery>();
+    }
+    return query;
+}
+
+DBCDecoder* CaptureQuery::customDecoder()
+{
+    if (!m_customDecoder) {
+        m_customDecoder.reset(new DBCDecoder);
+    }
+    return m_customDecoder.data();
+}
+
+bool CaptureQuery::looksLikeQuery(const QString& text)
+{
+    static const QRegularExpression pattern("==|!=|<|>|&&|\\|\\||\\bwithin\\b.+\\bof\\b",
+                                            QRegularExpression::CaseInsensitiveOption);
+    return pattern.match(text).hasMatch();
+}
+
+void CaptureQuery::prepare(const CaptureStore& store, int first, int count)
+{
+    for (const QSharedPointer<TimeWindow>& window : m_windows) {
+        QVector<qint64>& times = window->anchorTimes;
+        for (int row = first; row < first + count; row++) {
+            if (!window->anchor(store, row)) {
+                continue;
+            }
+            // Rows are in capture order, so this is nearly always an append
+            const qint64 time = store.wallNs(row);
+            if (times.isEmpty() || times.last() <= time) {
+                times.append(time);
+            } else {
+                times.insert(std::upper_bound(times.begin(), times.end(), time) - times.begin(), time);
+            }
+        }
+    }
+}
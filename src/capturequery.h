@@ -0,0 +1,83 @@
+#ifndef CAPTUREQUERY_H
+#define CAPTUREQUERY_H
+
+#include <QString>
+#include <QVector>
+#include <QSharedPointer>
+#include <functional>
+
+class CaptureStore;
+class DBCDecoder;
+
+/**
+ * @brief Compiled query over captured messages.
+ *
+ * A small expression language for finding messages by field and decoded signal:
+ *
+ *   pgn==127488 && src==0x23 && Speed > 2000
+ *   decoded.Zone_ID == 3 within 5s of pgn==126208
+ *   !(dst == 255) || data[0] >= 0x80
+ *
+ * Fields are pgn, src/source, dst/destination, prio/priority, len/length, sent
+ * and data[n] (a payload byte). Any other name, with or without a "decoded."
+ * prefix, is a decoded signal. Signal names match ignoring case, spaces and
+ * underscores. A signal compares by the scaled value shown in decoded text, or
+ * by its value description when compared with a quoted string. A signal the
+ * row's PGN does not carry, or one that is "not available", never matches.
+ *
+ * PGNs with a custom decoder (the lighting and group function PGNs) are
+ * matched against the fields that decoder shows, not their DBC layout: a
+ * number compares with the leading number of the field text, a quoted string
+ * with the whole text. Since those fields are only known once a message is
+ * decoded, a name no DBC definition carries still compiles and then only
+ * matches custom decoder fields.
+ *
+ * Operators: == (or =), !=, <, <=, >, >=, && (and), || (or), ! (not),
+ * parentheses, and "A within <n>[us|ms|s|min] of B". The last one matches rows
+ * that match A and lie within that time of a row matching B, before or after it.
+ * "within" binds loosest.
+ *
+ * compile() resolves signal names to copies of their DBC definitions. Custom
+ * decoder PGNs go through a DBCDecoder owned by the query, whose cache is not
+ * locked, and prepare() records state for "within", so a compiled instance
+ * may run on any thread but only on one at a time.
+ */
+class CaptureQuery
+{
+public:
+    typedef std::function<bool(const CaptureStore& store, int row)> Predicate;
+
+    // Returns null and sets errorString when the text does not parse
+    static QSharedPointer<CaptureQuery> compile(const QString& text, DBCDecoder* decoder,
+                                                QString* errorString = nullptr);
+
+    // True for text with comparison or logic operators - used to tell queries from plain search text
+    static bool looksLikeQuery(const QString& text);
+
+    QString text() const { return m_text; }
+    bool hasTimeWindows() const { return !m_windows.isEmpty(); }
+
+    // Record the anchor rows of "within" clauses - rows must be prepared before they are matched
+    void prepare(const CaptureStore& store, int first, int count);
+    bool matches(const CaptureStore& store, int row) const { return m_predicate(store, row); }
+
+private:
+    class Parser;
+
+    struct TimeWindow {
+        Predicate anchor;
+        QVector<qint64> anchorTimes;  // Wall-clock ns of the rows matching anchor, ascending
+    };
+
+    CaptureQuery() {}
+
+    // Decoder for the custom decoder PGNs, created on first use
+    DBCDecoder* customDecoder();
+
+    QString m_text;
+    Predicate m_predicate;
+    QVector<QSharedPointer<TimeWindow>> m_windows;  // A nested window comes before the one containing it
+    QSharedPointer<DBCDecoder> m_customDecoder;
+};
+
+#endif // CAPTUREQUERY_H
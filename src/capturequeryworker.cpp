@@ -0,0 +1,86 @@
+#include "capturequeryworker.h"
+#include <QMutexLocker>
+
+CaptureQueryWorker::CaptureQueryWorker(const CaptureStore& store, int rowCount,
+                                       const QSharedPointer<CaptureQuery>& query, QObject* parent)
+    : QThread(parent)
+    , m_store(store)
+    , m_rowCount(qMin(rowCount, store.size()))
+    , m_query(query)
+{
+}
+
+CaptureQueryWorker::~CaptureQueryWorker()
+{
+    cancel();
+    wait();
+}
+
+void CaptureQueryWorker::cancel()
+{
+    m_cancelled.store(true);
+}
+
+void CaptureQueryWorker::run()
+{
+    scan();
+}
+
+void CaptureQueryWorker::scan()
+{
+    // A time window has to see all of its anchors before any row can be matched against it
+    if (m_query->hasTimeWindows()) {
+        for (int first = 0; first < m_rowCount && !isCancelled(); first += SCAN_CHUNK_ROWS) {
+            const int count = m_rowCount - first < SCAN_CHUNK_ROWS ? m_rowCount - first : SCAN_CHUNK_ROWS;
+            m_query->prepare(m_store, first, count);
+        }
+    }
+
+    QVector<int> found;
+    for (int first = 0; first < m_rowCount && !isCancelled(); first += SCAN_CHUNK_ROWS) {
+        const int last = m_rowCount - first < SCAN_CHUNK_ROWS ? m_rowCount : first + SCAN_CHUNK_ROWS;
+        for (int row = first; row < last; row++) {
+            if (m_query->matches(m_store, row)) {
+                found.append(row);
+            }
+        }
+        publishMatches(found);
+        emit progressChanged(int(qint64(last) * 100 / m_rowCount));
+    }
+
+    emit scanFinished(!isCancelled());
+}
+
+bool CaptureQueryWorker::takeMatches(QVector<int>& rows)
+{
+    QMutexLocker<QMutex> locker(&m_mutex);
+    if (m_matches.isEmpty()) {
+        return false;
+    }
+    rows.append(m_matches);
+    m_matches.clear();
+    return true;
+}
+
+void CaptureQueryWorker::acknowledgeNotification()
+{
+    m_notifyPending.store(false);
+}
+
+void CaptureQueryWorker::publishMatches(QVector<int>& rows)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    {
+        QMutexLocker<QMutex> locker(&m_mutex);
+        m_matches.append(rows);
+    }
+    rows.clear();
+
+    // Only signal when the GUI has drained the previous notification
+    if (!m_notifyPending.exchange(true)) {
+        emit matchesAvailable();
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef CAPTUREQUERYWORKER_H
+#define CAPTUREQUERYWORKER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QVector>
+#include <QSharedPointer>
+#include <atomic>
+#include "capturestore.h"
+#include "capturequery.h"
+
+/**
+ * @brief Runs a CaptureQuery over a snapshot of the capture on a worker thread.
+ *
+ * The snapshot is a copy of the store, which shares its column data until the
+ * GUI thread next modifies the store. Matching rows are streamed back in
+ * ascending order as the scan goes. The GUI is told at most once per drain via
+ * matchesAvailable() and pulls the rows with takeMatches(). Row numbers refer to
+ * the snapshot, so the caller has to account for rows evicted since the scan
+ * started.
+ *
+ * On builds without thread support call scan() directly instead of start().
+ */
+class CaptureQueryWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    CaptureQueryWorker(const CaptureStore& store, int rowCount, const QSharedPointer<CaptureQuery>& query,
+                       QObject* parent = nullptr);
+    ~CaptureQueryWorker();
+
+    void cancel();
+    bool isCancelled() const { return m_cancelled.load(); }
+
+    // Scan every row in the calling thread (run() calls this)
+    void scan();
+
+    // Consumer side (GUI thread only)
+    bool takeMatches(QVector<int>& rows);
+    void acknowledgeNotification();
+
+    // The query instance the scan prepared - only safe to use once scanFinished() arrived
+    QSharedPointer<CaptureQuery> query() const { return m_query; }
+
+signals:
+    void matchesAvailable();
+    void progressChanged(int percent);
+    // Emitted once, after the last matches have been queued
+    void scanFinished(bool completed);
+
+protected:
+    void run() override;
+
+private:
+    void publishMatches(QVector<int>& rows);
+
+    CaptureStore m_store;
+    int m_rowCount;
+    QSharedPointer<CaptureQuery> m_query;
+    QMutex m_mutex;  // Guards m_matches
+    QVector<int> m_matches;
+    std::atomic<bool> m_cancelled{false};
+    std::atomic<bool> m_notifyPending{false};
+
+    static const int SCAN_CHUNK_ROWS = 16384;
+};
+
+#endif // CAPTUREQUERYWORKER_H
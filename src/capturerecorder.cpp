@@ -0,0 +1,308 @@
+#include "capturerecorder.h"
+#include "capturesegment.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QStandardPaths>
+#include <QMutexLocker>
+#include <QDebug>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+static const char* SEGMENT_PREFIX = "rec_";
+static const char* SEGMENT_TIME_FORMAT = "yyyyMMdd_HHmmss_zzz";
+
+CaptureRecorder::CaptureRecorder(QObject* parent)
+    : QThread(parent)
+    , m_recording(false)
+    , m_ring(RING_CAPACITY)
+    , m_segmentOpenedNs(0)
+    , m_blockStartedNs(0)
+    , m_errorReported(false)
+    , m_droppedAtStart(0)
+{
+}
+
+CaptureRecorder::~CaptureRecorder()
+{
+    stopRecording();
+}
+
+QString CaptureRecorder::defaultDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/recordings";
+}
+
+bool CaptureRecorder::startRecording(const Settings& settings, QString* errorString)
+{
+    if (m_recording) {
+        return true;
+    }
+    if (!QDir().mkpath(settings.directory)) {
+        if (errorString) {
+            *errorString = QString("Cannot create %1").arg(settings.directory);
+        }
+        return false;
+    }
+
+    m_settings = settings;
+    m_settings.segmentMegabytes = qMax(settings.segmentMegabytes, 1);
+    m_settings.segmentMinutes = qMax(settings.segmentMinutes, 1);
+    m_settings.retentionMegabytes = qMax(settings.retentionMegabytes, m_settings.segmentMegabytes);
+    m_errorReported = false;
+    m_recorded = 0;
+    m_bytesWritten = 0;
+    m_segments = 0;
+    m_deletedSegments = 0;
+    m_droppedAtStart = m_ring.droppedCount();
+    {
+        QMutexLocker<QMutex> locker(&m_mutex);
+        m_errorString.clear();
+    }
+
+    m_recording = true;
+    start(QThread::LowPriority);
+    return true;
+}
+
+void CaptureRecorder::stopRecording()
+{
+    if (!m_recording) {
+        return;
+    }
+    m_recording = false;
+    requestInterruption();
+    wait();
+}
+
+void CaptureRecorder::append(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent)
+{
+    if (!m_recording) {
+        return;
+    }
+
+    RecordedMessage recorded;
+    recorded.msg = msg;
+    recorded.timestamp = timestamp;
+    recorded.sent = sent;
+    m_ring.tryPush(recorded);
+}
+
+CaptureRecorder::Stats CaptureRecorder::stats() const
+{
+    Stats s;
+    s.recorded = m_recorded.load(std::memory_order_relaxed);
+    s.dropped = m_ring.droppedCount() - m_droppedAtStart;
+    s.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    s.segments = m_segments.load(std::memory_order_relaxed);
+    s.deletedSegments = m_deletedSegments.load(std::memory_order_relaxed);
+    QMutexLocker<QMutex> locker(&m_mutex);
+    s.currentFile = m_currentFile;
+    return s;
+}
+
+void CaptureRecorder::run()
+{
+    qDebug() << "CaptureRecorder: writer thread started in" << m_settings.directory;
+
+    QElapsedTimer clock;
+    clock.start();
+    m_block.clear();
+
+    RecordedMessage recorded;
+    for (;;) {
+        // After a stop request, write out what is still queued and finish
+        const bool stopping = isInterruptionRequested();
+        if (stopping && m_ring.isEmpty() && m_block.isEmpty()) {
+            break;
+        }
+
+        bool received = false;
+        while (m_block.size() < BLOCK_MESSAGES && m_ring.tryPop(recorded)) {
+            if (m_block.isEmpty()) {
+                m_blockStartedNs = clock.nsecsElapsed();
+            }
+            m_block.append(recorded.msg, recorded.timestamp, recorded.sent);
+            received = true;
+        }
+
+        const bool blockDue = !m_block.isEmpty() &&
+            (m_block.size() >= BLOCK_MESSAGES || stopping ||
+             clock.nsecsElapsed() - m_blockStartedNs >= qint64(BLOCK_INTERVAL_MS) * 1000000);
+        if (blockDue) {
+            // Rotate by age before the block goes in, by size after it
+            if (m_segment.isOpen() &&
+                clock.nsecsElapsed() - m_segmentOpenedNs >= qint64(m_settings.segmentMinutes) * 60 * 1000000000LL) {
+                closeSegment();
+            }
+            if (!m_segment.isOpen()) {
+                if (openSegment(m_block.wallNs(0))) {
+                    m_segmentOpenedNs = clock.nsecsElapsed();
+                }
+            }
+            writeBlock();
+            if (m_segment.isOpen() && m_segment.size() >= qint64(m_settings.segmentMegabytes) * 1024 * 1024) {
+                closeSegment();
+            }
+        }
+
+        if (!received && !stopping) {
+            QThread::msleep(IDLE_SLEEP_MS);
+        }
+    }
+
+    closeSegment();
+    qDebug() << "CaptureRecorder: writer thread stopped," << m_recorded.load() << "messages recorded";
+}
+
+bool CaptureRecorder::writeBlock()
+{
+    const int count = m_block.size();
+    if (!m_segment.isOpen()) {
+        // Nowhere to write - the messages are lost, but recording carries on with the next block
+        m_block.clear();
+        return false;
+    }
+
+    const QByteArray block = CaptureSegment::encodeBlock(m_block, m_settings.compress);
+    m_block.clear();
+    if (m_segment.write(block) != block.size() || !m_segment.flush()) {
+        setError(QString("Cannot write %1: %2").arg(m_segment.fileName(), m_segment.errorString()));
+        m_segment.close();
+        return false;
+    }
+    if (m_settings.syncPolicy == SyncPerBlock) {
+        syncFile();
+    }
+
+    m_recorded += quint64(count);
+    m_bytesWritten += quint64(block.size());
+    return true;
+}
+
+bool CaptureRecorder::openSegment(qint64 wallNs)
+{
+    const QDateTime start = QDateTime::fromMSecsSinceEpoch(wallNs / 1000000);
+    const QString fileName = QString("%1/%2%3.pgnlog")
+                                 .arg(m_settings.directory, SEGMENT_PREFIX, start.toString(QString::fromLatin1(SEGMENT_TIME_FORMAT)));
+    m_segment.setFileName(fileName);
+    if (!m_segment.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        setError(QString("Cannot create %1: %2").arg(fileName, m_segment.errorString()));
+        return false;
+    }
+
+    const QByteArray header = CaptureSegment::header(wallNs);
+    if (m_segment.write(header) != header.size()) {
+        setError(QString("Cannot write %1: %2").arg(fileName, m_segment.errorString()));
+        m_segment.close();
+        return false;
+    }
+
+    m_segments++;
+    {
+        QMutexLocker<QMutex> locker(&m_mutex);
+        m_currentFile = fileName;
+    }
+
+    // The new segment counts towards the limit too, so older ones make room for it
+    enforceRetention();
+    return true;
+}
+
+void CaptureRecorder::closeSegment()
+{
+    if (!m_segment.isOpen()) {
+        return;
+    }
+    m_segment.flush();
+    if (m_settings.syncPolicy != SyncNever) {
+        syncFile();
+    }
+    m_segment.close();
+}
+
+bool CaptureRecorder::syncFile()
+{
+#ifdef Q_OS_UNIX
+    if (::fsync(m_segment.handle()) != 0) {
+        setError(QString("Cannot sync %1 to disk").arg(m_segment.fileName()));
+        return false;
+    }
+#endif
+    return true;
+}
+
+void CaptureRecorder::enforceRetention()
+{
+    QDir dir(m_settings.directory);
+    const QFileInfoList segments = dir.entryInfoList(QStringList{QString("%1*.pgnlog").arg(SEGMENT_PREFIX)},
+                                                     QDir::Files, QDir::Name);
+
+    // Names sort by start time; the segment being written is the newest and is never removed
+    const qint64 limitBytes = qint64(m_settings.retentionMegabytes) * 1024 * 1024;
+    const qint64 reserveBytes = qint64(m_settings.segmentMegabytes) * 1024 * 1024;
+    qint64 totalBytes = reserveBytes;
+    for (const QFileInfo& info : segments) {
+        totalBytes += info.size();
+    }
+
+    for (const QFileInfo& info : segments) {
+        if (totalBytes <= limitBytes) {
+            break;
+        }
+        if (info.absoluteFilePath() == QFileInfo(m_segment.fileName()).absoluteFilePath()) {
+            continue;
+        }
+        if (QFile::remove(info.absoluteFilePath())) {
+            totalBytes -= info.size();
+            m_deletedSegments++;
+        }
+    }
+}
+
+void CaptureRecorder::setError(const QString& error)
+{
+    qWarning() << "CaptureRecorder:" << error;
+    {
+        QMutexLocker<QMutex> locker(&m_mutex);
+        m_errorString = error;
+    }
+    if (!m_errorReported) {
+        m_errorReported = true;
+        emit writeFailed(error);
+    }
+}
+
+QDateTime CaptureRecorder::segmentStartTime(const QString& fileName)
+{
+    const QString baseName = QFileInfo(fileName).completeBaseName();
+    return QDateTime::fromString(baseName.mid(int(strlen(SEGMENT_PREFIX))), QString::fromLatin1(SEGMENT_TIME_FORMAT));
+}
+
+QStringList CaptureRecorder::segmentsInRange(const QString& directory, const QDateTime& from, const QDateTime& to)
+{
+    QDir dir(directory);
+    const QStringList names = dir.entryList(QStringList{QString("%1*.pgnlog").arg(SEGMENT_PREFIX)},
+                                            QDir::Files, QDir::Name);
+
+    // A segment ends where the next one starts, so it overlaps the range unless it starts
+    // after the end or the next one starts before the beginning
+    QStringList files;
+    for (int i = 0; i < names.size(); i++) {
+        const QDateTime start = segmentStartTime(names[i]);
+        if (!start.isValid() || start > to) {
+            continue;
+        }
+        if (i + 1 < names.size()) {
+            const QDateTime nextStart = segmentStartTime(names[i + 1]);
+            if (nextStart.isValid() && nextStart <= from) {
+                continue;
+            }
+        }
+        files.append(dir.absoluteFilePath(names[i]));
+    }
+    return files;
+}
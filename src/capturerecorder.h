@@ -0,0 +1,129 @@
+#ifndef CAPTURERECORDER_H
+#define CAPTURERECORDER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QDateTime>
+#include <atomic>
+#include <N2kMsg.h>
+#include "n2ktimestamp.h"
+#include "spscring.h"
+#include "capturestore.h"
+
+/**
+ * @brief Records every message to rotating segment files on a writer thread.
+ *
+ * append() only pushes the message into a lock-free SPSC ring, so the caller
+ * never waits for the disk; when the writer falls behind far enough to fill
+ * the ring, messages are dropped and counted rather than blocking. The writer
+ * thread packs messages into CaptureSegment blocks (optionally compressed),
+ * starts a new segment when the current one reaches its size or age limit,
+ * and deletes the oldest segments in the directory to keep their total size
+ * within the retention limit.
+ *
+ * Segments are named rec_yyyyMMdd_HHmmss_zzz.pgnlog after the wall time of
+ * their first message, so segmentsInRange() can pick the files covering a
+ * time range without opening them.
+ *
+ * Requires thread support; not available on WASM builds.
+ */
+class CaptureRecorder : public QThread
+{
+    Q_OBJECT
+
+public:
+    enum SyncPolicy {
+        SyncNever = 0,      // Leave flushing to the operating system
+        SyncPerSegment,     // fsync when a segment is closed
+        SyncPerBlock        // fsync after every block - at most one block is lost on power failure
+    };
+
+    struct Settings {
+        QString directory;
+        int segmentMegabytes = 64;
+        int segmentMinutes = 60;
+        int retentionMegabytes = 4096;  // Total size of all segments in the directory
+        bool compress = true;
+        SyncPolicy syncPolicy = SyncPerSegment;
+    };
+
+    struct Stats {
+        quint64 recorded = 0;       // Messages written to disk
+        quint64 dropped = 0;        // Messages lost because the writer fell behind
+        quint64 bytesWritten = 0;
+        int segments = 0;           // Segments started by this recording
+        int deletedSegments = 0;    // Removed to stay within the retention limit
+        QString currentFile;
+    };
+
+    explicit CaptureRecorder(QObject* parent = nullptr);
+    ~CaptureRecorder();
+
+    // Start recording into settings.directory; false if it cannot be created
+    bool startRecording(const Settings& settings, QString* errorString = nullptr);
+    // Write what is queued, close the segment and stop the thread
+    void stopRecording();
+    bool isRecording() const { return m_recording; }
+
+    // Producer side (GUI thread only) - never blocks
+    void append(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent = false);
+
+    const Settings& settings() const { return m_settings; }
+    Stats stats() const;
+
+    static QString defaultDirectory();
+    // Segment files, oldest first, that may hold messages between the two wall times
+    static QStringList segmentsInRange(const QString& directory, const QDateTime& from, const QDateTime& to);
+
+signals:
+    // Emitted from the writer thread, once per failure
+    void writeFailed(const QString& errorString);
+
+protected:
+    void run() override;
+
+private:
+    struct RecordedMessage {
+        tN2kMsg msg;
+        N2kTimestamp timestamp;
+        bool sent = false;
+    };
+
+    bool writeBlock();
+    bool openSegment(qint64 wallNs);
+    void closeSegment();
+    bool syncFile();
+    void enforceRetention();
+    void setError(const QString& error);
+    static QDateTime segmentStartTime(const QString& fileName);
+
+    Settings m_settings;
+    bool m_recording;
+    SpscRing<RecordedMessage> m_ring;
+
+    // Writer thread state
+    CaptureStore m_block;
+    QFile m_segment;
+    qint64 m_segmentOpenedNs;       // Monotonic time the segment was started
+    qint64 m_blockStartedNs;        // Monotonic time of the first message in m_block
+    bool m_errorReported;
+
+    mutable QMutex m_mutex;  // Guards m_currentFile and m_errorString
+    QString m_currentFile;
+    QString m_errorString;
+    std::atomic<quint64> m_recorded{0};
+    std::atomic<quint64> m_bytesWritten{0};
+    std::atomic<int> m_segments{0};
+    std::atomic<int> m_deletedSegments{0};
+    quint64 m_droppedAtStart;
+
+    static const int RING_CAPACITY = 16384;         // Several seconds at full bus load
+    static const int BLOCK_MESSAGES = 4096;
+    static const int BLOCK_INTERVAL_MS = 1000;      // A quiet bus still reaches the disk every second
+    static const int IDLE_SLEEP_MS = 20;
+};
+
+#endif // CAPTURERECORDER_H
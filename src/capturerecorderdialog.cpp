@@ -0,0 +1,232 @@
+#include "capturerecorderdialog.h"
+#include "toastmanager.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDateTimeEdit>
+#include <QLabel>
+#include <QPushButton>
+#include <QTimer>
+#include <QSettings>
+#include <QFileDialog>
+#include <QFileInfo>
+
+CaptureRecorderDialog::CaptureRecorderDialog(CaptureRecorder* recorder, QWidget* parent)
+    : QDialog(parent)
+    , m_recorder(recorder)
+{
+    setupUI();
+    loadSettings();
+
+    connect(m_recorder, &CaptureRecorder::writeFailed, this, &CaptureRecorderDialog::onWriteFailed);
+
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    connect(m_refreshTimer, &QTimer::timeout, this, &CaptureRecorderDialog::updateStatus);
+    m_refreshTimer->start();
+
+    updateStatus();
+
+    setWindowTitle("Long-Term Recording");
+    setModal(false);
+    resize(600, 420);
+}
+
+void CaptureRecorderDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+
+    QGroupBox* settingsGroup = new QGroupBox("Recording");
+    QFormLayout* formLayout = new QFormLayout(settingsGroup);
+
+    QHBoxLayout* directoryLayout = new QHBoxLayout();
+    m_directoryEdit = new QLineEdit();
+    m_browseButton = new QPushButton("Browse...");
+    directoryLayout->addWidget(m_directoryEdit);
+    directoryLayout->addWidget(m_browseButton);
+    formLayout->addRow("Directory:", directoryLayout);
+
+    m_segmentSizeSpinBox = new QSpinBox();
+    m_segmentSizeSpinBox->setRange(1, 2048);
+    m_segmentSizeSpinBox->setSuffix(" MB");
+    formLayout->addRow("Segment size:", m_segmentSizeSpinBox);
+
+    m_segmentMinutesSpinBox = new QSpinBox();
+    m_segmentMinutesSpinBox->setRange(1, 24 * 60);
+    m_segmentMinutesSpinBox->setSuffix(" min");
+    formLayout->addRow("Segment length:", m_segmentMinutesSpinBox);
+
+    m_retentionSpinBox = new QSpinBox();
+    m_retentionSpinBox->setRange(1, 1024 * 1024);
+    m_retentionSpinBox->setSuffix(" MB");
+    m_retentionSpinBox->setToolTip("The oldest segments in the directory are deleted to stay within this total");
+    formLayout->addRow("Keep at most:", m_retentionSpinBox);
+
+    m_compressCheckBox = new QCheckBox("Compress blocks");
+    formLayout->addRow(QString(), m_compressCheckBox);
+
+    m_syncCombo = new QComboBox();
+    m_syncCombo->addItem("Leave to the system", int(CaptureRecorder::SyncNever));
+    m_syncCombo->addItem("When a segment closes", int(CaptureRecorder::SyncPerSegment));
+    m_syncCombo->addItem("After every block", int(CaptureRecorder::SyncPerBlock));
+    m_syncCombo->setToolTip("When written data is forced to disk - after every block loses at most a second on power failure");
+    formLayout->addRow("Sync to disk:", m_syncCombo);
+    mainLayout->addWidget(settingsGroup);
+
+    QHBoxLayout* controlLayout = new QHBoxLayout();
+    m_statusLabel = new QLabel();
+    m_statusLabel->setStyleSheet("font-weight: bold; padding: 5px;");
+    m_statusLabel->setWordWrap(true);
+    m_startStopButton = new QPushButton("Start");
+    controlLayout->addWidget(m_statusLabel, 1);
+    controlLayout->addWidget(m_startStopButton);
+    mainLayout->addLayout(controlLayout);
+
+    QGroupBox* rangeGroup = new QGroupBox("Open Recorded Range");
+    QHBoxLayout* rangeLayout = new QHBoxLayout(rangeGroup);
+    m_fromEdit = new QDateTimeEdit(QDateTime::currentDateTime().addSecs(-3600));
+    m_toEdit = new QDateTimeEdit(QDateTime::currentDateTime());
+    for (QDateTimeEdit* edit : {m_fromEdit, m_toEdit}) {
+        edit->setDisplayFormat("yyyy-MM-dd hh:mm:ss");
+        edit->setCalendarPopup(true);
+    }
+    m_openRangeButton = new QPushButton("Open in PGN Log");
+    rangeLayout->addWidget(new QLabel("From:"));
+    rangeLayout->addWidget(m_fromEdit);
+    rangeLayout->addWidget(new QLabel("To:"));
+    rangeLayout->addWidget(m_toEdit);
+    rangeLayout->addWidget(m_openRangeButton);
+    mainLayout->addWidget(rangeGroup);
+    mainLayout->addStretch();
+
+    connect(m_browseButton, &QPushButton::clicked, this, &CaptureRecorderDialog::onBrowseClicked);
+    connect(m_startStopButton, &QPushButton::clicked, this, &CaptureRecorderDialog::onStartStopClicked);
+    connect(m_openRangeButton, &QPushButton::clicked, this, &CaptureRecorderDialog::onOpenRangeClicked);
+}
+
+void CaptureRecorderDialog::loadSettings()
+{
+    QSettings settings;
+    settings.beginGroup("CaptureRecorder");
+    CaptureRecorder::Settings defaults;
+    m_directoryEdit->setText(settings.value("directory", CaptureRecorder::defaultDirectory()).toString());
+    m_segmentSizeSpinBox->setValue(settings.value("segmentMegabytes", defaults.segmentMegabytes).toInt());
+    m_segmentMinutesSpinBox->setValue(settings.value("segmentMinutes", defaults.segmentMinutes).toInt());
+    m_retentionSpinBox->setValue(settings.value("retentionMegabytes", defaults.retentionMegabytes).toInt());
+    m_compressCheckBox->setChecked(settings.value("compress", defaults.compress).toBool());
+    m_syncCombo->setCurrentIndex(m_syncCombo->findData(settings.value("syncPolicy", int(defaults.syncPolicy)).toInt()));
+    settings.endGroup();
+}
+
+void CaptureRecorderDialog::saveSettings(const CaptureRecorder::Settings& recorderSettings)
+{
+    QSettings settings;
+    settings.beginGroup("CaptureRecorder");
+    settings.setValue("directory", recorderSettings.directory);
+    settings.setValue("segmentMegabytes", recorderSettings.segmentMegabytes);
+    settings.setValue("segmentMinutes", recorderSettings.segmentMinutes);
+    settings.setValue("retentionMegabytes", recorderSettings.retentionMegabytes);
+    settings.setValue("compress", recorderSettings.compress);
+    settings.setValue("syncPolicy", int(recorderSettings.syncPolicy));
+    settings.endGroup();
+}
+
+CaptureRecorder::Settings CaptureRecorderDialog::currentSettings() const
+{
+    CaptureRecorder::Settings settings;
+    settings.directory = m_directoryEdit->text().trimmed();
+    settings.segmentMegabytes = m_segmentSizeSpinBox->value();
+    settings.segmentMinutes = m_segmentMinutesSpinBox->value();
+    settings.retentionMegabytes = m_retentionSpinBox->value();
+    settings.compress = m_compressCheckBox->isChecked();
+    settings.syncPolicy = static_cast<CaptureRecorder::SyncPolicy>(m_syncCombo->currentData().toInt());
+    return settings;
+}
+
+void CaptureRecorderDialog::onBrowseClicked()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, "Recording Directory", m_directoryEdit->text());
+    if (!directory.isEmpty()) {
+        m_directoryEdit->setText(directory);
+    }
+}
+
+void CaptureRecorderDialog::onStartStopClicked()
+{
+    if (m_recorder->isRecording()) {
+        m_recorder->stopRecording();
+        updateStatus();
+        return;
+    }
+
+    CaptureRecorder::Settings settings = currentSettings();
+    if (settings.directory.isEmpty()) {
+        settings.directory = CaptureRecorder::defaultDirectory();
+        m_directoryEdit->setText(settings.directory);
+    }
+    QString error;
+    if (!m_recorder->startRecording(settings, &error)) {
+        ToastManager::instance()->showError(QString("Cannot start recording: %1").arg(error), this);
+        return;
+    }
+    saveSettings(settings);
+    updateStatus();
+}
+
+void CaptureRecorderDialog::onOpenRangeClicked()
+{
+    const QDateTime from = m_fromEdit->dateTime();
+    const QDateTime to = m_toEdit->dateTime();
+    if (from >= to) {
+        ToastManager::instance()->showError("The start of the range must come before its end", this);
+        return;
+    }
+
+    const QStringList files = CaptureRecorder::segmentsInRange(m_directoryEdit->text().trimmed(), from, to);
+    if (files.isEmpty()) {
+        ToastManager::instance()->showInfo("No recorded segments cover that range", this);
+        return;
+    }
+    emit openRangeRequested(files, from.toMSecsSinceEpoch() * 1000000LL, to.toMSecsSinceEpoch() * 1000000LL);
+}
+
+void CaptureRecorderDialog::onWriteFailed(const QString& errorString)
+{
+    ToastManager::instance()->showError(QString("Recording: %1").arg(errorString), this);
+}
+
+void CaptureRecorderDialog::updateStatus()
+{
+    const bool recording = m_recorder->isRecording();
+    const CaptureRecorder::Stats stats = m_recorder->stats();
+
+    QString text = recording ? "Recording" : "Stopped";
+    if (recording || stats.recorded > 0) {
+        text += QString(" | %1 msgs, %2 MB in %3 segments")
+                    .arg(stats.recorded)
+                    .arg(double(stats.bytesWritten) / (1024.0 * 1024.0), 0, 'f', 1)
+                    .arg(stats.segments);
+        if (stats.dropped > 0) {
+            text += QString(" | %1 dropped").arg(stats.dropped);
+        }
+        if (stats.deletedSegments > 0) {
+            text += QString(" | %1 old segments deleted").arg(stats.deletedSegments);
+        }
+        if (recording && !stats.currentFile.isEmpty()) {
+            text += QString("\n%1").arg(QFileInfo(stats.currentFile).fileName());
+        }
+    }
+    m_statusLabel->setText(text);
+
+    m_startStopButton->setText(recording ? "Stop" : "Start");
+    for (QWidget* widget : std::initializer_list<QWidget*>{m_directoryEdit, m_browseButton, m_segmentSizeSpinBox,
+                                                           m_segmentMinutesSpinBox, m_retentionSpinBox,
+                                                           m_compressCheckBox, m_syncCombo}) {
+        widget->setEnabled(!recording);
+    }
+}
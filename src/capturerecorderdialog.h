@@ -0,0 +1,65 @@
+#ifndef CAPTURERECORDERDIALOG_H
+#define CAPTURERECORDERDIALOG_H
+
+#include <QDialog>
+#include <QStringList>
+#include "capturerecorder.h"
+
+class QLineEdit;
+class QSpinBox;
+class QCheckBox;
+class QComboBox;
+class QDateTimeEdit;
+class QLabel;
+class QPushButton;
+class QTimer;
+
+/**
+ * @brief Controls the long-term CaptureRecorder owned by DeviceMainWindow.
+ *
+ * Recording keeps running with the dialog closed. A time range of the
+ * recorded segments can be opened in a PGN log window.
+ */
+class CaptureRecorderDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit CaptureRecorderDialog(CaptureRecorder* recorder, QWidget* parent = nullptr);
+
+signals:
+    void openRangeRequested(const QStringList& fileNames, qint64 fromWallNs, qint64 toWallNs);
+
+private slots:
+    void onBrowseClicked();
+    void onStartStopClicked();
+    void onOpenRangeClicked();
+    void onWriteFailed(const QString& errorString);
+    void updateStatus();
+
+private:
+    void setupUI();
+    void loadSettings();
+    void saveSettings(const CaptureRecorder::Settings& settings);
+    CaptureRecorder::Settings currentSettings() const;
+
+    CaptureRecorder* m_recorder;
+
+    QLineEdit* m_directoryEdit;
+    QPushButton* m_browseButton;
+    QSpinBox* m_segmentSizeSpinBox;
+    QSpinBox* m_segmentMinutesSpinBox;
+    QSpinBox* m_retentionSpinBox;
+    QCheckBox* m_compressCheckBox;
+    QComboBox* m_syncCombo;
+    QPushButton* m_startStopButton;
+    QLabel* m_statusLabel;
+    QDateTimeEdit* m_fromEdit;
+    QDateTimeEdit* m_toEdit;
+    QPushButton* m_openRangeButton;
+    QTimer* m_refreshTimer;
+
+    static const int REFRESH_INTERVAL_MS = 1000;
+};
+
+#endif // CAPTURERECORDERDIALOG_H
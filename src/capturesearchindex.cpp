@@ -0,0 +1,188 @@
+#include "capturesearchindex.h"
+#include "capturestore.h"
+#include "dbcdecoder.h"
+#include "pgnlogmodel.h"
+#include <QtEndian>
+#include <cstring>
+
+CaptureSearchIndex::CaptureSearchIndex()
+    : m_decoder(nullptr)
+{
+}
+
+void CaptureSearchIndex::setDecoder(DBCDecoder* decoder)
+{
+    m_decoder = decoder;
+    clear();
+}
+
+void CaptureSearchIndex::clear()
+{
+    m_documents.clear();
+    m_documentIds.clear();
+    m_trigrams.clear();
+    m_nameDocuments.clear();
+    m_contentIds.clear();
+    m_contents.clear();
+    m_rowContent.clear();
+}
+
+void CaptureSearchIndex::removeFirst(int count)
+{
+    m_rowContent.remove(0, qMin(count, int(m_rowContent.size())));
+}
+
+void CaptureSearchIndex::update(const CaptureStore& store, int rowCount)
+{
+    if (m_contents.size() > MAX_CONTENTS) {
+        clear();
+    }
+
+    rowCount = qMin(rowCount, store.size());
+    m_rowContent.reserve(rowCount);
+
+    // Key buffer reused across rows: PGN followed by the payload bytes
+    QByteArray key;
+    for (int row = m_rowContent.size(); row < rowCount; row++) {
+        const int length = store.length(row);
+        key.resize(4 + length);
+        qToLittleEndian<quint32>(store.pgn(row), key.data());
+        if (length > 0) {
+            memcpy(key.data() + 4, store.payload(row), length);
+        }
+
+        auto it = m_contentIds.constFind(key);
+        int content;
+        if (it != m_contentIds.constEnd()) {
+            content = it.value();
+        } else {
+            content = m_contents.size();
+            m_contents.append(indexContent(store, row));
+            m_contentIds.insert(key, content);
+        }
+        m_rowContent.append(content);
+    }
+}
+
+CaptureSearchIndex::Content CaptureSearchIndex::indexContent(const CaptureStore& store, int row)
+{
+    const quint32 pgn = store.pgn(row);
+    const bool decodable = m_decoder && m_decoder->canDecode(pgn);
+
+    Content content;
+    auto name = m_nameDocuments.constFind(pgn);
+    if (name != m_nameDocuments.constEnd()) {
+        content.nameDocument = name.value();
+    } else {
+        content.nameDocument = addDocument(decodable ? m_decoder->getCleanMessageName(pgn)
+                                                     : QString("PGN %1").arg(pgn));
+        m_nameDocuments.insert(pgn, content.nameDocument);
+    }
+
+    // Same rules as the Decoded column - placeholders are not searchable
+    content.decodedDocument = -1;
+    if (decodable) {
+        QString decoded = m_decoder->getFormattedDecoded(store.message(row));
+        if (!decoded.isEmpty() && decoded != "Raw data" && !decoded.startsWith("PGN")) {
+            content.decodedDocument = addDocument(decoded);
+        }
+    }
+    return content;
+}
+
+int CaptureSearchIndex::addDocument(const QString& text)
+{
+    const QString lowered = text.toLower();
+    auto existing = m_documentIds.constFind(lowered);
+    if (existing != m_documentIds.constEnd()) {
+        return existing.value();
+    }
+
+    const int document = m_documents.size();
+    m_documents.append(lowered);
+    m_documentIds.insert(lowered, document);
+
+    const QChar* chars = lowered.constData();
+    for (int i = 0; i + TRIGRAM_LENGTH <= lowered.size(); i++) {
+        QVector<int>& postings = m_trigrams[trigramKey(chars + i)];
+        if (postings.isEmpty() || postings.last() != document) {
+            postings.append(document);
+        }
+    }
+    return document;
+}
+
+quint64 CaptureSearchIndex::trigramKey(const QChar* chars)
+{
+    return (quint64(chars[0].unicode()) << 32) | (quint64(chars[1].unicode()) << 16) | chars[2].unicode();
+}
+
+QVector<quint8> CaptureSearchIndex::matchingDocuments(const QString& needle) const
+{
+    QVector<quint8> matches(m_documents.size(), 0);
+
+    // Too short for a trigram - the distinct documents are few enough to scan
+    if (needle.size() < TRIGRAM_LENGTH) {
+        for (int document = 0; document < m_documents.size(); document++) {
+            matches[document] = m_documents[document].contains(needle);
+        }
+        return matches;
+    }
+
+    // Candidates come from the rarest trigram of the needle and are then verified
+    const QVector<int>* rarest = nullptr;
+    for (int i = 0; i + TRIGRAM_LENGTH <= needle.size(); i++) {
+        auto it = m_trigrams.constFind(trigramKey(needle.constData() + i));
+        if (it == m_trigrams.constEnd()) {
+            return matches;
+        }
+        if (!rarest || it.value().size() < rarest->size()) {
+            rarest = &it.value();
+        }
+    }
+    for (int document : *rarest) {
+        matches[document] = m_documents[document].contains(needle);
+    }
+    return matches;
+}
+
+QVector<int> CaptureSearchIndex::search(const CaptureStore& store, const QString& text, bool includeDecoded,
+                                        const DeviceNameLookup& deviceName) const
+{
+    QVector<int> rows;
+    if (text.isEmpty()) {
+        return rows;
+    }
+
+    const QVector<quint8> documents = matchingDocuments(text.toLower());
+    QVector<quint8> contents(m_contents.size(), 0);
+    for (int i = 0; i < m_contents.size(); i++) {
+        const Content& content = m_contents[i];
+        contents[i] = (content.nameDocument >= 0 && documents[content.nameDocument]) ||
+                      (includeDecoded && content.decodedDocument >= 0 && documents[content.decodedDocument]);
+    }
+
+    // Names that are just the address (unknown devices) would match every row on "0x"
+    quint8 addresses[256] = {};
+    if (deviceName) {
+        for (int address = 0; address < 256; address++) {
+            const QString name = deviceName(quint8(address));
+            if (!name.isEmpty() &&
+                name.compare(PGNLogModel::addressText(quint8(address)), Qt::CaseInsensitive) != 0 &&
+                name.contains(text, Qt::CaseInsensitive)) {
+                addresses[address] = 1;
+            }
+        }
+    }
+
+    const quint8* source = store.sourceData();
+    const quint8* destination = store.destinationData();
+    const int* rowContent = m_rowContent.constData();
+    const int rowCount = qMin(int(m_rowContent.size()), store.size());
+    for (int row = 0; row < rowCount; row++) {
+        if (contents[rowContent[row]] | addresses[source[row]] | addresses[destination[row]]) {
+            rows.append(row);
+        }
+    }
+    return rows;
+}
@@ -0,0 +1,73 @@
+#ifndef CAPTURESEARCHINDEX_H
+#define CAPTURESEARCHINDEX_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include <functional>
+
+class CaptureStore;
+class DBCDecoder;
+
+/**
+ * @brief Incremental trigram index for searching the PGN log.
+ *
+ * Rows are not indexed one by one. Every distinct PGN + payload ("content") is
+ * decoded once, and its message name and decoded signal text become documents in
+ * a trigram index. Each row then only stores its content id. A search checks the
+ * documents through their trigrams, marks the contents that match, and then makes
+ * one pass over the per-row content ids and address columns. Device names are
+ * matched when the search runs, so renamed devices are found under their current
+ * name.
+ *
+ * update() only indexes rows added since the previous call, and removeFirst()
+ * follows evictions from the capture store.
+ */
+class CaptureSearchIndex
+{
+public:
+    typedef std::function<QString(quint8)> DeviceNameLookup;
+
+    CaptureSearchIndex();
+
+    // Decoded text depends on the decoder, so changing it starts the index over
+    void setDecoder(DBCDecoder* decoder);
+    void clear();
+    void removeFirst(int count);
+
+    // Index store rows [indexedRows(), rowCount)
+    void update(const CaptureStore& store, int rowCount);
+    int indexedRows() const { return m_rowContent.size(); }
+
+    // Indexed store rows, ascending, whose message name, decoded text (when
+    // includeDecoded is set) or source/destination device name contain text, ignoring case
+    QVector<int> search(const CaptureStore& store, const QString& text, bool includeDecoded,
+                        const DeviceNameLookup& deviceName) const;
+
+private:
+    struct Content {
+        int nameDocument;     // -1 when there is none
+        int decodedDocument;
+    };
+
+    Content indexContent(const CaptureStore& store, int row);
+    int addDocument(const QString& text);
+    QVector<quint8> matchingDocuments(const QString& needle) const;
+    static quint64 trigramKey(const QChar* chars);
+
+    DBCDecoder* m_decoder;
+    QVector<QString> m_documents;               // Lowercased text
+    QHash<QString, int> m_documentIds;
+    QHash<quint64, QVector<int>> m_trigrams;    // Trigram -> documents containing it, ascending
+    QHash<quint32, int> m_nameDocuments;        // PGN -> message name document
+    QHash<QByteArray, int> m_contentIds;        // PGN + payload -> content
+    QVector<Content> m_contents;
+    QVector<int> m_rowContent;                  // Store row -> content
+
+    // Contents of evicted rows are never dropped one by one - past this the index starts over
+    static const int MAX_CONTENTS = 1 << 20;
+    static const int TRIGRAM_LENGTH = 3;
+};
+
+#endif // CAPTURESEARCHINDEX_H
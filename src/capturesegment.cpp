@@ -0,0 +1,201 @@
+#include "capturesegment.h"
+#include "capturefile.h"
+#include "capturestore.h"
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+template <typename T>
+void appendLE(QByteArray& out, T value)
+{
+    char bytes[sizeof(T)];
+    qToLittleEndian<T>(value, bytes);
+    out.append(bytes, sizeof(T));
+}
+
+bool fail(QString* errorString, const QString& message)
+{
+    if (errorString) {
+        *errorString = message;
+    }
+    return false;
+}
+
+} // namespace
+
+QByteArray CaptureSegment::magic()
+{
+    return QByteArray("N2KSEGMT", 8);
+}
+
+bool CaptureSegment::isSegmentFile(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return file.read(8) == magic();
+}
+
+QByteArray CaptureSegment::header(qint64 createdWallNs)
+{
+    QByteArray out = magic();
+    appendLE<quint16>(out, FORMAT_VERSION);
+    appendLE<quint16>(out, CaptureFile::RECORD_SIZE);
+    appendLE<quint32>(out, 0);
+    appendLE<qint64>(out, createdWallNs);
+    return out;
+}
+
+QByteArray CaptureSegment::encodeBlock(const CaptureStore& store, bool compress)
+{
+    const int count = store.size();
+    const QByteArray& payload = store.payloadArena();
+
+    QByteArray data(qsizetype(count) * CaptureFile::RECORD_SIZE, Qt::Uninitialized);
+    uchar* record = reinterpret_cast<uchar*>(data.data());
+    for (int row = 0; row < count; row++, record += CaptureFile::RECORD_SIZE) {
+        CaptureFile::encodeRecord(store, row, record);
+    }
+    data.append(payload);
+
+    quint32 rawBytes = 0;
+    if (compress) {
+        // Keep the packed bytes only when they are actually smaller
+        QByteArray packed = qCompress(data);
+        if (packed.size() < data.size()) {
+            rawBytes = quint32(data.size());
+            data = packed;
+        }
+    }
+
+    QByteArray out;
+    out.reserve(BLOCK_HEADER_SIZE + data.size());
+    appendLE<quint32>(out, BLOCK_MAGIC);
+    appendLE<quint32>(out, quint32(count));
+    appendLE<quint32>(out, quint32(data.size()));
+    appendLE<quint32>(out, rawBytes);
+    appendLE<qint64>(out, count > 0 ? store.wallNs(0) : 0);
+    appendLE<qint64>(out, count > 0 ? store.wallNs(count - 1) : 0);
+    out.append(data);
+    return out;
+}
+
+CaptureSegmentReader::CaptureSegmentReader()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_recordSize(0)
+    , m_createdWallNs(0)
+    , m_recordCount(0)
+{
+}
+
+CaptureSegmentReader::~CaptureSegmentReader()
+{
+    close();
+}
+
+void CaptureSegmentReader::close()
+{
+    m_file.close();  // Also unmaps
+    m_contents.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_recordSize = 0;
+    m_createdWallNs = 0;
+    m_recordCount = 0;
+    m_blocks.clear();
+}
+
+bool CaptureSegmentReader::open(const QString& fileName, QString* errorString)
+{
+    close();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(errorString, m_file.errorString());
+    }
+
+    // Map the file when possible, otherwise fall back to reading it into memory
+    m_size = m_file.size();
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        m_contents = m_file.readAll();
+        m_data = reinterpret_cast<const uchar*>(m_contents.constData());
+        m_size = m_contents.size();
+    }
+
+    if (m_size < CaptureSegment::HEADER_SIZE || memcmp(m_data, CaptureSegment::magic().constData(), 8) != 0) {
+        return fail(errorString, "Not a capture segment file");
+    }
+    const quint16 version = qFromLittleEndian<quint16>(m_data + 8);
+    m_recordSize = qFromLittleEndian<quint16>(m_data + 10);
+    m_createdWallNs = qFromLittleEndian<qint64>(m_data + 16);
+    if (version != CaptureSegment::FORMAT_VERSION) {
+        return fail(errorString, QString("Unsupported capture segment version %1").arg(version));
+    }
+    // Later revisions may append fields to a record, so only require the ones we know
+    if (m_recordSize < CaptureFile::RECORD_SIZE) {
+        return fail(errorString, QString("Invalid capture record size %1").arg(m_recordSize));
+    }
+
+    qint64 pos = CaptureSegment::HEADER_SIZE;
+    while (pos + CaptureSegment::BLOCK_HEADER_SIZE <= m_size) {
+        const uchar* header = m_data + pos;
+        if (qFromLittleEndian<quint32>(header) != CaptureSegment::BLOCK_MAGIC) {
+            break;
+        }
+
+        CaptureSegment::Block block;
+        block.recordCount = int(qFromLittleEndian<quint32>(header + 4));
+        block.storedBytes = qFromLittleEndian<quint32>(header + 8);
+        block.rawBytes = qFromLittleEndian<quint32>(header + 12);
+        block.firstWallNs = qFromLittleEndian<qint64>(header + 16);
+        block.lastWallNs = qFromLittleEndian<qint64>(header + 24);
+        block.offset = pos + CaptureSegment::BLOCK_HEADER_SIZE;
+        if (block.recordCount < 0 || block.offset + qint64(block.storedBytes) > m_size) {
+            // Cut short while it was being written
+            break;
+        }
+
+        m_blocks.append(block);
+        m_recordCount += block.recordCount;
+        pos = block.offset + block.storedBytes;
+    }
+    return true;
+}
+
+bool CaptureSegmentReader::readBlock(int index, CaptureStore& store, QString* errorString)
+{
+    if (index < 0 || index >= m_blocks.size()) {
+        return fail(errorString, "Block is outside the capture segment");
+    }
+    const CaptureSegment::Block& block = m_blocks[index];
+
+    const uchar* data = m_data + block.offset;
+    qint64 size = block.storedBytes;
+    QByteArray unpacked;
+    if (block.rawBytes != 0) {
+        unpacked = qUncompress(data, int(block.storedBytes));
+        if (unpacked.size() != qsizetype(block.rawBytes)) {
+            return fail(errorString, QString("Capture segment block %1 is damaged").arg(index));
+        }
+        data = reinterpret_cast<const uchar*>(unpacked.constData());
+        size = unpacked.size();
+    }
+
+    const qint64 recordBytes = qint64(block.recordCount) * m_recordSize;
+    if (recordBytes > size) {
+        return fail(errorString, QString("Capture segment block %1 is damaged").arg(index));
+    }
+
+    const uchar* payload = data + recordBytes;
+    const quint64 payloadSize = quint64(size - recordBytes);
+    for (int i = 0; i < block.recordCount; i++) {
+        if (!CaptureFile::decodeRecord(data + qint64(i) * m_recordSize, payload, payloadSize, store)) {
+            return fail(errorString, QString("Capture segment block %1 is damaged").arg(index));
+        }
+    }
+    return true;
+}
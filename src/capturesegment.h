@@ -0,0 +1,94 @@
+#ifndef CAPTURESEGMENT_H
+#define CAPTURESEGMENT_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+#include <QFile>
+#include <QByteArray>
+
+class CaptureStore;
+
+/**
+ * @brief Block-structured capture segment, written while capturing.
+ *
+ * A binary .pgnlog needs its record count and section sizes up front, so it
+ * can only be written once a capture is complete. A segment is appended to in
+ * self-contained blocks instead, which makes it safe to write for days: after
+ * a crash or power loss only the block being written is lost. All integers are
+ * little-endian.
+ *
+ *   Header    magic "N2KSEGMT", u16 version, u16 record size, u32 flags (0),
+ *             i64 creation wall ns
+ *   Blocks    u32 block magic, u32 record count, u32 stored bytes,
+ *             u32 raw bytes (0 when stored uncompressed), i64 first wall ns,
+ *             i64 last wall ns, then the stored bytes: record count x record
+ *             size bytes in the CaptureFile record layout with payload offsets
+ *             relative to the block, followed by the block's payload bytes.
+ *             A compressed block holds the same bytes packed with qCompress().
+ *
+ * Segment files use the .pgnlog extension and open in the log viewer like
+ * any other capture.
+ */
+class CaptureSegment
+{
+public:
+    static const quint16 FORMAT_VERSION = 1;
+    static const int HEADER_SIZE = 24;
+    static const int BLOCK_HEADER_SIZE = 32;
+    static const quint32 BLOCK_MAGIC = 0x314B4C42;  // "BLK1"
+
+    struct Block {
+        qint64 offset = 0;          // Of the stored bytes in the file
+        int recordCount = 0;
+        quint32 storedBytes = 0;
+        quint32 rawBytes = 0;       // 0 for an uncompressed block
+        qint64 firstWallNs = 0;
+        qint64 lastWallNs = 0;
+    };
+
+    // True when the file starts with the segment magic
+    static bool isSegmentFile(const QString& fileName);
+
+    static QByteArray header(qint64 createdWallNs);
+    // Block header and data for every row of the store, which must hold only this block
+    static QByteArray encodeBlock(const CaptureStore& store, bool compress);
+
+    static QByteArray magic();
+};
+
+/**
+ * @brief Reads a capture segment block by block.
+ *
+ * open() maps the file and walks the block headers, so the time covered by
+ * every block is known without reading any records. A truncated last block -
+ * the one being written when a recording stopped unexpectedly - is ignored.
+ */
+class CaptureSegmentReader
+{
+public:
+    CaptureSegmentReader();
+    ~CaptureSegmentReader();
+
+    bool open(const QString& fileName, QString* errorString = nullptr);
+    void close();
+
+    const QVector<CaptureSegment::Block>& blocks() const { return m_blocks; }
+    qint64 recordCount() const { return m_recordCount; }
+    qint64 createdWallNs() const { return m_createdWallNs; }
+
+    // Append the records of one block to store
+    bool readBlock(int block, CaptureStore& store, QString* errorString = nullptr);
+
+private:
+    QFile m_file;
+    QByteArray m_contents;  // Only used when the file cannot be mapped
+    const uchar* m_data;
+    qint64 m_size;
+    quint16 m_recordSize;
+    qint64 m_createdWallNs;
+    qint64 m_recordCount;
+    QVector<CaptureSegment::Block> m_blocks;
+};
+
+#endif // CAPTURESEGMENT_H
@@ -0,0 +1,330 @@
+#include "capturestore.h"
+#include <algorithm>
+#include <cstring>
+
+CaptureStore::CaptureStore()
+    : m_livePayloadBytes(0)
+{
+}
+
+int CaptureStore::append(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent)
+{
+    quint8 flags = 0;
+    if (sent) {
+        flags |= SentFlag;
+    }
+    if (timestamp.fromKernel) {
+        flags |= KernelTimestampFlag;
+    }
+
+    return appendRaw(quint32(msg.PGN), quint8(msg.Priority), quint8(msg.Source), quint8(msg.Destination),
+                     msg.Data, msg.DataLen, timestamp.wallNs, timestamp.monotonicNs, flags);
+}
+
+int CaptureStore::appendRaw(quint32 pgn, quint8 priority, quint8 source, quint8 destination,
+                            const unsigned char* data, int len, qint64 wallNs, qint64 monotonicNs, quint8 flags)
+{
+    int row = m_pgn.size();
+    int dataLen = qBound(0, len, int(tN2kMsg::MaxDataLen));
+
+    // Repeats are decided here, whatever the caller passed
+    flags &= quint8(~RepeatFlag);
+    const quint64 key = streamKey(pgn, source, destination, flags);
+    auto stream = m_streams.find(key);
+    const bool repeat = stream != m_streams.end() && stream->length == dataLen &&
+                        (dataLen == 0 || memcmp(m_payload.constData() + stream->payloadOffset, data, dataLen) == 0);
+
+    quint32 payloadOffset;
+    if (repeat) {
+        flags |= RepeatFlag;
+        payloadOffset = stream->payloadOffset;
+        m_runRepeats[stream->run]++;
+        m_runLastRows[stream->run] = row;
+    } else {
+        payloadOffset = quint32(m_payload.size());
+        m_payload.append(reinterpret_cast<const char*>(data), dataLen);
+        m_livePayloadBytes += dataLen;
+        m_streams.insert(key, StreamState{payloadOffset, quint8(dataLen), int(m_runRows.size())});
+        m_runRows.append(row);
+        m_runRepeats.append(0);
+        m_runLastRows.append(row);
+    }
+
+    m_wallNs.append(wallNs);
+    m_monotonicNs.append(monotonicNs);
+    m_pgn.append(pgn);
+    m_payloadOffset.append(payloadOffset);
+    m_priority.append(priority);
+    m_source.append(source);
+    m_destination.append(destination);
+    m_length.append(quint8(dataLen));
+    m_flags.append(flags);
+    return row;
+}
+
+int CaptureStore::appendFrom(const CaptureStore& other, int row)
+{
+    int newRow = appendRaw(other.m_pgn[row], other.m_priority[row], other.m_source[row], other.m_destination[row],
+                           other.payload(row), other.m_length[row], other.m_wallNs[row], other.m_monotonicNs[row],
+                           other.m_flags[row]);
+    if (!other.m_timestampText.isEmpty() && other.m_timestampText.contains(row)) {
+        m_timestampText.insert(newRow, other.m_timestampText.value(row));
+    }
+    return newRow;
+}
+
+void CaptureStore::clear()
+{
+    m_wallNs.clear();
+    m_monotonicNs.clear();
+    m_pgn.clear();
+    m_payloadOffset.clear();
+    m_priority.clear();
+    m_source.clear();
+    m_destination.clear();
+    m_length.clear();
+    m_flags.clear();
+    m_payload.clear();
+    m_livePayloadBytes = 0;
+    m_timestampText.clear();
+    m_runRows.clear();
+    m_runRepeats.clear();
+    m_runLastRows.clear();
+    m_streams.clear();
+    m_promotedRows.clear();
+}
+
+void CaptureStore::reserve(int rows)
+{
+    m_wallNs.reserve(rows);
+    m_monotonicNs.reserve(rows);
+    m_pgn.reserve(rows);
+    m_payloadOffset.reserve(rows);
+    m_priority.reserve(rows);
+    m_source.reserve(rows);
+    m_destination.reserve(rows);
+    m_length.reserve(rows);
+    m_flags.reserve(rows);
+    m_payload.reserve(qsizetype(rows) * 8);  // Most traffic is single-frame
+}
+
+void CaptureStore::removeFirst(int count)
+{
+    m_promotedRows.clear();
+    count = qMin(count, size());
+    if (count <= 0) {
+        return;
+    }
+    if (count == size()) {
+        clear();
+        return;
+    }
+
+    // Runs whose change row goes but whose repeats reach the retained rows - at most one per stream
+    struct Orphan {
+        int run;
+        int promotedRow;
+        int repeats;
+        quint32 payloadOffset;
+        int newRun;
+    };
+    const int firstKeptRun = runIndex(count);
+    QHash<quint64, Orphan> orphans;
+    int scanEnd = count;
+    for (int run = 0; run < firstKeptRun; run++) {
+        if (m_runLastRows[run] >= count) {
+            const int row = m_runRows[run];
+            orphans.insert(streamKey(m_pgn[row], m_source[row], m_destination[row], m_flags[row]),
+                           Orphan{run, -1, 0, 0, -1});
+            scanEnd = qMax(scanEnd, m_runLastRows[run] + 1);
+        }
+    }
+
+    // The first retained repeat of an orphaned run becomes its change row and gets
+    // its own copy of the payload at the end of the arena
+    const quint32 arenaEnd = quint32(m_payload.size());
+    QByteArray promotedPayload;
+    QVector<Orphan> promoted;
+    for (int row = count; row < scanEnd && !orphans.isEmpty(); row++) {
+        if (!(m_flags[row] & RepeatFlag)) {
+            continue;
+        }
+        auto it = orphans.find(streamKey(m_pgn[row], m_source[row], m_destination[row], m_flags[row]));
+        if (it == orphans.end() || row > m_runLastRows[it->run]) {
+            continue;
+        }
+        if (it->promotedRow < 0) {
+            it->promotedRow = row;
+            it->payloadOffset = arenaEnd + quint32(promotedPayload.size());
+            promotedPayload.append(m_payload.constData() + m_payloadOffset[row], m_length[row]);
+            m_flags[row] &= quint8(~RepeatFlag);
+        } else {
+            it->repeats++;
+        }
+        m_payloadOffset[row] = it->payloadOffset;
+    }
+    m_payload.append(promotedPayload);
+    for (const Orphan& orphan : orphans) {
+        promoted.append(orphan);
+    }
+    std::sort(promoted.begin(), promoted.end(), [](const Orphan& a, const Orphan& b) {
+        return a.promotedRow < b.promotedRow;
+    });
+
+    // Retained rows only reference bytes from the lowest retained change row on. Earlier
+    // promotions may have left change rows out of arena order, so this is a scan, and
+    // bytes above it that belonged to removed rows go with a later eviction
+    quint32 payloadBase = arenaEnd;
+    for (int run = firstKeptRun; run < m_runRows.size(); run++) {
+        payloadBase = qMin(payloadBase, m_payloadOffset[m_runRows[run]]);
+    }
+
+    // Merge the kept and promoted runs back into row order
+    const int keptRuns = m_runRows.size() - firstKeptRun;
+    QVector<int> keptRunIndex(keptRuns);
+    QVector<int> runRows;
+    QVector<int> runRepeats;
+    QVector<int> runLastRows;
+    runRows.reserve(keptRuns + promoted.size());
+    runRepeats.reserve(keptRuns + promoted.size());
+    runLastRows.reserve(keptRuns + promoted.size());
+    int kept = 0;
+    int next = 0;
+    while (kept < keptRuns || next < promoted.size()) {
+        const bool takePromoted = kept == keptRuns ||
+                                  (next < promoted.size() && promoted[next].promotedRow < m_runRows[firstKeptRun + kept]);
+        if (takePromoted) {
+            Orphan& orphan = promoted[next++];
+            orphan.newRun = runRows.size();
+            runRows.append(orphan.promotedRow - count);
+            runRepeats.append(orphan.repeats);
+            runLastRows.append(m_runLastRows[orphan.run] - count);
+            m_promotedRows.append(orphan.promotedRow - count);
+        } else {
+            const int run = firstKeptRun + kept;
+            keptRunIndex[kept++] = runRows.size();
+            runRows.append(m_runRows[run] - count);
+            runRepeats.append(m_runRepeats[run]);
+            runLastRows.append(m_runLastRows[run] - count);
+        }
+    }
+    for (const Orphan& orphan : promoted) {
+        orphans[streamKey(m_pgn[orphan.promotedRow], m_source[orphan.promotedRow],
+                          m_destination[orphan.promotedRow], m_flags[orphan.promotedRow])] = orphan;
+    }
+    m_runRows.swap(runRows);
+    m_runRepeats.swap(runRepeats);
+    m_runLastRows.swap(runLastRows);
+
+    // Streams whose last run was removed entirely start over with their next message
+    for (auto it = m_streams.begin(); it != m_streams.end();) {
+        if (it->run >= firstKeptRun) {
+            it->run = keptRunIndex[it->run - firstKeptRun];
+            it->payloadOffset -= payloadBase;
+            ++it;
+            continue;
+        }
+        auto orphan = orphans.constFind(it.key());
+        if (orphan != orphans.constEnd() && orphan->run == it->run) {
+            it->run = orphan->newRun;
+            it->payloadOffset = orphan->payloadOffset - payloadBase;
+            ++it;
+        } else {
+            it = m_streams.erase(it);
+        }
+    }
+
+    m_wallNs.remove(0, count);
+    m_monotonicNs.remove(0, count);
+    m_pgn.remove(0, count);
+    m_payloadOffset.remove(0, count);
+    m_priority.remove(0, count);
+    m_source.remove(0, count);
+    m_destination.remove(0, count);
+    m_length.remove(0, count);
+    m_flags.remove(0, count);
+
+    m_payload.remove(0, payloadBase);
+    for (quint32& offset : m_payloadOffset) {
+        offset -= payloadBase;
+    }
+    m_livePayloadBytes = 0;
+    for (int runRow : m_runRows) {
+        m_livePayloadBytes += m_length[runRow];
+    }
+
+    if (!m_timestampText.isEmpty()) {
+        QHash<int, QString> shifted;
+        for (auto it = m_timestampText.constBegin(); it != m_timestampText.constEnd(); ++it) {
+            if (it.key() >= count) {
+                shifted.insert(it.key() - count, it.value());
+            }
+        }
+        m_timestampText.swap(shifted);
+    }
+}
+
+int CaptureStore::repeatCount(int row) const
+{
+    if (isRepeat(row)) {
+        return 0;
+    }
+    return m_runRepeats[runIndex(row)];
+}
+
+int CaptureStore::lastSeenRow(int row) const
+{
+    if (isRepeat(row)) {
+        return row;
+    }
+    return m_runLastRows[runIndex(row)];
+}
+
+int CaptureStore::runIndex(int row) const
+{
+    return int(std::lower_bound(m_runRows.constBegin(), m_runRows.constEnd(), row) - m_runRows.constBegin());
+}
+
+quint64 CaptureStore::streamKey(quint32 pgn, quint8 source, quint8 destination, quint8 flags)
+{
+    // Sent and received messages are separate streams
+    return (quint64(flags & SentFlag) << 48) | (quint64(pgn) << 16) | (quint64(source) << 8) | destination;
+}
+
+const unsigned char* CaptureStore::payload(int row) const
+{
+    return reinterpret_cast<const unsigned char*>(m_payload.constData()) + m_payloadOffset[row];
+}
+
+N2kTimestamp CaptureStore::timestamp(int row) const
+{
+    N2kTimestamp ts;
+    ts.wallNs = m_wallNs[row];
+    ts.monotonicNs = m_monotonicNs[row];
+    ts.fromKernel = m_flags[row] & KernelTimestampFlag;
+    return ts;
+}
+
+tN2kMsg CaptureStore::message(int row) const
+{
+    tN2kMsg msg;
+    msg.PGN = m_pgn[row];
+    msg.Priority = m_priority[row];
+    msg.Source = m_source[row];
+    msg.Destination = m_destination[row];
+    msg.DataLen = m_length[row];
+    memcpy(msg.Data, payload(row), msg.DataLen);
+    return msg;
+}
+
+void CaptureStore::setTimestampText(int row, const QString& text)
+{
+    m_timestampText.insert(row, text);
+}
+
+qint64 CaptureStore::memoryUsage() const
+{
+    return qint64(m_pgn.capacity()) * ROW_OVERHEAD_BYTES + m_payload.capacity() +
+           qint64(m_runRows.capacity()) * 3 * qint64(sizeof(int)) +
+           qint64(m_streams.size()) * qint64(sizeof(quint64) + sizeof(StreamState));
+}
@@ -0,0 +1,133 @@
+#ifndef CAPTURESTORE_H
+#define CAPTURESTORE_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <N2kMsg.h>
+#include "n2ktimestamp.h"
+
+/**
+ * @brief Compact columnar storage for captured NMEA2000 messages.
+ *
+ * Each field lives in its own array and payload bytes are packed back to back
+ * in a single arena, so a message costs roughly 30 bytes plus its payload
+ * instead of a set of heap-allocated table items. Display text is never
+ * stored here - it is produced on demand by PGNLogModel.
+ *
+ * Every row is kept, but a message whose payload equals the previous message
+ * of the same PGN, source and destination is stored as a repeat: it gets
+ * RepeatFlag and shares the payload bytes of the row that started the run. A
+ * hash of the last payload per stream makes the check one lookup per append.
+ * Each change row (a row without RepeatFlag) knows how many repeats followed
+ * it and which was the newest, so a change-only view can hide the repeats
+ * without losing them.
+ */
+class CaptureStore
+{
+public:
+    enum RowFlag : quint8 {
+        SentFlag = 0x01,            // Transmitted by this application
+        KernelTimestampFlag = 0x02, // Receive time came from SO_TIMESTAMPNS
+        RepeatFlag = 0x04           // Same payload as the previous message of the stream - set by the store
+    };
+
+    // Column bytes per row, excluding payload
+    static const int ROW_OVERHEAD_BYTES = 2 * sizeof(qint64) + 2 * sizeof(quint32) + 5 * sizeof(quint8);
+
+    CaptureStore();
+
+    int append(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent = false);
+    int appendRaw(quint32 pgn, quint8 priority, quint8 source, quint8 destination,
+                  const unsigned char* data, int len, qint64 wallNs, qint64 monotonicNs, quint8 flags);
+    int appendFrom(const CaptureStore& other, int row);
+    void clear();
+    void reserve(int rows);
+
+    // Drop the oldest rows - callers should evict in chunks, each call moves the remaining data.
+    // A retained repeat whose change row was dropped becomes a change row itself
+    void removeFirst(int count);
+    // Rows, ascending, that removeFirst() turned from repeats into change rows
+    const QVector<int>& promotedRows() const { return m_promotedRows; }
+
+    int size() const { return m_pgn.size(); }
+    bool isEmpty() const { return m_pgn.isEmpty(); }
+
+    quint32 pgn(int row) const { return m_pgn[row]; }
+    quint8 priority(int row) const { return m_priority[row]; }
+    quint8 source(int row) const { return m_source[row]; }
+    quint8 destination(int row) const { return m_destination[row]; }
+    quint8 length(int row) const { return m_length[row]; }
+    const unsigned char* payload(int row) const;
+    bool isSent(int row) const { return m_flags[row] & SentFlag; }
+    quint8 flags(int row) const { return m_flags[row]; }
+    qint64 wallNs(int row) const { return m_wallNs[row]; }
+    qint64 monotonicNs(int row) const { return m_monotonicNs[row]; }
+
+    // Change tracking - repeatCount() and lastSeenRow() describe the run a change row starts
+    bool isRepeat(int row) const { return m_flags[row] & RepeatFlag; }
+    int repeatCount(int row) const;  // 0 for repeat rows
+    int lastSeenRow(int row) const;  // Newest row of the run, row itself without repeats
+    int changeCount() const { return m_runRows.size(); }
+
+    // Raw column arrays, for filters that scan whole columns
+    const quint32* pgnData() const { return m_pgn.constData(); }
+    const quint8* sourceData() const { return m_source.constData(); }
+    const quint8* destinationData() const { return m_destination.constData(); }
+    const quint8* flagsData() const { return m_flags.constData(); }
+
+    // Packed payload bytes of all rows, addressed by payloadOffset() - used for bulk file writes.
+    // Repeat rows point at the bytes of an earlier row
+    const QByteArray& payloadArena() const { return m_payload; }
+    quint32 payloadOffset(int row) const { return m_payloadOffset[row]; }
+
+    N2kTimestamp timestamp(int row) const;
+    tN2kMsg message(int row) const;
+
+    // Original timestamp column for loaded rows whose time could not be parsed
+    void setTimestampText(int row, const QString& text);
+    QString timestampText(int row) const { return m_timestampText.value(row); }
+
+    // Bytes held by the retained rows, used for the capture budget. Counts the payloads
+    // of change rows, not the arena, which can still hold bytes of evicted rows
+    qint64 retainedBytes() const { return qint64(size()) * ROW_OVERHEAD_BYTES + m_livePayloadBytes; }
+    qint64 rowBytes(int row) const { return ROW_OVERHEAD_BYTES + (isRepeat(row) ? 0 : m_length[row]); }
+
+    // Approximate heap usage of the capture, for status display
+    qint64 memoryUsage() const;
+
+private:
+    // Last payload seen on a PGN/source/destination stream
+    struct StreamState {
+        quint32 payloadOffset;
+        quint8 length;
+        int run;  // Index into the run columns
+    };
+
+    static quint64 streamKey(quint32 pgn, quint8 source, quint8 destination, quint8 flags);
+    int runIndex(int row) const;
+
+    QVector<qint64> m_wallNs;
+    QVector<qint64> m_monotonicNs;
+    QVector<quint32> m_pgn;
+    QVector<quint32> m_payloadOffset;
+    QVector<quint8> m_priority;
+    QVector<quint8> m_source;
+    QVector<quint8> m_destination;
+    QVector<quint8> m_length;
+    QVector<quint8> m_flags;
+    QByteArray m_payload;
+    qint64 m_livePayloadBytes;  // Payload bytes of the retained change rows
+    QHash<int, QString> m_timestampText;  // Sparse - only rows without a valid timestamp
+
+    // One entry per change row, ascending
+    QVector<int> m_runRows;
+    QVector<int> m_runRepeats;
+    QVector<int> m_runLastRows;
+    QHash<quint64, StreamState> m_streams;
+    QVector<int> m_promotedRows;
+};
+
+#endif // CAPTURESTORE_H
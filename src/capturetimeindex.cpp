@@ -0,0 +1,180 @@
+#include "capturetimeindex.h"
+#include "capturestore.h"
+#include <algorithm>
+
+CaptureTimeIndex::CaptureTimeIndex()
+    : m_indexedRows(0)
+    , m_sequenceShift(0)
+    , m_firstBlockSequence(0)
+{
+}
+
+void CaptureTimeIndex::clear()
+{
+    m_indexedRows = 0;
+    m_sequenceShift = 0;
+    m_firstBlockSequence = 0;
+    m_blockMaxNs.clear();
+    m_runningMaxNs.clear();
+    m_byPgn.clear();
+    m_bySource.clear();
+    m_byPgnSource.clear();
+}
+
+void CaptureTimeIndex::removeFirst(const CaptureStore& store, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    // Rows past indexedRows() were never indexed - their sequence numbers are simply skipped
+    m_sequenceShift += count;
+    m_indexedRows = qMax(0, m_indexedRows - count);
+
+    // Drop the time blocks that lie entirely before the first remaining row
+    const int dropped = qMin((m_sequenceShift - m_firstBlockSequence) / TIME_STRIDE, int(m_blockMaxNs.size()));
+    m_blockMaxNs.remove(0, dropped);
+    m_firstBlockSequence += dropped * TIME_STRIDE;
+    if (m_indexedRows == 0) {
+        m_blockMaxNs.clear();
+        m_firstBlockSequence = m_sequenceShift;
+    } else {
+        // The first block lost some of its rows - take its latest time from the rows left
+        const int blockEnd = qMin(m_firstBlockSequence + TIME_STRIDE - m_sequenceShift, m_indexedRows);
+        qint64 latest = store.wallNs(0);
+        for (int row = 1; row < blockEnd; row++) {
+            latest = qMax(latest, store.wallNs(row));
+        }
+        m_blockMaxNs[0] = latest;
+    }
+    rebuildRunningMax();
+
+    trimPostings(m_byPgn);
+    trimPostings(m_bySource);
+    trimPostings(m_byPgnSource);
+
+    if (m_sequenceShift > REBASE_THRESHOLD) {
+        rebase();
+    }
+}
+
+void CaptureTimeIndex::update(const CaptureStore& store, int rowCount)
+{
+    rowCount = qMin(rowCount, store.size());
+    for (int row = m_indexedRows; row < rowCount; row++) {
+        const int sequence = row + m_sequenceShift;
+        const qint64 wallNs = store.wallNs(row);
+        const int block = (sequence - m_firstBlockSequence) / TIME_STRIDE;
+        if (block == m_blockMaxNs.size()) {
+            const qint64 previous = m_runningMaxNs.isEmpty() ? wallNs : m_runningMaxNs.last();
+            m_blockMaxNs.append(wallNs);
+            m_runningMaxNs.append(qMax(previous, wallNs));
+        } else {
+            m_blockMaxNs[block] = qMax(m_blockMaxNs[block], wallNs);
+            m_runningMaxNs[block] = qMax(m_runningMaxNs[block], wallNs);
+        }
+
+        const quint32 pgn = store.pgn(row);
+        const quint8 source = store.source(row);
+        m_byPgn[pgn].append(sequence);
+        m_bySource[source].append(sequence);
+        m_byPgnSource[pgn << 8 | source].append(sequence);
+    }
+    m_indexedRows = qMax(m_indexedRows, rowCount);
+}
+
+int CaptureTimeIndex::rowAtTime(const CaptureStore& store, qint64 wallNs) const
+{
+    // The first block whose running maximum reaches wallNs holds the first such row
+    auto block = std::lower_bound(m_runningMaxNs.constBegin(), m_runningMaxNs.constEnd(), wallNs);
+    if (block == m_runningMaxNs.constEnd()) {
+        return -1;
+    }
+
+    const int blockIndex = int(block - m_runningMaxNs.constBegin());
+    const int firstRow = qMax(0, m_firstBlockSequence + blockIndex * TIME_STRIDE - m_sequenceShift);
+    for (int row = firstRow; row < m_indexedRows; row++) {
+        if (store.wallNs(row) >= wallNs) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+int CaptureTimeIndex::nextRow(quint32 pgn, int source, int fromRow, bool forward) const
+{
+    if (pgn == ANY_PGN && source == ANY_SOURCE) {
+        const int row = forward ? qMax(fromRow + 1, 0) : qMin(fromRow - 1, m_indexedRows - 1);
+        return row >= 0 && row < m_indexedRows ? row : -1;
+    }
+
+    const QVector<int>* list = postings(pgn, source);
+    if (!list) {
+        return -1;
+    }
+
+    const int sequence = fromRow + m_sequenceShift;
+    if (forward) {
+        auto it = std::upper_bound(list->constBegin(), list->constEnd(), sequence);
+        return it != list->constEnd() ? *it - m_sequenceShift : -1;
+    }
+    auto it = std::lower_bound(list->constBegin(), list->constEnd(), sequence);
+    return it != list->constBegin() ? *(it - 1) - m_sequenceShift : -1;
+}
+
+const QVector<int>* CaptureTimeIndex::postings(quint32 pgn, int source) const
+{
+    const QHash<quint32, QVector<int>>* lists;
+    quint32 key;
+    if (source == ANY_SOURCE) {
+        lists = &m_byPgn;
+        key = pgn;
+    } else if (pgn == ANY_PGN) {
+        lists = &m_bySource;
+        key = quint32(source);
+    } else {
+        lists = &m_byPgnSource;
+        key = pgn << 8 | quint32(source);
+    }
+
+    auto it = lists->constFind(key);
+    return it != lists->constEnd() ? &it.value() : nullptr;
+}
+
+void CaptureTimeIndex::trimPostings(QHash<quint32, QVector<int>>& lists)
+{
+    for (auto it = lists.begin(); it != lists.end(); ) {
+        QVector<int>& list = it.value();
+        auto kept = std::lower_bound(list.begin(), list.end(), m_sequenceShift);
+        list.erase(list.begin(), kept);
+        if (list.isEmpty()) {
+            it = lists.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void CaptureTimeIndex::rebase()
+{
+    // The first block starts at or before the first row, so nothing goes negative
+    const int base = m_firstBlockSequence;
+    m_sequenceShift -= base;
+    m_firstBlockSequence = 0;
+    for (QHash<quint32, QVector<int>>* lists : {&m_byPgn, &m_bySource, &m_byPgnSource}) {
+        for (QVector<int>& list : *lists) {
+            for (int& sequence : list) {
+                sequence -= base;
+            }
+        }
+    }
+}
+
+void CaptureTimeIndex::rebuildRunningMax()
+{
+    m_runningMaxNs.resize(m_blockMaxNs.size());
+    for (int block = 0; block < m_blockMaxNs.size(); block++) {
+        m_runningMaxNs[block] = block > 0 ? qMax(m_runningMaxNs[block - 1], m_blockMaxNs[block])
+                                          : m_blockMaxNs[block];
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef CAPTURETIMEINDEX_H
+#define CAPTURETIMEINDEX_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QHash>
+
+class CaptureStore;
+
+/**
+ * @brief Sparse time index and PGN/source postings for navigating a capture.
+ *
+ * Every TIME_STRIDE rows the index keeps the latest wall clock time seen so
+ * far. That running maximum never decreases, even when the clock steps back,
+ * so the first row at or after a time is found by a binary search over the
+ * samples and a scan of at most one stride.
+ *
+ * Postings list the rows of each PGN, each source address and each PGN and
+ * source pair in ascending order, so the next or previous row with a key is
+ * one binary search away.
+ *
+ * Entries are kept as row sequence numbers that do not change when the oldest
+ * rows are evicted: removeFirst() only trims the front of each list. update()
+ * only indexes rows added since the previous call.
+ */
+class CaptureTimeIndex
+{
+public:
+    static const quint32 ANY_PGN = 0xFFFFFFFF;
+    static const int ANY_SOURCE = -1;
+
+    CaptureTimeIndex();
+
+    void clear();
+    // Follow the store dropping its first count rows - call after it has done so
+    void removeFirst(const CaptureStore& store, int count);
+
+    // Index store rows [indexedRows(), rowCount)
+    void update(const CaptureStore& store, int rowCount);
+    int indexedRows() const { return m_indexedRows; }
+
+    // First indexed row whose wall clock time is at or after wallNs, -1 when there is none
+    int rowAtTime(const CaptureStore& store, qint64 wallNs) const;
+    // Nearest indexed row after fromRow (before it when backwards) with this PGN
+    // and source, either of which may be ANY. -1 when there is none
+    int nextRow(quint32 pgn, int source, int fromRow, bool forward) const;
+
+private:
+    const QVector<int>* postings(quint32 pgn, int source) const;
+    void trimPostings(QHash<quint32, QVector<int>>& lists);
+    void rebase();
+    void rebuildRunningMax();
+
+    int m_indexedRows;
+    int m_sequenceShift;                      // Sequence number of store row 0
+    int m_firstBlockSequence;                 // Sequence number the first time block starts at
+    QVector<qint64> m_blockMaxNs;             // Latest wall time within each block
+    QVector<qint64> m_runningMaxNs;           // Latest wall time up to the end of each block
+    QHash<quint32, QVector<int>> m_byPgn;     // PGN -> row sequence numbers, ascending
+    QHash<quint32, QVector<int>> m_bySource;
+    QHash<quint32, QVector<int>> m_byPgnSource;  // PGN << 8 | source
+
+    static const int TIME_STRIDE = 1024;
+    // Sequence numbers are renumbered from zero before they could overflow
+    static const int REBASE_THRESHOLD = 1 << 30;
+};
+
+#endif // CAPTURETIMEINDEX_H
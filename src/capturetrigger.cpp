@@ -0,0 +1,261 @@
+#include "capturetrigger.h"
+#include "capturefile.h"
+#include <QTimer>
+#include <QDir>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QSet>
+
+static const qint64 NS_PER_SECOND = 1000000000LL;
+// Segments listed by segmentFiles() - older files stay on disk
+static const int MAX_LISTED_SEGMENTS = 200;
+
+CaptureTrigger::CaptureTrigger(QObject* parent)
+    : QObject(parent)
+    , m_state(Idle)
+    , m_rateExceeded(false)
+    , m_triggerNs(0)
+    , m_postTriggerTimer(new QTimer(this))
+    , m_triggerCount(0)
+{
+    // Ends the segment when traffic stops before the post-trigger window has passed
+    m_postTriggerTimer->setSingleShot(true);
+    connect(m_postTriggerTimer, &QTimer::timeout, this, &CaptureTrigger::finishSegment);
+}
+
+QString CaptureTrigger::segmentDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/triggers";
+}
+
+bool CaptureTrigger::arm(const Settings& settings, DBCDecoder* decoder, QString* errorString)
+{
+    QSharedPointer<CaptureQuery> query;
+    const QString text = settings.query.trimmed();
+    if (!text.isEmpty()) {
+        query = CaptureQuery::compile(text, decoder, errorString);
+        if (!query) {
+            return false;
+        }
+        if (query->hasTimeWindows()) {
+            // A "within" clause keeps every anchor time, which would grow without bound while armed
+            if (errorString) {
+                *errorString = "\"within\" is not supported in trigger conditions";
+            }
+            return false;
+        }
+    } else if (settings.kind == ConditionTrigger) {
+        if (errorString) {
+            *errorString = "Enter a trigger condition";
+        }
+        return false;
+    }
+
+    disarm();
+    m_settings = settings;
+    m_settings.query = text;
+    m_settings.preTriggerSeconds = qMax(settings.preTriggerSeconds, 0);
+    m_settings.postTriggerSeconds = qMax(settings.postTriggerSeconds, 0);
+    m_settings.rateLimit = qMax(settings.rateLimit, 1);
+    m_query = query;
+    m_state = Armed;
+    emit stateChanged();
+    return true;
+}
+
+void CaptureTrigger::disarm()
+{
+    if (m_state == Idle) {
+        return;
+    }
+
+    m_postTriggerTimer->stop();
+    m_state = Idle;
+    m_query.clear();
+    m_ring.clear();
+    m_streamMatching.clear();
+    m_rateTimes.clear();
+    m_rateExceeded = false;
+    emit stateChanged();
+}
+
+void CaptureTrigger::append(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent)
+{
+    if (m_state == Idle) {
+        return;
+    }
+
+    const int row = m_ring.append(msg, timestamp, sent);
+    const qint64 timeNs = rowTimeNs(m_ring, row);
+
+    QString description;
+    const bool fired = checkTrigger(row, timeNs, description);
+
+    if (m_state == Collecting) {
+        // A trigger inside the post-trigger window belongs to the segment already being recorded
+        if (timeNs - m_triggerNs >= qint64(m_settings.postTriggerSeconds) * NS_PER_SECOND
+            || m_ring.size() >= MAX_RING_MESSAGES) {
+            finishSegment();
+        }
+        return;
+    }
+
+    if (fired) {
+        m_state = Collecting;
+        m_triggerNs = timeNs;
+        m_triggerDescription = description;
+        m_triggerCount++;
+        m_postTriggerTimer->start(m_settings.postTriggerSeconds * 1000);
+        emit triggered(description);
+        emit stateChanged();
+        if (m_settings.postTriggerSeconds == 0) {
+            finishSegment();
+        }
+        return;
+    }
+
+    trimRing(timeNs);
+}
+
+bool CaptureTrigger::checkTrigger(int row, qint64 timeNs, QString& description)
+{
+    const bool matched = !m_query || m_query->matches(m_ring, row);
+
+    if (m_settings.kind == RateTrigger) {
+        if (matched) {
+            m_rateTimes.enqueue(timeNs);
+        }
+        while (!m_rateTimes.isEmpty() && timeNs - m_rateTimes.head() >= RATE_WINDOW_NS) {
+            m_rateTimes.dequeue();
+        }
+
+        // Fire when the rate goes over the limit, not for every message while it stays there
+        const bool exceeded = m_rateTimes.size() > m_settings.rateLimit;
+        const bool fired = exceeded && !m_rateExceeded;
+        m_rateExceeded = exceeded;
+        if (fired) {
+            description = QString("%1 msgs/s%2").arg(m_rateTimes.size())
+                              .arg(m_query ? QString(" matching %1").arg(m_query->text()) : QString());
+        }
+        return fired;
+    }
+
+    if (m_settings.everyMatch) {
+        if (matched) {
+            description = QString("PGN %1 from %2 matched %3")
+                              .arg(m_ring.pgn(row)).arg(m_ring.source(row)).arg(m_query->text());
+        }
+        return matched;
+    }
+
+    // Edge per stream - a condition that stays true fires once, and again only after it clears
+    const quint64 key = (quint64(m_ring.pgn(row)) << 16) | (quint64(m_ring.source(row)) << 8) | m_ring.destination(row);
+    if (!matched) {
+        if (m_streamMatching.contains(key)) {
+            m_streamMatching.insert(key, false);
+        }
+        return false;
+    }
+
+    const bool wasMatching = m_streamMatching.value(key, false);
+    m_streamMatching.insert(key, true);
+    if (wasMatching) {
+        return false;
+    }
+    description = QString("PGN %1 from %2 matched %3")
+                      .arg(m_ring.pgn(row)).arg(m_ring.source(row)).arg(m_query->text());
+    return true;
+}
+
+void CaptureTrigger::trimRing(qint64 newestNs)
+{
+    if (m_ring.isEmpty()) {
+        return;
+    }
+
+    const qint64 preNs = qint64(m_settings.preTriggerSeconds) * NS_PER_SECOND;
+    const qint64 slackNs = preNs * RING_SLACK_PERCENT / 100;
+    int evict = 0;
+
+    // Evict in chunks: let the ring grow past the window by the slack, then cut it back to the window
+    if (newestNs - rowTimeNs(m_ring, 0) > preNs + slackNs) {
+        int low = 0;
+        int high = m_ring.size();
+        while (low < high) {
+            const int middle = low + (high - low) / 2;
+            if (rowTimeNs(m_ring, middle) < newestNs - preNs) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        evict = low;
+    }
+    if (m_ring.size() - evict > MAX_RING_MESSAGES) {
+        evict = m_ring.size() - MAX_RING_MESSAGES * 3 / 4;
+    }
+    if (evict > 0) {
+        m_ring.removeFirst(evict);
+    }
+}
+
+void CaptureTrigger::finishSegment()
+{
+    if (m_state != Collecting) {
+        return;
+    }
+    m_postTriggerTimer->stop();
+
+    // Rows from the pre-trigger start on - the ring may hold a little more because of the slack
+    const qint64 startNs = m_triggerNs - qint64(m_settings.preTriggerSeconds) * NS_PER_SECOND;
+    int first = 0;
+    while (first < m_ring.size() && rowTimeNs(m_ring, first) < startNs) {
+        first++;
+    }
+
+    CaptureStore segment;
+    segment.reserve(m_ring.size() - first);
+    QSet<quint8> sources;
+    for (int row = first; row < m_ring.size(); row++) {
+        segment.appendFrom(m_ring, row);
+        sources.insert(m_ring.source(row));
+    }
+
+    QHash<quint8, QString> deviceNames;
+    if (m_deviceNameResolver) {
+        for (quint8 source : sources) {
+            const QString name = m_deviceNameResolver(source);
+            if (!name.isEmpty()) {
+                deviceNames.insert(source, name);
+            }
+        }
+    }
+
+    QDir().mkpath(segmentDirectory());
+    const QString fileName = QString("%1/trigger_%2.pgnlog")
+                                 .arg(segmentDirectory(), QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss_zzz"));
+    QString error;
+    const bool saved = CaptureFile::save(fileName, segment, deviceNames, &error);
+
+    // Re-arm with what is left of the ring as the next pre-trigger window
+    m_state = Armed;
+    if (!m_ring.isEmpty()) {
+        trimRing(rowTimeNs(m_ring, m_ring.size() - 1));
+    }
+
+    if (saved) {
+        m_segmentFiles.append(fileName);
+        while (m_segmentFiles.size() > MAX_LISTED_SEGMENTS) {
+            m_segmentFiles.removeFirst();
+        }
+        emit segmentSaved(fileName, segment.size());
+    } else {
+        emit saveFailed(error);
+    }
+    emit stateChanged();
+}
+
+qint64 CaptureTrigger::rowTimeNs(const CaptureStore& store, int row)
+{
+    return store.monotonicNs(row) != 0 ? store.monotonicNs(row) : store.wallNs(row);
+}
@@ -0,0 +1,115 @@
+#ifndef CAPTURETRIGGER_H
+#define CAPTURETRIGGER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QQueue>
+#include <QSharedPointer>
+#include <functional>
+#include <N2kMsg.h>
+#include "n2ktimestamp.h"
+#include "capturestore.h"
+#include "capturequery.h"
+
+class QTimer;
+class DBCDecoder;
+
+/**
+ * @brief Oscilloscope-style trigger over live traffic.
+ *
+ * While armed, every message goes into a ring that only keeps the pre-trigger
+ * window. When the trigger fires, the ring stops dropping rows until the
+ * post-trigger window has passed. Then the rows from the pre-trigger start on
+ * are saved as a binary capture segment, and the trigger arms again. Memory
+ * stays bounded by the two windows, however long it runs.
+ *
+ * A condition trigger is a CaptureQuery, such as "pgn==59392 && data[0]!=0" for
+ * a NACK or "Speed > 2000" for a decoded signal crossing a threshold. By default
+ * it fires when a PGN/source/destination stream starts matching, so a level
+ * that stays crossed fires once. A rate trigger fires when the messages matching
+ * its query, or all messages, exceed a rate over the last second.
+ */
+class CaptureTrigger : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Kind {
+        ConditionTrigger = 0,
+        RateTrigger
+    };
+
+    enum State {
+        Idle,
+        Armed,        // Filling the pre-trigger ring
+        Collecting    // Fired, recording the post-trigger window
+    };
+
+    struct Settings {
+        Kind kind = ConditionTrigger;
+        QString query;              // Condition, or the messages a rate trigger counts (empty for all)
+        bool everyMatch = false;    // Fire on each matching message, not only when a stream starts matching
+        int rateLimit = 500;        // Messages per second
+        int preTriggerSeconds = 10;
+        int postTriggerSeconds = 10;
+    };
+
+    typedef std::function<QString(quint8)> DeviceNameLookup;
+
+    explicit CaptureTrigger(QObject* parent = nullptr);
+
+    void setDeviceNameResolver(const DeviceNameLookup& resolver) { m_deviceNameResolver = resolver; }
+
+    // Compile the settings and start filling the ring. Returns false and sets errorString when they are invalid
+    bool arm(const Settings& settings, DBCDecoder* decoder, QString* errorString = nullptr);
+    void disarm();
+
+    void append(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent = false);
+
+    State state() const { return m_state; }
+    const Settings& settings() const { return m_settings; }
+    int ringSize() const { return m_ring.size(); }
+    qint64 ringBytes() const { return m_ring.retainedBytes(); }
+    int triggerCount() const { return m_triggerCount; }
+    const QStringList& segmentFiles() const { return m_segmentFiles; }
+
+    static QString segmentDirectory();
+
+    // Hard cap on the ring, in case a flood makes the time windows hold too much
+    static const int MAX_RING_MESSAGES = 1000000;
+    // The ring is trimmed once it holds this much more than the pre-trigger window
+    static const int RING_SLACK_PERCENT = 25;
+    static const qint64 RATE_WINDOW_NS = 1000000000LL;
+
+signals:
+    void stateChanged();
+    void triggered(const QString& description);
+    void segmentSaved(const QString& fileName, int messageCount);
+    void saveFailed(const QString& errorString);
+
+private slots:
+    void finishSegment();
+
+private:
+    bool checkTrigger(int row, qint64 timeNs, QString& description);
+    void trimRing(qint64 newestNs);
+    static qint64 rowTimeNs(const CaptureStore& store, int row);
+
+    Settings m_settings;
+    State m_state;
+    QSharedPointer<CaptureQuery> m_query;
+    CaptureStore m_ring;
+    QHash<quint64, bool> m_streamMatching;  // Condition state of each stream at its last message
+    QQueue<qint64> m_rateTimes;             // Times of the counted messages in the last second
+    bool m_rateExceeded;
+    qint64 m_triggerNs;
+    QString m_triggerDescription;
+    QTimer* m_postTriggerTimer;
+    int m_triggerCount;
+    QStringList m_segmentFiles;
+    DeviceNameLookup m_deviceNameResolver;
+};
+
+#endif // CAPTURETRIGGER_H
@@ -0,0 +1,246 @@
+#include "capturetriggerdialog.h"
+#include "toastmanager.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QLabel>
+#include <QPushButton>
+#include <QListWidget>
+#include <QTimer>
+#include <QSettings>
+#include <QFileInfo>
+#include <QDir>
+#include <QUrl>
+#include <QDesktopServices>
+
+// Condition presets - the text goes into the query field, where it can be edited
+static const struct {
+    const char* name;
+    const char* query;
+} TRIGGER_PRESETS[] = {
+    { "Custom", "" },
+    { "NACK (ISO Acknowledgement 59392)", "pgn==59392 && data[0]!=0" },
+    { "ISO Request (59904)", "pgn==59904" },
+    { "Address claim (60928)", "pgn==60928" },
+    { "Payload mask (PGN, source, bytes)", "pgn==127501 && src==0 && data[0]==0" },
+    { "Signal crossing a threshold", "pgn==127488 && Speed > 3000" }
+};
+
+CaptureTriggerDialog::CaptureTriggerDialog(CaptureTrigger* trigger, DBCDecoder* decoder, QWidget* parent)
+    : QDialog(parent)
+    , m_trigger(trigger)
+    , m_dbcDecoder(decoder)
+{
+    setupUI();
+    loadSettings();
+
+    connect(m_trigger, &CaptureTrigger::stateChanged, this, &CaptureTriggerDialog::updateStatus);
+    connect(m_trigger, &CaptureTrigger::segmentSaved, this, &CaptureTriggerDialog::onSegmentSaved);
+    connect(m_trigger, &CaptureTrigger::saveFailed, this, &CaptureTriggerDialog::onSaveFailed);
+
+    for (const QString& fileName : m_trigger->segmentFiles()) {
+        m_segmentList->addItem(QFileInfo(fileName).fileName());
+    }
+
+    // The ring size changes per message; the label follows at a readable pace
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    connect(m_refreshTimer, &QTimer::timeout, this, &CaptureTriggerDialog::updateStatus);
+    m_refreshTimer->start();
+
+    updateStatus();
+
+    setWindowTitle("Capture Triggers");
+    setModal(false);
+    resize(640, 480);
+}
+
+void CaptureTriggerDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+
+    QFormLayout* formLayout = new QFormLayout();
+    m_kindCombo = new QComboBox();
+    m_kindCombo->addItem("Condition", int(CaptureTrigger::ConditionTrigger));
+    m_kindCombo->addItem("Rate spike", int(CaptureTrigger::RateTrigger));
+    formLayout->addRow("Trigger:", m_kindCombo);
+
+    m_presetCombo = new QComboBox();
+    for (const auto& preset : TRIGGER_PRESETS) {
+        m_presetCombo->addItem(preset.name);
+    }
+    formLayout->addRow("Preset:", m_presetCombo);
+
+    m_queryEdit = new QLineEdit();
+    m_queryEdit->setToolTip("A search query: pgn, src, dst, prio, len, data[n] and decoded signal names,\n"
+                            "compared with == != < <= > >= and combined with && || !");
+    formLayout->addRow("Query:", m_queryEdit);
+
+    m_everyMatchCheckBox = new QCheckBox("Fire on every matching message");
+    m_everyMatchCheckBox->setToolTip("Otherwise a stream fires when it starts matching, and again only after it stopped");
+    formLayout->addRow(QString(), m_everyMatchCheckBox);
+
+    m_rateSpinBox = new QSpinBox();
+    m_rateSpinBox->setRange(1, 100000);
+    m_rateSpinBox->setSuffix(" msgs/s");
+    m_rateSpinBox->setToolTip("Fire when more messages than this match the query (all messages if empty) within one second");
+    formLayout->addRow("Rate limit:", m_rateSpinBox);
+
+    m_preTriggerSpinBox = new QSpinBox();
+    m_preTriggerSpinBox->setRange(0, 600);
+    m_preTriggerSpinBox->setSuffix(" s");
+    formLayout->addRow("Before trigger:", m_preTriggerSpinBox);
+
+    m_postTriggerSpinBox = new QSpinBox();
+    m_postTriggerSpinBox->setRange(0, 600);
+    m_postTriggerSpinBox->setSuffix(" s");
+    formLayout->addRow("After trigger:", m_postTriggerSpinBox);
+    mainLayout->addLayout(formLayout);
+
+    QHBoxLayout* controlLayout = new QHBoxLayout();
+    m_statusLabel = new QLabel();
+    m_statusLabel->setStyleSheet("font-weight: bold; padding: 5px;");
+    m_armButton = new QPushButton("Arm");
+    m_openFolderButton = new QPushButton("Open Folder");
+    m_openFolderButton->setToolTip(QString("Segments are saved to %1").arg(CaptureTrigger::segmentDirectory()));
+    controlLayout->addWidget(m_statusLabel);
+    controlLayout->addStretch();
+    controlLayout->addWidget(m_openFolderButton);
+    controlLayout->addWidget(m_armButton);
+    mainLayout->addLayout(controlLayout);
+
+    m_segmentList = new QListWidget();
+    mainLayout->addWidget(m_segmentList);
+
+    connect(m_kindCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &CaptureTriggerDialog::onKindChanged);
+    connect(m_presetCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &CaptureTriggerDialog::onPresetChanged);
+    connect(m_armButton, &QPushButton::clicked, this, &CaptureTriggerDialog::onArmClicked);
+    connect(m_openFolderButton, &QPushButton::clicked, this, &CaptureTriggerDialog::onOpenFolderClicked);
+}
+
+void CaptureTriggerDialog::loadSettings()
+{
+    QSettings settings;
+    settings.beginGroup("TriggerCapture");
+    CaptureTrigger::Settings defaults;
+    m_kindCombo->setCurrentIndex(m_kindCombo->findData(settings.value("kind", int(defaults.kind)).toInt()));
+    m_queryEdit->setText(settings.value("query", TRIGGER_PRESETS[1].query).toString());
+    m_everyMatchCheckBox->setChecked(settings.value("everyMatch", defaults.everyMatch).toBool());
+    m_rateSpinBox->setValue(settings.value("rateLimit", defaults.rateLimit).toInt());
+    m_preTriggerSpinBox->setValue(settings.value("preTriggerSeconds", defaults.preTriggerSeconds).toInt());
+    m_postTriggerSpinBox->setValue(settings.value("postTriggerSeconds", defaults.postTriggerSeconds).toInt());
+    settings.endGroup();
+    onKindChanged();
+}
+
+void CaptureTriggerDialog::saveSettings(const CaptureTrigger::Settings& triggerSettings)
+{
+    QSettings settings;
+    settings.beginGroup("TriggerCapture");
+    settings.setValue("kind", int(triggerSettings.kind));
+    settings.setValue("query", triggerSettings.query);
+    settings.setValue("everyMatch", triggerSettings.everyMatch);
+    settings.setValue("rateLimit", triggerSettings.rateLimit);
+    settings.setValue("preTriggerSeconds", triggerSettings.preTriggerSeconds);
+    settings.setValue("postTriggerSeconds", triggerSettings.postTriggerSeconds);
+    settings.endGroup();
+}
+
+CaptureTrigger::Settings CaptureTriggerDialog::currentSettings() const
+{
+    CaptureTrigger::Settings settings;
+    settings.kind = static_cast<CaptureTrigger::Kind>(m_kindCombo->currentData().toInt());
+    settings.query = m_queryEdit->text().trimmed();
+    settings.everyMatch = m_everyMatchCheckBox->isChecked();
+    settings.rateLimit = m_rateSpinBox->value();
+    settings.preTriggerSeconds = m_preTriggerSpinBox->value();
+    settings.postTriggerSeconds = m_postTriggerSpinBox->value();
+    return settings;
+}
+
+void CaptureTriggerDialog::onKindChanged()
+{
+    const bool rate = m_kindCombo->currentData().toInt() == CaptureTrigger::RateTrigger;
+    m_rateSpinBox->setEnabled(rate);
+    m_everyMatchCheckBox->setEnabled(!rate);
+    m_queryEdit->setPlaceholderText(rate ? "Messages to count - empty counts all traffic" : "Condition, e.g. pgn==59392 && data[0]!=0");
+}
+
+void CaptureTriggerDialog::onPresetChanged(int index)
+{
+    if (index > 0) {
+        m_queryEdit->setText(TRIGGER_PRESETS[index].query);
+    }
+}
+
+void CaptureTriggerDialog::onArmClicked()
+{
+    if (m_trigger->state() != CaptureTrigger::Idle) {
+        m_trigger->disarm();
+        return;
+    }
+
+    const CaptureTrigger::Settings settings = currentSettings();
+    QString error;
+    if (!m_trigger->arm(settings, m_dbcDecoder, &error)) {
+        ToastManager::instance()->showError(QString("Cannot arm trigger: %1").arg(error), this);
+        return;
+    }
+    saveSettings(settings);
+}
+
+void CaptureTriggerDialog::onOpenFolderClicked()
+{
+    QDir().mkpath(CaptureTrigger::segmentDirectory());
+    QDesktopServices::openUrl(QUrl::fromLocalFile(CaptureTrigger::segmentDirectory()));
+}
+
+void CaptureTriggerDialog::onSegmentSaved(const QString& fileName, int messageCount)
+{
+    m_segmentList->addItem(QString("%1 (%2 msgs)").arg(QFileInfo(fileName).fileName()).arg(messageCount));
+    m_segmentList->scrollToBottom();
+}
+
+void CaptureTriggerDialog::onSaveFailed(const QString& errorString)
+{
+    ToastManager::instance()->showError(QString("Failed to save trigger segment: %1").arg(errorString), this);
+}
+
+void CaptureTriggerDialog::updateStatus()
+{
+    const CaptureTrigger::State state = m_trigger->state();
+    const bool idle = state == CaptureTrigger::Idle;
+
+    QString text;
+    switch (state) {
+    case CaptureTrigger::Idle:
+        text = "Disarmed";
+        break;
+    case CaptureTrigger::Armed:
+        text = "Armed";
+        break;
+    case CaptureTrigger::Collecting:
+        text = "Triggered - recording";
+        break;
+    }
+    if (!idle) {
+        text += QString(" | Ring: %1 msgs, %2 KB")
+                    .arg(m_trigger->ringSize())
+                    .arg(m_trigger->ringBytes() / 1024);
+    }
+    text += QString(" | Triggers: %1").arg(m_trigger->triggerCount());
+    m_statusLabel->setText(text);
+
+    m_armButton->setText(idle ? "Arm" : "Disarm");
+    m_kindCombo->setEnabled(idle);
+    m_presetCombo->setEnabled(idle);
+    m_queryEdit->setEnabled(idle);
+    m_preTriggerSpinBox->setEnabled(idle);
+    m_postTriggerSpinBox->setEnabled(idle);
+    m_rateSpinBox->setEnabled(idle && m_kindCombo->currentData().toInt() == CaptureTrigger::RateTrigger);
+    m_everyMatchCheckBox->setEnabled(idle && m_kindCombo->currentData().toInt() != CaptureTrigger::RateTrigger);
+}
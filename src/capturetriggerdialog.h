@@ -0,0 +1,64 @@
+#ifndef CAPTURETRIGGERDIALOG_H
+#define CAPTURETRIGGERDIALOG_H
+
+#include <QDialog>
+#include "capturetrigger.h"
+
+class QComboBox;
+class QLineEdit;
+class QSpinBox;
+class QCheckBox;
+class QLabel;
+class QPushButton;
+class QListWidget;
+class QTimer;
+class DBCDecoder;
+
+/**
+ * @brief Sets up and arms the CaptureTrigger owned by DeviceMainWindow.
+ *
+ * The trigger keeps running when the dialog is closed; the settings are saved
+ * so the same trigger can be armed again after a restart.
+ */
+class CaptureTriggerDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    CaptureTriggerDialog(CaptureTrigger* trigger, DBCDecoder* decoder, QWidget* parent = nullptr);
+
+private slots:
+    void onKindChanged();
+    void onPresetChanged(int index);
+    void onArmClicked();
+    void onOpenFolderClicked();
+    void onSegmentSaved(const QString& fileName, int messageCount);
+    void onSaveFailed(const QString& errorString);
+    void updateStatus();
+
+private:
+    void setupUI();
+    void loadSettings();
+    void saveSettings(const CaptureTrigger::Settings& settings);
+    CaptureTrigger::Settings currentSettings() const;
+
+    CaptureTrigger* m_trigger;
+    DBCDecoder* m_dbcDecoder;
+
+    QComboBox* m_kindCombo;
+    QComboBox* m_presetCombo;
+    QLineEdit* m_queryEdit;
+    QCheckBox* m_everyMatchCheckBox;
+    QSpinBox* m_rateSpinBox;
+    QSpinBox* m_preTriggerSpinBox;
+    QSpinBox* m_postTriggerSpinBox;
+    QPushButton* m_armButton;
+    QPushButton* m_openFolderButton;
+    QLabel* m_statusLabel;
+    QListWidget* m_segmentList;
+    QTimer* m_refreshTimer;
+
+    static const int REFRESH_INTERVAL_MS = 500;
+};
+
+#endif // CAPTURETRIGGERDIALOG_H
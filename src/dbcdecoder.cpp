@@ -1,6 +1,10 @@
 #include "dbcdecoder.h"
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QCryptographicHash>
 #include <QTextStream>
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
@@ -8,7 +12,12 @@
 #include <QEventLoop>
 #include <QRegularExpression>
 #include <QStringList>
+#include <QSet>
+#include <QRecursiveMutex>
+#include <QtEndian>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include "N2kMessages.h"
 #include "NMEA2000.h"
 
@@ -40,7 +49,44 @@ int mapIntensity200To255(int value)
 
 DBCDecoder::DBCDecoder(QObject *parent)
     : QObject(parent)
+    , m_database(DBCDatabase::shared())
+    , m_decodeCache(DEFAULT_DECODE_CACHE_ENTRIES)
+    , m_decodeCacheHits(0)
+    , m_decodeCacheMisses(0)
 {
+}
+
+std::shared_ptr<const DBCDatabase> DBCDatabase::shared()
+{
+    // Recursive, because a download runs an event loop that may create another decoder
+    static QRecursiveMutex mutex;
+    static std::shared_ptr<const DBCDatabase> database;
+    static bool loading = false;
+    QMutexLocker locker(&mutex);
+    if (!database) {
+        if (loading) {
+            // Created from within the download's event loop - use the built-in definitions
+            // rather than starting a second download
+            qDebug() << "DBC database requested while it is loading, using built-in definitions";
+            return std::shared_ptr<const DBCDatabase>(new DBCDatabase(true));
+        }
+        loading = true;
+        database.reset(new DBCDatabase(false));
+        loading = false;
+    }
+    return database;
+}
+
+DBCDatabase::DBCDatabase(bool builtInOnly)
+    : m_dispatchMask(0)
+{
+    if (builtInOnly) {
+        initializeStandardNMEA2000();
+        initializeCustomDecoders();
+        buildDispatchTable();
+        return;
+    }
+    
     bool dbcLoaded = false;
     
     // First try to load from a local NMEA2000 DBC file
@@ -66,29 +112,149 @@ DBCDecoder::DBCDecoder(QObject *parent)
     // Initialize custom decoder lookup table
     initializeCustomDecoders();
     
-    qDebug() << "DBCDecoder initialized with" << m_messages.size() << "message definitions and" << m_customDecoders.size() << "custom decoders";
+    // Compile every definition once, now that all of them are registered
+    buildDispatchTable();
+    
+    qDebug() << "DBC database loaded with" << m_messages.size() << "message definitions and" << m_customDecoders.size() << "custom decoders";
 }
 
 DBCDecoder::~DBCDecoder()
 {
 }
 
-bool DBCDecoder::loadDBCFile(const QString& filePath)
+bool DBCDatabase::loadDBCFile(const QString& filePath)
 {
     QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         qDebug() << "Failed to open DBC file:" << filePath;
         return false;
     }
     
-    QTextStream in(&file);
-    QString content = in.readAll();
+    QByteArray bytes = file.readAll();
     file.close();
     
-    return parseDBCFile(content);
+    // A snapshot of this exact file skips the text parse
+    const QByteArray dbcHash = QCryptographicHash::hash(bytes, QCryptographicHash::Sha1);
+    const QString snapshot = snapshotPath(filePath);
+    if (loadSnapshot(snapshot, dbcHash)) {
+        qDebug() << "Loaded DBC snapshot:" << snapshot;
+        return true;
+    }
+    
+    if (!parseDBCFile(QString::fromUtf8(bytes))) {
+        return false;
+    }
+    saveSnapshot(snapshot, dbcHash);
+    return true;
+}
+
+QString DBCDatabase::snapshotPath(const QString& dbcPath)
+{
+    return QFileInfo(dbcPath).absoluteFilePath() + ".snapshot";
 }
 
-bool DBCDecoder::loadDBCFromUrl(const QString& url)
+bool DBCDatabase::loadSnapshot(const QString& path, const QByteArray& dbcHash)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    
+    // Read straight from the mapping when possible
+    QByteArray contents;
+    const qint64 size = file.size();
+    uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    if (mapped) {
+        contents = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), size);
+    } else {
+        contents = file.readAll();
+    }
+    
+    QDataStream in(contents);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    QByteArray magic(8, '\0');
+    quint32 version = 0;
+    QByteArray hash;
+    if (in.readRawData(magic.data(), 8) != 8 || magic != snapshotMagic()) {
+        return false;
+    }
+    in >> version >> hash;
+    if (version != quint32(SNAPSHOT_VERSION) || hash != dbcHash) {
+        qDebug() << "DBC snapshot is stale:" << path;
+        return false;
+    }
+    
+    quint32 messageCount = 0;
+    in >> messageCount;
+    QMap<unsigned long, DBCMessage> messages;
+    for (quint32 m = 0; m < messageCount && in.status() == QDataStream::Ok; m++) {
+        DBCMessage message;
+        quint32 pgn = 0;
+        qint32 dlc = 0;
+        quint32 signalCount = 0;
+        in >> pgn >> message.name >> message.description >> dlc >> signalCount;
+        message.pgn = pgn;
+        message.dlc = dlc;
+        for (quint32 g = 0; g < signalCount && in.status() == QDataStream::Ok; g++) {
+            DBCSignal signal;
+            qint32 startBit = 0;
+            qint32 bitLength = 0;
+            in >> signal.name >> startBit >> bitLength >> signal.isSigned
+               >> signal.scale >> signal.offset >> signal.minimum >> signal.maximum
+               >> signal.unit >> signal.description >> signal.valueDescriptions;
+            signal.startBit = startBit;
+            signal.bitLength = bitLength;
+            message.signalList.append(signal);
+        }
+        messages.insert(message.pgn, message);
+    }
+    
+    if (in.status() != QDataStream::Ok || messages.isEmpty()) {
+        qDebug() << "Ignoring damaged DBC snapshot:" << path;
+        return false;
+    }
+    
+    m_messages = messages;
+    return true;
+}
+
+bool DBCDatabase::saveSnapshot(const QString& path, const QByteArray& dbcHash) const
+{
+    // Written to a temporary file and renamed, so a reader never sees half a snapshot
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Cannot write DBC snapshot:" << path;
+        return false;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out.writeRawData(snapshotMagic().constData(), 8);
+    out << quint32(SNAPSHOT_VERSION) << dbcHash << quint32(m_messages.size());
+    for (const DBCMessage& message : m_messages) {
+        out << quint32(message.pgn) << message.name << message.description
+            << qint32(message.dlc) << quint32(message.signalList.size());
+        for (const DBCSignal& signal : message.signalList) {
+            out << signal.name << qint32(signal.startBit) << qint32(signal.bitLength) << signal.isSigned
+                << signal.scale << signal.offset << signal.minimum << signal.maximum
+                << signal.unit << signal.description << signal.valueDescriptions;
+        }
+    }
+    
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qDebug() << "Cannot write DBC snapshot:" << path << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QByteArray DBCDatabase::snapshotMagic()
+{
+    return QByteArray("N2KDBCSN", 8);
+}
+
+bool DBCDatabase::loadDBCFromUrl(const QString& url)
 {
     QNetworkAccessManager manager;
     QNetworkRequest request(url);
@@ -97,7 +263,7 @@ bool DBCDecoder::loadDBCFromUrl(const QString& url)
     QNetworkReply* reply = manager.get(request);
     QEventLoop loop;
     QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
+    loop.exec(QEventLoop::ExcludeUserInputEvents);  // No windows opened mid-load
     
     bool success = false;
     if (reply->error() == QNetworkReply::NoError) {
@@ -120,7 +286,7 @@ bool DBCDecoder::loadDBCFromUrl(const QString& url)
     return success;
 }
 
-bool DBCDecoder::parseDBCFile(const QString& content)
+bool DBCDatabase::parseDBCFile(const QString& content)
 {
     QStringList lines = content.split('\n');
     m_messages.clear();
@@ -150,9 +316,7 @@ bool DBCDecoder::parseDBCFile(const QString& content)
                 
                 // Check if this is a proprietary PGN
                 QString displayName;
-                if ((pgn >= 65280 && pgn <= 65535) ||          // 0xFF00-0xFFFF: Single-frame proprietary
-                    (pgn >= 126720 && pgn <= 126975) ||        // 0x1EF00-0x1EFFF: Multi-frame proprietary
-                    (pgn >= 127744 && pgn <= 128511)) {         // 0x1F300-0x1F5FF: Additional proprietary
+                if (isProprietaryPGN(pgn)) {
                     // Proprietary PGN - use special format
                     displayName = QString("Proprietary %1").arg(pgn);
                 } else {
@@ -207,7 +371,7 @@ bool DBCDecoder::parseDBCFile(const QString& content)
     return messagesAdded > 0;
 }
 
-DBCSignal DBCDecoder::parseDBCSignal(const QString& signalLine)
+DBCSignal DBCDatabase::parseDBCSignal(const QString& signalLine)
 {
     DBCSignal signal;
     
@@ -231,7 +395,7 @@ DBCSignal DBCDecoder::parseDBCSignal(const QString& signalLine)
     return signal;
 }
 
-void DBCDecoder::initializeStandardNMEA2000()
+void DBCDatabase::initializeStandardNMEA2000()
 {
     // Minimal fallback - just add a few basic message stubs for when DBC file is unavailable
     // In practice, this should rarely be used since we download the comprehensive canboat DBC file
@@ -268,72 +432,219 @@ void DBCDecoder::initializeStandardNMEA2000()
     qDebug() << "Initialized" << m_messages.size() << "fallback message definitions";
 }
 
-void DBCDecoder::addMessage(const DBCMessage& message)
+void DBCDatabase::addMessage(const DBCMessage& message)
 {
     m_messages[message.pgn] = message;
 }
 
-DecodedMessage DBCDecoder::decodeMessage(const tN2kMsg& msg)
+void DBCDatabase::buildDispatchTable()
 {
-    DecodedMessage decoded;
-    decoded.isDecoded = false;
-
-    // Check if we have a custom decoder for this PGN
-    auto customDecoderIt = m_customDecoders.find(msg.PGN);
-    if (customDecoderIt != m_customDecoders.end()) {
-        return customDecoderIt.value().decoder(this, msg);
+    m_dispatchEntries.clear();
+    
+    // Custom decoders take precedence, but the DBC plan is kept for decodePGN()
+    QList<unsigned long> pgns = m_messages.keys() + m_customDecoders.keys();
+    std::sort(pgns.begin(), pgns.end());
+    pgns.erase(std::unique(pgns.begin(), pgns.end()), pgns.end());
+    
+    // Names are interned - entries with the same text share one string
+    QSet<QString> names;
+    auto intern = [&names](const QString& name) {
+        auto it = names.constFind(name);
+        return it != names.constEnd() ? *it : *names.insert(name);
+    };
+    
+    m_dispatchEntries.reserve(pgns.size());
+    for (unsigned long pgn : pgns) {
+        DispatchEntry entry;
+        entry.pgn = quint32(pgn);
+        auto message = m_messages.constFind(pgn);
+        if (message != m_messages.constEnd()) {
+            entry.hasPlan = true;
+            entry.plan = compileMessage(message.value());
+            entry.name = message.value().name;
+        }
+        auto custom = m_customDecoders.constFind(pgn);
+        if (custom != m_customDecoders.constEnd()) {
+            entry.customDecoder = custom.value().decoder;
+            entry.name = custom.value().name;
+        }
+        entry.name = intern(entry.name);
+        entry.cleanName = intern(cleanMessageName(entry.name, pgn));
+        m_dispatchEntries.append(entry);
     }
-
-    // Fall back to DBC-based decoding if no custom decoder exists
-    if (!m_messages.contains(msg.PGN)) {
-        return decoded;
+    
+    // Name-only entries for the rest of the proprietary ranges
+    const unsigned long proprietaryRanges[][2] = { {65280, 65535}, {126720, 126975}, {127744, 128511} };
+    for (const auto& range : proprietaryRanges) {
+        for (unsigned long pgn = range[0]; pgn <= range[1]; pgn++) {
+            if (m_messages.contains(pgn) || m_customDecoders.contains(pgn)) {
+                continue;
+            }
+            DispatchEntry entry;
+            entry.pgn = quint32(pgn);
+            entry.name = QString("Proprietary %1").arg(pgn);
+            entry.cleanName = cleanMessageName(entry.name, pgn);
+            m_dispatchEntries.append(entry);
+        }
+    }
+    
+    int size = 16;
+    while (size < m_dispatchEntries.size() * 2) {
+        size *= 2;
+    }
+    m_dispatchSlots.fill(DispatchSlot{0, -1}, size);
+    m_dispatchMask = quint32(size - 1);
+    for (int i = 0; i < m_dispatchEntries.size(); i++) {
+        const quint32 pgn = m_dispatchEntries[i].pgn;
+        quint32 slot = (pgn * 0x9E3779B1u) & m_dispatchMask;
+        while (m_dispatchSlots[slot].entry >= 0) {
+            slot = (slot + 1) & m_dispatchMask;
+        }
+        m_dispatchSlots[slot] = DispatchSlot{pgn, i};
     }
+}
 
-    const DBCMessage& dbcMsg = m_messages[msg.PGN];
-    decoded.messageName = dbcMsg.name;
-    decoded.description = dbcMsg.description;
-    decoded.isDecoded = true;
+const DBCDatabase::DispatchEntry* DBCDatabase::dispatch(unsigned long pgn) const
+{
+    if (m_dispatchSlots.isEmpty()) {
+        return nullptr;
+    }
+    
+    const quint32 key = quint32(pgn);
+    const DispatchSlot* table = m_dispatchSlots.constData();
+    for (quint32 slot = (key * 0x9E3779B1u) & m_dispatchMask; ; slot = (slot + 1) & m_dispatchMask) {
+        if (table[slot].entry < 0) {
+            return nullptr;
+        }
+        if (table[slot].pgn == key) {
+            return &m_dispatchEntries.constData()[table[slot].entry];
+        }
+    }
+}
 
-    // Decode each signal
-    for (const DBCSignal& signal : dbcMsg.signalList) {
-        DecodedSignal decodedSignal;
+DBCDatabase::MessagePlan DBCDatabase::compileMessage(const DBCMessage& message)
+{
+    MessagePlan plan;
+    plan.name = message.name;
+    plan.description = message.description;
+    plan.signalPlans.reserve(message.signalList.size());
+    
+    static const QRegularExpression genericFieldRegex("^Field\\s*\\d+$|^Field_\\d+$", QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression fieldNumberRegex("(\\d+)");
+    
+    for (const DBCSignal& signal : message.signalList) {
+        SignalPlan signalPlan;
+        signalPlan.layout = DBCSignalLayout::compile(signal);
         
-        // Check if we have a better field name available for lighting PGNs
-        QString enhancedName = signal.name;
-        if (signal.name.contains(QRegularExpression("^Field\\s*\\d+$|^Field_\\d+$", QRegularExpression::CaseInsensitiveOption))) {
-            // Extract field number from generic field name
-            QRegularExpression fieldRegex("(\\d+)");
-            QRegularExpressionMatch match = fieldRegex.match(signal.name);
+        // Generic field names of lighting PGNs get their descriptive name
+        signalPlan.name = signal.name;
+        if (signal.name.startsWith("Field", Qt::CaseInsensitive) && genericFieldRegex.match(signal.name).hasMatch()) {
+            QRegularExpressionMatch match = fieldNumberRegex.match(signal.name);
             if (match.hasMatch()) {
                 uint8_t fieldNum = match.captured(1).toUInt();
-                enhancedName = getFieldName(msg.PGN, fieldNum);
+                signalPlan.name = DBCDecoder::getFieldName(message.pgn, fieldNum);
             }
         }
         
-        decodedSignal.name = enhancedName;
-        decodedSignal.unit = signal.unit;
-        decodedSignal.description = signal.description;
+        signalPlan.unit = signal.unit;
+        signalPlan.description = signal.description;
+        signalPlan.valueDescriptions = signal.valueDescriptions;
+        plan.signalPlans.append(signalPlan);
+    }
+    return plan;
+}
 
-        double rawValue = extractSignalValue(msg.Data, signal);
-        decodedSignal.isValid = isSignalValid(rawValue, signal);
+DecodedMessage DBCDecoder::decodeMessage(const tN2kMsg& msg)
+{
+    return cachedDecode(msg)->decoded;
+}
 
-        if (decodedSignal.isValid) {
-            double scaledValue = rawValue * signal.scale + signal.offset;
+DBCDecoder::DecodeCacheEntry* DBCDecoder::cachedDecode(const tN2kMsg& msg)
+{
+    // Decoding only depends on the PGN and payload bytes, never on source, destination or priority
+    int dataLen = qBound(0, msg.DataLen, int(tN2kMsg::MaxDataLen));
+    DecodeCacheKey lookupKey{ quint32(msg.PGN), QByteArray::fromRawData(reinterpret_cast<const char*>(msg.Data), dataLen) };
+    
+    DecodeCacheEntry* entry = m_decodeCache.object(lookupKey);
+    if (entry) {
+        m_decodeCacheHits++;
+        return entry;
+    }
+    m_decodeCacheMisses++;
+    
+    entry = new DecodeCacheEntry;
+    entry->decoded = decodeMessageUncached(msg);
+    
+    // The cache owns the key, so it needs its own copy of the payload
+    DecodeCacheKey ownedKey{ lookupKey.pgn, QByteArray(lookupKey.payload.constData(), dataLen) };
+    m_decodeCache.insert(ownedKey, entry);
+    return entry;
+}
 
-            // Special handling for temperature (convert from Kelvin to Celsius)
-            if (signal.unit == "°C" && scaledValue > 100) {
-                // Assume raw value is in 0.01K units, convert to Celsius
-                scaledValue = (rawValue * 0.01) - 273.15;
-            }
+DecodeCacheStats DBCDecoder::decodeCacheStats() const
+{
+    DecodeCacheStats stats;
+    stats.hits = m_decodeCacheHits;
+    stats.misses = m_decodeCacheMisses;
+    stats.entries = int(m_decodeCache.size());
+    stats.capacity = int(m_decodeCache.maxCost());
+    return stats;
+}
+
+void DBCDecoder::setDecodeCacheCapacity(int entries)
+{
+    m_decodeCache.setMaxCost(qMax(1, entries));
+}
+
+void DBCDecoder::clearDecodeCache()
+{
+    m_decodeCache.clear();
+}
+
+DecodedMessage DBCDecoder::decodeMessageUncached(const tN2kMsg& msg)
+{
+    DecodedMessage decoded;
+    decoded.isDecoded = false;
+
+    const DBCDatabase::DispatchEntry* entry = m_database->dispatch(msg.PGN);
+    if (!entry || (!entry->customDecoder && !entry->hasPlan)) {
+        return decoded;
+    }
+
+    // Check if we have a custom decoder for this PGN
+    if (entry->customDecoder) {
+        return entry->customDecoder(this, msg);
+    }
+
+    // Fall back to DBC-based decoding if no custom decoder exists
+    const DBCDatabase::MessagePlan& plan = entry->plan;
+    decoded.messageName = plan.name;
+    decoded.description = plan.description;
+    decoded.isDecoded = true;
+    decoded.signalList.reserve(plan.signalPlans.size());
+
+    // Decode each signal from one load of the frame
+    const quint64 frame = DBCSignalLayout::frameWord(msg.Data, msg.DataLen);
+    for (const DBCDatabase::SignalPlan& signalPlan : plan.signalPlans) {
+        DecodedSignal decodedSignal;
+        decodedSignal.name = signalPlan.name;
+        decodedSignal.unit = signalPlan.unit;
+        decodedSignal.description = signalPlan.description;
 
+        double rawValue = 0.0;
+        double scaledValue = 0.0;
+        decodedSignal.isValid = signalPlan.layout.value(frame, rawValue, scaledValue);
+
+        if (decodedSignal.isValid) {
             // Check for enumerated values
-            if (!signal.valueDescriptions.isEmpty() && signal.valueDescriptions.contains((int)rawValue)) {
-                decodedSignal.value = signal.valueDescriptions[(int)rawValue];
+            auto description = signalPlan.valueDescriptions.constFind(int(rawValue));
+            if (description != signalPlan.valueDescriptions.constEnd()) {
+                decodedSignal.value = description.value();
             } else {
                 decodedSignal.value = scaledValue;
             }
         } else {
-            decodedSignal.value = "N/A";
+            decodedSignal.value = QStringLiteral("N/A");
         }
 
         decoded.signalList.append(decodedSignal);
@@ -342,97 +653,149 @@ DecodedMessage DBCDecoder::decodeMessage(const tN2kMsg& msg)
     return decoded;
 }
 
-double DBCDecoder::extractSignalValue(const uint8_t* data, const DBCSignal& signal)
+bool DBCDecoder::signalValue(const DBCSignal& signal, const uint8_t* data, int len, double& rawValue, double& value)
 {
-    uint64_t rawValue = 0;
-    
-    // Simple byte-aligned extraction for most NMEA2000 signals
-    if (signal.startBit % 8 == 0 && signal.bitLength % 8 == 0) {
-        // Byte-aligned signal
-        int startByte = signal.startBit / 8;
-        int numBytes = signal.bitLength / 8;
-        
-        for (int i = 0; i < numBytes && (startByte + i) < 8; i++) {
-            rawValue |= ((uint64_t)data[startByte + i]) << (i * 8);
-        }
-    } else {
-        // Bit-level extraction for non-byte-aligned signals
-        int startByte = signal.startBit / 8;
-        int startBitInByte = signal.startBit % 8;
-        int remainingBits = signal.bitLength;
-        int bitPosition = 0;
-        
-        for (int i = startByte; i < 8 && remainingBits > 0; i++) {
-            int bitsToRead = qMin(8 - (i == startByte ? startBitInByte : 0), remainingBits);
-            int shift = i == startByte ? startBitInByte : 0;
-            uint8_t mask = ((1 << bitsToRead) - 1);
-            uint8_t maskedByte = (data[i] >> shift) & mask;
-            
-            rawValue |= ((uint64_t)maskedByte) << bitPosition;
-            bitPosition += bitsToRead;
-            remainingBits -= bitsToRead;
+    return DBCSignalLayout::compile(signal).value(DBCSignalLayout::frameWord(data, len), rawValue, value);
+}
+
+DBCSignalLayout DBCSignalLayout::compile(const DBCSignal& signal)
+{
+    DBCSignalLayout layout;
+    
+    // Bits past the 8-byte frame read as zero; a signal starting past it has no value bits
+    if (signal.startBit >= 0 && signal.startBit < 64 && signal.bitLength > 0) {
+        layout.shift = signal.startBit;
+        layout.mask = signal.bitLength >= 64 ? ~0ULL : (1ULL << signal.bitLength) - 1;
+        if (signal.isSigned && signal.bitLength < 64) {
+            layout.signBit = 1ULL << (signal.bitLength - 1);
         }
     }
     
-    // Handle signed values
-    if (signal.isSigned && signal.bitLength < 64) {
-        uint64_t signBit = 1ULL << (signal.bitLength - 1);
-        if (rawValue & signBit) {
-            // Sign extend
-            uint64_t mask = ~((1ULL << signal.bitLength) - 1);
-            rawValue |= mask;
-        }
+    layout.scale = signal.scale;
+    layout.offset = signal.offset;
+    
+    // NMEA2000 "not available" values
+    layout.hasNotAvailable = true;
+    switch (signal.bitLength) {
+    case 8:  layout.notAvailable = 250.0; break;
+    case 16: layout.notAvailable = 65530.0; break;
+    case 32: layout.notAvailable = 4294967290.0; break;
+    default: layout.hasNotAvailable = false; break;
     }
     
-    return (double)rawValue;
+    // Temperatures in 0.01K units are shown in Celsius
+    layout.kelvinToCelsius = signal.unit == "°C";
+    return layout;
+}
+
+quint64 DBCSignalLayout::frameWord(const uint8_t* data, int len)
+{
+    uint8_t frame[8] = {};
+    if (len > 0) {
+        memcpy(frame, data, qMin(len, 8));
+    }
+    return qFromLittleEndian<quint64>(frame);
 }
 
-bool DBCDecoder::isSignalValid(double rawValue, const DBCSignal& signal)
+bool DBCSignalLayout::value(quint64 frame, double& rawValue, double& value) const
 {
-    // Check for NMEA2000 "not available" values
-    if (signal.bitLength == 8 && rawValue >= 250) return false;
-    if (signal.bitLength == 16 && rawValue >= 65530) return false;
-    if (signal.bitLength == 32 && rawValue >= 4294967290ULL) return false;
+    quint64 raw = (frame >> shift) & mask;
+    if (raw & signBit) {
+        raw |= ~mask;  // Sign extend
+    }
     
+    rawValue = double(raw);
+    if (hasNotAvailable && rawValue >= notAvailable) {
+        return false;
+    }
+    
+    value = rawValue * scale + offset;
+    if (kelvinToCelsius && value > 100) {
+        // Assume raw value is in 0.01K units, convert to Celsius
+        value = (rawValue * 0.01) - 273.15;
+    }
     return true;
 }
 
-bool DBCDecoder::canDecode(unsigned long pgn) const
+QStringList DBCDatabase::getSignalNames(unsigned long pgn) const
 {
-    // Check if we have a custom decoder for this PGN
-    if (m_customDecoders.contains(pgn)) {
-        return true;
+    QStringList names;
+    if (m_customDecoders.contains(pgn) || !m_messages.contains(pgn)) {
+        return names;
     }
-    
-    // Check if we have a DBC definition for this PGN
-    return m_messages.contains(pgn);
+    const DBCMessage message = m_messages.value(pgn);
+    for (const DBCSignal& signal : message.signalList) {
+        names.append(signal.name);
+    }
+    return names;
 }
 
-QString DBCDecoder::getMessageName(unsigned long pgn) const
+QList<QPair<unsigned long, DBCSignal>> DBCDatabase::findSignals(const QString& name) const
 {
-    // First check if we have a custom decoder with a name for this PGN
-    if (m_customDecoders.contains(pgn)) {
-        return m_customDecoders[pgn].name;
+    auto normalized = [](QString text) {
+        return text.remove(QChar('_')).remove(QChar(' ')).toLower();
+    };
+    const QString wanted = normalized(name);
+
+    QList<QPair<unsigned long, DBCSignal>> found;
+    for (auto it = m_messages.constBegin(); it != m_messages.constEnd(); ++it) {
+        for (const DBCSignal& signal : it.value().signalList) {
+            if (normalized(signal.name) == wanted) {
+                found.append(qMakePair(it.key(), signal));
+                break;
+            }
+        }
     }
-    
-    // Fall back to DBC message names
-    if (m_messages.contains(pgn)) {
-        return m_messages[pgn].name;
+    return found;
+}
+
+bool DBCDatabase::canDecode(unsigned long pgn) const
+{
+    const DispatchEntry* entry = dispatch(pgn);
+    return entry && (entry->customDecoder || entry->hasPlan);
+}
+
+QString DBCDatabase::getMessageName(unsigned long pgn) const
+{
+    // Custom decoder names take precedence over DBC message names; proprietary PGNs have their own entries
+    const DispatchEntry* entry = dispatch(pgn);
+    if (entry) {
+        return entry->name;
     }
-    
-    // Check if this is a proprietary PGN
-    if ((pgn >= 65280 && pgn <= 65535) ||          // 0xFF00-0xFFFF: Single-frame proprietary
-        (pgn >= 126720 && pgn <= 126975) ||        // 0x1EF00-0x1EFFF: Multi-frame proprietary
-        (pgn >= 127744 && pgn <= 128511)) {         // 0x1F300-0x1F5FF: Additional proprietary
-        return QString("Proprietary %1").arg(pgn);
+    return QString("PGN %1").arg(pgn);
+}
+
+QString DBCDatabase::getCleanMessageName(unsigned long pgn) const
+{
+    // Names are built once per load, so this only hands out a shared string
+    const DispatchEntry* entry = dispatch(pgn);
+    if (entry) {
+        return entry->cleanName;
     }
     
-    return QString("PGN %1").arg(pgn);
+    // Unknown PGNs are formatted the first time they are seen
+    QMutexLocker locker(&m_unknownNamesMutex);
+    auto it = m_unknownCleanNames.constFind(quint32(pgn));
+    if (it != m_unknownCleanNames.constEnd()) {
+        return it.value();
+    }
+    const QString name = cleanMessageName(getMessageName(pgn), pgn);
+    if (m_unknownCleanNames.size() < MAX_UNKNOWN_NAMES) {
+        m_unknownCleanNames.insert(quint32(pgn), name);
+    }
+    return name;
 }
 
-QString DBCDecoder::getCleanMessageName(unsigned long pgn) const
+bool DBCDatabase::isProprietaryPGN(unsigned long pgn)
 {
-    QString name = getMessageName(pgn);
+    return (pgn >= 65280 && pgn <= 65535) ||          // 0xFF00-0xFFFF: Single-frame proprietary
+           (pgn >= 126720 && pgn <= 126975) ||        // 0x1EF00-0x1EFFF: Multi-frame proprietary
+           (pgn >= 127744 && pgn <= 128511);          // 0x1F300-0x1F5FF: Additional proprietary
+}
+
+QString DBCDatabase::cleanMessageName(const QString& messageName, unsigned long pgn)
+{
+    QString name = messageName;
     
     // Enhanced formatting inspired by cantools experience
     
@@ -466,48 +829,71 @@ QString DBCDecoder::getCleanMessageName(unsigned long pgn) const
     return name;
 }
 
+bool DBCDecoder::canDecode(unsigned long pgn) const
+{
+    return m_database->canDecode(pgn);
+}
+
+QString DBCDecoder::getMessageName(unsigned long pgn) const
+{
+    return m_database->getMessageName(pgn);
+}
+
+QString DBCDecoder::getCleanMessageName(unsigned long pgn) const
+{
+    return m_database->getCleanMessageName(pgn);
+}
+
+QStringList DBCDecoder::getSignalNames(unsigned long pgn) const
+{
+    return m_database->getSignalNames(pgn);
+}
+
+QList<QPair<unsigned long, DBCSignal>> DBCDecoder::findSignals(const QString& name) const
+{
+    return m_database->findSignals(name);
+}
+
+QList<unsigned long> DBCDecoder::getCustomDecoderPGNs() const
+{
+    return m_database->getCustomDecoderPGNs();
+}
+
+bool DBCDecoder::hasCustomDecoder(unsigned long pgn) const
+{
+    return m_database->hasCustomDecoder(pgn);
+}
+
 QString DBCDecoder::getFormattedDecoded(const tN2kMsg& msg)
 {
-    DecodedMessage decoded = decodeMessage(msg);
-    
-    if (!decoded.isDecoded) {
-        return "Raw data";
-    }
-    
-    QStringList parts;
-    for (const DecodedSignal& signal : decoded.signalList) {
-        if (signal.isValid && signal.value.toString() != "N/A") {
-            QString part = QString("%1: %2").arg(signal.name);
-            
-            if (signal.value.typeId() == QMetaType::Double) {
-                part = part.arg(signal.value.toDouble(), 0, 'f', 2);
-            } else {
-                part = part.arg(signal.value.toString());
-            }
-            
-            if (!signal.unit.isEmpty()) {
-                part += " " + signal.unit;
-            }
-            
-            parts.append(part);
-        }
+    DecodeCacheEntry* entry = cachedDecode(msg);
+    if (!entry->hasFormatted) {
+        entry->formatted = formatDecoded(entry->decoded, false);
+        entry->hasFormatted = true;
     }
-    
-    return parts.join(", ");
+    return entry->formatted;
 }
 
 QString DBCDecoder::getFormattedDecodedForSave(const tN2kMsg& msg)
 {
-    DecodedMessage decoded = decodeMessage(msg);
-    
+    DecodeCacheEntry* entry = cachedDecode(msg);
+    if (!entry->hasFormattedForSave) {
+        // Skip reserved fields when saving
+        entry->formattedForSave = formatDecoded(entry->decoded, true);
+        entry->hasFormattedForSave = true;
+    }
+    return entry->formattedForSave;
+}
+
+QString DBCDecoder::formatDecoded(const DecodedMessage& decoded, bool skipReserved)
+{
     if (!decoded.isDecoded) {
         return "Raw data";
     }
     
     QStringList parts;
     for (const DecodedSignal& signal : decoded.signalList) {
-        // Skip reserved fields when saving
-        if (signal.name.contains("Reserved", Qt::CaseInsensitive)) {
+        if (skipReserved && signal.name.contains("Reserved", Qt::CaseInsensitive)) {
             continue;
         }
         
@@ -534,19 +920,26 @@ QString DBCDecoder::getFormattedDecodedForSave(const tN2kMsg& msg)
 bool DBCDecoder::isInitialized() const
 {
     // Decoder is considered initialized if we have message definitions loaded
-    return m_messages.count() > 0;
+    return !m_database->messages().isEmpty();
 }
 
 QString DBCDecoder::getDecoderInfo() const
 {
+    const QMap<unsigned long, DBCMessage>& messages = m_database->messages();
     QString info = QString("DBC Decoder Status:\n");
-    info += QString("- Messages loaded: %1\n").arg(m_messages.count());
+    info += QString("- Messages loaded: %1\n").arg(messages.count());
     info += QString("- Decoder type: Original/Fast C++\n");
     
-    if (m_messages.count() > 0) {
+    DecodeCacheStats cacheStats = decodeCacheStats();
+    info += QString("- Decode cache: %1/%2 entries, %3% hit rate (%4 hits, %5 misses)\n")
+            .arg(cacheStats.entries).arg(cacheStats.capacity)
+            .arg(cacheStats.hitRate() * 100.0, 0, 'f', 1)
+            .arg(cacheStats.hits).arg(cacheStats.misses);
+    
+    if (messages.count() > 0) {
         QStringList samplePGNs;
-        auto it = m_messages.constBegin();
-        for (int i = 0; i < qMin(5, m_messages.count()) && it != m_messages.constEnd(); ++it, ++i) {
+        auto it = messages.constBegin();
+        for (int i = 0; i < qMin(5, int(messages.count())) && it != messages.constEnd(); ++it, ++i) {
             samplePGNs.append(QString("%1 (%2)").arg(it.value().name).arg(it.key()));
         }
         info += QString("- Sample messages: %1\n").arg(samplePGNs.join(", "));
@@ -555,14 +948,15 @@ QString DBCDecoder::getDecoderInfo() const
     return info;
 }
 
-QList<unsigned long> DBCDecoder::getCustomDecoderPGNs() const
+QList<unsigned long> DBCDatabase::getCustomDecoderPGNs() const
 {
     return m_customDecoders.keys();
 }
 
-bool DBCDecoder::hasCustomDecoder(unsigned long pgn) const
+bool DBCDatabase::hasCustomDecoder(unsigned long pgn) const
 {
-    return m_customDecoders.contains(pgn);
+    const DispatchEntry* entry = dispatch(pgn);
+    return entry && bool(entry->customDecoder);
 }
 
 QString DBCDecoder::formatSignalValue(const DecodedSignal& signal)
@@ -584,12 +978,11 @@ QString DBCDecoder::decodePGN(const tN2kMsg& msg)
     QString decoded;
     
     // First try to find in loaded DBC messages
-    for (const DBCMessage& message : m_messages) {
-        if (message.pgn == pgn) {
-            DecodedMessage decodedMsg = decodeMessage(msg);
-            if (!decodedMsg.messageName.isEmpty()) {
-                return getFormattedDecoded(msg);
-            }
+    const DBCDatabase::DispatchEntry* entry = m_database->dispatch(pgn);
+    if (entry && entry->hasPlan) {
+        DecodedMessage decodedMsg = decodeMessage(msg);
+        if (!decodedMsg.messageName.isEmpty()) {
+            return getFormattedDecoded(msg);
         }
     }
     
@@ -601,7 +994,7 @@ QString DBCDecoder::decodePGN(const tN2kMsg& msg)
     return decoded;
 }
 
-void DBCDecoder::initializeCustomDecoders()
+void DBCDatabase::initializeCustomDecoders()
 {
     // Initialize the custom decoder lookup table with PGN number, name, and decoder function
     // This makes it easy to add new custom decoders and maintain them in one place
@@ -2174,7 +2567,7 @@ DecodedMessage DBCDecoder::decodePGN126998(const tN2kMsg& msg)
     return decoded;
 }
 
-QString DBCDecoder::getFieldName(unsigned long pgn, uint8_t fieldNumber) const
+QString DBCDecoder::getFieldName(unsigned long pgn, uint8_t fieldNumber)
 {
     switch (pgn) {
         case 130561: // Zone Lighting Control
@@ -2327,88 +2720,88 @@ QString DBCDecoder::getFieldName(unsigned long pgn, uint8_t fieldNumber) const
 QString DBCDecoder::getPGNDescription(uint32_t pgn)
 {
     // Common NMEA2000 PGN descriptions
-    static QMap<uint32_t, QString> pgnDescriptions;
-    
-    // Initialize the map if it's empty
-    if (pgnDescriptions.isEmpty()) {
+    // Built once - function statics are initialized thread-safely
+    static const QMap<uint32_t, QString> pgnDescriptions = [] {
+        QMap<uint32_t, QString> names;
         // System PGNs
-        pgnDescriptions[59392] = "ISO Acknowledgement";
-        pgnDescriptions[59904] = "ISO Request";
-        pgnDescriptions[60416] = "ISO Transport Protocol - Data Transfer";
-        pgnDescriptions[60160] = "ISO Transport Protocol - Connection Management";
+        names[59392] = "ISO Acknowledgement";
+        names[59904] = "ISO Request";
+        names[60416] = "ISO Transport Protocol - Data Transfer";
+        names[60160] = "ISO Transport Protocol - Connection Management";
         
         // Standard NMEA2000 PGNs
-        pgnDescriptions[126208] = "Group Function";
-        pgnDescriptions[126464] = "PGN List";
-        pgnDescriptions[126992] = "System Time";
-        pgnDescriptions[126993] = "Heartbeat";
-        pgnDescriptions[126996] = "Product Information";
-        pgnDescriptions[126998] = "Configuration Information";
+        names[126208] = "Group Function";
+        names[126464] = "PGN List";
+        names[126992] = "System Time";
+        names[126993] = "Heartbeat";
+        names[126996] = "Product Information";
+        names[126998] = "Configuration Information";
         
         // Navigation PGNs
-        pgnDescriptions[127245] = "Rudder";
-        pgnDescriptions[127250] = "Vessel Heading";
-        pgnDescriptions[127251] = "Rate of Turn";
-        pgnDescriptions[127257] = "Attitude";
-        pgnDescriptions[127258] = "Magnetic Variation";
-        pgnDescriptions[129025] = "Position (Rapid Update)";
-        pgnDescriptions[129026] = "COG & SOG (Rapid Update)";
-        pgnDescriptions[129029] = "GNSS Position Data";
-        pgnDescriptions[129033] = "Time & Date";
-        pgnDescriptions[129283] = "Cross Track Error";
-        pgnDescriptions[129284] = "Navigation Data";
-        pgnDescriptions[129285] = "Navigation Route/WP Information";
+        names[127245] = "Rudder";
+        names[127250] = "Vessel Heading";
+        names[127251] = "Rate of Turn";
+        names[127257] = "Attitude";
+        names[127258] = "Magnetic Variation";
+        names[129025] = "Position (Rapid Update)";
+        names[129026] = "COG & SOG (Rapid Update)";
+        names[129029] = "GNSS Position Data";
+        names[129033] = "Time & Date";
+        names[129283] = "Cross Track Error";
+        names[129284] = "Navigation Data";
+        names[129285] = "Navigation Route/WP Information";
         
         // Engine PGNs
-        pgnDescriptions[127488] = "Engine Parameters (Rapid Update)";
-        pgnDescriptions[127489] = "Engine Parameters (Dynamic)";
-        pgnDescriptions[127493] = "Transmission Parameters (Dynamic)";
-        pgnDescriptions[127497] = "Trip Parameters (Engine)";
-        pgnDescriptions[127498] = "Trip Parameters (Vessel)";
-        pgnDescriptions[127500] = "Load Controller Connection State/Control";
-        pgnDescriptions[127501] = "Binary Switch Bank Status";
-        pgnDescriptions[127502] = "Switch Bank Control";
-        pgnDescriptions[127503] = "AC Input Status";
-        pgnDescriptions[127504] = "AC Output Status";
-        pgnDescriptions[127505] = "Fluid Level";
-        pgnDescriptions[127506] = "DC Detailed Status";
-        pgnDescriptions[127507] = "Charger Status";
-        pgnDescriptions[127508] = "Battery Status";
-        pgnDescriptions[127509] = "Inverter Status";
+        names[127488] = "Engine Parameters (Rapid Update)";
+        names[127489] = "Engine Parameters (Dynamic)";
+        names[127493] = "Transmission Parameters (Dynamic)";
+        names[127497] = "Trip Parameters (Engine)";
+        names[127498] = "Trip Parameters (Vessel)";
+        names[127500] = "Load Controller Connection State/Control";
+        names[127501] = "Binary Switch Bank Status";
+        names[127502] = "Switch Bank Control";
+        names[127503] = "AC Input Status";
+        names[127504] = "AC Output Status";
+        names[127505] = "Fluid Level";
+        names[127506] = "DC Detailed Status";
+        names[127507] = "Charger Status";
+        names[127508] = "Battery Status";
+        names[127509] = "Inverter Status";
         
         // Environmental PGNs
-        pgnDescriptions[128259] = "Speed (Water Referenced)";
-        pgnDescriptions[128267] = "Water Depth";
-        pgnDescriptions[128275] = "Distance Log";
-        pgnDescriptions[130306] = "Wind Data";
-        pgnDescriptions[130310] = "Environmental Parameters";
-        pgnDescriptions[130311] = "Environmental Parameters";
-        pgnDescriptions[130312] = "Temperature";
-        pgnDescriptions[130313] = "Humidity";
-        pgnDescriptions[130314] = "Actual Pressure";
-        pgnDescriptions[130316] = "Temperature (Extended Range)";
+        names[128259] = "Speed (Water Referenced)";
+        names[128267] = "Water Depth";
+        names[128275] = "Distance Log";
+        names[130306] = "Wind Data";
+        names[130310] = "Environmental Parameters";
+        names[130311] = "Environmental Parameters";
+        names[130312] = "Temperature";
+        names[130313] = "Humidity";
+        names[130314] = "Actual Pressure";
+        names[130316] = "Temperature (Extended Range)";
         
         // Lighting PGNs (Lumitec specific)
-        pgnDescriptions[130330] = "Lighting System Settings";
-        pgnDescriptions[130561] = "Zone Lighting Control";
-        pgnDescriptions[130562] = "Lighting Scene";
-        pgnDescriptions[130563] = "Lighting Device";
-        pgnDescriptions[130564] = "Lighting Device Enumeration";
-        pgnDescriptions[130565] = "Lighting Color Sequence";
-        pgnDescriptions[130566] = "Lighting Program";
+        names[130330] = "Lighting System Settings";
+        names[130561] = "Zone Lighting Control";
+        names[130562] = "Lighting Scene";
+        names[130563] = "Lighting Device";
+        names[130564] = "Lighting Device Enumeration";
+        names[130565] = "Lighting Color Sequence";
+        names[130566] = "Lighting Program";
         
         // AIS PGNs
-        pgnDescriptions[129038] = "AIS Class A Position Report";
-        pgnDescriptions[129039] = "AIS Class B Position Report";
-        pgnDescriptions[129040] = "AIS Class B Extended Position Report";
-        pgnDescriptions[129041] = "AIS Aids to Navigation (AtoN) Report";
-        pgnDescriptions[129793] = "AIS UTC and Date Report";
-        pgnDescriptions[129794] = "AIS Class A Static and Voyage Related Data";
-        pgnDescriptions[129798] = "AIS SAR Aircraft Position Report";
-        pgnDescriptions[129802] = "AIS Safety Related Broadcast Message";
-        pgnDescriptions[129809] = "AIS Class B Static Data (Part A)";
-        pgnDescriptions[129810] = "AIS Class B Static Data (Part B)";
-    }
+        names[129038] = "AIS Class A Position Report";
+        names[129039] = "AIS Class B Position Report";
+        names[129040] = "AIS Class B Extended Position Report";
+        names[129041] = "AIS Aids to Navigation (AtoN) Report";
+        names[129793] = "AIS UTC and Date Report";
+        names[129794] = "AIS Class A Static and Voyage Related Data";
+        names[129798] = "AIS SAR Aircraft Position Report";
+        names[129802] = "AIS Safety Related Broadcast Message";
+        names[129809] = "AIS Class B Static Data (Part A)";
+        names[129810] = "AIS Class B Static Data (Part B)";
+        return names;
+    }();
     
     // Look up the PGN description
     if (pgnDescriptions.contains(pgn)) {
@@ -2601,50 +2994,50 @@ int DBCDecoder::getFieldSize(unsigned long pgn, uint8_t fieldNumber) const
 QString DBCDecoder::decodeManufacturerCode(uint16_t manufacturerCode)
 {
     // NMEA2000 Manufacturer Codes
-    // Based on NMEA 2000 Registration List
-    static QMap<uint16_t, QString> manufacturerNames;
-    
-    if (manufacturerNames.isEmpty()) {
+    // Based on NMEA 2000 Registration List, built on first use
+    static const QMap<uint16_t, QString> manufacturerNames = [] {
+        QMap<uint16_t, QString> names;
         // Initialize manufacturer code mapping
-        manufacturerNames[126] = "Furuno";
-        manufacturerNames[130] = "Raymarine";
-        manufacturerNames[135] = "Airmar";
-        manufacturerNames[137] = "Maretron";
-        manufacturerNames[140] = "Lowrance";
-        manufacturerNames[144] = "Furuno";
-        manufacturerNames[147] = "Garmin";
-        manufacturerNames[154] = "Navico";
-        manufacturerNames[161] = "Raymarine";
-        manufacturerNames[163] = "Maretron";
-        manufacturerNames[165] = "B&G";
-        manufacturerNames[168] = "Garmin";
-        manufacturerNames[174] = "Yacht Devices";
-        manufacturerNames[176] = "Carling Technologies";
-        manufacturerNames[194] = "Simrad";
-        manufacturerNames[199] = "Victron Energy";
-        manufacturerNames[215] = "Digital Yacht";
-        manufacturerNames[229] = "Lumitec";
-        manufacturerNames[273] = "Navionics";
-        manufacturerNames[275] = "McMurdo";
-        manufacturerNames[304] = "EmpirBus";
-        manufacturerNames[355] = "Blue Water Data";
-        manufacturerNames[358] = "Victron";
-        manufacturerNames[381] = "Rose Point Navigation";
-        manufacturerNames[419] = "Fusion Electronics";
-        manufacturerNames[437] = "Chetco Digital Instruments";
-        manufacturerNames[493] = "Ocean Signal";
-        manufacturerNames[504] = "Vesper";
-        manufacturerNames[517] = "Sea Recovery";
-        manufacturerNames[573] = "Yacht Monitoring Solutions";
-        manufacturerNames[580] = "Siren Marine";
-        manufacturerNames[591] = "NoLand Engineering";
-        manufacturerNames[658] = "Dometic";
-        manufacturerNames[1084] = "ShadowCaster";
-        manufacturerNames[1403] = "Arco";
-        manufacturerNames[1440] = "Egis Mobile";
-        manufacturerNames[1512] = "Lumitec";
-        manufacturerNames[1857] = "Simrad";
-    }
+        names[126] = "Furuno";
+        names[130] = "Raymarine";
+        names[135] = "Airmar";
+        names[137] = "Maretron";
+        names[140] = "Lowrance";
+        names[144] = "Furuno";
+        names[147] = "Garmin";
+        names[154] = "Navico";
+        names[161] = "Raymarine";
+        names[163] = "Maretron";
+        names[165] = "B&G";
+        names[168] = "Garmin";
+        names[174] = "Yacht Devices";
+        names[176] = "Carling Technologies";
+        names[194] = "Simrad";
+        names[199] = "Victron Energy";
+        names[215] = "Digital Yacht";
+        names[229] = "Lumitec";
+        names[273] = "Navionics";
+        names[275] = "McMurdo";
+        names[304] = "EmpirBus";
+        names[355] = "Blue Water Data";
+        names[358] = "Victron";
+        names[381] = "Rose Point Navigation";
+        names[419] = "Fusion Electronics";
+        names[437] = "Chetco Digital Instruments";
+        names[493] = "Ocean Signal";
+        names[504] = "Vesper";
+        names[517] = "Sea Recovery";
+        names[573] = "Yacht Monitoring Solutions";
+        names[580] = "Siren Marine";
+        names[591] = "NoLand Engineering";
+        names[658] = "Dometic";
+        names[1084] = "ShadowCaster";
+        names[1403] = "Arco";
+        names[1440] = "Egis Mobile";
+        names[1512] = "Lumitec";
+        names[1857] = "Simrad";
+        return names;
+    }();
     
     if (manufacturerNames.contains(manufacturerCode)) {
         return manufacturerNames[manufacturerCode];
@@ -5,8 +5,15 @@
 #include <QString>
 #include <QList>
 #include <QMap>
+#include <QHash>
+#include <QVector>
+#include <QPair>
 #include <QVariant>
+#include <QCache>
+#include <QMutex>
+#include <QByteArray>
 #include <functional>
+#include <memory>
 #include <N2kMsg.h>
 
 struct DBCSignal {
@@ -31,6 +38,26 @@ struct DBCMessage {
     QList<DBCSignal> signalList;
 };
 
+// Bit position, scaling and "not available" limit of a DBC signal, resolved once so that
+// reading a value is a shift, a mask and a multiply. Only uses its own fields, so it is
+// safe to use from worker threads
+struct DBCSignalLayout {
+    int shift = 0;              // Start bit within the 8-byte frame, read little-endian
+    quint64 mask = 0;           // Value bits after the shift, 0 when the signal lies outside the frame
+    quint64 signBit = 0;        // Top value bit of a signed signal, 0 otherwise
+    double scale = 1.0;
+    double offset = 0.0;
+    double notAvailable = 0.0;  // Raw values from here up mean "not available"
+    bool hasNotAvailable = false;
+    bool kelvinToCelsius = false;
+
+    static DBCSignalLayout compile(const DBCSignal& signal);
+    // The first 8 payload bytes as a little-endian word, zero padded
+    static quint64 frameWord(const uint8_t* data, int len);
+    // Scaled value as shown in decoded text; false for "not available"
+    bool value(quint64 frame, double& rawValue, double& value) const;
+};
+
 struct DecodedSignal {
     QString name;
     QString unit;
@@ -46,6 +73,143 @@ struct DecodedMessage {
     bool isDecoded;
 };
 
+// Hit/miss counters of the decode cache
+struct DecodeCacheStats {
+    quint64 hits = 0;
+    quint64 misses = 0;
+    int entries = 0;
+    int capacity = 0;
+
+    double hitRate() const { return (hits + misses) > 0 ? double(hits) / double(hits + misses) : 0.0; }
+};
+
+class DBCDecoder;
+
+/**
+ * @brief Parsed DBC messages, custom decoders and the PGN dispatch table.
+ *
+ * shared() loads the database on first use: from the binary snapshot or text
+ * of nmea2000.dbc, from the canboat repository, or from built-in fallback
+ * definitions. After that it is never modified, so every DBCDecoder in the
+ * process, on any thread, reads the same instance without locking. Only the
+ * clean names of unknown PGNs are added on first sight, behind a mutex.
+ */
+class DBCDatabase
+{
+public:
+    // Custom decoder function pointer type
+    using CustomDecoderFunction = std::function<DecodedMessage(DBCDecoder*, const tN2kMsg&)>;
+    
+    // A DBC message compiled for decoding - names, units and layouts are resolved up
+    // front, so decoding a payload is one loop over the signal plans
+    struct SignalPlan {
+        DBCSignalLayout layout;
+        QString name;           // Display name, generic "Field N" names already resolved
+        QString unit;
+        QString description;
+        QMap<int, QString> valueDescriptions;  // Shared with the definition
+    };
+    
+    struct MessagePlan {
+        QString name;
+        QString description;
+        QVector<SignalPlan> signalPlans;
+    };
+    
+    // Everything a message needs from the decoder, found with one lookup. Proprietary
+    // PGNs without a decoder get an entry too, which only carries their names
+    struct DispatchEntry {
+        quint32 pgn = 0;
+        CustomDecoderFunction customDecoder;  // Empty without a custom decoder
+        bool hasPlan = false;                 // A DBC definition exists
+        MessagePlan plan;
+        QString name;                         // getMessageName()
+        QString cleanName;                    // getCleanMessageName()
+    };
+    
+    // The process-wide database, loaded by the first caller
+    static std::shared_ptr<const DBCDatabase> shared();
+    
+    const DispatchEntry* dispatch(unsigned long pgn) const;
+    const QMap<unsigned long, DBCMessage>& messages() const { return m_messages; }
+    
+    bool canDecode(unsigned long pgn) const;
+    QString getMessageName(unsigned long pgn) const;
+    QString getCleanMessageName(unsigned long pgn) const;
+    bool hasCustomDecoder(unsigned long pgn) const;
+    QList<unsigned long> getCustomDecoderPGNs() const;
+    QStringList getSignalNames(unsigned long pgn) const;
+    QList<QPair<unsigned long, DBCSignal>> findSignals(const QString& name) const;
+
+private:
+    // builtInOnly skips the DBC file and the download
+    explicit DBCDatabase(bool builtInOnly);
+    
+    // DBC file loading
+    bool loadDBCFile(const QString& filePath);
+    bool loadDBCFromUrl(const QString& url);
+    
+    void initializeStandardNMEA2000();
+    void addMessage(const DBCMessage& message);
+    
+    // DBC file parsing
+    bool parseDBCFile(const QString& content);
+    DBCMessage parseDBCMessage(const QString& messageLines);
+    DBCSignal parseDBCSignal(const QString& signalLine);
+    void parseValueTable(const QString& line, DBCSignal& signal);
+    
+    // Binary snapshot of the parsed messages, stored next to the DBC file and keyed by
+    // the SHA-1 of its contents. A snapshot for other contents or another version is
+    // ignored and rewritten after the text parse
+    //   magic "N2KDBCSN", u32 version, hash, u32 message count, then the messages
+    //   as QDataStream (Qt 6.0) values
+    static QString snapshotPath(const QString& dbcPath);
+    static QByteArray snapshotMagic();
+    bool loadSnapshot(const QString& path, const QByteArray& dbcHash);
+    bool saveSnapshot(const QString& path, const QByteArray& dbcHash) const;
+    // Bump when DBCMessage or DBCSignal change
+    static const quint32 SNAPSHOT_VERSION = 1;
+    
+    // Custom decoder entry structure
+    struct CustomDecoderEntry {
+        unsigned long pgn;
+        QString name;
+        CustomDecoderFunction decoder;
+    };
+    
+    // Slot of the open-addressing table - entry is an index into m_dispatchEntries, -1 when free
+    struct DispatchSlot {
+        quint32 pgn;
+        int entry;
+    };
+    
+    // Initialize custom decoder lookup table
+    void initializeCustomDecoders();
+    // Build the dispatch table once all DBC messages and custom decoders are registered
+    void buildDispatchTable();
+    static MessagePlan compileMessage(const DBCMessage& message);
+    static bool isProprietaryPGN(unsigned long pgn);
+    static QString cleanMessageName(const QString& name, unsigned long pgn);
+    
+    QMap<unsigned long, DBCMessage> m_messages;
+    QMap<unsigned long, CustomDecoderEntry> m_customDecoders;
+    QVector<DispatchEntry> m_dispatchEntries;
+    QVector<DispatchSlot> m_dispatchSlots;   // Power-of-two size, at most half full, linear probing
+    quint32 m_dispatchMask;
+    
+    // Clean names of PGNs outside the table, formatted on first sight
+    mutable QMutex m_unknownNamesMutex;
+    mutable QHash<quint32, QString> m_unknownCleanNames;
+    static const int MAX_UNKNOWN_NAMES = 4096;
+};
+
+/**
+ * @brief Decodes NMEA2000 messages through the DBC definitions and custom decoders.
+ *
+ * The definitions live in the process-wide DBCDatabase, so creating a decoder
+ * costs nothing beyond its decode cache. The cache is not locked: a thread
+ * that decodes needs a decoder of its own.
+ */
 class DBCDecoder : public QObject
 {
     Q_OBJECT
@@ -54,9 +218,7 @@ public:
     explicit DBCDecoder(QObject *parent = nullptr);
     ~DBCDecoder();
 
-    // DBC file loading
-    bool loadDBCFile(const QString& filePath);
-    bool loadDBCFromUrl(const QString& url);
+    const std::shared_ptr<const DBCDatabase>& database() const { return m_database; }
     
     // Main decode function
     DecodedMessage decodeMessage(const tN2kMsg& msg);
@@ -70,6 +232,15 @@ public:
     QString getFormattedDecodedForSave(const tN2kMsg& msg);  // Format without reserved fields for saving
     QString formatSignalValue(const DecodedSignal& signal);
     
+    // Names of the DBC signals of a PGN; empty for PGNs with a custom decoder, whose fields are only known once decoded
+    QStringList getSignalNames(unsigned long pgn) const;
+    // Signal definitions whose name matches, ignoring case, spaces and underscores, keyed by PGN
+    QList<QPair<unsigned long, DBCSignal>> findSignals(const QString& name) const;
+    // Scaled value of a signal as shown in decoded text; false for "not available".
+    // Only uses its arguments, so it is safe to call from worker threads. Callers that
+    // read the same signal repeatedly should keep a DBCSignalLayout instead
+    static bool signalValue(const DBCSignal& signal, const uint8_t* data, int len, double& rawValue, double& value);
+    
     // Status functions
     int getLoadedMessageCount() const;
     QStringList getAvailablePGNs() const;
@@ -80,23 +251,17 @@ public:
     
     // Utility functions
     static QString decodeManufacturerCode(uint16_t manufacturerCode);
+    
+    // Decode cache - most traffic repeats byte-for-byte, so decoded results are memoized
+    // per (PGN, payload) in a bounded LRU cache
+    DecodeCacheStats decodeCacheStats() const;
+    void setDecodeCacheCapacity(int entries);
+    void clearDecodeCache();
+    static const int DEFAULT_DECODE_CACHE_ENTRIES = 4096;
 
 private:
-    void initializeStandardNMEA2000();
-    void addMessage(const DBCMessage& message);
-    
-    // DBC file parsing
-    bool parseDBCFile(const QString& content);
-    DBCMessage parseDBCMessage(const QString& messageLines);
-    DBCSignal parseDBCSignal(const QString& signalLine);
-    void parseValueTable(const QString& line, DBCSignal& signal);
-    
-    // Signal extraction and validation
-    double extractSignalValue(const uint8_t* data, const DBCSignal& signal);
-    bool isSignalValid(double rawValue, const DBCSignal& signal);
-    
     // Field name mapping for group functions
-    QString getFieldName(unsigned long pgn, uint8_t fieldNumber) const;
+    static QString getFieldName(unsigned long pgn, uint8_t fieldNumber);
     
     // Field size mapping for group functions
     int getFieldSize(unsigned long pgn, uint8_t fieldNumber) const;
@@ -149,21 +314,34 @@ private:
     DecodedMessage decodePGN59392(const tN2kMsg& msg);   // ISO Acknowledgment
 
 private:
-    // Custom decoder function pointer type
-    using CustomDecoderFunction = std::function<DecodedMessage(DBCDecoder*, const tN2kMsg&)>;
+    // Parsed definitions and the PGN dispatch table, shared with every other decoder
+    std::shared_ptr<const DBCDatabase> m_database;
+    friend class DBCDatabase;  // Its custom decoder table calls the decodePGN*() members
     
-    // Custom decoder entry structure
-    struct CustomDecoderEntry {
-        unsigned long pgn;
-        QString name;
-        CustomDecoderFunction decoder;
+    // Decode cache
+    struct DecodeCacheKey {
+        quint32 pgn;
+        QByteArray payload;
+        
+        bool operator==(const DecodeCacheKey& other) const { return pgn == other.pgn && payload == other.payload; }
+        friend size_t qHash(const DecodeCacheKey& key, size_t seed = 0) { return qHash(key.payload, seed ^ key.pgn); }
     };
     
-    QMap<unsigned long, DBCMessage> m_messages;
-    QMap<unsigned long, CustomDecoderEntry> m_customDecoders;
+    struct DecodeCacheEntry {
+        DecodedMessage decoded;
+        QString formatted;
+        QString formattedForSave;
+        bool hasFormatted = false;
+        bool hasFormattedForSave = false;
+    };
     
-    // Initialize custom decoder lookup table
-    void initializeCustomDecoders();
+    DecodeCacheEntry* cachedDecode(const tN2kMsg& msg);
+    DecodedMessage decodeMessageUncached(const tN2kMsg& msg);
+    static QString formatDecoded(const DecodedMessage& decoded, bool skipReserved);
+    
+    QCache<DecodeCacheKey, DecodeCacheEntry> m_decodeCache;
+    quint64 m_decodeCacheHits;
+    quint64 m_decodeCacheMisses;
 };
 
 #endif // DBCDECODER_H
@@ -8,11 +8,21 @@
 #include "directchannelcontroldialog.h"
 #include "LumitecPoco.h"
 #include "dbcdecoder.h"
+#include "n2kreceiveworker.h"
+#include "trafficstatsdialog.h"
+#include "signalplotdialog.h"
+#include "livecapture.h"
+#include "capturetrigger.h"
+#include "capturetriggerdialog.h"
+#include "capturediffdialog.h"
+#include "capturerecorder.h"
+#include "capturerecorderdialog.h"
 
 #ifdef WASM_BUILD
 #include "NMEA2000_WASM.h"
 #else
 #include "NMEA2000_SocketCAN.h"
+#include "socketcantimestamped.h"
 #endif
 
 #ifdef ENABLE_IPG100_SUPPORT
@@ -152,6 +162,19 @@ DeviceMainWindow::DeviceMainWindow(QWidget *parent)
     // Initialize the instance conflict analyzer
     m_conflictAnalyzer = new InstanceConflictAnalyzer(this);
     
+    // Shared by every PGN log window
+    m_liveCapture = new LiveCapture(this);
+    
+    m_captureTrigger = new CaptureTrigger(this);
+    m_captureTrigger->setDeviceNameResolver([this](quint8 address) {
+        return getDeviceName(address);
+    });
+    connect(m_captureTrigger, &CaptureTrigger::saveFailed, this, [this](const QString& error) {
+        ToastManager::instance()->showError(QString("Failed to save trigger segment: %1").arg(error), this);
+    });
+    
+    m_captureRecorder = new CaptureRecorder(this);
+    
     setupUI();
     setupMenuBar();
     applyTheme();
@@ -190,17 +213,34 @@ DeviceMainWindow::DeviceMainWindow(QWidget *parent)
 
 DeviceMainWindow::~DeviceMainWindow()
 {
+    // Stop the receive thread first so nothing is delivered into a half-destroyed window
+    stopReceiveWorker();
+    
     // Clean up PGN log dialogs and disconnect their signals to prevent crashes
     for (PGNLogDialog* dialog : m_pgnLogDialogs) {
         if (dialog) {
             // Disconnect the destroyed signal to prevent calling onPGNLogDialogDestroyed
             // after this object is partially destroyed
             disconnect(dialog, &QObject::destroyed, this, &DeviceMainWindow::onPGNLogDialogDestroyed);
-            dialog->deleteLater(); // Safely queue for deletion
+            // Deleted now - the dialogs are views over m_liveCapture, a child that goes first
+            delete dialog;
         }
     }
     m_pgnLogDialogs.clear();
     
+    // The dialog reads m_trafficStats, which goes away before child widgets do
+    delete m_trafficStatsDialog;
+    m_trafficStatsDialog = nullptr;
+    
+    // The trigger dialog points at m_captureTrigger, a child that goes first
+    delete m_captureTriggerDialog;
+    m_captureTriggerDialog = nullptr;
+    delete m_captureRecorderDialog;
+    m_captureRecorderDialog = nullptr;
+    
+    // Write out what is queued before the window goes
+    m_captureRecorder->stopRecording();
+    
     if (m_updateTimer) {
         m_updateTimer->stop();
     }
@@ -359,6 +399,13 @@ void DeviceMainWindow::setupMenuBar()
     QMenu* toolsMenu = menuBar->addMenu("&Tools");
     toolsMenu->addAction("&Send PGN...", this, &DeviceMainWindow::showSendPGNDialog);
     toolsMenu->addAction("Show PGN &Log", this, &DeviceMainWindow::showPGNLog);
+    toolsMenu->addAction("&Traffic Statistics...", this, &DeviceMainWindow::showTrafficStatistics);
+    toolsMenu->addAction("Signal &Plot...", this, &DeviceMainWindow::showSignalPlot);
+    toolsMenu->addAction("Capture T&riggers...", this, &DeviceMainWindow::showCaptureTriggers);
+    toolsMenu->addAction("&Compare Captures...", this, &DeviceMainWindow::showCaptureDiff);
+#ifndef WASM_BUILD
+    toolsMenu->addAction("&Long-Term Recording...", this, &DeviceMainWindow::showCaptureRecorder);
+#endif
     toolsMenu->addSeparator();
     toolsMenu->addAction("&Request Info from All Devices", this, &DeviceMainWindow::requestInfoFromAllDevices);
     toolsMenu->addSeparator();
@@ -401,6 +448,8 @@ void DeviceMainWindow::initNMEA2000()
     m_knownDevices.clear();
     m_interfaceStartTime = QDateTime::currentDateTime();
     
+    stopReceiveWorker();
+    
     if (nmea2000 != nullptr) {
         delete nmea2000;
         nmea2000 = nullptr;
@@ -441,7 +490,7 @@ void DeviceMainWindow::initNMEA2000()
         nmea2000 = new tNMEA2000_WASM(can_interface);
 #else
         qDebug() << "Creating SocketCAN interface for:" << can_interface;
-        nmea2000 = new tNMEA2000_SocketCAN(can_interface);
+        nmea2000 = new tNMEA2000_SocketCANTimestamped(can_interface);
 #endif
     }
     
@@ -503,7 +552,7 @@ void DeviceMainWindow::initNMEA2000()
     
     nmea2000->SetMode(tNMEA2000::N2km_ListenAndNode, 22);
     nmea2000->EnableForward(false);
-    nmea2000->SetMsgHandler(staticN2kMsgHandler);
+    nmea2000->SetMsgHandler(staticN2kMsgHandler);  // Replaced by the receive worker's handler on native builds
     nmea2000->Open();
     
     // NOW create device list after NMEA2000 is open and initialized
@@ -521,7 +570,14 @@ void DeviceMainWindow::initNMEA2000()
     // This helps trigger responses from all devices on the network
     QTimer::singleShot(2000, this, &DeviceMainWindow::sendInitialBroadcastRequest);
     
-    startTimer(100); // Start timer event for regular NMEA2000 processing
+#ifdef WASM_BUILD
+    // No threads in the browser - poll from the GUI thread instead
+    if (m_parseTimerId == 0) {
+        m_parseTimerId = startTimer(100); // Start timer event for regular NMEA2000 processing
+    }
+#else
+    startReceiveWorker();
+#endif
 }
 
 void DeviceMainWindow::timerEvent(QTimerEvent *event)
@@ -532,15 +588,68 @@ void DeviceMainWindow::timerEvent(QTimerEvent *event)
     }
 }
 
+void DeviceMainWindow::startReceiveWorker()
+{
+    stopReceiveWorker();
+    
+    m_receiveWorker = new N2kReceiveWorker(nmea2000, this);
+    connect(m_receiveWorker, &N2kReceiveWorker::messagesAvailable,
+            this, &DeviceMainWindow::processReceivedMessages, Qt::QueuedConnection);
+    m_receiveWorker->start(QThread::HighPriority);
+}
+
+void DeviceMainWindow::stopReceiveWorker()
+{
+    if (!m_receiveWorker) {
+        return;
+    }
+    
+    // Anything still queued belongs to the bus being torn down and is discarded
+    m_receiveWorker->stop();
+    delete m_receiveWorker;
+    m_receiveWorker = nullptr;
+}
+
+void DeviceMainWindow::processReceivedMessages()
+{
+    if (!m_receiveWorker) {
+        return;
+    }
+    
+    // Re-arm the worker's notification before draining so nothing is missed
+    m_receiveWorker->acknowledgeNotification();
+    
+    int backlog = m_receiveWorker->stats().queueDepth;
+    m_peakDrainBacklog = qMax(m_peakDrainBacklog, backlog);
+    
+    // Drain in bounded batches so a burst can't starve the event loop
+    N2kReceivedMessage received;
+    int processed = 0;
+    while (processed < RX_DRAIN_BATCH_SIZE && m_receiveWorker->popMessage(received)) {
+        handleN2kMsg(received.msg, received.timestamp);
+        processed++;
+    }
+    m_drainedMessages += processed;
+    if (processed > 0) {
+        m_drainBatches++;
+    }
+    
+    // More waiting - yield to the event loop and come back for the rest
+    if (processed == RX_DRAIN_BATCH_SIZE) {
+        QTimer::singleShot(0, this, &DeviceMainWindow::processReceivedMessages);
+    }
+}
+
 void DeviceMainWindow::staticN2kMsgHandler(const tN2kMsg &msg) {
     if (instance) {
-        instance->handleN2kMsg(msg);
+        instance->handleN2kMsg(msg, N2kTimestamp::now());
     }
 }
 
-void DeviceMainWindow::handleN2kMsg(const tN2kMsg& msg) {
+void DeviceMainWindow::handleN2kMsg(const tN2kMsg& msg, const N2kTimestamp& timestamp) {
     // Let the device list handle the message first to update device information
     if (m_deviceList) {
+        N2kBusLocker busLock(N2kReceiveWorker::busMutex());
         m_deviceList->HandleMsg(msg);
     }
     
@@ -549,6 +658,7 @@ void DeviceMainWindow::handleN2kMsg(const tN2kMsg& msg) {
     
     // Track received bytes for bandwidth calculation
     trackReceivedBytes(msg.DataLen);
+    m_trafficStats.add(msg, timestamp);
     
     // Track traffic for automatic device discovery
     m_messagesReceived++;
@@ -599,11 +709,16 @@ void DeviceMainWindow::handleN2kMsg(const tN2kMsg& msg) {
         handleGroupFunctionMessage(msg);
     }
 
-    // Forward to all PGN log dialogs
-    for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-        if (dialog && dialog->isVisible()) {
-            dialog->appendMessage(msg);
-        }
+    // Captured once for all PGN log windows, while one of them is following live traffic
+    if (isPgnLogCapturing()) {
+        m_liveCapture->append(msg, timestamp);
+    }
+    
+    m_captureTrigger->append(msg, timestamp);
+    m_captureRecorder->append(msg, timestamp);
+    
+    if (m_signalPlotDialog && m_signalPlotDialog->isVisible()) {
+        m_signalPlotDialog->appendMessage(msg, timestamp);
     }
 }
 
@@ -701,6 +816,8 @@ void DeviceMainWindow::reinitializeNMEA2000()
 {
     qDebug() << "reinitializeNMEA2000() called";
     
+    stopReceiveWorker();
+    
     if (nmea2000 != nullptr) {
         qDebug() << "Deleting existing NMEA2000 instance";
         delete nmea2000;
@@ -869,6 +986,61 @@ void DeviceMainWindow::updateDeviceList()
     populateDeviceTable();
 }
 
+QList<DeviceMainWindow::DeviceTableEntry> DeviceMainWindow::snapshotDeviceList(uint8_t localSource)
+{
+    // The device list is updated from the receive thread - hold the bus lock while reading it
+    N2kBusLocker busLock(N2kReceiveWorker::busMutex());
+    
+    // Create a local device entry if it doesn't exist in the device list
+    const tNMEA2000::tDevice* localDevice = m_deviceList->FindDeviceBySource(localSource);
+    if (!localDevice) {
+        qDebug() << "Adding local device to device list with source:" << QString("0x%1").arg(localSource, 2, 16, QChar('0')).toUpper();
+        // Force add the local device to the device list by creating a fake address claim message
+        tN2kMsg addressClaimMsg;
+        uint32_t uniqueNumber = 12345; // Match our device info
+        uint16_t manufacturerCode = LUMITEC_MANUFACTURER_CODE;
+        uint8_t deviceFunction = 130; // PC Gateway
+        uint8_t deviceClass = 25; // Internetwork Device
+        uint8_t deviceInstance = 0;
+        uint8_t systemInstance = 0;
+        uint8_t industryGroup = MARINE_INDUSTRY_CODE;
+        
+        // Build ISO Address Claim message (PGN 60928)
+        SetN2kPGN60928(addressClaimMsg, uniqueNumber, manufacturerCode, deviceFunction, 
+                       deviceClass, deviceInstance, systemInstance, industryGroup);
+        addressClaimMsg.Source = localSource;
+        
+        // Let the device list handle this message to register our local device
+        m_deviceList->HandleMsg(addressClaimMsg);
+        
+        // Also send product information for the local device
+        tN2kMsg productInfoMsg;
+        SetN2kPGN126996(productInfoMsg, 1000, 2101, "POCO-DIAG-001", "1.0.0", "NMEA2000 Analyzer", "1.0", 1, 1);
+        productInfoMsg.Source = localSource;
+        m_deviceList->HandleMsg(productInfoMsg);
+        
+        // Send configuration information for the local device
+        tN2kMsg configInfoMsg;
+        SetN2kPGN126998(configInfoMsg, 
+                       "Lumitec, Inc. - www.lumitec.com",          // Manufacturer Info
+                       "NMEA2000 Network Diagnostic Tool",         // Installation Description 1
+                       "Poco Protocol Analyzer and Tester");       // Installation Description 2
+        configInfoMsg.Source = localSource;
+        m_deviceList->HandleMsg(configInfoMsg);
+        
+        qDebug() << "Registered local device with product and configuration information";
+    }
+    
+    QList<DeviceTableEntry> devices;
+    for (uint8_t source = 0; source < N2kMaxBusDevices; source++) {
+        const tNMEA2000::tDevice* device = m_deviceList->FindDeviceBySource(source);
+        if (device) {
+            devices.append(deviceTableEntry(source, device));
+        }
+    }
+    return devices;
+}
+
 void DeviceMainWindow::populateDeviceTable()
 {
     if (!m_deviceList) {
@@ -915,100 +1087,61 @@ void DeviceMainWindow::populateDeviceTable()
     // Add the local device (this application) to the device list
     uint8_t localSource = nmea2000->GetN2kSource();
     
-    // Create a local device entry if it doesn't exist in the device list
-    const tNMEA2000::tDevice* localDevice = m_deviceList->FindDeviceBySource(localSource);
-    if (!localDevice) {
-        qDebug() << "Adding local device to device list with source:" << QString("0x%1").arg(localSource, 2, 16, QChar('0')).toUpper();
-        // Force add the local device to the device list by creating a fake address claim message
-        tN2kMsg addressClaimMsg;
-        uint32_t uniqueNumber = 12345; // Match our device info
-        uint16_t manufacturerCode = LUMITEC_MANUFACTURER_CODE;
-        uint8_t deviceFunction = 130; // PC Gateway
-        uint8_t deviceClass = 25; // Internetwork Device
-        uint8_t deviceInstance = 0;
-        uint8_t systemInstance = 0;
-        uint8_t industryGroup = MARINE_INDUSTRY_CODE;
-        
-        // Build ISO Address Claim message (PGN 60928)
-        SetN2kPGN60928(addressClaimMsg, uniqueNumber, manufacturerCode, deviceFunction, 
-                       deviceClass, deviceInstance, systemInstance, industryGroup);
-        addressClaimMsg.Source = localSource;
-        
-        // Let the device list handle this message to register our local device
-        m_deviceList->HandleMsg(addressClaimMsg);
-        
-        // Also send product information for the local device
-        tN2kMsg productInfoMsg;
-        SetN2kPGN126996(productInfoMsg, 1000, 2101, "POCO-DIAG-001", "1.0.0", "NMEA2000 Analyzer", "1.0", 1, 1);
-        productInfoMsg.Source = localSource;
-        m_deviceList->HandleMsg(productInfoMsg);
-        
-        // Send configuration information for the local device
-        tN2kMsg configInfoMsg;
-        SetN2kPGN126998(configInfoMsg, 
-                       "Lumitec, Inc. - www.lumitec.com",          // Manufacturer Info
-                       "NMEA2000 Network Diagnostic Tool",         // Installation Description 1
-                       "Poco Protocol Analyzer and Tester");       // Installation Description 2
-        configInfoMsg.Source = localSource;
-        m_deviceList->HandleMsg(configInfoMsg);
-        
-        qDebug() << "Registered local device with product and configuration information";
-    }
+    // Copy what the table shows under the bus lock, then build the table without holding it
+    const QList<DeviceTableEntry> devices = snapshotDeviceList(localSource);
     
     // Ensure the local device has proper activity tracking
     updateDeviceActivity(localSource);
     
     // First pass: update existing devices and mark active ones
-    for (uint8_t source = 0; source < N2kMaxBusDevices; source++) {
-        const tNMEA2000::tDevice* device = m_deviceList->FindDeviceBySource(source);
-        if (device) {
-            // Determine if device is active based on activity tracking
-            bool isActive;
-            if (source == localSource) {
-                // Local device is always considered active
-                isActive = true;
-            } else if (m_deviceActivity.contains(source)) {
-                // Use existing activity status
-                isActive = m_deviceActivity[source].isActive;
-            } else {
-                // Device not in activity tracking - consider it inactive until it sends a message
-                isActive = false;
+    for (const DeviceTableEntry& device : devices) {
+        const uint8_t source = device.source;
+        // Determine if device is active based on activity tracking
+        bool isActive;
+        if (source == localSource) {
+            // Local device is always considered active
+            isActive = true;
+        } else if (m_deviceActivity.contains(source)) {
+            // Use existing activity status
+            isActive = m_deviceActivity[source].isActive;
+        } else {
+            // Device not in activity tracking - consider it inactive until it sends a message
+            isActive = false;
+        }
+        
+        if (existingDeviceRows.contains(source)) {
+            // Update existing device
+            int row = existingDeviceRows[source];
+            updateDeviceTableRow(row, device, isActive);
+            if (m_deviceActivity.contains(source)) {
+                m_deviceActivity[source].tableRow = row;
             }
+            // Don't create activity entries here - let updateDeviceActivity() handle it when messages arrive
+            deviceCount++;
             
-            if (existingDeviceRows.contains(source)) {
-                // Update existing device
-                int row = existingDeviceRows[source];
-                updateDeviceTableRow(row, source, device, isActive);
-                if (m_deviceActivity.contains(source)) {
-                    m_deviceActivity[source].tableRow = row;
-                }
-                // Don't create activity entries here - let updateDeviceActivity() handle it when messages arrive
-                deviceCount++;
-                
-                // Add to known devices if not already there
+            // Add to known devices if not already there
+            m_knownDevices.insert(source);
+        } else {
+            // New device - add to end
+            int newRow = m_deviceTable->rowCount();
+            m_deviceTable->insertRow(newRow);
+            updateDeviceTableRow(newRow, device, isActive);
+            if (m_deviceActivity.contains(source)) {
+                m_deviceActivity[source].tableRow = newRow;
+            }
+            // Don't create activity entries here - let updateDeviceActivity() handle it when messages arrive
+            deviceCount++;
+            
+            // Check if this is truly a new device (not just a reconnection)
+            if (!m_knownDevices.contains(source)) {
                 m_knownDevices.insert(source);
-            } else {
-                // New device - add to end
-                int newRow = m_deviceTable->rowCount();
-                m_deviceTable->insertRow(newRow);
-                updateDeviceTableRow(newRow, source, device, isActive);
-                if (m_deviceActivity.contains(source)) {
-                    m_deviceActivity[source].tableRow = newRow;
-                }
-                // Don't create activity entries here - let updateDeviceActivity() handle it when messages arrive
-                deviceCount++;
+                qDebug() << "New device detected:" << QString("0x%1").arg(source, 2, 16, QChar('0')).toUpper() 
+                         << "- scheduling information query";
                 
-                // Check if this is truly a new device (not just a reconnection)
-                if (!m_knownDevices.contains(source)) {
-                    m_knownDevices.insert(source);
-                    qDebug() << "New device detected:" << QString("0x%1").arg(source, 2, 16, QChar('0')).toUpper() 
-                             << "- scheduling information query";
-                    
-                    // Schedule query for this new device with a short delay to let it settle
-                    QTimer::singleShot(1000, [this, source]() {
-                        queryNewDevice(source);
-                    });
-                }
+                // Schedule query for this new device with a short delay to let it settle
+                QTimer::singleShot(1000, [this, source]() {
+                    queryNewDevice(source);
+                });
             }
         }
     }
@@ -1870,6 +2003,7 @@ QString DeviceMainWindow::getDeviceDisplayName(uint8_t sourceAddress) const
         return QString("0x%1").arg(sourceAddress, 2, 16, QChar('0')).toUpper();
     }
     
+    N2kBusLocker busLock(N2kReceiveWorker::busMutex());
     const tNMEA2000::tDevice* device = m_deviceList->FindDeviceBySource(sourceAddress);
     if (!device) {
         return QString("0x%1 (Unknown)").arg(sourceAddress, 2, 16, QChar('0')).toUpper();
@@ -2140,7 +2274,7 @@ bool DeviceMainWindow::sendInstanceChangeCommand(uint8_t deviceAddress, unsigned
     msg.AddByte(instanceFieldNumber);  // Field number for instance
     msg.AddByte(newInstance);  // New instance value
     
-    bool success = nmea2000->SendMsg(msg);
+    bool success = N2kReceiveWorker::sendMessage(nmea2000, msg);
     if (success) {
         qDebug() << "Sent instance change command to device" 
                  << QString("0x%1").arg(deviceAddress, 2, 16, QChar('0'))
@@ -2246,7 +2380,7 @@ bool DeviceMainWindow::sendConfigurationUpdate(uint8_t targetAddress, const QStr
         msg.AddVarStr(desc2Ascii.constData(), false, 70, 70);
     }
     
-    bool success = nmea2000->SendMsg(msg);
+    bool success = N2kReceiveWorker::sendMessage(nmea2000, msg);
     if (success) {
         qDebug() << "Sent configuration update command to device" 
                  << QString("0x%1").arg(targetAddress, 2, 16, QChar('0'))
@@ -2257,12 +2391,8 @@ bool DeviceMainWindow::sendConfigurationUpdate(uint8_t targetAddress, const QStr
         // Blink TX indicator for transmitted messages
         blinkTxIndicator(msg.DataLen);
         
-        // Log the sent message to all PGN log dialogs
-        for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-            if (dialog && dialog->isVisible()) {
-                dialog->appendSentMessage(msg);
-            }
-        }
+        // Log the sent message to the PGN log windows
+        logSentMessage(msg);
         
         // Schedule a configuration information request after a delay to get updated values
         QTimer::singleShot(2000, [this, targetAddress]() {
@@ -2359,7 +2489,7 @@ void DeviceMainWindow::showPGNLog()
     qDebug() << "showPGNLog: Creating new PGNLogDialog instance...";
     
     // Always create a new dialog for multi-instance support
-    PGNLogDialog* newDialog = new PGNLogDialog(this);
+    PGNLogDialog* newDialog = new PGNLogDialog(m_liveCapture, this);
     
     // Set up device name resolver
     newDialog->setDeviceNameResolver([this](uint8_t address) {
@@ -2392,6 +2522,75 @@ void DeviceMainWindow::showPGNLog()
     qDebug() << "showPGNLog: Total PGN dialogs now: " << m_pgnLogDialogs.size();
 }
 
+void DeviceMainWindow::showTrafficStatistics()
+{
+    // One window - the statistics are shared, so a second view would add nothing
+    if (!m_trafficStatsDialog) {
+        m_trafficStatsDialog = new TrafficStatsDialog(&m_trafficStats, this);
+        m_trafficStatsDialog->setDeviceNameResolver([this](quint8 address) {
+            return getDeviceName(address);
+        });
+    }
+    m_trafficStatsDialog->show();
+    m_trafficStatsDialog->raise();
+    m_trafficStatsDialog->activateWindow();
+}
+
+void DeviceMainWindow::showSignalPlot()
+{
+    // One window - it can plot any number of signals
+    if (!m_signalPlotDialog) {
+        m_signalPlotDialog = new SignalPlotDialog(this);
+        m_signalPlotDialog->setDeviceNameResolver([this](quint8 address) {
+            return getDeviceName(address);
+        });
+    }
+    m_signalPlotDialog->show();
+    m_signalPlotDialog->raise();
+    m_signalPlotDialog->activateWindow();
+}
+
+void DeviceMainWindow::showCaptureTriggers()
+{
+    // One window - there is one trigger, which keeps running while the window is closed
+    if (!m_captureTriggerDialog) {
+        m_captureTriggerDialog = new CaptureTriggerDialog(m_captureTrigger, m_liveCapture->decoder(), this);
+    }
+    m_captureTriggerDialog->show();
+    m_captureTriggerDialog->raise();
+    m_captureTriggerDialog->activateWindow();
+}
+
+void DeviceMainWindow::showCaptureDiff()
+{
+    if (!m_captureDiffDialog) {
+        m_captureDiffDialog = new CaptureDiffDialog(this);
+    }
+    m_captureDiffDialog->show();
+    m_captureDiffDialog->raise();
+    m_captureDiffDialog->activateWindow();
+}
+
+void DeviceMainWindow::showCaptureRecorder()
+{
+    // One window - there is one recorder, which keeps running while the window is closed
+    if (!m_captureRecorderDialog) {
+        m_captureRecorderDialog = new CaptureRecorderDialog(m_captureRecorder, this);
+        connect(m_captureRecorderDialog, &CaptureRecorderDialog::openRangeRequested,
+                this, &DeviceMainWindow::openRecordedRange);
+    }
+    m_captureRecorderDialog->show();
+    m_captureRecorderDialog->raise();
+    m_captureRecorderDialog->activateWindow();
+}
+
+void DeviceMainWindow::openRecordedRange(const QStringList& fileNames, qint64 fromWallNs, qint64 toWallNs)
+{
+    // A new PGN log window, so the live views stay as they are
+    showPGNLog();
+    m_pgnLogDialogs.last()->loadRecordedRange(fileNames, fromWallNs, toWallNs);
+}
+
 void DeviceMainWindow::showSendPGNDialog()
 {
     PGNDialog* pgnDialog = new PGNDialog(this);
@@ -2400,16 +2599,8 @@ void DeviceMainWindow::showSendPGNDialog()
     connect(pgnDialog, &PGNDialog::messageTransmitted, this, [this](const tN2kMsg& message) {
         blinkTxIndicator(message.DataLen);
         
-        // Log the sent message to all PGN log dialogs - safer iteration
-        QList<PGNLogDialog*> dialogsCopy = m_pgnLogDialogs;  // Make a copy to avoid iterator invalidation
-        for (PGNLogDialog* dialog : dialogsCopy) {
-            if (dialog && dialog->isVisible()) {
-                // Additional safety check to ensure dialog is still in the original list
-                if (m_pgnLogDialogs.contains(dialog)) {
-                    dialog->appendSentMessage(message);
-                }
-            }
-        }
+        // Log the sent message to the PGN log windows
+        logSentMessage(message);
     });
     
     // Auto-delete when dialog is closed
@@ -2443,16 +2634,8 @@ void DeviceMainWindow::showSendPGNToDevice(uint8_t targetAddress, const QString&
         
         blinkTxIndicator(message.DataLen);
         
-        // Log the sent message to all PGN log dialogs - safer iteration
-        QList<PGNLogDialog*> dialogsCopy = m_pgnLogDialogs;  // Make a copy to avoid iterator invalidation
-        for (PGNLogDialog* dialog : dialogsCopy) {
-            if (dialog && dialog->isVisible()) {
-                // Additional safety check to ensure dialog is still in the original list
-                if (m_pgnLogDialogs.contains(dialog)) {
-                    dialog->appendSentMessage(message);
-                }
-            }
-        }
+        // Log the sent message to the PGN log windows
+        logSentMessage(message);
         
         qDebug() << "PGN" << message.PGN << "sent from dialog to destination" 
                  << QString("0x%1").arg(message.Destination, 2, 16, QChar('0')).toUpper()
@@ -2515,6 +2698,7 @@ void DeviceMainWindow::showDeviceDetails(int row)
     QString additionalInfo = "";
     
     if (ok && m_deviceList) {
+        N2kBusLocker busLock(N2kReceiveWorker::busMutex());
         const tNMEA2000::tDevice* device = m_deviceList->FindDeviceBySource(source);
         if (device) {
             additionalInfo += QString("Device Function: %1\n").arg(device->GetDeviceFunction());
@@ -2566,19 +2750,15 @@ void DeviceMainWindow::queryDeviceConfiguration(uint8_t targetAddress)
     tN2kMsg N2kMsg;
     SetN2kPGN59904(N2kMsg, targetAddress, N2kPGNConfigurationInformation);
     
-    if (nmea2000->SendMsg(N2kMsg)) {
+    if (N2kReceiveWorker::sendMessage(nmea2000, N2kMsg)) {
         // Track this request so we can show details when we get the response
         m_pendingConfigInfoRequests.insert(targetAddress);
         
         // Blink TX indicator for transmitted messages
         blinkTxIndicator(N2kMsg.DataLen);
         
-        // Log the sent message to all PGN log dialogs
-        for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-            if (dialog && dialog->isVisible()) {
-                dialog->appendSentMessage(N2kMsg);
-            }
-        }
+        // Log the sent message to the PGN log windows
+        logSentMessage(N2kMsg);
         
         qDebug() << "Configuration information request sent to device" << 
                    QString("0x%1").arg(targetAddress, 2, 16, QChar('0')).toUpper();
@@ -2599,7 +2779,7 @@ void DeviceMainWindow::requestProductInformation(uint8_t targetAddress)
     tN2kMsg N2kMsg;
     SetN2kPGN59904(N2kMsg, targetAddress, N2kPGNProductInformation);
     
-    if (nmea2000->SendMsg(N2kMsg)) {
+    if (N2kReceiveWorker::sendMessage(nmea2000, N2kMsg)) {
         // Blink TX indicator for transmitted messages
         blinkTxIndicator(N2kMsg.DataLen);
         
@@ -2618,12 +2798,8 @@ void DeviceMainWindow::requestProductInformation(uint8_t targetAddress)
         m_productInfoRetryTimers[targetAddress] = retryTimer;
         retryTimer->start(PRODUCT_INFO_RETRY_TIMEOUT_MS);
         
-        // Log the sent message to all PGN log dialogs
-        for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-            if (dialog && dialog->isVisible()) {
-                dialog->appendSentMessage(N2kMsg);
-            }
-        }
+        // Log the sent message to the PGN log windows
+        logSentMessage(N2kMsg);
         
         qDebug() << "Product information request sent to device" << 
                    QString("0x%1").arg(targetAddress, 2, 16, QChar('0')).toUpper();
@@ -2644,15 +2820,11 @@ void DeviceMainWindow::requestSupportedPGNs(uint8_t targetAddress)
     tN2kMsg N2kMsg;
     SetN2kPGN59904(N2kMsg, targetAddress, 126464L);
     
-    if (nmea2000->SendMsg(N2kMsg)) {
+    if (N2kReceiveWorker::sendMessage(nmea2000, N2kMsg)) {
         blinkTxIndicator(N2kMsg.DataLen);
         
-        // Log the sent message to all PGN log dialogs
-        for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-            if (dialog && dialog->isVisible()) {
-                dialog->appendSentMessage(N2kMsg);
-            }
-        }
+        // Log the sent message to the PGN log windows
+        logSentMessage(N2kMsg);
         
         qDebug() << "Supported PGNs request sent to device" << 
                    QString("0x%1").arg(targetAddress, 2, 16, QChar('0')).toUpper();
@@ -2768,7 +2940,7 @@ void DeviceMainWindow::sendInitialBroadcastRequest()
     tN2kMsg msg;
     SetN2kPGN59904(msg, 0xFF, N2kPGNProductInformation); // 0xFF = broadcast
     
-    if (nmea2000->SendMsg(msg)) {
+    if (N2kReceiveWorker::sendMessage(nmea2000, msg)) {
         // Blink TX indicator for transmitted message
         blinkTxIndicator(msg.DataLen);
         
@@ -2800,7 +2972,7 @@ void DeviceMainWindow::triggerAutomaticDeviceDiscovery()
         qDebug() << "Sending wake-up broadcast for Product Information to discover quiet devices";
         tN2kMsg msg;
         SetN2kPGN59904(msg, 0xFF, N2kPGNProductInformation); // 0xFF = broadcast
-        nmea2000->SendMsg(msg);
+        N2kReceiveWorker::sendMessage(nmea2000, msg);
         
         // Blink TX indicator for transmitted messages
         blinkTxIndicator(8); // Default 8 bytes
@@ -2968,10 +3140,30 @@ void DeviceMainWindow::queryNewDevice(uint8_t sourceAddress)
     qDebug() << "Information requests sent to new device" << deviceDesc;
 }
 
+bool DeviceMainWindow::isPgnLogCapturing() const
+{
+    for (PGNLogDialog* dialog : m_pgnLogDialogs) {
+        if (dialog && dialog->isCapturingLive()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DeviceMainWindow::logSentMessage(const tN2kMsg& msg)
+{
+    // Flagged as sent so the PGN log shows it in blue
+    if (isPgnLogCapturing()) {
+        m_liveCapture->append(msg, N2kTimestamp::now(), true);
+    }
+    m_captureTrigger->append(msg, N2kTimestamp::now(), true);
+    m_captureRecorder->append(msg, N2kTimestamp::now(), true);
+}
+
 void DeviceMainWindow::showPGNLogForDevice(uint8_t sourceAddress)
 {
     // Create a new PGN log dialog for this specific device
-    PGNLogDialog* deviceDialog = new PGNLogDialog(this);
+    PGNLogDialog* deviceDialog = new PGNLogDialog(m_liveCapture, this);
     
     // Set up device name resolver
     deviceDialog->setDeviceNameResolver([this](uint8_t address) {
@@ -3384,16 +3576,12 @@ void DeviceMainWindow::sendLumitecSimpleAction(uint8_t targetAddress, uint8_t ac
     
     tN2kMsg msg;
     if (SetLumitecExtSwSimpleAction(msg, targetAddress, actionId, switchId)) {
-        if (nmea2000->SendMsg(msg)) {
+        if (N2kReceiveWorker::sendMessage(nmea2000, msg)) {
             // Blink TX indicator for transmitted messages
             blinkTxIndicator(8); // Default 8 bytes
             
-            // Log the sent message to all PGN log dialogs
-            for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-                if (dialog && dialog->isVisible()) {
-                    dialog->appendSentMessage(msg);
-                }
-            }
+            // Log the sent message to the PGN log windows
+            logSentMessage(msg);
             
             qDebug() << "Sent Lumitec Simple Action - Target:" << QString("0x%1").arg(targetAddress, 2, 16, QChar('0'))
                      << "Action:" << GetLumitecActionName(actionId) 
@@ -3482,16 +3670,12 @@ void DeviceMainWindow::sendLumitecCustomHSB(uint8_t targetAddress, uint8_t hue,
     
     tN2kMsg msg;
     if (SetLumitecExtSwCustomHSB(msg, targetAddress, ACTION_T2HSB, 1, hue, saturation, brightness)) {
-        if (nmea2000->SendMsg(msg)) {
+        if (N2kReceiveWorker::sendMessage(nmea2000, msg)) {
             // Blink TX indicator for transmitted messages
             blinkTxIndicator(8); // Default 8 bytes
             
-            // Log the sent message to all PGN log dialogs
-            for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-                if (dialog && dialog->isVisible()) {
-                    dialog->appendSentMessage(msg);
-                }
-            }
+            // Log the sent message to the PGN log windows
+            logSentMessage(msg);
             
             qDebug() << "Sent Lumitec Custom HSB - Target:" << QString("0x%1").arg(targetAddress, 2, 16, QChar('0'))
                      << "H:" << hue << "S:" << saturation << "B:" << brightness;
@@ -3511,16 +3695,12 @@ void DeviceMainWindow::sendLumitecOutputChannelBin(uint8_t targetAddress, uint8_
 
     tN2kMsg msg;
     if (SetLumitecOutputChannelBin(msg, targetAddress, channel, state)) {
-        if (nmea2000->SendMsg(msg)) {
+        if (N2kReceiveWorker::sendMessage(nmea2000, msg)) {
             // Blink TX indicator for transmitted messages
             blinkTxIndicator(8); // Default 8 bytes
 
-            // Log the sent message to all PGN log dialogs
-            for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-                if (dialog && dialog->isVisible()) {
-                    dialog->appendSentMessage(msg);
-                }
-            }
+            // Log the sent message to the PGN log windows
+            logSentMessage(msg);
 
             qDebug() << "Sent Lumitec Output Channel BIN - Target:" << QString("0x%1").arg(targetAddress, 2, 16, QChar('0'))
                      << "Channel:" << channel << "State:" << state;
@@ -3540,16 +3720,12 @@ void DeviceMainWindow::sendLumitecOutputChannelPWM(uint8_t targetAddress, uint8_
 
     tN2kMsg msg;
     if (SetLumitecOutputChannelPWM(msg, targetAddress, channel, duty, transitionTime)) {
-        if (nmea2000->SendMsg(msg)) {
+        if (N2kReceiveWorker::sendMessage(nmea2000, msg)) {
             // Blink TX indicator for transmitted messages
             blinkTxIndicator(8); // Default 8 bytes
 
-            // Log the sent message to all PGN log dialogs
-            for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-                if (dialog && dialog->isVisible()) {
-                    dialog->appendSentMessage(msg);
-                }
-            }
+            // Log the sent message to the PGN log windows
+            logSentMessage(msg);
 
             qDebug() << "Sent Lumitec Output Channel PWM - Target:" << QString("0x%1").arg(targetAddress, 2, 16, QChar('0'))
                      << "Channel:" << channel << "Duty:" << duty << "Transition:" << transitionTime << "ms";
@@ -3569,16 +3745,12 @@ void DeviceMainWindow::sendLumitecOutputChannelPLI(uint8_t targetAddress, uint8_
 
     tN2kMsg msg;
     if (SetLumitecOutputChannelPLI(msg, targetAddress, channel, pliMessage)) {
-        if (nmea2000->SendMsg(msg)) {
+        if (N2kReceiveWorker::sendMessage(nmea2000, msg)) {
             // Blink TX indicator for transmitted messages
             blinkTxIndicator(8); // Default 8 bytes
 
-            // Log the sent message to all PGN log dialogs
-            for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-                if (dialog && dialog->isVisible()) {
-                    dialog->appendSentMessage(msg);
-                }
-            }
+            // Log the sent message to the PGN log windows
+            logSentMessage(msg);
 
             qDebug() << "Sent Lumitec Output Channel PLI - Target:" << QString("0x%1").arg(targetAddress, 2, 16, QChar('0'))
                      << "Channel:" << channel << "PLI:" << QString("0x%1").arg(pliMessage, 8, 16, QChar('0'));
@@ -3599,16 +3771,12 @@ void DeviceMainWindow::sendLumitecOutputChannelPLIT2HSB(uint8_t targetAddress, u
 
     tN2kMsg msg;
     if (SetLumitecOutputChannelPLIT2HSB(msg, targetAddress, channel, pliClan, transition, brightness, hue, saturation)) {
-        if (nmea2000->SendMsg(msg)) {
+        if (N2kReceiveWorker::sendMessage(nmea2000, msg)) {
             // Blink TX indicator for transmitted messages
             blinkTxIndicator(8); // Default 8 bytes
 
-            // Log the sent message to all PGN log dialogs
-            for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-                if (dialog && dialog->isVisible()) {
-                    dialog->appendSentMessage(msg);
-                }
-            }
+            // Log the sent message to the PGN log windows
+            logSentMessage(msg);
 
             qDebug() << "Sent Lumitec Output Channel PLI T2HSB - Target:" << QString("0x%1").arg(targetAddress, 2, 16, QChar('0'))
                      << "Channel:" << channel << "Clan:" << pliClan << "Transition:" << transition
@@ -3854,71 +4022,58 @@ void DeviceMainWindow::sendIsoRequestToDevice(uint8_t deviceAddress) {
     tN2kMsg isoRequest;
     SetN2kPGN59904(isoRequest, deviceAddress, N2kPGNConfigurationInformation);
     
-    if (nmea2000->SendMsg(isoRequest)) {
+    if (N2kReceiveWorker::sendMessage(nmea2000, isoRequest)) {
         qDebug() << "Sent ISO request (PGN 126998) to device" << QString("0x%1").arg(deviceAddress, 2, 16, QChar('0')).toUpper()
                  << "for connectivity test";
     }
 }
 
-void DeviceMainWindow::updateDeviceTableRow(int row, uint8_t source, const tNMEA2000::tDevice* device, bool isActive) {
+DeviceMainWindow::DeviceTableEntry DeviceMainWindow::deviceTableEntry(uint8_t source, const tNMEA2000::tDevice* device) {
+    // Text fields fall back to a placeholder when the device has not reported them
+    auto text = [](const char* value, const char* placeholder) {
+        return value && strlen(value) > 0 ? QString(value) : QString(placeholder);
+    };
+    
+    DeviceTableEntry entry;
+    entry.source = source;
+    entry.manufacturerCode = device->GetManufacturerCode();
+    entry.deviceInstance = device->GetDeviceInstance();
+    entry.modelId = text(device->GetModelID(), "Unknown");
+    entry.serialNumber = text(device->GetModelSerialCode(), "Unknown");
+    entry.softwareVersion = text(device->GetSwCode(), "-");
+    entry.installDesc1 = text(device->GetInstallationDescription1(), "-");
+    entry.installDesc2 = text(device->GetInstallationDescription2(), "-");
+    return entry;
+}
+
+void DeviceMainWindow::updateDeviceTableRow(int row, const DeviceTableEntry& device, bool isActive) {
     // Check if this is the local device (own node)
-    bool isLocalDevice = (source == nmea2000->GetN2kSource());
+    bool isLocalDevice = (device.source == nmea2000->GetN2kSource());
     
     // Node Address (Source) - in hex format with 0x prefix like standard NMEA2000 tools
-    QTableWidgetItem* nodeAddressItem = new QTableWidgetItem(QString("0x%1").arg(QString("%1").arg(source, 2, 16, QChar('0')).toUpper()));
+    QTableWidgetItem* nodeAddressItem = new QTableWidgetItem(QString("0x%1").arg(QString("%1").arg(device.source, 2, 16, QChar('0')).toUpper()));
     nodeAddressItem->setTextAlignment(Qt::AlignCenter);
     m_deviceTable->setItem(row, 0, nodeAddressItem);
     
     // Manufacturer - convert manufacturer code to name
-    uint16_t manufacturerCode = device->GetManufacturerCode();
-    QString manufacturerName = getManufacturerName(manufacturerCode);
+    QString manufacturerName = getManufacturerName(device.manufacturerCode);
     m_deviceTable->setItem(row, 1, new QTableWidgetItem(manufacturerName));
     
-    // Mfg Model ID - use virtual method
-    QString modelId = "Unknown";
-    const char* modelIdStr = device->GetModelID();
-    if (modelIdStr && strlen(modelIdStr) > 0) {
-        modelId = QString(modelIdStr);
-    }
-    m_deviceTable->setItem(row, 2, new QTableWidgetItem(modelId));
-    
-    // Mfg Serial Number - use virtual method
-    QString serialNumber = "Unknown";
-    const char* serialStr = device->GetModelSerialCode();
-    if (serialStr && strlen(serialStr) > 0) {
-        serialNumber = QString(serialStr);
-    }
-    m_deviceTable->setItem(row, 3, new QTableWidgetItem(serialNumber));
+    // Mfg Model ID and Serial Number
+    m_deviceTable->setItem(row, 2, new QTableWidgetItem(device.modelId));
+    m_deviceTable->setItem(row, 3, new QTableWidgetItem(device.serialNumber));
     
     // Device Instance
-    uint8_t deviceInstance = device->GetDeviceInstance();
-    QTableWidgetItem* instanceItem = new QTableWidgetItem(QString::number(deviceInstance));
+    QTableWidgetItem* instanceItem = new QTableWidgetItem(QString::number(device.deviceInstance));
     instanceItem->setTextAlignment(Qt::AlignCenter);
     m_deviceTable->setItem(row, 4, instanceItem);
     
-    // Current Software - use virtual method
-    QString softwareVersion = "-";
-    const char* swCodeStr = device->GetSwCode();
-    if (swCodeStr && strlen(swCodeStr) > 0) {
-        softwareVersion = QString(swCodeStr);
-    }
-    m_deviceTable->setItem(row, 5, new QTableWidgetItem(softwareVersion));
+    // Current Software
+    m_deviceTable->setItem(row, 5, new QTableWidgetItem(device.softwareVersion));
     
     // Installation Description 1 and 2 - separate columns for PGN 126998 fields
-    QString installDesc1 = "-";
-    QString installDesc2 = "-";
-    const char* installDesc1Ptr = device->GetInstallationDescription1();
-    const char* installDesc2Ptr = device->GetInstallationDescription2();
-    
-    if (installDesc1Ptr && strlen(installDesc1Ptr) > 0) {
-        installDesc1 = QString(installDesc1Ptr);
-    }
-    if (installDesc2Ptr && strlen(installDesc2Ptr) > 0) {
-        installDesc2 = QString(installDesc2Ptr);
-    }
-    
-    m_deviceTable->setItem(row, 6, new QTableWidgetItem(installDesc1));
-    m_deviceTable->setItem(row, 7, new QTableWidgetItem(installDesc2));
+    m_deviceTable->setItem(row, 6, new QTableWidgetItem(device.installDesc1));
+    m_deviceTable->setItem(row, 7, new QTableWidgetItem(device.installDesc2));
     
     // Set text color and formatting based on activity status and local device
     QColor textColor;
@@ -4038,16 +4193,12 @@ void DeviceMainWindow::sendZonePGN130561(uint8_t targetAddress, uint8_t zoneId,
         uint8_t statusByte = zoneEnabled ? 0x01 : 0x00; // Set bit 0 for enabled/disabled
         msg.AddByte(statusByte);
         
-        if (nmea2000->SendMsg(msg)) {
+        if (N2kReceiveWorker::sendMessage(nmea2000, msg)) {
             // Blink TX indicator for transmitted messages
             blinkTxIndicator(8); // Default 8 bytes
             
-            // Log the sent message to all PGN log dialogs
-            for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-                if (dialog && dialog->isVisible()) {
-                    dialog->appendSentMessage(msg);
-                }
-            }
+            // Log the sent message to the PGN log windows
+            logSentMessage(msg);
             qDebug() << "Sent Simple Zone Command (PGN 126208->130561) - Target:" << QString("0x%1").arg(targetAddress, 2, 16, QChar('0'))
                      << "Zone:" << zoneId << "Action:" << (zoneEnabled ? "ON" : "OFF");
         } else {
@@ -4114,16 +4265,12 @@ void DeviceMainWindow::sendZonePGN130561(uint8_t targetAddress, uint8_t zoneId,
         uint8_t statusByte = zoneEnabled ? 0x01 : 0x00; // Set bit 0 for enabled/disabled
         msg.AddByte(statusByte);
 
-        if (nmea2000->SendMsg(msg)) {
+        if (N2kReceiveWorker::sendMessage(nmea2000, msg)) {
             // Blink TX indicator for transmitted messages
             blinkTxIndicator(8); // Default 8 bytes
             
-            // Log the sent message to all PGN log dialogs
-            for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-                if (dialog && dialog->isVisible()) {
-                    dialog->appendSentMessage(msg);
-                }
-            }
+            // Log the sent message to the PGN log windows
+            logSentMessage(msg);
             qDebug() << "Sent Full Zone Command (PGN 126208->130561) - Target:" << QString("0x%1").arg(targetAddress, 2, 16, QChar('0'))
                      << "Zone:" << zoneId << "Name:" << zoneName 
                      << "RGB:" << red << green << blue << "Intensity:" << intensity;
@@ -4150,6 +4297,9 @@ void DeviceMainWindow::onConnectClicked()
 void DeviceMainWindow::onDisconnectClicked()
 {
     if (nmea2000) {
+        // Stop receiving before the bus object goes away
+        stopReceiveWorker();
+        
         // Cleanup and delete the NMEA2000 connection
         delete nmea2000;
         nmea2000 = nullptr;
@@ -4394,6 +4544,23 @@ void DeviceMainWindow::updateBandwidthDisplay()
      .arg(rxBytes)
      .arg(txBytes)
      .arg(NMEA2000_MAX_BPS));
+    
+    // Append receive queue health so overruns are visible without a debugger
+    if (m_receiveWorker) {
+        N2kReceiveStats rxStats = m_receiveWorker->stats();
+        m_bandwidthLabel->setToolTip(m_bandwidthLabel->toolTip() + QString(
+            "\n\nRX Queue: %1 / %2 (peak %3)\n"
+            "RX Dropped: %4 of %5 messages\n"
+            "GUI Drain: %6 messages in %7 batches (peak backlog %8)"
+        ).arg(rxStats.queueDepth)
+         .arg(rxStats.capacity)
+         .arg(rxStats.peakQueueDepth)
+         .arg(rxStats.dropped)
+         .arg(rxStats.received + rxStats.dropped)
+         .arg(m_drainedMessages)
+         .arg(m_drainBatches)
+         .arg(m_peakDrainBacklog));
+    }
 }
 
 void DeviceMainWindow::onPGNLogDialogDestroyed(QObject* obj)
@@ -4446,7 +4613,7 @@ void DeviceMainWindow::retryProductInformation(uint8_t targetAddress)
         tN2kMsg N2kMsg;
         SetN2kPGN59904(N2kMsg, targetAddress, N2kPGNProductInformation);
         
-        if (nmea2000->SendMsg(N2kMsg)) {
+        if (N2kReceiveWorker::sendMessage(nmea2000, N2kMsg)) {
             blinkTxIndicator(8); // Default 8 bytes
             
             // Start another retry timer
@@ -4461,12 +4628,8 @@ void DeviceMainWindow::retryProductInformation(uint8_t targetAddress)
             m_productInfoRetryTimers[targetAddress] = retryTimer;
             retryTimer->start(PRODUCT_INFO_RETRY_TIMEOUT_MS);
             
-            // Log the sent message to all PGN log dialogs
-            for (PGNLogDialog* dialog : m_pgnLogDialogs) {
-                if (dialog && dialog->isVisible()) {
-                    dialog->appendSentMessage(N2kMsg);
-                }
-            }
+            // Log the sent message to the PGN log windows
+            logSentMessage(N2kMsg);
         }
     }
 }
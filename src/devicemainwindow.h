@@ -21,6 +21,8 @@
 #include "LumitecPoco.h"
 #include "instanceconflictanalyzer.h"
 #include "thememanager.h"
+#include "n2ktimestamp.h"
+#include "trafficstats.h"
 #include <QStyledItemDelegate>
 #include <QPainter>
 
@@ -31,6 +33,15 @@ class PGNLogDialog;
 class PocoDeviceDialog;
 class InstanceConflictAnalyzer;
 class DirectChannelControlDialog;
+class N2kReceiveWorker;
+class TrafficStatsDialog;
+class SignalPlotDialog;
+class LiveCapture;
+class CaptureTrigger;
+class CaptureTriggerDialog;
+class CaptureDiffDialog;
+class CaptureRecorder;
+class CaptureRecorderDialog;
 
 // Custom delegate for consistent text alignment
 class AlignedTextDelegate : public QStyledItemDelegate
@@ -71,6 +82,12 @@ private slots:
     void analyzeInstanceConflicts();
     void showPGNLog();
     void showSendPGNDialog();
+    void showTrafficStatistics();
+    void showSignalPlot();
+    void showCaptureTriggers();
+    void showCaptureDiff();
+    void showCaptureRecorder();
+    void openRecordedRange(const QStringList& fileNames, qint64 fromWallNs, qint64 toWallNs);
     void onCanInterfaceChanged(const QString &interface);
     void clearConflictHistory();
     void showDeviceContextMenu(const QPoint& position);
@@ -91,10 +108,14 @@ private:
     QString getPGNName(unsigned long pgn);
     
     // NMEA2000 and PGN handling
-    void handleN2kMsg(const tN2kMsg& msg);
+    void handleN2kMsg(const tN2kMsg& msg, const N2kTimestamp& timestamp);
     static void staticN2kMsgHandler(const tN2kMsg &msg);
     static DeviceMainWindow* instance; // Singleton-style reference for static callback
     
+    // Receive thread management
+    void startReceiveWorker();
+    void stopReceiveWorker();
+    
     void setupCanInterfaceSelector();
     void populateCanInterfaces();
     void reinitializeNMEA2000();
@@ -111,7 +132,21 @@ private:
     void removeInactiveDevice(uint8_t deviceAddress);
     void grayOutInactiveDevices();
     void sendIsoRequestToDevice(uint8_t deviceAddress);
-    void updateDeviceTableRow(int row, uint8_t source, const tNMEA2000::tDevice* device, bool isActive);
+    // Device list fields shown in the table, copied under the bus lock so the table is built without it
+    struct DeviceTableEntry {
+        uint8_t source;
+        uint16_t manufacturerCode;
+        uint8_t deviceInstance;
+        QString modelId;
+        QString serialNumber;
+        QString softwareVersion;
+        QString installDesc1;
+        QString installDesc2;
+    };
+    static DeviceTableEntry deviceTableEntry(uint8_t source, const tNMEA2000::tDevice* device);
+    // Registers the local device if needed, then copies every device under the bus lock
+    QList<DeviceTableEntry> snapshotDeviceList(uint8_t localSource);
+    void updateDeviceTableRow(int row, const DeviceTableEntry& device, bool isActive);
     
     // Context menu methods
     void showSendPGNToDevice(uint8_t targetAddress, const QString& nodeAddress);
@@ -171,6 +206,9 @@ private slots:
     void onRxBlinkTimeout();
     void onBandwidthTimerUpdate();
     
+    // Drain messages queued by the receive thread
+    void processReceivedMessages();
+    
     // PGN dialog management
     void onPGNLogDialogDestroyed(QObject* obj);
     
@@ -222,8 +260,31 @@ private:
     QString m_currentInterface;
     bool m_isConnected;
     
-    // Secondary dialogs - support multiple PGN log dialogs
+    // Receive thread and GUI-side drain statistics
+    N2kReceiveWorker* m_receiveWorker = nullptr;
+    int m_parseTimerId = 0;            // WASM only - GUI-thread polling timer
+    quint64 m_drainedMessages = 0;     // Messages handed to handleN2kMsg from the ring
+    quint64 m_drainBatches = 0;        // Number of non-empty drain passes
+    int m_peakDrainBacklog = 0;        // Largest backlog found when a drain started
+    static const int RX_DRAIN_BATCH_SIZE = 256;  // Max messages handled per event-loop pass
+    
+    // Secondary dialogs - support multiple PGN log dialogs, all views over one live capture
     QList<PGNLogDialog*> m_pgnLogDialogs;
+    LiveCapture* m_liveCapture;
+    
+    // Per-(source, PGN) statistics of everything received, shown on demand
+    TrafficStats m_trafficStats;
+    TrafficStatsDialog* m_trafficStatsDialog = nullptr;
+    SignalPlotDialog* m_signalPlotDialog = nullptr;
+    
+    // Pre/post-trigger recording of everything received and sent, armed from its dialog
+    CaptureTrigger* m_captureTrigger;
+    CaptureTriggerDialog* m_captureTriggerDialog = nullptr;
+    CaptureDiffDialog* m_captureDiffDialog = nullptr;
+    
+    // Every message to rotating segment files on disk, for soak tests
+    CaptureRecorder* m_captureRecorder;
+    CaptureRecorderDialog* m_captureRecorderDialog = nullptr;
     
     // Instance conflict analysis
     InstanceConflictAnalyzer* m_conflictAnalyzer;
@@ -277,6 +338,8 @@ private:
     
     // Helper methods
     void updatePGNDialogDeviceList();
+    bool isPgnLogCapturing() const;
+    void logSentMessage(const tN2kMsg& msg);
     void scheduleFollowUpQueries();
     void performFollowUpQueries();
     void queryNewDevice(uint8_t sourceAddress);
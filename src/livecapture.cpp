@@ -0,0 +1,98 @@
+#include "livecapture.h"
+#include "dbcdecoder.h"
+#include <QDebug>
+#include <QSettings>
+
+LiveCapture::LiveCapture(QObject* parent)
+    : QObject(parent)
+    , m_decoder(new DBCDecoder(this))
+    , m_spillWriter(nullptr)
+    , m_spillErrorReported(false)
+    , m_evictedCount(0)
+{
+    if (!m_decoder->isInitialized()) {
+        qWarning() << "Failed to initialize DBC Decoder for the live capture";
+    }
+
+    // The PGN log windows save the budget with their settings
+    QSettings settings;
+    settings.beginGroup("PGNLogDialog");
+    m_budget.limit = static_cast<CaptureBudget::Limit>(
+        settings.value("captureBudgetLimit", int(CaptureBudget::Unlimited)).toInt());
+    m_budget.value = settings.value("captureBudgetValue", 0).toLongLong();
+    m_budget.policy = static_cast<CaptureBudget::OverflowPolicy>(
+        settings.value("captureOverflowPolicy", int(CaptureBudget::DropOldest)).toInt());
+    settings.endGroup();
+}
+
+LiveCapture::~LiveCapture()
+{
+    delete m_spillWriter;
+}
+
+void LiveCapture::append(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent)
+{
+    m_store.append(msg, timestamp, sent);
+
+    // Checked per message - the budget evicts down to a lower mark, so this only acts in chunks
+    enforceBudget();
+    emit rowsAppended();
+}
+
+void LiveCapture::clear()
+{
+    m_store.clear();
+    m_evictedCount = 0;
+
+    // Start a new spill file for the next capture
+    delete m_spillWriter;
+    m_spillWriter = nullptr;
+    m_spillErrorReported = false;
+
+    emit cleared();
+}
+
+void LiveCapture::setBudget(const CaptureBudget& budget)
+{
+    if (budget.limit == m_budget.limit && budget.value == m_budget.value && budget.policy == m_budget.policy) {
+        return;
+    }
+    m_budget = budget;
+    emit budgetChanged();
+
+    // Apply a lowered limit right away rather than on the next message
+    enforceBudget();
+}
+
+void LiveCapture::enforceBudget()
+{
+    int evict = m_budget.rowsToEvict(m_store);
+    if (evict <= 0) {
+        return;
+    }
+
+    switch (m_budget.policy) {
+    case CaptureBudget::StopCapture:
+        emit budgetReached();
+        return;
+
+    case CaptureBudget::SpillToDisk:
+        if (!m_spillWriter) {
+            m_spillWriter = new CaptureSpillWriter();
+        }
+        if (!m_spillWriter->writeRows(m_store, evict) && !m_spillErrorReported) {
+            // Keep capturing - losing the oldest messages beats running out of memory
+            m_spillErrorReported = true;
+            emit spillFailed(m_spillWriter->errorString());
+        }
+        break;
+
+    case CaptureBudget::DropOldest:
+        break;
+    }
+
+    emit rowsAboutToBeEvicted(evict);
+    m_store.removeFirst(evict);
+    m_evictedCount += evict;
+    emit rowsEvicted(evict);
+}
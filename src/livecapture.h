@@ -0,0 +1,65 @@
+#ifndef LIVECAPTURE_H
+#define LIVECAPTURE_H
+
+#include <QObject>
+#include <QString>
+#include <N2kMsg.h>
+#include "n2ktimestamp.h"
+#include "capturestore.h"
+#include "capturebudget.h"
+
+class DBCDecoder;
+
+/**
+ * @brief The live capture shared by every PGN log window.
+ *
+ * DeviceMainWindow appends each received and sent message here once. The PGN
+ * log windows are views over the same CaptureStore, each with its own filter
+ * and visible-row index in a PGNLogModel, and they share one DBCDecoder and
+ * with it the decode cache. Another window costs a model and a table view.
+ *
+ * The capture budget applies to the shared store. Evicting rows is announced
+ * to every view before and after the store changes, so each model can keep
+ * its view in step.
+ */
+class LiveCapture : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LiveCapture(QObject* parent = nullptr);
+    ~LiveCapture();
+
+    CaptureStore* store() { return &m_store; }
+    DBCDecoder* decoder() const { return m_decoder; }
+
+    void append(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent = false);
+    void clear();
+
+    const CaptureBudget& budget() const { return m_budget; }
+    void setBudget(const CaptureBudget& budget);
+    qint64 evictedCount() const { return m_evictedCount; }
+    const CaptureSpillWriter* spillWriter() const { return m_spillWriter; }
+
+signals:
+    void rowsAppended();
+    void rowsAboutToBeEvicted(int count);
+    void rowsEvicted(int count);
+    void cleared();
+    void budgetChanged();
+    // The StopCapture budget was reached - views stop capturing live traffic
+    void budgetReached();
+    void spillFailed(const QString& errorString);
+
+private:
+    void enforceBudget();
+
+    CaptureStore m_store;
+    DBCDecoder* m_decoder;
+    CaptureBudget m_budget;
+    CaptureSpillWriter* m_spillWriter;
+    bool m_spillErrorReported;
+    qint64 m_evictedCount;
+};
+
+#endif // LIVECAPTURE_H
@@ -0,0 +1,125 @@
+#include "n2kreceiveworker.h"
+#include <QDebug>
+
+#ifndef WASM_BUILD
+#include "socketcantimestamped.h"
+#endif
+
+N2kReceiveWorker* N2kReceiveWorker::s_activeWorker = nullptr;
+
+N2kReceiveWorker::N2kReceiveWorker(tNMEA2000* bus, QObject* parent)
+    : QThread(parent)
+    , m_bus(bus)
+    , m_timestampedBus(nullptr)
+    , m_ring(RING_CAPACITY)
+{
+#ifndef WASM_BUILD
+    m_timestampedBus = dynamic_cast<tNMEA2000_SocketCANTimestamped*>(bus);
+#endif
+
+    // Messages are delivered on the worker thread and only ever enqueued there
+    N2kBusLocker locker(busMutex());
+    s_activeWorker = this;
+    m_bus->SetMsgHandler(&N2kReceiveWorker::onBusMessage);
+}
+
+N2kReceiveWorker::~N2kReceiveWorker()
+{
+    stop();
+
+    N2kBusLocker locker(busMutex());
+    if (s_activeWorker == this) {
+        s_activeWorker = nullptr;
+    }
+}
+
+void N2kReceiveWorker::stop()
+{
+    if (isRunning()) {
+        requestInterruption();
+        wait();
+    }
+}
+
+QRecursiveMutex* N2kReceiveWorker::busMutex()
+{
+    static QRecursiveMutex mutex;
+    return &mutex;
+}
+
+bool N2kReceiveWorker::sendMessage(tNMEA2000* bus, const tN2kMsg& msg)
+{
+    if (!bus) {
+        return false;
+    }
+    N2kBusLocker locker(busMutex());
+    return bus->SendMsg(msg);
+}
+
+void N2kReceiveWorker::run()
+{
+    qDebug() << "N2kReceiveWorker: receive thread started";
+
+    while (!isInterruptionRequested()) {
+        const quint64 receivedBefore = m_received.load(std::memory_order_relaxed);
+        {
+            N2kBusLocker locker(busMutex());
+            m_bus->ParseMessages();
+        }
+
+        // Wake the GUI once per drain cycle rather than once per message
+        if (!m_ring.isEmpty() && !m_notifyPending.exchange(true)) {
+            emit messagesAvailable();
+        }
+
+        // Keep reading back-to-back while frames are arriving, back off when idle
+        if (m_received.load(std::memory_order_relaxed) == receivedBefore) {
+            QThread::usleep(IDLE_POLL_INTERVAL_US);
+        }
+    }
+
+    qDebug() << "N2kReceiveWorker: receive thread stopped";
+}
+
+void N2kReceiveWorker::onBusMessage(const tN2kMsg& msg)
+{
+    // Called from inside ParseMessages() with the bus lock held
+    if (s_activeWorker) {
+        s_activeWorker->enqueue(msg);
+    }
+}
+
+void N2kReceiveWorker::enqueue(const tN2kMsg& msg)
+{
+    N2kReceivedMessage received;
+    received.msg = msg;
+
+    // The message is dispatched right after the frame that completed it was read,
+    // so the interface's last-frame stamp is this message's receive time
+    received.timestamp = m_timestampedBus ? m_timestampedBus->lastFrameTimestamp() : N2kTimestamp::now();
+
+    if (m_ring.tryPush(received)) {
+        m_received.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool N2kReceiveWorker::popMessage(N2kReceivedMessage& received)
+{
+    return m_ring.tryPop(received);
+}
+
+void N2kReceiveWorker::acknowledgeNotification()
+{
+    m_notifyPending.store(false);
+}
+
+N2kReceiveStats N2kReceiveWorker::stats() const
+{
+    N2kReceiveStats s;
+    s.received = m_received.load(std::memory_order_relaxed);
+    s.dropped = m_ring.droppedCount();
+    s.queueDepth = static_cast<int>(m_ring.size());
+    s.peakQueueDepth = static_cast<int>(m_ring.peakDepth());
+    s.capacity = static_cast<int>(m_ring.capacity());
+    return s;
+}
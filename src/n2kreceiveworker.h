@@ -0,0 +1,89 @@
+#ifndef N2KRECEIVEWORKER_H
+#define N2KRECEIVEWORKER_H
+
+#include <QThread>
+#include <QRecursiveMutex>
+#include <QMutexLocker>
+#include <atomic>
+#include <N2kMsg.h>
+#include <NMEA2000.h>
+#include "spscring.h"
+#include "n2ktimestamp.h"
+
+class tNMEA2000_SocketCANTimestamped;
+
+using N2kBusLocker = QMutexLocker<QRecursiveMutex>;
+
+// A received message together with the time its last frame arrived
+struct N2kReceivedMessage {
+    tN2kMsg msg;
+    N2kTimestamp timestamp;
+};
+
+// Snapshot of receive-path health, for display in the main window
+struct N2kReceiveStats {
+    quint64 received = 0;        // Messages pushed into the ring by the worker
+    quint64 dropped = 0;         // Messages discarded because the ring was full
+    int queueDepth = 0;          // Messages waiting for the GUI right now
+    int peakQueueDepth = 0;      // Deepest backlog seen by the worker
+    int capacity = 0;            // Ring size
+};
+
+/**
+ * @brief Receive/parse thread for the NMEA2000 bus.
+ *
+ * The worker owns the ParseMessages() loop of the tNMEA2000 instance and
+ * pushes every complete message into a bounded lock-free SPSC ring. The GUI
+ * thread is told (at most once per drain) via messagesAvailable() and pulls
+ * the messages in batches with popMessage(), so a stalled GUI no longer
+ * stalls the socket.
+ *
+ * tNMEA2000 itself is not thread-safe: any GUI-side access to the bus object
+ * or to a tN2kDeviceList attached to it must hold busMutex().
+ */
+class N2kReceiveWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit N2kReceiveWorker(tNMEA2000* bus, QObject* parent = nullptr);
+    ~N2kReceiveWorker();
+
+    // Stop the thread and wait for it to exit
+    void stop();
+
+    // Consumer side (GUI thread only)
+    bool popMessage(N2kReceivedMessage& received);
+    void acknowledgeNotification();
+    N2kReceiveStats stats() const;
+
+    // Serializes access to the bus object between the worker and the GUI
+    static QRecursiveMutex* busMutex();
+
+    // Send a message with the bus lock held
+    static bool sendMessage(tNMEA2000* bus, const tN2kMsg& msg);
+
+signals:
+    // Emitted from the worker thread when the ring goes from drained to non-empty
+    void messagesAvailable();
+
+protected:
+    void run() override;
+
+private:
+    static void onBusMessage(const tN2kMsg& msg);
+    void enqueue(const tN2kMsg& msg);
+
+    tNMEA2000* m_bus;
+    tNMEA2000_SocketCANTimestamped* m_timestampedBus;  // Non-null when kernel receive stamps are available
+    SpscRing<N2kReceivedMessage> m_ring;
+    std::atomic<quint64> m_received{0};
+    std::atomic<bool> m_notifyPending{false};
+
+    static N2kReceiveWorker* s_activeWorker;
+
+    static const int RING_CAPACITY = 4096;         // ~1 MB of messages, several seconds at full bus load
+    static const int IDLE_POLL_INTERVAL_US = 500;  // Sleep between polls when the bus is quiet
+};
+
+#endif // N2KRECEIVEWORKER_H
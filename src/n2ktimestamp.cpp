@@ -0,0 +1,65 @@
+#include "n2ktimestamp.h"
+#include <QTime>
+#include <QElapsedTimer>
+
+#ifndef WASM_BUILD
+#include <time.h>
+#endif
+
+N2kTimestamp N2kTimestamp::now()
+{
+    N2kTimestamp ts;
+#ifndef WASM_BUILD
+    struct timespec wall;
+    struct timespec mono;
+    clock_gettime(CLOCK_REALTIME, &wall);
+    clock_gettime(CLOCK_MONOTONIC, &mono);
+    ts.wallNs = qint64(wall.tv_sec) * 1000000000LL + wall.tv_nsec;
+    ts.monotonicNs = qint64(mono.tv_sec) * 1000000000LL + mono.tv_nsec;
+#else
+    static QElapsedTimer monotonicClock;
+    if (!monotonicClock.isValid()) {
+        monotonicClock.start();
+    }
+    ts.wallNs = QDateTime::currentMSecsSinceEpoch() * 1000000LL;
+    ts.monotonicNs = monotonicClock.nsecsElapsed();
+#endif
+    return ts;
+}
+
+N2kTimestamp N2kTimestamp::fromWallNs(qint64 wallNs)
+{
+    N2kTimestamp ts;
+    ts.wallNs = wallNs;
+    ts.monotonicNs = wallNs;  // Same timeline, so deltas between loaded rows still work
+    return ts;
+}
+
+QDateTime N2kTimestamp::toDateTime() const
+{
+    return QDateTime::fromMSecsSinceEpoch(wallNs / 1000000LL);
+}
+
+QString N2kTimestamp::toTimeString() const
+{
+    int micros = int((wallNs / 1000LL) % 1000LL);
+    return toDateTime().toString("HH:mm:ss.zzz") + QString("%1").arg(micros, 3, 10, QChar('0'));
+}
+
+qint64 N2kTimestamp::nsecsSince(const N2kTimestamp& earlier) const
+{
+    if (monotonicNs != 0 && earlier.monotonicNs != 0) {
+        return monotonicNs - earlier.monotonicNs;
+    }
+    return wallNs - earlier.wallNs;
+}
+
+QString N2kTimestamp::formatDelta(qint64 deltaNs)
+{
+    return QString("%1 ms").arg(double(deltaNs) / 1000000.0, 0, 'f', 3);
+}
+
+QString N2kTimestamp::toLogField() const
+{
+    return QString("%1,%2%3").arg(wallNs).arg(monotonicNs).arg(fromKernel ? "K" : "");
+}
@@ -0,0 +1,44 @@
+#ifndef N2KTIMESTAMP_H
+#define N2KTIMESTAMP_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QDateTime>
+
+/**
+ * @brief Receive time of a NMEA2000 message, carried from the socket to the log.
+ *
+ * wallNs is nanoseconds since the Unix epoch (for display and saving),
+ * monotonicNs is nanoseconds on CLOCK_MONOTONIC (for inter-frame deltas that
+ * are immune to NTP steps). When the kernel supplied the stamp via
+ * SO_TIMESTAMPNS, fromKernel is set.
+ */
+struct N2kTimestamp {
+    qint64 wallNs = 0;
+    qint64 monotonicNs = 0;
+    bool fromKernel = false;
+
+    bool isValid() const { return wallNs != 0; }
+
+    // Current time from user space (used for sent messages and non-SocketCAN interfaces)
+    static N2kTimestamp now();
+
+    // Build a timestamp from a wall-clock value whose monotonic time is unknown
+    static N2kTimestamp fromWallNs(qint64 wallNs);
+
+    QDateTime toDateTime() const;
+
+    // "HH:mm:ss.zzzuuu" - wall-clock time with microsecond resolution
+    QString toTimeString() const;
+
+    // Nanoseconds elapsed since an earlier timestamp (monotonic when both have it)
+    qint64 nsecsSince(const N2kTimestamp& earlier) const;
+
+    // "12.345 ms"
+    static QString formatDelta(qint64 deltaNs);
+
+    // RX_TIME_NS column of saved logs: "<wall ns>,<monotonic ns>" with a "K" suffix for kernel stamps
+    QString toLogField() const;
+};
+
+#endif // N2KTIMESTAMP_H
@@ -1,5 +1,6 @@
 #include "pgndialog.h"
 #include "toastmanager.h"
+#include "n2kreceiveworker.h"
 
 #ifdef WASM_BUILD
 #include "NMEA2000_WASM.h"
@@ -306,7 +307,7 @@ void PGNDialog::onSendPGN()
         tN2kMsg msgCopy = msg;
         
         // Send the message
-        bool success = nmea2000->SendMsg(msg);
+        bool success = N2kReceiveWorker::sendMessage(nmea2000, msg);
         
         if (success) {
             // Emit signal to notify parent about the transmission
@@ -14,12 +14,18 @@
 #include <QFont>
 #include <QClipboard>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QTime>
+#include <QDateTime>
 #include <QPointer>
+#include <QFontMetrics>
+#include <QSignalBlocker>
 
-PGNLogDialog::PGNLogDialog(QWidget *parent)
+PGNLogDialog::PGNLogDialog(LiveCapture* liveCapture, QWidget *parent)
     : QDialog(parent)
     , m_logTable(nullptr)
+    , m_logModel(nullptr)
+    , m_liveCapture(liveCapture)
     , m_clearButton(nullptr)
     , m_closeButton(nullptr)
     , m_saveButton(nullptr)
@@ -43,7 +49,7 @@ PGNLogDialog::PGNLogDialog(QWidget *parent)
     , m_loadedLogFileName("")    // No loaded log initially
     , m_autoScrollEnabled(true)  // Start with auto-scrolling enabled
     , m_userInteracting(false)   // User not initially interacting
-    , m_dbcDecoder(nullptr)      // Will be initialized in constructor body
+    , m_dbcDecoder(liveCapture->decoder())
     , m_pgnIgnoreEdit(nullptr)
     , m_addPgnIgnoreButton(nullptr)
     , m_removePgnIgnoreButton(nullptr)
@@ -51,14 +57,21 @@ PGNLogDialog::PGNLogDialog(QWidget *parent)
     , m_pgnFilteringEnabled(nullptr)
 {
     setupUI();
-    
-    // Initialize the original DBC decoder - proven stable and fast
-    m_dbcDecoder = new DBCDecoder(this);
-    if (m_dbcDecoder && m_dbcDecoder->isInitialized()) {
-        // DBC Decoder initialized successfully
-    } else {
-        qWarning() << "Failed to create or initialize DBC Decoder";
-    }
+    m_logModel->setDecoder(m_dbcDecoder);
+    
+    // The live capture is appended to once for all windows - this view follows it
+    connect(m_liveCapture, &LiveCapture::rowsAppended, this, &PGNLogDialog::onLiveRowsAppended);
+    connect(m_liveCapture, &LiveCapture::rowsAboutToBeEvicted, this, &PGNLogDialog::onLiveRowsAboutToBeEvicted);
+    connect(m_liveCapture, &LiveCapture::rowsEvicted, this, &PGNLogDialog::onLiveRowsEvicted);
+    connect(m_liveCapture, &LiveCapture::cleared, this, &PGNLogDialog::onLiveCaptureCleared);
+    connect(m_liveCapture, &LiveCapture::budgetChanged, this, &PGNLogDialog::onLiveBudgetChanged);
+    connect(m_liveCapture, &LiveCapture::budgetReached, this, &PGNLogDialog::onLiveBudgetReached);
+    connect(m_liveCapture, &LiveCapture::spillFailed, this, [this](const QString& errorString) {
+        if (isVisible()) {
+            ToastManager::instance()->showError(
+                QString("Could not write capture spill file, dropping oldest messages: %1").arg(errorString), this);
+        }
+    });
     
     setWindowTitle("NMEA2000 PGN Message Log - LIVE");
     setModal(false);
@@ -72,6 +85,9 @@ PGNLogDialog::~PGNLogDialog()
 {
     // Save settings when dialog is destroyed
     saveSettings();
+    stopLoader();
+    stopQueryWorker(m_filterQueryWorker);
+    stopQueryWorker(m_searchQueryWorker);
 }
 
 void PGNLogDialog::setupUI()
@@ -81,7 +97,27 @@ void PGNLogDialog::setupUI()
     // Status label
     m_statusLabel = new QLabel("Live NMEA2000 PGN message log - Real-time updates");
     m_statusLabel->setStyleSheet("font-weight: bold; color: #333; padding: 5px;");
-    mainLayout->addWidget(m_statusLabel);
+    
+    // Retained window / eviction statistics, refreshed on a timer rather than per message
+    m_captureStatsLabel = new QLabel();
+    m_captureStatsLabel->setStyleSheet("color: #666666; padding: 5px;");
+    
+    QHBoxLayout* statusLayout = new QHBoxLayout();
+    // Log file load progress, only shown while a loader is running
+    m_loadProgressBar = new QProgressBar();
+    m_loadProgressBar->setRange(0, 100);
+    m_loadProgressBar->setMaximumWidth(200);
+    m_loadProgressBar->setVisible(false);
+    m_cancelLoadButton = new QPushButton("Cancel");
+    m_cancelLoadButton->setVisible(false);
+    connect(m_cancelLoadButton, &QPushButton::clicked, this, &PGNLogDialog::onCancelLoadClicked);
+    
+    statusLayout->addWidget(m_statusLabel);
+    statusLayout->addWidget(m_loadProgressBar);
+    statusLayout->addWidget(m_cancelLoadButton);
+    statusLayout->addStretch();
+    statusLayout->addWidget(m_captureStatsLabel);
+    mainLayout->addLayout(statusLayout);
     
     // Filter toolbar - single horizontal line
     QHBoxLayout* filterToolbar = new QHBoxLayout();
@@ -118,6 +154,21 @@ void PGNLogDialog::setupUI()
     // Add spacing
     filterToolbar->addSpacing(20);
     
+    // Query filter - narrows the view by fields and decoded signals, applied with Enter
+    filterToolbar->addWidget(new QLabel("Query:"));
+    m_queryFilterEdit = new QLineEdit();
+    m_queryFilterEdit->setPlaceholderText("e.g. pgn==127488 && Speed > 2000");
+    m_queryFilterEdit->setToolTip("Fields: pgn, src, dst, prio, len, sent, data[n], or any DBC signal name\n"
+                                  "Operators: == != < <= > >= && || ! ( )\n"
+                                  "Time windows: decoded.Zone_ID == 3 within 5s of pgn==126208\n"
+                                  "Press Enter to apply");
+    m_queryFilterEdit->setClearButtonEnabled(true);
+    m_queryFilterEdit->setMinimumWidth(220);
+    filterToolbar->addWidget(m_queryFilterEdit);
+    
+    // Add spacing
+    filterToolbar->addSpacing(20);
+    
     // Clear filters button
     m_clearFiltersButton = new QPushButton("Clear Filters");
     filterToolbar->addWidget(m_clearFiltersButton);
@@ -142,6 +193,13 @@ void PGNLogDialog::setupUI()
     connect(m_filterLogicCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &PGNLogDialog::onFilterLogicChanged);
     connect(m_clearFiltersButton, &QPushButton::clicked, this, &PGNLogDialog::onClearFilters);
+    connect(m_queryFilterEdit, &QLineEdit::returnPressed, this, &PGNLogDialog::onQueryFilterApplied);
+    connect(m_queryFilterEdit, &QLineEdit::textChanged, this, [this](const QString& text) {
+        // The clear button empties the field without pressing Enter
+        if (text.isEmpty() && m_queryFilter) {
+            onQueryFilterApplied();
+        }
+    });
     
     // PGN Filtering Section - Compact layout
     QGroupBox* pgnFilterGroup = new QGroupBox("PGN Filtering");
@@ -214,39 +272,160 @@ void PGNLogDialog::setupUI()
     m_decodingEnabled->setToolTip("Decode known NMEA2000 messages using DBC definitions");
     optionsLayout->addWidget(m_decodingEnabled);
     
+    optionsLayout->addSpacing(20);
+    
+    // Change-only view - every message is still captured, repeats are counted on the row they repeat
+    m_changesOnlyCheck = new QCheckBox("Changes only");
+    m_changesOnlyCheck->setToolTip("Show a message only when its payload differs from the previous one\n"
+                                   "with the same PGN, source and destination");
+    optionsLayout->addWidget(m_changesOnlyCheck);
+    
+    optionsLayout->addSpacing(20);
+    
+    // Capture budget - bounds memory on long-running captures
+    optionsLayout->addWidget(new QLabel("Retain:"));
+    m_budgetLimitCombo = new QComboBox();
+    m_budgetLimitCombo->addItem("Everything", CaptureBudget::Unlimited);
+    m_budgetLimitCombo->addItem("Last messages", CaptureBudget::MessageCount);
+    m_budgetLimitCombo->addItem("Last megabytes", CaptureBudget::Megabytes);
+    m_budgetLimitCombo->addItem("Last minutes", CaptureBudget::Minutes);
+    m_budgetLimitCombo->setToolTip("Limit how much of the live capture is kept in memory");
+    optionsLayout->addWidget(m_budgetLimitCombo);
+    
+    m_budgetValueSpin = new QSpinBox();
+    m_budgetValueSpin->setRange(1, 100000000);
+    m_budgetValueSpin->setValue(100000);
+    m_budgetValueSpin->setEnabled(false);
+    optionsLayout->addWidget(m_budgetValueSpin);
+    
+    optionsLayout->addWidget(new QLabel("When full:"));
+    m_overflowPolicyCombo = new QComboBox();
+    m_overflowPolicyCombo->addItem("Drop oldest", CaptureBudget::DropOldest);
+    m_overflowPolicyCombo->addItem("Stop capture", CaptureBudget::StopCapture);
+    m_overflowPolicyCombo->addItem("Spill to disk", CaptureBudget::SpillToDisk);
+    m_overflowPolicyCombo->setToolTip(QString("Spilled messages are written to %1").arg(CaptureSpillWriter::spillDirectory()));
+    m_overflowPolicyCombo->setEnabled(false);
+    optionsLayout->addWidget(m_overflowPolicyCombo);
+    
     optionsLayout->addStretch();
     mainLayout->addLayout(optionsLayout);
     
+    // Navigation - jump to a time, or step through the messages of a PGN and/or source
+    QHBoxLayout* navigationLayout = new QHBoxLayout();
+    navigationLayout->addWidget(new QLabel("Go to:"));
+    m_goToTimeEdit = new QDateTimeEdit(QDateTime::currentDateTime());
+    m_goToTimeEdit->setDisplayFormat("yyyy-MM-dd HH:mm:ss.zzz");
+    m_goToTimeEdit->setCalendarPopup(true);
+    m_goToTimeEdit->setToolTip("Select the first message at or after this time");
+    navigationLayout->addWidget(m_goToTimeEdit);
+    QPushButton* goToTimeButton = new QPushButton("Go");
+    goToTimeButton->setFixedWidth(45);
+    navigationLayout->addWidget(goToTimeButton);
+    
+    navigationLayout->addSpacing(20);
+    
+    navigationLayout->addWidget(new QLabel("Find PGN:"));
+    m_findPgnEdit = new QLineEdit();
+    m_findPgnEdit->setPlaceholderText("any");
+    m_findPgnEdit->setFixedWidth(80);
+    navigationLayout->addWidget(m_findPgnEdit);
+    navigationLayout->addWidget(new QLabel("from:"));
+    m_findSourceEdit = new QLineEdit();
+    m_findSourceEdit->setPlaceholderText("any");
+    m_findSourceEdit->setToolTip("Source address, decimal or hex such as 0x23");
+    m_findSourceEdit->setFixedWidth(60);
+    navigationLayout->addWidget(m_findSourceEdit);
+    QPushButton* findPreviousButton = new QPushButton("◀");
+    findPreviousButton->setFixedSize(30, 24);
+    findPreviousButton->setToolTip("Previous message with this PGN and source");
+    navigationLayout->addWidget(findPreviousButton);
+    QPushButton* findNextButton = new QPushButton("▶");
+    findNextButton->setFixedSize(30, 24);
+    findNextButton->setToolTip("Next message with this PGN and source");
+    navigationLayout->addWidget(findNextButton);
+    
+    navigationLayout->addStretch();
+    mainLayout->addLayout(navigationLayout);
+    
+    connect(goToTimeButton, &QPushButton::clicked, this, &PGNLogDialog::onGoToTimeClicked);
+    connect(findPreviousButton, &QPushButton::clicked, this, &PGNLogDialog::onFindPreviousByKey);
+    connect(findNextButton, &QPushButton::clicked, this, &PGNLogDialog::onFindNextByKey);
+    connect(m_findPgnEdit, &QLineEdit::returnPressed, this, &PGNLogDialog::onFindNextByKey);
+    connect(m_findSourceEdit, &QLineEdit::returnPressed, this, &PGNLogDialog::onFindNextByKey);
+    
+    connect(m_budgetLimitCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() {
+        // Pick a sensible starting value for the new unit
+        const int limit = m_budgetLimitCombo->currentData().toInt();
+        m_budgetValueSpin->setSuffix(budgetValueSuffix(limit));
+        switch (limit) {
+        case CaptureBudget::MessageCount: m_budgetValueSpin->setValue(100000); break;
+        case CaptureBudget::Megabytes:    m_budgetValueSpin->setValue(256);    break;
+        case CaptureBudget::Minutes:      m_budgetValueSpin->setValue(60);     break;
+        default:                          break;
+        }
+        onCaptureBudgetChanged();
+    });
+    connect(m_budgetValueSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &PGNLogDialog::onCaptureBudgetChanged);
+    connect(m_overflowPolicyCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &PGNLogDialog::onCaptureBudgetChanged);
+    
+    m_captureStatsTimer = new QTimer(this);
+    connect(m_captureStatsTimer, &QTimer::timeout, this, &PGNLogDialog::updateCaptureStats);
+    m_captureStatsTimer->start(500);
+    
+    // Started by the first message of each batch, so an idle bus costs nothing
+    m_batchCommitTimer = new QTimer(this);
+    m_batchCommitTimer->setSingleShot(true);
+    m_batchCommitTimer->setInterval(1000 / m_viewRefreshHz);
+    connect(m_batchCommitTimer, &QTimer::timeout, this, &PGNLogDialog::commitPendingMessages);
+    
     connect(m_decodingEnabled, &QCheckBox::toggled, this, &PGNLogDialog::onToggleDecoding);
-
-    // Log table
-    m_logTable = new QTableWidget();
-    m_logTable->setColumnCount(9);
-    QStringList headers;
-    headers << "Timestamp" << "PGN" << "Message Name" << "Pri" << "Src" << "Dst" << "Len" << "Raw Data" << "Decoded";
-    m_logTable->setHorizontalHeaderLabels(headers);
+    connect(m_changesOnlyCheck, &QCheckBox::toggled, this, &PGNLogDialog::refreshTableFilter);
+
+    // Log table - a virtual view over the capture store, text is only built for visible rows
+    m_logModel = new PGNLogModel(m_liveCapture->store(), this);
+    m_logTable = new QTableView();
+    m_logTable->setModel(m_logModel);
+    m_logModel->setDeviceNameResolver([this](quint8 address) {
+        return deviceName(address);
+    });
+    m_searchDelegate = new SearchHighlightDelegate(m_logTable);
+    m_logTable->setItemDelegate(m_searchDelegate);
+    
+    // Set smaller font for the table
+    QFont tableFont("Consolas, Monaco, monospace", 9);
+    m_logTable->setFont(tableFont);
+    QFontMetrics metrics(tableFont);
     
     // Configure table
     m_logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_logTable->setAlternatingRowColors(true);
-    m_logTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents); // Timestamp
-    m_logTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::ResizeToContents); // PGN
-    m_logTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Interactive); // Message Name
-    m_logTable->horizontalHeader()->setSectionResizeMode(3, QHeaderView::ResizeToContents); // Priority
-    m_logTable->horizontalHeader()->setSectionResizeMode(4, QHeaderView::ResizeToContents); // Source
-    m_logTable->horizontalHeader()->setSectionResizeMode(5, QHeaderView::ResizeToContents); // Destination
-    m_logTable->horizontalHeader()->setSectionResizeMode(6, QHeaderView::ResizeToContents); // Length
-    m_logTable->horizontalHeader()->setSectionResizeMode(7, QHeaderView::Interactive); // Raw Data - interactive sizing
-    m_logTable->horizontalHeader()->setSectionResizeMode(8, QHeaderView::Stretch); // Decoded - stretch to fill
-    m_logTable->verticalHeader()->setVisible(false);
+    m_logTable->setWordWrap(false);
     m_logTable->setSortingEnabled(false);
     
-    // Set smaller font for the table
-    QFont tableFont("Consolas, Monaco, monospace", 9);
-    m_logTable->setFont(tableFont);
+    // Fixed column widths - sizing to contents would make the view measure rows on every insert
+    QHeaderView* header = m_logTable->horizontalHeader();
+    header->setSectionResizeMode(QHeaderView::Interactive);
+    header->resizeSection(PGNLogModel::TimestampColumn, metrics.horizontalAdvance("00:00:00.000000") + 16);
+    header->resizeSection(PGNLogModel::PgnColumn, metrics.horizontalAdvance("0000000") + 16);
+    header->resizeSection(PGNLogModel::NameColumn, metrics.horizontalAdvance("M") * 28);
+    header->resizeSection(PGNLogModel::PriorityColumn, metrics.horizontalAdvance("Pri") + 16);
+    header->resizeSection(PGNLogModel::SourceColumn, metrics.horizontalAdvance("0x00") + 16);
+    header->resizeSection(PGNLogModel::DestinationColumn, metrics.horizontalAdvance("0x00") + 16);
+    header->resizeSection(PGNLogModel::LengthColumn, metrics.horizontalAdvance("Len") + 16);
+    header->resizeSection(PGNLogModel::RepeatsColumn, metrics.horizontalAdvance("Repeats") + 16);
+    header->resizeSection(PGNLogModel::LastSeenColumn, metrics.horizontalAdvance("00:00:00.000000") + 16);
+    m_logTable->setColumnHidden(PGNLogModel::RepeatsColumn, true);
+    m_logTable->setColumnHidden(PGNLogModel::LastSeenColumn, true);
+    header->resizeSection(PGNLogModel::RawDataColumn, metrics.horizontalAdvance("00 00 00 00 00 00 00 00") + 16);
+    header->setSectionResizeMode(PGNLogModel::DecodedColumn, QHeaderView::Stretch); // Decoded - stretch to fill
+    
+    // Uniform row heights so the view never has to measure rows
+    m_logTable->verticalHeader()->setVisible(false);
+    m_logTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_logTable->verticalHeader()->setDefaultSectionSize(metrics.height() + 6);
     
     // Connect table click signal
-    connect(m_logTable, &QTableWidget::cellClicked, this, &PGNLogDialog::onTableItemClicked);
+    connect(m_logTable, &QTableView::clicked, this, &PGNLogDialog::onTableItemClicked);
     
     // Monitor scroll position to detect when user scrolls to bottom
     connect(m_logTable->verticalScrollBar(), &QScrollBar::valueChanged, 
@@ -254,7 +433,7 @@ void PGNLogDialog::setupUI()
     
     // Enable context menu for right-click to add PGN to filter
     m_logTable->setContextMenuPolicy(Qt::CustomContextMenu);
-    connect(m_logTable, &QTableWidget::customContextMenuRequested, 
+    connect(m_logTable, &QTableView::customContextMenuRequested, 
             this, &PGNLogDialog::onTableContextMenu);
     
     mainLayout->addWidget(m_logTable);
@@ -300,259 +479,51 @@ void PGNLogDialog::setupUI()
     setupSearchShortcuts();
 }
 
-void PGNLogDialog::appendMessage(const tN2kMsg& msg)
+void PGNLogDialog::onLiveRowsAppended()
 {
-    // Check if logging is stopped - if so, don't add new messages
-    if (m_logStopped) {
-        return; 
-    }
-    
-    // If paused, continue adding messages but don't scroll (for examination)
-    // If user is interacting, continue logging but don't auto-scroll
-    
-    // Apply filters
-    if (!messagePassesFilter(msg)) {
-        // Debug: Log when messages are filtered out
-#if 0
-        static int filteredCount = 0;
-        filteredCount++;
-        if (filteredCount % 10 == 0) { // Log every 10th filtered message to avoid spam
-            qDebug() << "Message PGN" << msg.PGN << "filtered out (" << filteredCount << "total filtered)";
-        }
-#endif
-        return; // Skip this message
-    }
-    
-    // Format hex data payload
-    QString hexData = "";
-    for (int i = 0; i < msg.DataLen; i++) {
-        if (i > 0) hexData += " ";
-        hexData += QString("%1").arg(msg.Data[i], 2, 16, QChar('0')).toUpper();
-    }
-    if (hexData.isEmpty()) {
-        hexData = "(no data)";
+    // A stopped view keeps its rows; the capture goes on for the other windows
+    if (m_logStopped || !isLiveView()) {
+        return;
     }
-
-    // Get decoded message name and data using original decoder with enhancements
-    // Original decoder works with PGN directly, not CAN ID
     
-    QString messageName;
-    if (m_dbcDecoder && m_dbcDecoder->canDecode(msg.PGN)) {
-        messageName = m_dbcDecoder->getCleanMessageName(msg.PGN);  // Use enhanced formatting
-    } else {
-        messageName = QString("PGN %1").arg(msg.PGN);
+    // If paused, continue adding messages but don't scroll (for examination).
+    // The rows reach the table with the rest of their batch in commitPendingMessages()
+    if (!m_batchCommitTimer->isActive()) {
+        m_batchCommitTimer->start();
     }
-    
-    // Prepare decoded data
-    QString decodedData = "";
-    if (m_decodingEnabled->isChecked() && m_dbcDecoder && m_dbcDecoder->canDecode(msg.PGN)) {
-        decodedData = m_dbcDecoder->getFormattedDecoded(msg);
-        if (decodedData.isEmpty() || decodedData == "Raw data" || decodedData.startsWith("PGN")) {
-            decodedData = "(not decoded)";
-        }
-    } else {
-        decodedData = "(decoding disabled)";
-    }
-
-    // Add new row to table
-    int row = m_logTable->rowCount();
-    m_logTable->insertRow(row);
-
-    // Timestamp column (0)
-    QDateTime now = QDateTime::currentDateTime();
-    QString tsText;
-    if (m_timestampMode == Absolute) {
-        tsText = now.toString("HH:mm:ss.zzz");
-    } else {
-        qint64 deltaMs = 0;
-        if (!m_messageTimestamps.isEmpty()) {
-            deltaMs = m_messageTimestamps.last().msecsTo(now);
-        }
-        tsText = QString::number(deltaMs) + " ms";
-    }
-    m_messageTimestamps.append(now);
-    QTableWidgetItem* tsItem = new QTableWidgetItem(tsText);
-    tsItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-    m_logTable->setItem(row, 0, tsItem);
-
-    // Column 1: PGN
-    QTableWidgetItem* pgnItem = new QTableWidgetItem(QString::number(msg.PGN));
-    pgnItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-    m_logTable->setItem(row, 1, pgnItem);
-
-    // Column 2: Message Name
-    QTableWidgetItem* nameItem = new QTableWidgetItem(messageName);
-    nameItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    m_logTable->setItem(row, 2, nameItem);
-
-    // Column 3: Priority
-    QTableWidgetItem* priItem = new QTableWidgetItem(QString::number(msg.Priority));
-    priItem->setTextAlignment(Qt::AlignCenter);
-    m_logTable->setItem(row, 3, priItem);
-
-    // Column 4: Source
-    QTableWidgetItem* srcItem = new QTableWidgetItem(QString("0x%1").arg(QString("%1").arg(msg.Source, 2, 16, QChar('0')).toUpper()));
-    srcItem->setTextAlignment(Qt::AlignCenter);
-    m_logTable->setItem(row, 4, srcItem);
-
-    // Column 5: Destination
-    QString destText = QString("0x%1").arg(QString("%1").arg(msg.Destination, 2, 16, QChar('0')).toUpper());
-    QTableWidgetItem* destItem = new QTableWidgetItem(destText);
-    destItem->setTextAlignment(Qt::AlignCenter);
-    m_logTable->setItem(row, 5, destItem);
-
-    // Column 6: Length
-    QTableWidgetItem* lenItem = new QTableWidgetItem(QString::number(msg.DataLen));
-    lenItem->setTextAlignment(Qt::AlignCenter);
-    m_logTable->setItem(row, 6, lenItem);
-
-    // Column 7: Raw Data
-    QTableWidgetItem* rawDataItem = new QTableWidgetItem(hexData);
-    rawDataItem->setFont(QFont("Consolas, Monaco, monospace", 9));
-    m_logTable->setItem(row, 7, rawDataItem);
-
-    // Column 8: Decoded Data
-    QTableWidgetItem* decodedItem = new QTableWidgetItem(decodedData);
-    decodedItem->setFont(QFont("Consolas, Monaco, monospace", 9));
-    m_logTable->setItem(row, 8, decodedItem);
-
-    // Auto-scroll to bottom if enabled
-    scrollToBottom();
-    
-    // Emit signal to notify that a new message was added
-    emit messageCountChanged(m_logTable->rowCount());
 }
 
-void PGNLogDialog::appendSentMessage(const tN2kMsg& msg)
+void PGNLogDialog::commitPendingMessages()
 {
-    // Check if logging is stopped - if so, don't add new messages
-    if (m_logStopped) {
-        return; 
-    }
-    
-    // If paused or user is interacting, continue adding messages but don't scroll
-    
-    // Apply filters (sent messages should also be filtered)
-    if (!messagePassesFilter(msg)) {
-        return; // Skip this message
-    }
-
-    // Format hex data payload
-    QString hexData = "";
-    for (int i = 0; i < msg.DataLen; i++) {
-        if (i > 0) hexData += " ";
-        hexData += QString("%1").arg(msg.Data[i], 2, 16, QChar('0')).toUpper();
-    }
-    if (hexData.isEmpty()) {
-        hexData = "(no data)";
-    }
-
-    // Get decoded message name and data using original decoder with enhancements (sent messages)
+    m_batchCommitTimer->stop();
     
-    QString messageName;
-    if (m_dbcDecoder && m_dbcDecoder->canDecode(msg.PGN)) {
-        messageName = m_dbcDecoder->getCleanMessageName(msg.PGN);  // Use enhanced formatting
-    } else {
-        messageName = QString("PGN %1").arg(msg.PGN);
-    }
-    
-    // Prepare decoded data for sent messages
-    QString decodedData = "";
-    if (m_decodingEnabled->isChecked() && m_dbcDecoder && m_dbcDecoder->canDecode(msg.PGN)) {
-        decodedData = m_dbcDecoder->getFormattedDecoded(msg);
-        if (decodedData.isEmpty() || decodedData == "Raw data" || decodedData.startsWith("PGN")) {
-            decodedData = "(not decoded)";
-        }
-    } else {
-        decodedData = "(decoding disabled)";
+    if (m_logStopped || !m_logModel->commitPendingRows()) {
+        return;
     }
-
-    // Add new row to table
-    int row = m_logTable->rowCount();
-    m_logTable->insertRow(row);
-    
-    QColor blueColor(0, 0, 255);
-    
-    // Timestamp column (0)
-    QDateTime now = QDateTime::currentDateTime();
-    QString tsText;
-    if (m_timestampMode == Absolute) {
-        tsText = now.toString("HH:mm:ss.zzz");
-    } else {
-        qint64 deltaMs = 0;
-        if (!m_messageTimestamps.isEmpty()) {
-            deltaMs = m_messageTimestamps.last().msecsTo(now);
-        }
-        tsText = QString::number(deltaMs) + " ms";
-    }
-    m_messageTimestamps.append(now);
-    QTableWidgetItem* tsItem = new QTableWidgetItem(tsText);
-    tsItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-    tsItem->setForeground(QBrush(blueColor));
-    m_logTable->setItem(row, 0, tsItem);
-    
-    // Column 1: PGN (without prefix since blue highlighting indicates sent messages)
-    QTableWidgetItem* pgnItem = new QTableWidgetItem(QString::number(msg.PGN));
-    pgnItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-    pgnItem->setForeground(QBrush(blueColor));
-    m_logTable->setItem(row, 1, pgnItem);
-    
-    // Column 2: Message Name
-    QTableWidgetItem* nameItem = new QTableWidgetItem(messageName);
-    nameItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    nameItem->setForeground(QBrush(blueColor));
-    m_logTable->setItem(row, 2, nameItem);
-    
-    // Column 3: Priority
-    QTableWidgetItem* priItem = new QTableWidgetItem(QString::number(msg.Priority));
-    priItem->setTextAlignment(Qt::AlignCenter);
-    priItem->setForeground(QBrush(blueColor));
-    m_logTable->setItem(row, 3, priItem);
-    
-    // Column 4: Source
-    QTableWidgetItem* srcItem = new QTableWidgetItem(QString("0x%1").arg(QString("%1").arg(msg.Source, 2, 16, QChar('0')).toUpper()));
-    srcItem->setTextAlignment(Qt::AlignCenter);
-    srcItem->setForeground(QBrush(blueColor));
-    m_logTable->setItem(row, 4, srcItem);
-    
-    // Column 5: Destination
-    QString destText = QString("0x%1").arg(QString("%1").arg(msg.Destination, 2, 16, QChar('0')).toUpper());
-    QTableWidgetItem* destItem = new QTableWidgetItem(destText);
-    destItem->setTextAlignment(Qt::AlignCenter);
-    destItem->setForeground(QBrush(blueColor));
-    m_logTable->setItem(row, 5, destItem);
-    
-    // Column 6: Length
-    QTableWidgetItem* lenItem = new QTableWidgetItem(QString::number(msg.DataLen));
-    lenItem->setTextAlignment(Qt::AlignCenter);
-    lenItem->setForeground(QBrush(blueColor));
-    m_logTable->setItem(row, 6, lenItem);
-    
-    // Column 7: Raw Data
-    QTableWidgetItem* rawDataItem = new QTableWidgetItem(hexData);
-    rawDataItem->setFont(QFont("Consolas, Monaco, monospace", 9));
-    rawDataItem->setForeground(QBrush(blueColor));
-    m_logTable->setItem(row, 7, rawDataItem);
-    
-    // Column 8: Decoded Data
-    QTableWidgetItem* decodedItem = new QTableWidgetItem(decodedData);
-    decodedItem->setFont(QFont("Consolas, Monaco, monospace", 9));
-    decodedItem->setForeground(QBrush(blueColor));
-    m_logTable->setItem(row, 8, decodedItem);
     
     // Auto-scroll to bottom if enabled
     scrollToBottom();
     
-    // Emit signal to notify that a new message was added
-    emit messageCountChanged(m_logTable->rowCount());
+    // Emit signal to notify that new messages were added
+    emit messageCountChanged(m_logModel->rowCount());
 }
 
 void PGNLogDialog::clearLog()
 {
-    int messageCount = m_logTable->rowCount();
+    stopLoader();
+    stopQueryWorker(m_filterQueryWorker);
+    stopQueryWorker(m_searchQueryWorker);
+    
+    int messageCount = m_logModel->rowCount();
     
-    m_logTable->setRowCount(0);
-    m_messageTimestamps.clear();
+    // Clearing a loaded log goes back to the live capture; clearing the live capture clears it for every window
+    if (isLiveView()) {
+        m_liveCapture->clear();
+    } else {
+        showCapture(m_liveCapture->store());
+        m_fileStore.clear();
+        m_loadedDeviceNames.clear();
+    }
     
     // Reset to running state when clearing
     m_logPaused = false;
@@ -585,14 +556,33 @@ void PGNLogDialog::clearLog()
 
 void PGNLogDialog::clearLogForLoad()
 {
-    // Clear table and timestamps without changing logging state
-    m_logTable->setRowCount(0);
-    m_messageTimestamps.clear();
+    // Loaded messages go into this window's own store - the live capture carries on for the others
+    m_fileStore.clear();
+    showCapture(&m_fileStore);
+    m_loadedDeviceNames.clear();
     
     // Keep logging stopped and buttons in their current state
     // Status will be updated after load completes
 }
 
+void PGNLogDialog::showCapture(CaptureStore* store)
+{
+    stopQueryWorker(m_filterQueryWorker);
+    stopQueryWorker(m_searchQueryWorker);
+    m_batchCommitTimer->stop();
+    
+    m_logModel->setStore(store);
+    if (m_logModel->isQueryScanPending()) {
+        startFilterQuery();
+    }
+    
+    // Search results were view rows of the other store
+    if (!m_searchResults.isEmpty()) {
+        clearSearchState();
+        updateSearchResultsLabel();
+    }
+}
+
 void PGNLogDialog::onCloseClicked()
 {
     hide(); // Hide instead of close so it can be reopened
@@ -600,7 +590,10 @@ void PGNLogDialog::onCloseClicked()
 
 void PGNLogDialog::onSaveLogClicked()
 {
-    if (m_logTable->rowCount() == 0) {
+    // Save exactly what the table shows, including the batch still waiting for the timer
+    commitPendingMessages();
+    
+    if (m_logModel->rowCount() == 0) {
         QMessageBox::information(this, "Save Log", "No messages to save. The log is empty.");
         return;
     }
@@ -609,34 +602,70 @@ void PGNLogDialog::onSaveLogClicked()
     QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
     QString defaultFileName = QString("nmea2000_log_%1.pgnlog").arg(timestamp);
     
-    // Show file save dialog
+    // Show file save dialog - binary capture by default, the text log is kept as an export format
+    const QString binaryFilter = "PGN Capture Files (*.pgnlog)";
+    const QString textFilter = "PGN Text Log (*.pgnlog *.txt)";
+    QString selectedFilter = binaryFilter;
     QString fileName = QFileDialog::getSaveFileName(
         this,
         "Save PGN Log",
         defaultFileName,
-        "PGN Log Files (*.pgnlog);;Text Files (*.txt);;All Files (*)"
+        binaryFilter + ";;" + textFilter,
+        &selectedFilter
     );
     
     if (fileName.isEmpty()) {
         return; // User cancelled
     }
     
-    // Write log to file
-    QFile file(fileName);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    // The live capture is shared by every window - a filtered view saves the rows it shows
+    const CaptureStore* store = m_logModel->store();
+    CaptureStore visibleRows;
+    if (m_logModel->rowCount() != store->size()) {
+        visibleRows.reserve(m_logModel->rowCount());
+        for (int row = 0; row < m_logModel->rowCount(); row++) {
+            visibleRows.appendFrom(*store, m_logModel->storeRow(row));
+        }
+        store = &visibleRows;
+    }
+    
+    bool saved;
+    QString errorString;
+    if (selectedFilter == textFilter) {
+        saved = saveTextLog(fileName, *store, &errorString);
+    } else {
+        saved = CaptureFile::save(fileName, *store, captureDeviceNames(*store), &errorString);
+    }
+    
+    if (!saved) {
         ToastManager::instance()->showError(
-            QString("Could not save log file: %1").arg(file.errorString()), this);
+            QString("Could not save log file: %1").arg(errorString), this);
         return;
     }
     
+    // Show success toast notification
+    ToastManager::instance()->showSuccess(
+        QString("Log saved successfully! %1 messages exported to %2")
+        .arg(store->size())
+        .arg(QFileInfo(fileName).fileName()), this);
+}
+
+bool PGNLogDialog::saveTextLog(const QString& fileName, const CaptureStore& store, QString* errorString)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        *errorString = file.errorString();
+        return false;
+    }
+    
     QTextStream out(&file);
     
     // Write structured header
     out << "# NMEA2000 PGN Message Log\n";
     out << "# Generated by Lumitec Poco Tester\n";
-    out << "# Format Version: 1.0\n";
+    out << "# Format Version: 1.1\n";
     out << "# Export Time: " << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss") << "\n";
-    out << "# Total Messages: " << m_logTable->rowCount() << "\n";
+    out << "# Total Messages: " << store.size() << "\n";
     
     // Write filter information if active
     if (m_sourceFilterActive || m_destinationFilterActive) {
@@ -653,51 +682,35 @@ void PGNLogDialog::onSaveLogClicked()
     }
     
     out << "#\n";
-    out << "# Format: TIMESTAMP | PGN | PRIORITY | SOURCE | DESTINATION | LENGTH | RAW_DATA\n";
+    out << "# Format: TIMESTAMP | PGN | PRIORITY | SOURCE | DESTINATION | LENGTH | RAW_DATA | RX_TIME_NS\n";
     out << "# All values are preserved in original format for exact reconstruction\n";
+    out << "# RX_TIME_NS is <wall clock ns>,<monotonic ns>, suffixed with K when stamped by the kernel\n";
     out << "# Device names are included in decoded comments for readability\n";
     out << "#\n";
     
     // Write all log entries in structured format
-    for (int row = 0; row < m_logTable->rowCount(); row++) {
-        QStringList messageData;
+    for (int row = 0; row < store.size(); row++) {
+        // Format: TIMESTAMP | PGN | PRIORITY | SOURCE | DESTINATION | LENGTH | RAW_DATA | RX_TIME_NS
+        out << PGNLogModel::logRecordLine(store, row) << "\n";
         
-        // Extract core message data for reconstruction
-        QString timestamp = m_logTable->item(row, 0) ? m_logTable->item(row, 0)->text() : "";
-        QString pgn = m_logTable->item(row, 1) ? m_logTable->item(row, 1)->text() : "";
-        QString priority = m_logTable->item(row, 3) ? m_logTable->item(row, 3)->text() : "";
-        QString source = m_logTable->item(row, 4) ? m_logTable->item(row, 4)->text() : "";
-        QString destination = m_logTable->item(row, 5) ? m_logTable->item(row, 5)->text() : "";
-        QString length = m_logTable->item(row, 6) ? m_logTable->item(row, 6)->text() : "";
-        QString rawData = m_logTable->item(row, 7) ? m_logTable->item(row, 7)->text() : "";
-        
-        // PGN field no longer has "Sent:" prefix since we removed it
-        
-        // Format: TIMESTAMP | PGN | PRIORITY | SOURCE | DESTINATION | LENGTH | RAW_DATA
-        messageData << timestamp << pgn << priority << source << destination << length << rawData;
-        out << messageData.join(" | ") << "\n";
+        QString pgn = QString::number(store.pgn(row));
+        QString source = PGNLogModel::addressText(store.source(row));
+        QString destination = PGNLogModel::addressText(store.destination(row));
         
         // Append current decoded information as human-readable comments with device names
-        QString messageName = m_logTable->item(row, 2) ? m_logTable->item(row, 2)->text() : "";
+        QString messageName = m_dbcDecoder && m_dbcDecoder->canDecode(store.pgn(row))
+                              ? m_dbcDecoder->getCleanMessageName(store.pgn(row)) : QString("PGN %1").arg(pgn);
         
         // Get device names for the comments section
         QString sourceName = "";
         QString destName = "";
         
-        if (m_deviceNameResolver) {
-            bool ok;
-            uint8_t srcAddr = source.toUInt(&ok, 16);
-            if (ok) {
-                sourceName = m_deviceNameResolver(srcAddr);
-            }
-            
-            uint8_t destAddr = destination.toUInt(&ok, 16);
-            if (ok) {
-                destName = m_deviceNameResolver(destAddr);
-                if (destAddr == 255) {
-                    destName = "Broadcast";
-                }
-            }
+        sourceName = deviceName(store.source(row));
+        
+        uint8_t destAddr = store.destination(row);
+        destName = deviceName(destAddr);
+        if (destAddr == 255) {
+            destName = "Broadcast";
         }
         
         // Add device name information in comments
@@ -712,47 +725,20 @@ void PGNLogDialog::onSaveLogClicked()
         if (!messageName.isEmpty() && messageName != QString("PGN %1").arg(pgn)) {
             out << "#   Message: " << pgn << " - " << messageName << "\n";
         }        // Reconstruct message for clean decoding without reserved fields
-        if (m_dbcDecoder && m_decodingEnabled->isChecked()) {
-            bool ok;
-            uint32_t pgnNum = pgn.toUInt(&ok);
-            if (ok && m_dbcDecoder->canDecode(pgnNum)) {
-                // Parse raw data to reconstruct message
-                QStringList hexBytes = rawData.split(" ", Qt::SkipEmptyParts);
-                uint8_t dataLen = length.toUInt(&ok);
-                if (ok && !rawData.isEmpty() && rawData != "(no data)") {
-                    // Reconstruct N2K message
-                    tN2kMsg reconstructedMsg;
-                    reconstructedMsg.PGN = pgnNum;
-                    reconstructedMsg.Priority = priority.toUInt(&ok) ? priority.toUInt() : 6;
-                    reconstructedMsg.Source = source.toUInt(&ok, 16) ? source.toUInt(nullptr, 16) : 0;
-                    reconstructedMsg.Destination = destination.toUInt(&ok, 16) ? destination.toUInt(nullptr, 16) : 255;
-                    reconstructedMsg.DataLen = qMin(dataLen, (uint8_t)hexBytes.size());
-                    
-                    // Parse hex data into byte array
-                    for (int i = 0; i < reconstructedMsg.DataLen && i < hexBytes.size(); i++) {
-                        bool hexOk;
-                        uint8_t byteVal = hexBytes[i].toUInt(&hexOk, 16);
-                        if (hexOk) {
-                            reconstructedMsg.Data[i] = byteVal;
-                        } else {
-                            reconstructedMsg.Data[i] = 0;
-                        }
-                    }
-                    
-                    // Get decoded data without reserved fields
-                    QString cleanDecodedData = m_dbcDecoder->getFormattedDecodedForSave(reconstructedMsg);
-                    if (!cleanDecodedData.isEmpty() && cleanDecodedData != "Raw data" && cleanDecodedData != "(not decoded)") {
-                        // Split decoded data into multiple lines for readability if it's long
-                        if (cleanDecodedData.length() > 80) {
-                            QStringList decodedLines = cleanDecodedData.split(", ");
-                            out << "#   Decoded: " << decodedLines.first() << "\n";
-                            for (int i = 1; i < decodedLines.size(); i++) {
-                                out << "#           " << decodedLines[i] << "\n";
-                            }
-                        } else {
-                            out << "#   Decoded: " << cleanDecodedData << "\n";
-                        }
+        if (m_dbcDecoder && m_decodingEnabled->isChecked() && store.length(row) > 0 &&
+            m_dbcDecoder->canDecode(store.pgn(row))) {
+            // Get decoded data without reserved fields
+            QString cleanDecodedData = m_dbcDecoder->getFormattedDecodedForSave(store.message(row));
+            if (!cleanDecodedData.isEmpty() && cleanDecodedData != "Raw data" && cleanDecodedData != "(not decoded)") {
+                // Split decoded data into multiple lines for readability if it's long
+                if (cleanDecodedData.length() > 80) {
+                    QStringList decodedLines = cleanDecodedData.split(", ");
+                    out << "#   Decoded: " << decodedLines.first() << "\n";
+                    for (int i = 1; i < decodedLines.size(); i++) {
+                        out << "#           " << decodedLines[i] << "\n";
                     }
+                } else {
+                    out << "#   Decoded: " << cleanDecodedData << "\n";
                 }
             }
         }
@@ -761,13 +747,43 @@ void PGNLogDialog::onSaveLogClicked()
         out << "\n";
     }
     
+    out.flush();
+    if (out.status() != QTextStream::Ok) {
+        *errorString = file.errorString();
+        return false;
+    }
     file.close();
-    
-    // Show success toast notification
-    ToastManager::instance()->showSuccess(
-        QString("Log saved successfully! %1 messages exported to %2")
-        .arg(m_logTable->rowCount())
-        .arg(QFileInfo(fileName).fileName()), this);
+    return true;
+}
+
+QHash<quint8, QString> PGNLogDialog::captureDeviceNames(const CaptureStore& store) const
+{
+    // Names of every address that appears in the capture, for the binary file header
+    bool seen[256] = {};
+    for (int row = 0; row < store.size(); row++) {
+        seen[store.source(row)] = true;
+        seen[store.destination(row)] = true;
+    }
+    
+    QHash<quint8, QString> names;
+    for (int address = 0; address < 255; address++) {
+        if (seen[address]) {
+            QString name = deviceName(uint8_t(address));
+            if (!name.isEmpty()) {
+                names.insert(quint8(address), name);
+            }
+        }
+    }
+    return names;
+}
+
+QString PGNLogDialog::deviceName(uint8_t address) const
+{
+    // A loaded capture carries the names the devices had when it was recorded
+    if (m_showingLoadedLog && m_loadedDeviceNames.contains(address)) {
+        return m_loadedDeviceNames.value(address);
+    }
+    return m_deviceNameResolver ? m_deviceNameResolver(address) : QString();
 }
 
 void PGNLogDialog::onLoadLogClicked()
@@ -784,177 +800,265 @@ void PGNLogDialog::onLoadLogClicked()
         return; // User cancelled - no action needed
     }
     
+    startLoad(QStringList{fileName}, QFileInfo(fileName).fileName(), 0, 0);
+}
+
+void PGNLogDialog::loadRecordedRange(const QStringList& fileNames, qint64 fromWallNs, qint64 toWallNs)
+{
+    const QString format = "yyyy-MM-dd hh:mm:ss";
+    const QString title = QString("Recording %1 - %2")
+        .arg(QDateTime::fromMSecsSinceEpoch(fromWallNs / 1000000).toString(format),
+             QDateTime::fromMSecsSinceEpoch(toWallNs / 1000000).toString(format));
+    startLoad(fileNames, title, fromWallNs, toWallNs);
+}
+
+void PGNLogDialog::startLoad(const QStringList& fileNames, const QString& title, qint64 fromWallNs, qint64 toWallNs)
+{
     // Automatically stop live logging when loading a log file
     if (!m_logStopped) {
         onStopClicked();
     }
     
-    // Read log from file
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        ToastManager::instance()->showError(
-            QString("Could not load log file: %1").arg(file.errorString()), this);
-        return;
-    }
-    
-    QTextStream in(&file);
+    // Only one load at a time
+    stopLoader();
     
     // Clear current log without restarting live logging
     clearLogForLoad();
-    
-    int loadedMessages = 0;
-    int skippedMessages = 0;
-    
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        
-        // Skip comments and empty lines
-        if (line.isEmpty() || line.startsWith("#") || line.startsWith("=")) {
-            continue;
-        }
-        
-        // Skip header lines
-        if (line.contains("NMEA2000 PGN Message Log") || 
-            line.contains("Generated by") || 
-            line.contains("Export Time:") || 
-            line.contains("Total Messages:") || 
-            line.contains("Active Filters:") || 
-            line.contains("Filter Logic:") ||
-            (line.contains("Timestamp") && line.contains("PGN") && line.contains("Message Name"))) {
-            continue;
-        }
-        
-        // Detect format and parse accordingly
-        tN2kMsg reconstructedMsg;
-        QString timestamp;
-        bool parseSuccess = false;
-        
-        // Try parsing as older format first (tab-delimited with decoded data)
-        if (line.contains('\t') && !line.contains('|')) {
-            parseSuccess = parseOlderFormatLine(line, reconstructedMsg, timestamp);
-        }
-        // Try parsing as newer format (pipe-delimited)
-        else if (line.contains('|')) {
-            parseSuccess = parseNewerFormatLine(line, reconstructedMsg, timestamp);
-        }
-        
-        if (parseSuccess) {
-            // Apply filtering to loaded messages (same as live messages)
-            if (!messagePassesFilter(reconstructedMsg)) {
-                skippedMessages++;
-                continue; // Skip this message if it doesn't pass filters
-            }
-            
-            // Add message to table
-            addLoadedMessage(reconstructedMsg, timestamp);
-            loadedMessages++;
-        } else {
-            skippedMessages++;
-        }
-    }
-    
-    file.close();
-    
-    // Update status to clearly indicate a log has been loaded and live logging is stopped
-    m_statusLabel->setText(QString("LOG LOADED (%1 messages) - Live logging STOPPED - Click Start to resume live logging").arg(loadedMessages));
-    m_statusLabel->setStyleSheet("font-weight: bold; color: #0066cc; padding: 5px;");
+    m_loadedMessageCount = 0;
+    m_loadSkippedCount = 0;
     
     // Set loaded log state and update window title
     m_showingLoadedLog = true;
-    QFileInfo fileInfo(fileName);
-    m_loadedLogFileName = fileInfo.fileName();
+    m_loadedLogFileName = title;
     updateWindowTitle();
     
-    // Show load result
-    ToastManager::instance()->showSuccess(
-        QString("Log loaded successfully! %1 messages from %2")
-        .arg(loadedMessages)
-        .arg(QFileInfo(fileName).fileName()), this);
+    m_statusLabel->setText(QString("LOADING %1...").arg(m_loadedLogFileName));
+    m_statusLabel->setStyleSheet("font-weight: bold; color: #0066cc; padding: 5px;");
+    m_loadProgressBar->setValue(0);
+    m_loadProgressBar->setVisible(true);
+    m_cancelLoadButton->setEnabled(true);
+    m_cancelLoadButton->setVisible(true);
+    
+    // Parse on a worker thread - rows appear in the table chunk by chunk
+    m_loader = new PGNLogLoader(fileNames, fromWallNs, toWallNs, this);
+    connect(m_loader, &PGNLogLoader::chunksAvailable, this, &PGNLogDialog::onLoaderChunksAvailable, Qt::QueuedConnection);
+    connect(m_loader, &PGNLogLoader::progressChanged, m_loadProgressBar, &QProgressBar::setValue, Qt::QueuedConnection);
+    connect(m_loader, &PGNLogLoader::loadFinished, this, &PGNLogDialog::onLoaderFinished, Qt::QueuedConnection);
+#ifdef WASM_BUILD
+    // No threads in the browser - parse here, the queued signals are delivered afterwards
+    m_loader->load();
+#else
+    m_loader->start();
+#endif
 }
 
-void PGNLogDialog::addLoadedMessage(const tN2kMsg& msg, const QString& originalTimestamp)
+void PGNLogDialog::onLoaderChunksAvailable()
 {
-    // Get decoded message name and data using current decoder
-    QString messageName;
-    if (m_dbcDecoder && m_dbcDecoder->canDecode(msg.PGN)) {
-        messageName = m_dbcDecoder->getCleanMessageName(msg.PGN);
-    } else {
-        messageName = QString("PGN %1").arg(msg.PGN);
+    if (!m_loader) {
+        return;
+    }
+    
+    // Acknowledge before draining so a chunk queued meanwhile triggers a new notification
+    m_loader->acknowledgeNotification();
+    
+    if (m_loadedDeviceNames.isEmpty() && m_loader->isBinaryCapture()) {
+        m_loadedDeviceNames = m_loader->deviceNames();
     }
     
-    // Prepare decoded data
-    QString decodedData = "";
-    if (m_decodingEnabled->isChecked() && m_dbcDecoder && m_dbcDecoder->canDecode(msg.PGN)) {
-        decodedData = m_dbcDecoder->getFormattedDecoded(msg);
-        if (decodedData.isEmpty() || decodedData == "Raw data" || decodedData.startsWith("PGN")) {
-            decodedData = "(not decoded)";
+    // Loaded messages go through the same filters as live traffic
+    tN2kMsg header;
+    CaptureStore chunk;
+    while (m_loader->takeChunk(chunk)) {
+        for (int row = 0; row < chunk.size(); row++) {
+            header.PGN = chunk.pgn(row);
+            header.Source = chunk.source(row);
+            header.Destination = chunk.destination(row);
+            if (messagePassesFilter(header)) {
+                m_fileStore.appendFrom(chunk, row);
+                m_loadedMessageCount++;
+            } else {
+                m_loadSkippedCount++;
+            }
         }
-    } else {
-        decodedData = "(decoding disabled)";
     }
     
-    // Format hex data payload
-    QString hexData = "";
-    for (int i = 0; i < msg.DataLen; i++) {
-        if (i > 0) hexData += " ";
-        hexData += QString("%1").arg(msg.Data[i], 2, 16, QChar('0')).toUpper();
+    // One inserted range per drain
+    m_logModel->commitPendingRows();
+    if (!m_loader->isFinished()) {
+        m_statusLabel->setText(QString("LOADING %1... %2 messages")
+                               .arg(m_loadedLogFileName).arg(m_loadedMessageCount));
     }
-    if (hexData.isEmpty()) {
-        hexData = "(no data)";
+}
+
+void PGNLogDialog::onLoaderFinished(bool success)
+{
+    if (!m_loader) {
+        return;
     }
     
-    // Add new row to table
-    int row = m_logTable->rowCount();
-    m_logTable->insertRow(row);
-
-    // Column 0: Timestamp (use original timestamp from file)
-    QTableWidgetItem* tsItem = new QTableWidgetItem(originalTimestamp);
-    tsItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-    m_logTable->setItem(row, 0, tsItem);
-
-    // Column 1: PGN
-    QTableWidgetItem* pgnItem = new QTableWidgetItem(QString::number(msg.PGN));
-    pgnItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-    m_logTable->setItem(row, 1, pgnItem);
+    // Pick up anything queued after the last notification
+    onLoaderChunksAvailable();
+    
+    bool cancelled = m_loader->isCancelled();
+    QString errorString = m_loader->errorString();
+    m_loadSkippedCount += m_loader->invalidLines();
+    m_loader->deleteLater();
+    m_loader = nullptr;
+    m_loadProgressBar->setVisible(false);
+    m_cancelLoadButton->setVisible(false);
+    
+    if (!success && !cancelled) {
+        ToastManager::instance()->showError(
+            QString("Could not load log file: %1").arg(errorString), this);
+    }
+    
+    // Update status to clearly indicate a log has been loaded and live logging is stopped
+    QString state = cancelled ? "LOAD CANCELLED" : (success ? "LOG LOADED" : "LOAD FAILED");
+    QString counts = QString("%1 messages").arg(m_loadedMessageCount);
+    if (m_loadSkippedCount > 0) {
+        counts += QString(", %1 skipped").arg(m_loadSkippedCount);
+    }
+    m_statusLabel->setText(QString("%1 (%2) - Live logging STOPPED - Click Start to resume live logging")
+                           .arg(state, counts));
+    
+    // Show load result
+    if (success) {
+        ToastManager::instance()->showSuccess(
+            QString("Log loaded successfully! %1 messages from %2")
+            .arg(m_loadedMessageCount)
+            .arg(m_loadedLogFileName), this);
+    } else if (cancelled) {
+        ToastManager::instance()->showInfo(
+            QString("Load cancelled - %1 messages loaded").arg(m_loadedMessageCount), this);
+    }
+}
 
-    // Column 2: Message Name (re-decoded with current definitions)
-    QTableWidgetItem* nameItem = new QTableWidgetItem(messageName);
-    nameItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    m_logTable->setItem(row, 2, nameItem);
+void PGNLogDialog::onCancelLoadClicked()
+{
+    if (m_loader) {
+        m_loader->cancel();
+        m_cancelLoadButton->setEnabled(false);
+    }
+}
 
-    // Column 3: Priority
-    QTableWidgetItem* priItem = new QTableWidgetItem(QString::number(msg.Priority));
-    priItem->setTextAlignment(Qt::AlignCenter);
-    m_logTable->setItem(row, 3, priItem);
+void PGNLogDialog::stopLoader()
+{
+    if (!m_loader) {
+        return;
+    }
+    
+    // The destructor cancels and waits for the thread
+    disconnect(m_loader, nullptr, this, nullptr);
+    delete m_loader;
+    m_loader = nullptr;
+    m_loadProgressBar->setVisible(false);
+    m_cancelLoadButton->setVisible(false);
+}
 
-    // Column 4: Source
-    QTableWidgetItem* srcItem = new QTableWidgetItem(QString("0x%1").arg(QString("%1").arg(msg.Source, 2, 16, QChar('0')).toUpper()));
-    srcItem->setTextAlignment(Qt::AlignCenter);
-    m_logTable->setItem(row, 4, srcItem);
+CaptureQueryWorker* PGNLogDialog::startQueryWorker(const QSharedPointer<CaptureQuery>& query, int rowCount,
+                                                   void (PGNLogDialog::*onMatches)(),
+                                                   void (PGNLogDialog::*onFinished)(bool))
+{
+    // The worker scans a copy of the store, which shares its columns until the next append
+    CaptureQueryWorker* worker = new CaptureQueryWorker(*m_logModel->store(), rowCount, query, this);
+    connect(worker, &CaptureQueryWorker::matchesAvailable, this, onMatches, Qt::QueuedConnection);
+    connect(worker, &CaptureQueryWorker::scanFinished, this, onFinished, Qt::QueuedConnection);
+#ifdef WASM_BUILD
+    // No threads in the browser - scan here, the queued signals are delivered afterwards
+    worker->scan();
+#else
+    worker->start();
+#endif
+    return worker;
+}
 
-    // Column 5: Destination
-    QString destText = QString("0x%1").arg(QString("%1").arg(msg.Destination, 2, 16, QChar('0')).toUpper());
-    QTableWidgetItem* destItem = new QTableWidgetItem(destText);
-    destItem->setTextAlignment(Qt::AlignCenter);
-    m_logTable->setItem(row, 5, destItem);
+void PGNLogDialog::stopQueryWorker(CaptureQueryWorker*& worker)
+{
+    if (!worker) {
+        return;
+    }
+    
+    // The destructor cancels and waits for the thread
+    disconnect(worker, nullptr, this, nullptr);
+    delete worker;
+    worker = nullptr;
+}
 
-    // Column 6: Length
-    QTableWidgetItem* lenItem = new QTableWidgetItem(QString::number(msg.DataLen));
-    lenItem->setTextAlignment(Qt::AlignCenter);
-    m_logTable->setItem(row, 6, lenItem);
+void PGNLogDialog::onQueryFilterApplied()
+{
+    const QString text = m_queryFilterEdit->text().trimmed();
+    if (text.isEmpty()) {
+        m_queryFilter.reset();
+    } else {
+        QString error;
+        QSharedPointer<CaptureQuery> query = CaptureQuery::compile(text, m_dbcDecoder, &error);
+        if (!query) {
+            ToastManager::instance()->showError(QString("Invalid query: %1").arg(error), this);
+            return;
+        }
+        m_queryFilter = query;
+    }
+    
+    refreshTableFilter();
+}
 
-    // Column 7: Raw Data
-    QTableWidgetItem* rawDataItem = new QTableWidgetItem(hexData);
-    rawDataItem->setFont(QFont("Consolas, Monaco, monospace", 9));
-    m_logTable->setItem(row, 7, rawDataItem);
+void PGNLogDialog::startFilterQuery()
+{
+    // Each thread needs its own compiled instance - time windows keep per-instance state
+    QSharedPointer<CaptureQuery> query = CaptureQuery::compile(m_queryFilter->text(), m_dbcDecoder);
+    if (!query) {
+        return;
+    }
+    
+    m_filterQueryBase = m_logModel->removedRowCount();
+    m_filterQueryWorker = startQueryWorker(query, m_logModel->queryScanRows(),
+                                           &PGNLogDialog::onFilterQueryMatches,
+                                           &PGNLogDialog::onFilterQueryFinished);
+    updateStatusLabel();
+}
 
-    // Column 8: Decoded Data (re-decoded with current DBC definitions)
-    QTableWidgetItem* decodedItem = new QTableWidgetItem(decodedData);
-    decodedItem->setFont(QFont("Consolas, Monaco, monospace", 9));
-    m_logTable->setItem(row, 8, decodedItem);
+void PGNLogDialog::onFilterQueryMatches()
+{
+    if (!m_filterQueryWorker) {
+        return;
+    }
+    
+    // Acknowledge before draining so matches queued meanwhile trigger a new notification
+    m_filterQueryWorker->acknowledgeNotification();
+    QVector<int> rows;
+    if (!m_filterQueryWorker->takeMatches(rows)) {
+        return;
+    }
+    
+    // Rows evicted since the scan started no longer exist; the model skips negative rows
+    const int shift = int(m_logModel->removedRowCount() - m_filterQueryBase);
+    if (shift > 0) {
+        for (int& row : rows) {
+            row -= shift;
+        }
+    }
+    m_logModel->addQueryMatches(rows);
+}
 
-    // Auto-scroll to bottom
-    m_logTable->scrollToBottom();
+void PGNLogDialog::onFilterQueryFinished(bool completed)
+{
+    if (!m_filterQueryWorker) {
+        return;
+    }
+    
+    // Pick up anything queued after the last notification
+    onFilterQueryMatches();
+    if (completed) {
+        m_logModel->finishQueryScan(m_filterQueryWorker->query());
+    }
+    m_filterQueryWorker->deleteLater();
+    m_filterQueryWorker = nullptr;
+    
+    if (m_logModel->rowCount() > 0 && m_autoScrollEnabled) {
+        scrollToBottom();
+    }
+    updateStatusLabel();
+    emit messageCountChanged(m_logModel->rowCount());
 }
 
 void PGNLogDialog::setSourceFilter(uint8_t sourceAddress)
@@ -973,10 +1077,7 @@ void PGNLogDialog::setSourceFilter(uint8_t sourceAddress)
         }
     }
     
-    updateStatusLabel();
-    
-    // Clear existing log
-    clearLog();
+    refreshTableFilter(); // Re-filter existing rows, also updates the status label
 }
 
 void PGNLogDialog::setDestinationFilter(uint8_t destinationAddress)
@@ -995,10 +1096,7 @@ void PGNLogDialog::setDestinationFilter(uint8_t destinationAddress)
         }
     }
     
-    updateStatusLabel();
-    
-    // Clear existing log
-    clearLog();
+    refreshTableFilter(); // Re-filter existing rows, also updates the status label
 }
 
 void PGNLogDialog::setFilterLogic(bool useOrLogic)
@@ -1070,7 +1168,7 @@ void PGNLogDialog::onSourceFilterChanged()
         }
     }
     
-    updateStatusLabel();
+    refreshTableFilter(); // Re-filter existing rows, also updates the status label
 }
 
 void PGNLogDialog::onDestinationFilterChanged()
@@ -1108,7 +1206,7 @@ void PGNLogDialog::onDestinationFilterChanged()
     }
 
     //qDebug() << "Final destination filter state - Active:" << m_destinationFilterActive << "Filter:" << m_destinationFilter;
-    updateStatusLabel();
+    refreshTableFilter(); // Re-filter existing rows, also updates the status label
 }
 
 void PGNLogDialog::onClearFilters()
@@ -1122,8 +1220,10 @@ void PGNLogDialog::onClearFilters()
     m_sourceFilter = 255;
     m_destinationFilter = 255;
     m_useAndLogic = true;
+    m_queryFilter.reset();
+    m_queryFilterEdit->clear();
     
-    updateStatusLabel();
+    refreshTableFilter(); // Re-filter existing rows, also updates the status label
     
     // Show info toast
     ToastManager::instance()->showInfo("All filters cleared", this);
@@ -1141,18 +1241,18 @@ void PGNLogDialog::clearAllFilters()
     m_sourceFilter = 255;
     m_destinationFilter = 255;
     m_useAndLogic = true;
+    m_queryFilter.reset();
+    m_queryFilterEdit->clear();
     
-    // Clear the log and add fresh header (this will handle window title)
-    clearLog();
-    
-    updateStatusLabel();
+    // The capture is shared with the other windows - show all of it rather than clearing it
+    refreshTableFilter(); // Also updates the status label
 }
 
 void PGNLogDialog::onFilterLogicChanged()
 {
     m_useAndLogic = (m_filterLogicCombo->currentIndex() == 0); // 0 = AND, 1 = OR
     //qDebug() << "Filter logic changed to:" << (m_useAndLogic ? "AND" : "OR");
-    updateStatusLabel();
+    refreshTableFilter(); // Re-filter existing rows, also updates the status label
 }
 
 void PGNLogDialog::updateStatusLabel()
@@ -1183,71 +1283,43 @@ void PGNLogDialog::updateStatusLabel()
         status += " - Real-time updates";
     }
     
+    if (m_queryFilter) {
+        status += QString(" - Query: %1").arg(m_queryFilter->text());
+        if (m_logModel->isQueryScanPending()) {
+            status += " (scanning...)";
+        }
+    }
+    
     m_statusLabel->setText(status);
 }
 
 bool PGNLogDialog::messagePassesFilter(const tN2kMsg& msg)
 {
-    // First check PGN filtering - if enabled and PGN is ignored, reject immediately
-    if (m_pgnFilteringEnabled && m_pgnFilteringEnabled->isChecked() && m_ignoredPgns.contains(msg.PGN)) {
-        return false;
-    }
-    
-    bool sourceMatch = true;
-    bool destMatch = true;
-    
-    // Check source filter
-    if (m_sourceFilterActive) {
-        sourceMatch = (msg.Source == m_sourceFilter);
-        //qDebug() << "Source filter active - msg source:" << msg.Source << "filter:" << m_sourceFilter << "match:" << sourceMatch;
-    } else {
-        //qDebug() << "Source filter inactive";
-    }
-    
-    // Check destination filter
-    if (m_destinationFilterActive) {
-        destMatch = (msg.Destination == m_destinationFilter);
-        //qDebug() << "Dest filter active - msg dest:" << msg.Destination << "filter:" << m_destinationFilter << "match:" << destMatch;
-    } else {
-        //qDebug() << "Destination filter inactive";
-    }
-    
-    // Apply logic
-    bool result;
-    if (m_useAndLogic) {
-        // AND logic: both filters must pass (or be inactive)
-        if (m_sourceFilterActive && m_destinationFilterActive) {
-            result = sourceMatch && destMatch;
-        } else if (m_sourceFilterActive) {
-            result = sourceMatch;
-        } else if (m_destinationFilterActive) {
-            result = destMatch;
-        } else {
-            result = true; // No filters active
-        }
-        //qDebug() << "AND logic result:" << result;
-    } else {
-        // OR logic: at least one filter must pass (if any are active)
-        if (m_sourceFilterActive && m_destinationFilterActive) {
-            result = sourceMatch || destMatch;
-        } else if (m_sourceFilterActive) {
-            result = sourceMatch;
-        } else if (m_destinationFilterActive) {
-            result = destMatch;
-        } else {
-            result = true; // No filters active
+    return captureFilter().matches(msg.PGN, msg.Source, msg.Destination);
+}
+
+CaptureFilter PGNLogDialog::captureFilter() const
+{
+    CaptureFilter filter;
+    filter.sourceActive = m_sourceFilterActive;
+    filter.source = m_sourceFilter;
+    filter.destinationActive = m_destinationFilterActive;
+    filter.destination = m_destinationFilter;
+    filter.useAndLogic = m_useAndLogic;
+    if (m_pgnFilteringEnabled && m_pgnFilteringEnabled->isChecked()) {
+        for (uint32_t pgn : m_ignoredPgns) {
+            filter.ignoredPgns.insert(pgn);
         }
-        //qDebug() << "OR logic result:" << result;
     }
-    
-    return result;
+    filter.query = m_queryFilter;
+    filter.changesOnly = m_changesOnlyCheck && m_changesOnlyCheck->isChecked();
+    return filter;
 }
 
 void PGNLogDialog::onToggleDecoding(bool enabled)
 {
-    // This slot is called when the decoding checkbox is toggled
-    // No immediate action needed - the appendMessage functions will check the checkbox state
-    Q_UNUSED(enabled);
+    // Decoded text is produced on demand, so this applies to rows already in the log too
+    m_logModel->setDecodingEnabled(enabled);
 }
 
 void PGNLogDialog::refreshTableFilter()
@@ -1256,151 +1328,178 @@ void PGNLogDialog::refreshTableFilter()
         return;
     }
     
-    qDebug() << "refreshTableFilter() called - starting filter update";
+    // Combo boxes re-emit when the device list is refreshed - keep the view if nothing changed
+    CaptureFilter filter = captureFilter();
+    if (filter == m_logModel->filter()) {
+        updateStatusLabel();
+        return;
+    }
     
-    int filteredCount = 0;
-    int totalRows = m_logTable->rowCount();
-    int visibleCount = 0;
+    // Evaluated over the capture store columns - the view then maps through the visible-row index
+    QElapsedTimer timer;
+    timer.start();
+    m_logModel->setFilter(filter);
+    m_logTable->setColumnHidden(PGNLogModel::RepeatsColumn, !filter.changesOnly);
+    m_logTable->setColumnHidden(PGNLogModel::LastSeenColumn, !filter.changesOnly);
+    qDebug() << "Filter applied:" << m_logModel->rowCount() << "of" << m_logModel->store()->size()
+             << "rows visible in" << timer.elapsed() << "ms";
     
-    qDebug() << "Total rows to process:" << totalRows;
+    // A query filter is scanned in the background - matching rows stream into the view
+    stopQueryWorker(m_filterQueryWorker);
+    if (filter.query) {
+        startFilterQuery();
+    }
     
-    // Temporarily disable updates to avoid flicker
-    m_logTable->setUpdatesEnabled(false);
+    // Search results were view rows of the old filter
+    if (!m_searchResults.isEmpty()) {
+        clearSearchState();
+        updateSearchResultsLabel();
+    }
     
-    // Track which rows are currently visible to minimize changes
-    QList<bool> currentlyVisible(totalRows);
-    QList<bool> shouldBeVisible(totalRows);
+    if (m_logModel->rowCount() > 0 && m_autoScrollEnabled) {
+        QTimer::singleShot(0, this, &PGNLogDialog::scrollToBottom);
+    }
     
-    // First pass: determine current visibility and calculate what should be visible
-    for (int row = 0; row < totalRows; ++row) {
-        currentlyVisible[row] = !m_logTable->isRowHidden(row);
-        shouldBeVisible[row] = true;
-        
-        // Get PGN from column 1
-        QTableWidgetItem* pgnItem = m_logTable->item(row, 1);
-        if (pgnItem) {
-            bool ok;
-            uint32_t pgn = pgnItem->text().toUInt(&ok);
-            bool pgnFilteringEnabled = m_pgnFilteringEnabled && m_pgnFilteringEnabled->isChecked();
-            bool pgnShouldBeFiltered = ok && pgnFilteringEnabled && m_ignoredPgns.contains(pgn);
-            
-            if (row < 3) { // Debug first few rows
-                qDebug() << "Row" << row << "PGN:" << pgn << "filtering enabled:" << pgnFilteringEnabled 
-                         << "should filter:" << pgnShouldBeFiltered << "ignored PGNs:" << m_ignoredPgns;
-            }
-            
-            if (pgnShouldBeFiltered) {
-                shouldBeVisible[row] = false;
-            }
-        }
-        
-        // If PGN filtering passes, check source/destination filters
-        if (shouldBeVisible[row]) {
-            // Create a minimal tN2kMsg structure for filter checking
-            tN2kMsg testMsg;
-            
-            // Get source from column 4
-            QTableWidgetItem* srcItem = m_logTable->item(row, 4);
-            if (srcItem) {
-                bool ok;
-                testMsg.Source = srcItem->text().toUInt(&ok, 16); // Parse as hex
-                if (!ok) testMsg.Source = 255; // Default to broadcast
-            }
-            
-            // Get destination from column 5  
-            QTableWidgetItem* destItem = m_logTable->item(row, 5);
-            if (destItem) {
-                bool ok;
-                testMsg.Destination = destItem->text().toUInt(&ok, 16); // Parse as hex
-                if (!ok) testMsg.Destination = 255; // Default to broadcast
-            }
-            
-            // Get PGN for the message structure
-            if (pgnItem) {
-                bool ok;
-                testMsg.PGN = pgnItem->text().toUInt(&ok);
-                if (!ok) testMsg.PGN = 0;
-            }
-            
-            // Apply source/destination filtering logic (skip PGN check since we already did it)
-            bool sourceMatch = true;
-            bool destMatch = true;
-            
-            if (m_sourceFilterActive) {
-                sourceMatch = (testMsg.Source == m_sourceFilter);
-            }
-            
-            if (m_destinationFilterActive) {
-                destMatch = (testMsg.Destination == m_destinationFilter);
-            }
-            
-            // Apply logic
-            if (m_useAndLogic) {
-                if (m_sourceFilterActive && m_destinationFilterActive) {
-                    shouldBeVisible[row] = sourceMatch && destMatch;
-                } else if (m_sourceFilterActive) {
-                    shouldBeVisible[row] = sourceMatch;
-                } else if (m_destinationFilterActive) {
-                    shouldBeVisible[row] = destMatch;
-                }
-            } else {
-                if (m_sourceFilterActive && m_destinationFilterActive) {
-                    shouldBeVisible[row] = sourceMatch || destMatch;
-                } else if (m_sourceFilterActive) {
-                    shouldBeVisible[row] = sourceMatch;
-                } else if (m_destinationFilterActive) {
-                    shouldBeVisible[row] = destMatch;
-                }
-            }
-        }
-        
-        if (shouldBeVisible[row]) {
-            visibleCount++;
-        } else {
-            filteredCount++;
-        }
+    updateStatusLabel();
+}
+
+void PGNLogDialog::onCaptureBudgetChanged()
+{
+    CaptureBudget budget;
+    budget.limit = static_cast<CaptureBudget::Limit>(m_budgetLimitCombo->currentData().toInt());
+    budget.value = m_budgetValueSpin->value();
+    budget.policy = static_cast<CaptureBudget::OverflowPolicy>(m_overflowPolicyCombo->currentData().toInt());
+    
+    m_budgetValueSpin->setEnabled(budget.limit != CaptureBudget::Unlimited);
+    m_overflowPolicyCombo->setEnabled(budget.limit != CaptureBudget::Unlimited);
+    
+    // The budget belongs to the shared live capture - the other windows follow the change
+    m_liveCapture->setBudget(budget);
+    updateCaptureStats();
+}
+
+void PGNLogDialog::onLiveBudgetChanged()
+{
+    const CaptureBudget& budget = m_liveCapture->budget();
+    
+    // Set without the change handlers, which would pick a starting value and set the budget again
+    QSignalBlocker limitBlocker(m_budgetLimitCombo);
+    QSignalBlocker valueBlocker(m_budgetValueSpin);
+    QSignalBlocker policyBlocker(m_overflowPolicyCombo);
+    m_budgetLimitCombo->setCurrentIndex(qMax(0, m_budgetLimitCombo->findData(int(budget.limit))));
+    m_budgetValueSpin->setSuffix(budgetValueSuffix(budget.limit));
+    if (budget.value > 0) {
+        m_budgetValueSpin->setValue(int(budget.value));
+    }
+    m_overflowPolicyCombo->setCurrentIndex(qMax(0, m_overflowPolicyCombo->findData(int(budget.policy))));
+    m_budgetValueSpin->setEnabled(budget.limit != CaptureBudget::Unlimited);
+    m_overflowPolicyCombo->setEnabled(budget.limit != CaptureBudget::Unlimited);
+    updateCaptureStats();
+}
+
+void PGNLogDialog::onLiveBudgetReached()
+{
+    if (!isLiveView() || m_logStopped) {
+        return;
+    }
+    onStopClicked();
+    m_statusLabel->setText("STOPPED - Capture budget reached. Clear the log or raise the limit to continue");
+}
+
+QString PGNLogDialog::budgetValueSuffix(int limit)
+{
+    switch (limit) {
+    case CaptureBudget::MessageCount: return " msgs";
+    case CaptureBudget::Megabytes:    return " MB";
+    case CaptureBudget::Minutes:      return " min";
+    default:                          return QString();
+    }
+}
+
+void PGNLogDialog::onLiveRowsAboutToBeEvicted(int count)
+{
+    if (isLiveView()) {
+        m_logModel->beginRemoveOldestRows(count);
+    }
+}
+
+void PGNLogDialog::onLiveRowsEvicted(int count)
+{
+    Q_UNUSED(count);
+    if (!isLiveView()) {
+        return;
     }
     
-    qDebug() << "Filter analysis: " << visibleCount << " rows should be visible, " << filteredCount << " should be hidden";
+    int viewRowsRemoved = m_logModel->endRemoveOldestRows();
     
-    // Second pass: only change visibility for rows that need it
-    int changedRows = 0;
-    for (int row = 0; row < totalRows; ++row) {
-        if (currentlyVisible[row] != shouldBeVisible[row]) {
-            m_logTable->setRowHidden(row, !shouldBeVisible[row]);
-            changedRows++;
+    // Search results refer to view rows, which have just shifted
+    if (!m_searchResults.isEmpty()) {
+        QList<int> shifted;
+        for (int row : m_searchResults) {
+            if (row >= viewRowsRemoved) {
+                shifted.append(row - viewRowsRemoved);
+            }
         }
+        int removedBeforeCurrent = m_searchResults.size() - shifted.size();
+        m_searchResults = shifted;
+        m_currentSearchIndex = qMax(-1, qMin(m_currentSearchIndex - removedBeforeCurrent, int(m_searchResults.size()) - 1));
+        updateSearchResultsLabel();
     }
     
-    qDebug() << "Visibility changes: " << changedRows << " rows changed";
-    
-    // Re-enable updates with a proper repaint
-    m_logTable->setUpdatesEnabled(true);
+    // Repeats left without their change row show up in a change-only view
+    if (m_logModel->insertPromotedRows() > 0 && !m_searchResults.isEmpty()) {
+        clearSearchState();
+        updateSearchResultsLabel();
+    }
+}
+
+void PGNLogDialog::onLiveCaptureCleared()
+{
+    if (isLiveView()) {
+        showCapture(m_liveCapture->store());
+    }
+}
+
+void PGNLogDialog::updateCaptureStats()
+{
+    const CaptureStore* store = m_logModel->store();
+    int rows = store->size();
+    QString stats = QString("Retained: %1 msgs (%2 changes), %3 MB")
+                    .arg(rows)
+                    .arg(store->changeCount())
+                    .arg(double(store->retainedBytes()) / (1024.0 * 1024.0), 0, 'f', 1);
+    
+    if (rows > 1) {
+        N2kTimestamp oldest = store->timestamp(0);
+        N2kTimestamp newest = store->timestamp(rows - 1);
+        if (oldest.isValid() && newest.isValid()) {
+            qint64 spanSecs = newest.nsecsSince(oldest) / 1000000000LL;
+            stats += QString(", %1m %2s").arg(spanSecs / 60).arg(spanSecs % 60, 2, 10, QChar('0'));
+        }
+    }
     
-    // Force a viewport update to ensure proper rendering
-    if (changedRows > 0) {
-        m_logTable->viewport()->update();
-        
-        // If we have visible rows, make sure scrolling still works
-        if (visibleCount > 0 && m_autoScrollEnabled) {
-            QTimer::singleShot(0, this, &PGNLogDialog::scrollToBottom);
+    const CaptureSpillWriter* spillWriter = m_liveCapture->spillWriter();
+    if (isLiveView() && (m_liveCapture->budget().isActive() || m_liveCapture->evictedCount() > 0)) {
+        stats += QString(" | Evicted: %1").arg(m_liveCapture->evictedCount());
+        if (spillWriter && spillWriter->spilledCount() > 0) {
+            stats += QString(" (%1 spilled)").arg(spillWriter->spilledCount());
+            m_captureStatsLabel->setToolTip(spillWriter->fileName());
         }
     }
     
-    // Update status to show filtering information
-    if (filteredCount > 0) {
-        qDebug() << "PGN filtering: " << filteredCount << " messages hidden from view (out of " << totalRows << " total)";
-    } else {
-        qDebug() << "PGN filtering: No messages filtered (all" << totalRows << "messages visible)";
+    if (m_dbcDecoder) {
+        DecodeCacheStats cacheStats = m_dbcDecoder->decodeCacheStats();
+        if (cacheStats.hits + cacheStats.misses > 0) {
+            stats += QString(" | Decode cache: %1% hits").arg(cacheStats.hitRate() * 100.0, 0, 'f', 1);
+        }
     }
     
-    updateStatusLabel();
+    m_captureStatsLabel->setText(stats);
 }
 
-void PGNLogDialog::onTableItemClicked(int row, int column)
+void PGNLogDialog::onTableItemClicked(const QModelIndex& index)
 {
-    Q_UNUSED(column);
-    Q_UNUSED(row);
+    Q_UNUSED(index);
     
     // User clicked on a row - disable auto-scrolling to let them examine the message
     m_autoScrollEnabled = false;
@@ -1424,6 +1523,14 @@ void PGNLogDialog::onPauseClicked()
 
 void PGNLogDialog::onStartClicked()
 {
+    // Going live abandons a load that is still running
+    stopLoader();
+    if (!isLiveView()) {
+        showCapture(m_liveCapture->store());
+        m_fileStore.clear();
+        m_loadedDeviceNames.clear();
+    }
+    
     m_logPaused = false;
     m_logStopped = false;
     
@@ -1444,6 +1551,9 @@ void PGNLogDialog::onStartClicked()
     m_showingLoadedLog = false;
     m_loadedLogFileName = "";
     updateWindowTitle();
+    
+    // Show what the live capture received while this view was stopped
+    commitPendingMessages();
 }
 
 void PGNLogDialog::onStopClicked()
@@ -1451,232 +1561,37 @@ void PGNLogDialog::onStopClicked()
     m_logPaused = false;
     m_logStopped = true;
     
-    // Update button states
-    m_startButton->setEnabled(true);
-    m_pauseButton->setEnabled(false);
-    m_stopButton->setEnabled(false);
-    
-    // Update status
-    m_statusLabel->setText("STOPPED - Click Start to resume logging or Clear to empty log");
-    m_statusLabel->setStyleSheet("font-weight: bold; color: #cc0000; padding: 5px;");
-}
-
-void PGNLogDialog::updateWindowTitle()
-{
-    if (m_showingLoadedLog) {
-        setWindowTitle(QString("NMEA2000 PGN Message Log - LOADED: %1").arg(m_loadedLogFileName));
-    } else {
-        setWindowTitle("NMEA2000 PGN Message Log - LIVE");
-    }
-}
-
-void PGNLogDialog::setTimestampMode(TimestampMode mode)
-{
-    if (m_timestampMode == mode) return;
-    m_timestampMode = mode;
-    // Update all timestamps in the table
-    for (int row = 0; row < m_logTable->rowCount(); ++row) {
-        QString tsText;
-        if (mode == Absolute) {
-            tsText = m_messageTimestamps[row].toString("HH:mm:ss.zzz");
-        } else {
-            qint64 deltaMs = 0;
-            if (row > 0) {
-                deltaMs = m_messageTimestamps[row-1].msecsTo(m_messageTimestamps[row]);
-            }
-            tsText = QString::number(deltaMs) + " ms";
-        }
-        QTableWidgetItem* tsItem = m_logTable->item(row, 0);
-        if (tsItem) tsItem->setText(tsText);
-    }
-}
-
-PGNLogDialog::TimestampMode PGNLogDialog::getTimestampMode() const
-{
-    return m_timestampMode;
-}
-
-bool PGNLogDialog::parseOlderFormatLine(const QString& line, tN2kMsg& msg, QString& timestamp)
-{
-    // Parse older format: Timestamp\tPGN\tMessage Name\tPri\tSrc\tDst\tLen\tData
-    // Example: 14:21:27.257	126993	Heartbeat	7	5C	FF	8	[decoded info] [60 EA 1F C0 FF FF FF FF]
-    
-    QStringList parts = line.split('\t');
-    if (parts.size() < 7) {
-        return false; // Not enough fields
-    }
-    
-    timestamp = parts[0].trimmed();
-    QString pgnStr = parts[1].trimmed();
-    // parts[2] is message name (skip)
-    QString priorityStr = parts[3].trimmed();
-    QString sourceStr = parts[4].trimmed();
-    QString destStr = parts[5].trimmed();
-    QString lengthStr = parts[6].trimmed();
-    
-    // Extract hex data from the last field - look for pattern [XX XX XX ...]
-    QString dataField = parts.size() > 7 ? parts[7] : "";
-    QString hexDataStr = "";
-    
-    // Find hex data in brackets at the end
-    QRegularExpression hexPattern(R"(\[([0-9A-Fa-f\s]+)\])");
-    QRegularExpressionMatch hexMatch = hexPattern.match(dataField);
-    if (hexMatch.hasMatch()) {
-        hexDataStr = hexMatch.captured(1).trimmed();
-    }
-    
-    // Validate and convert data
-    bool ok;
-    uint32_t pgn = pgnStr.toUInt(&ok);
-    if (!ok) return false;
-    
-    uint8_t priority = priorityStr.toUInt(&ok);
-    if (!ok) priority = 6; // Default priority
-    
-    uint8_t source = sourceStr.toUInt(&ok, 16);
-    if (!ok) source = 0;
-    
-    uint8_t destination = destStr.toUInt(&ok, 16);
-    if (!ok) destination = 255;
-    
-    uint8_t dataLen = lengthStr.toUInt(&ok);
-    if (!ok) dataLen = 0;
-    
-    // Parse hex data
-    QStringList hexBytes = hexDataStr.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-    
-    // Build the message
-    msg.PGN = pgn;
-    msg.Priority = priority;
-    msg.Source = source;
-    msg.Destination = destination;
-    msg.DataLen = qMin(dataLen, (uint8_t)hexBytes.size());
-    
-    // Parse hex data into byte array
-    for (int i = 0; i < msg.DataLen && i < hexBytes.size(); i++) {
-        bool hexOk;
-        uint8_t byteVal = hexBytes[i].toUInt(&hexOk, 16);
-        if (hexOk) {
-            msg.Data[i] = byteVal;
-        } else {
-            msg.Data[i] = 0;
-        }
-    }
+    // Update button states
+    m_startButton->setEnabled(true);
+    m_pauseButton->setEnabled(false);
+    m_stopButton->setEnabled(false);
     
-    return true;
+    // Update status
+    m_statusLabel->setText("STOPPED - Click Start to resume logging or Clear to empty log");
+    m_statusLabel->setStyleSheet("font-weight: bold; color: #cc0000; padding: 5px;");
 }
 
-bool PGNLogDialog::parseNewerFormatLine(const QString& line, tN2kMsg& msg, QString& timestamp)
+void PGNLogDialog::updateWindowTitle()
 {
-    // Parse formats - try newest format first (with device names), then fall back to older
-    QStringList parts = line.split("|");
-    
-    if (parts.size() == 9) {
-        // Newest format: TIMESTAMP | PGN | PRIORITY | SOURCE | SOURCE_NAME | DESTINATION | DEST_NAME | LENGTH | RAW_DATA
-        timestamp = parts[0].trimmed();
-        QString pgnStr = parts[1].trimmed();
-        QString priorityStr = parts[2].trimmed();
-        QString sourceStr = parts[3].trimmed();
-        // parts[4] is source name (we ignore for parsing)
-        QString destStr = parts[5].trimmed();
-        // parts[6] is dest name (we ignore for parsing) 
-        QString lengthStr = parts[7].trimmed();
-        QString rawDataStr = parts[8].trimmed();
-        
-        // Validate and convert data
-        bool ok;
-        uint32_t pgn = pgnStr.toUInt(&ok);
-        if (!ok) return false;
-        
-        uint8_t priority = priorityStr.toUInt(&ok);
-        if (!ok) priority = 6; // Default priority
-        
-        uint8_t source = sourceStr.toUInt(&ok, 16);
-        if (!ok) source = 0;
-        
-        uint8_t destination = destStr.toUInt(&ok, 16);
-        if (!ok) destination = 255;
-        
-        uint8_t dataLen = lengthStr.toUInt(&ok);
-        if (!ok) dataLen = 0;
-        
-        // Parse hex data
-        QStringList hexBytes = rawDataStr.split(" ", Qt::SkipEmptyParts);
-        
-        // Construct N2K message
-        msg.PGN = pgn;
-        msg.Priority = priority;
-        msg.Source = source;
-        msg.Destination = destination;
-        msg.DataLen = qMin(dataLen, (uint8_t)tN2kMsg::MaxDataLen);
-        
-        // Parse data bytes
-        for (int i = 0; i < msg.DataLen && i < hexBytes.size(); i++) {
-            bool hexOk;
-            uint8_t byteVal = hexBytes[i].toUInt(&hexOk, 16);
-            if (hexOk) {
-                msg.Data[i] = byteVal;
-            } else {
-                msg.Data[i] = 0;
-            }
-        }
-        
-        return true;
-    }
-    else if (parts.size() == 7) {
-        // Older format: TIMESTAMP | PGN | PRIORITY | SOURCE | DESTINATION | LENGTH | RAW_DATA
-        timestamp = parts[0].trimmed();
-        QString pgnStr = parts[1].trimmed();
-        QString priorityStr = parts[2].trimmed();
-        QString sourceStr = parts[3].trimmed();
-        QString destStr = parts[4].trimmed();
-        QString lengthStr = parts[5].trimmed();
-        QString rawDataStr = parts[6].trimmed();
-        
-        // Validate and convert data (same as before)
-        bool ok;
-        uint32_t pgn = pgnStr.toUInt(&ok);
-        if (!ok) return false;
-        
-        uint8_t priority = priorityStr.toUInt(&ok);
-        if (!ok) priority = 6; // Default priority
-        
-        uint8_t source = sourceStr.toUInt(&ok, 16);
-        if (!ok) source = 0;
-        
-        uint8_t destination = destStr.toUInt(&ok, 16);
-        if (!ok) destination = 255;
-        
-        uint8_t dataLen = lengthStr.toUInt(&ok);
-        if (!ok) dataLen = 0;
-        
-        // Parse hex data
-        QStringList hexBytes = rawDataStr.split(" ", Qt::SkipEmptyParts);
-        
-        // Construct N2K message
-        msg.PGN = pgn;
-        msg.Priority = priority;
-        msg.Source = source;
-        msg.Destination = destination;
-        msg.DataLen = qMin(dataLen, (uint8_t)tN2kMsg::MaxDataLen);
-        
-        // Parse data bytes
-        for (int i = 0; i < msg.DataLen && i < hexBytes.size(); i++) {
-            bool hexOk;
-            uint8_t byteVal = hexBytes[i].toUInt(&hexOk, 16);
-            if (hexOk) {
-                msg.Data[i] = byteVal;
-            } else {
-                msg.Data[i] = 0;
-            }
-        }
-        
-        return true;
+    if (m_showingLoadedLog) {
+        setWindowTitle(QString("NMEA2000 PGN Message Log - LOADED: %1").arg(m_loadedLogFileName));
+    } else {
+        setWindowTitle("NMEA2000 PGN Message Log - LIVE");
     }
-    
-    return false; // Unsupported format
 }
 
+void PGNLogDialog::setTimestampMode(TimestampMode mode)
+{
+    if (m_timestampMode == mode) return;
+    m_timestampMode = mode;
+    // Timestamp text is computed per visible row, so the model only needs to repaint the column
+    m_logModel->setRelativeTimestamps(mode == Relative);
+}
+
+PGNLogDialog::TimestampMode PGNLogDialog::getTimestampMode() const
+{
+    return m_timestampMode;
+}
 
 // PGN Filtering Methods
 void PGNLogDialog::onAddPgnIgnore()
@@ -1820,33 +1735,17 @@ void PGNLogDialog::onTableContextMenu(const QPoint& position)
     }
     lastTriggerTime = currentTime;
     
-    QTableWidgetItem* item = m_logTable->itemAt(position);
-    if (!item) {
-        return; // No item at this position
+    QModelIndex index = m_logTable->indexAt(position);
+    if (!index.isValid()) {
+        return; // No row at this position
     }
     
-    int row = item->row();
+    int row = index.row();
+    int storeRow = m_logModel->storeRow(row);
+    uint32_t pgn = m_logModel->store()->pgn(storeRow);
     
-    // Get the PGN from column 1 (PGN column)
-    QTableWidgetItem* pgnItem = m_logTable->item(row, 1);
-    if (!pgnItem) {
-        return; // No PGN data in this row
-    }
-    
-    bool ok;
-    QString pgnText = pgnItem->text();
-    uint32_t pgn = pgnText.toUInt(&ok);
-    
-    if (!ok) {
-        return; // Invalid PGN value
-    }
-    
-    // Get message name from column 2 for display
-    QString messageName;
-    QTableWidgetItem* nameItem = m_logTable->item(row, 2);
-    if (nameItem) {
-        messageName = nameItem->text();
-    }
+    // Get message name for display
+    QString messageName = m_logModel->messageName(storeRow);
     
     // Create context menu
     QMenu* contextMenu = new QMenu(this);
@@ -1930,6 +1829,14 @@ void PGNLogDialog::saveSettings()
     }
     settings.setValue("ignoredPgns", pgnList);
     
+    // Save capture budget
+    const CaptureBudget& budget = m_liveCapture->budget();
+    settings.setValue("captureBudgetLimit", int(budget.limit));
+    settings.setValue("captureBudgetValue", budget.value);
+    settings.setValue("captureOverflowPolicy", int(budget.policy));
+    
+    settings.setValue("viewRefreshHz", m_viewRefreshHz);
+    
     settings.endGroup();
 }
 
@@ -1966,6 +1873,13 @@ void PGNLogDialog::loadSettings()
         setIgnoredPgns(loadedPgns);
     }
     
+    // The capture budget is loaded by the live capture, which every window shares
+    onLiveBudgetChanged();
+    
+    // How often new messages are pushed to the table
+    m_viewRefreshHz = qBound(1, settings.value("viewRefreshHz", DEFAULT_VIEW_REFRESH_HZ).toInt(), MAX_VIEW_REFRESH_HZ);
+    m_batchCommitTimer->setInterval(1000 / m_viewRefreshHz);
+    
     settings.endGroup();
 }
 
@@ -2006,27 +1920,12 @@ void PGNLogDialog::setDeviceNameResolver(DeviceNameResolver resolver)
 
 void PGNLogDialog::showDecodeDetails(int row)
 {
-    if (row < 0 || row >= m_logTable->rowCount()) {
+    if (row < 0 || row >= m_logModel->rowCount()) {
         return; // Invalid row
     }
     
-    // Extract message data from the table row
-    QString timestamp = m_logTable->item(row, 0) ? m_logTable->item(row, 0)->text() : "";
-    QString pgnText = m_logTable->item(row, 1) ? m_logTable->item(row, 1)->text() : "";
-    QString messageName = m_logTable->item(row, 2) ? m_logTable->item(row, 2)->text() : "";
-    QString priority = m_logTable->item(row, 3) ? m_logTable->item(row, 3)->text() : "";
-    QString source = m_logTable->item(row, 4) ? m_logTable->item(row, 4)->text() : "";
-    QString destination = m_logTable->item(row, 5) ? m_logTable->item(row, 5)->text() : "";
-    QString length = m_logTable->item(row, 6) ? m_logTable->item(row, 6)->text() : "";
-    QString rawData = m_logTable->item(row, 7) ? m_logTable->item(row, 7)->text() : "";
-    QString decodedData = m_logTable->item(row, 8) ? m_logTable->item(row, 8)->text() : "";
-    
-    // PGN field no longer has "Sent:" prefix since we removed it
-    QString pgn = pgnText;
-    
     // Create the details dialog
     QDialog* detailsDialog = new QDialog(this);
-    detailsDialog->setWindowTitle(QString("Message Details - PGN %1 (Row %2)").arg(pgn).arg(row + 1));
     detailsDialog->setMinimumSize(600, 400);
     detailsDialog->resize(700, 500);
     detailsDialog->setAttribute(Qt::WA_DeleteOnClose); // Auto-delete when closed
@@ -2039,157 +1938,6 @@ void PGNLogDialog::showDecodeDetails(int row)
     textDisplay->setReadOnly(true);
     textDisplay->setFont(QFont("Courier", 10)); // Monospace font for better alignment
     
-    // Build the detailed information text
-    QString detailsText;
-    
-    // Basic message information in compact format
-    detailsText += "Message Information:\n";
-    detailsText += "-------------------\n";
-    
-    // Use consistent column width for alignment
-    const int leftColumnWidth = 35;
-    
-    detailsText += QString("Timestamp:    %1").arg(timestamp);
-    
-    // Add relative timestamp in parentheses
-    if (row > 0 && row < m_messageTimestamps.size()) {
-        qint64 deltaMs = m_messageTimestamps[row-1].msecsTo(m_messageTimestamps[row]);
-        detailsText += QString(" (+%1ms)").arg(deltaMs);
-    }
-    detailsText += "\n";
-    
-    // PGN on its own line to handle long names
-    detailsText += QString("PGN:          %1").arg(pgn);
-    if (!messageName.isEmpty() && messageName != QString("PGN %1").arg(pgn)) {
-        detailsText += QString(" (%1)").arg(messageName);
-    }
-    detailsText += "\n";
-    
-    // Priority and Length on same line
-    QString priorityLine = QString("Priority:     %1").arg(priority);
-    priorityLine = priorityLine.leftJustified(leftColumnWidth, ' ');
-    detailsText += priorityLine + QString("Length:       %1 bytes\n").arg(length);
-    
-    // Add device name information if available (inline with addresses)
-    QString sourceDeviceInfo, destDeviceInfo;
-    if (m_deviceNameResolver) {
-        bool ok;
-        uint8_t srcAddr = source.toUInt(&ok, 16);
-        if (ok) {
-            QString sourceName = m_deviceNameResolver(srcAddr);
-            if (!sourceName.isEmpty()) {
-                sourceDeviceInfo = QString(" (%1)").arg(sourceName);
-            }
-        }
-        
-        uint8_t destAddr = destination.toUInt(&ok, 16);
-        if (ok) {
-            QString destName = m_deviceNameResolver(destAddr);
-            if (destAddr == 255) {
-                destName = "Broadcast";
-            }
-            if (!destName.isEmpty()) {
-                destDeviceInfo = QString(" (%1)").arg(destName);
-            }
-        }
-    }
-    
-    // Rewrite the Source/Destination line with device names inline
-    QString sourceLine = QString("Source:       %1%2").arg(source).arg(sourceDeviceInfo);
-    sourceLine = sourceLine.leftJustified(leftColumnWidth, ' ');
-    detailsText += sourceLine + QString("Destination:  %1%2\n").arg(destination).arg(destDeviceInfo);
-    
-    detailsText += "\n";
-    
-    // Decoded data section
-    detailsText += "Decoded Information:\n";
-    detailsText += "-------------------\n";
-    
-    // Try to get enhanced decoded data if decoder is available
-    if (m_dbcDecoder && m_decodingEnabled->isChecked() && !rawData.isEmpty() && rawData != "(no data)") {
-        bool ok;
-        uint32_t pgnNum = pgn.toUInt(&ok);
-        if (ok && m_dbcDecoder->canDecode(pgnNum)) {
-            // Reconstruct the message for detailed decoding
-            QStringList hexBytes = rawData.split(" ", Qt::SkipEmptyParts);
-            uint8_t dataLen = length.toUInt(&ok);
-            if (ok) {
-                tN2kMsg reconstructedMsg;
-                reconstructedMsg.PGN = pgnNum;
-                reconstructedMsg.Priority = priority.toUInt(&ok) ? priority.toUInt() : 6;
-                reconstructedMsg.Source = source.toUInt(&ok, 16) ? source.toUInt(nullptr, 16) : 0;
-                reconstructedMsg.Destination = destination.toUInt(&ok, 16) ? destination.toUInt(nullptr, 16) : 255;
-                reconstructedMsg.DataLen = qMin(dataLen, (uint8_t)hexBytes.size());
-                
-                // Parse hex data into byte array
-                for (int i = 0; i < reconstructedMsg.DataLen && i < hexBytes.size(); i++) {
-                    bool hexOk;
-                    uint8_t byteVal = hexBytes[i].toUInt(&hexOk, 16);
-                    if (hexOk) {
-                        reconstructedMsg.Data[i] = byteVal;
-                    } else {
-                        reconstructedMsg.Data[i] = 0;
-                    }
-                }
-                
-                // Get detailed decoded information
-                QString detailedDecoded = m_dbcDecoder->getFormattedDecodedForSave(reconstructedMsg);
-                if (!detailedDecoded.isEmpty() && detailedDecoded != "Raw data" && detailedDecoded != "(not decoded)") {
-                    // Format the decoded data with better line breaks
-                    QStringList decodedParts = detailedDecoded.split(", ");
-                    for (const QString& part : decodedParts) {
-                        detailsText += QString("  %1\n").arg(part);
-                    }
-                } else {
-                    detailsText += "Message structure recognized but no decoded data available\n";
-                }
-            }
-        } else {
-            detailsText += "No decoder available for this PGN\n";
-        }
-    } else {
-        if (!decodedData.isEmpty() && decodedData != "(not decoded)" && decodedData != "Raw data") {
-            detailsText += QString("%1\n").arg(decodedData);
-        } else {
-            detailsText += "No decoded information available\n";
-        }
-    }
-
-    detailsText += "\n";
-    
-    // Raw data section (moved after decoded information)
-    detailsText += "Raw Data:\n";
-    detailsText += "---------\n";
-    if (!rawData.isEmpty() && rawData != "(no data)") {
-        // Format raw data with better spacing
-        QStringList hexBytes = rawData.split(" ", Qt::SkipEmptyParts);
-        QString formattedRawData;
-        for (int i = 0; i < hexBytes.size(); i++) {
-            if (i > 0 && i % 8 == 0) {
-                formattedRawData += "\n          ";
-            }
-            formattedRawData += hexBytes[i].rightJustified(2, '0').toUpper() + " ";
-        }
-        detailsText += QString("Hex:      %1\n").arg(formattedRawData.trimmed());
-        
-#if 0
-        // Add byte positions for reference
-        QString bytePositions;
-        for (int i = 0; i < hexBytes.size(); i++) {
-            if (i > 0 && i % 8 == 0) {
-                bytePositions += "\n          ";
-            }
-            bytePositions += QString("%1  ").arg(i, 2);
-        }
-        detailsText += QString("Positions:%1\n").arg(bytePositions);
-#endif
-    } else {
-        detailsText += "No data\n";
-    }
-    
-    // Set the text in the display
-    textDisplay->setPlainText(detailsText);
-    
     // Add to layout
     layout->addWidget(textDisplay);
     
@@ -2202,28 +1950,28 @@ void PGNLogDialog::showDecodeDetails(int row)
     
     // Lambda to update dialog content for a specific row
     auto updateDialogContent = [this, textDisplay, detailsDialog](int newRow) {
-        if (newRow < 0 || newRow >= m_logTable->rowCount()) {
+        if (newRow < 0 || newRow >= m_logModel->rowCount()) {
             return; // Invalid row
         }
         
-        // Extract message data from the table row
-        QString timestamp = m_logTable->item(newRow, 0) ? m_logTable->item(newRow, 0)->text() : "";
-        QString pgnText = m_logTable->item(newRow, 1) ? m_logTable->item(newRow, 1)->text() : "";
-        QString messageName = m_logTable->item(newRow, 2) ? m_logTable->item(newRow, 2)->text() : "";
-        QString priority = m_logTable->item(newRow, 3) ? m_logTable->item(newRow, 3)->text() : "";
-        QString source = m_logTable->item(newRow, 4) ? m_logTable->item(newRow, 4)->text() : "";
-        QString destination = m_logTable->item(newRow, 5) ? m_logTable->item(newRow, 5)->text() : "";
-        QString length = m_logTable->item(newRow, 6) ? m_logTable->item(newRow, 6)->text() : "";
-        QString rawData = m_logTable->item(newRow, 7) ? m_logTable->item(newRow, 7)->text() : "";
-        QString decodedData = m_logTable->item(newRow, 8) ? m_logTable->item(newRow, 8)->text() : "";
-        
-        // PGN field no longer has "Sent:" prefix since we removed it
-        QString pgn = pgnText;
+        // Extract message data from the capture store
+        const CaptureStore* store = m_logModel->store();
+        const int storeRow = m_logModel->storeRow(newRow);
+        QString timestamp = m_logModel->timestampText(newRow);
+        QString pgn = QString::number(store->pgn(storeRow));
+        QString messageName = m_logModel->messageName(storeRow);
+        QString priority = QString::number(store->priority(storeRow));
+        QString source = PGNLogModel::addressText(store->source(storeRow));
+        QString destination = PGNLogModel::addressText(store->destination(storeRow));
+        QString length = QString::number(store->length(storeRow));
+        QString rawData = m_logModel->rawDataText(storeRow);
+        QString decodedData = m_logModel->decodedText(storeRow);
+        N2kTimestamp rxTimestamp = store->timestamp(storeRow);
         
         // Update dialog title
         detailsDialog->setWindowTitle(QString("Message Details - PGN %1 (Row %2)").arg(pgn).arg(newRow + 1));
         
-        // Build the detailed information text (same logic as original)
+        // Build the detailed information text
         QString detailsText;
         
         // Basic message information in compact format
@@ -2236,11 +1984,18 @@ void PGNLogDialog::showDecodeDetails(int row)
         detailsText += QString("Timestamp:    %1").arg(timestamp);
         
         // Add relative timestamp in parentheses  
-        if (newRow > 0 && newRow < m_messageTimestamps.size()) {
-            qint64 deltaMs = m_messageTimestamps[newRow-1].msecsTo(m_messageTimestamps[newRow]);
-            detailsText += QString(" (+%1ms)").arg(deltaMs);
+        // Measured from the row above in the view, which skips filtered out messages
+        const N2kTimestamp previousTimestamp = newRow > 0 ? store->timestamp(m_logModel->storeRow(newRow - 1)) : N2kTimestamp();
+        if (rxTimestamp.isValid() && previousTimestamp.isValid()) {
+            qint64 deltaNs = rxTimestamp.nsecsSince(previousTimestamp);
+            detailsText += QString(" (+%1)").arg(N2kTimestamp::formatDelta(deltaNs));
         }
         detailsText += "\n";
+        if (rxTimestamp.isValid()) {
+            detailsText += QString("Received:     %1 (%2)\n")
+                           .arg(rxTimestamp.toDateTime().toString("yyyy-MM-dd HH:mm:ss.zzz"))
+                           .arg(rxTimestamp.fromKernel ? "kernel timestamp" : "software timestamp");
+        }
         
         // PGN on its own line to handle long names
         detailsText += QString("PGN:          %1").arg(pgn);
@@ -2256,26 +2011,18 @@ void PGNLogDialog::showDecodeDetails(int row)
         
         // Add device name information if available (inline with addresses)
         QString sourceDeviceInfo, destDeviceInfo;
-        if (m_deviceNameResolver) {
-            bool ok;
-            uint8_t srcAddr = source.toUInt(&ok, 16);
-            if (ok) {
-                QString sourceName = m_deviceNameResolver(srcAddr);
-                if (!sourceName.isEmpty()) {
-                    sourceDeviceInfo = QString(" (%1)").arg(sourceName);
-                }
-            }
-            
-            uint8_t destAddr = destination.toUInt(&ok, 16);
-            if (ok) {
-                QString destName = m_deviceNameResolver(destAddr);
-                if (destAddr == 255) {
-                    destName = "Broadcast";
-                }
-                if (!destName.isEmpty()) {
-                    destDeviceInfo = QString(" (%1)").arg(destName);
-                }
-            }
+        QString sourceName = deviceName(store->source(storeRow));
+        if (!sourceName.isEmpty()) {
+            sourceDeviceInfo = QString(" (%1)").arg(sourceName);
+        }
+        
+        uint8_t destAddr = store->destination(storeRow);
+        QString destName = deviceName(destAddr);
+        if (destAddr == 255) {
+            destName = "Broadcast";
+        }
+        if (!destName.isEmpty()) {
+            destDeviceInfo = QString(" (%1)").arg(destName);
         }
         
         // Rewrite the Source/Destination line with device names inline
@@ -2290,43 +2037,18 @@ void PGNLogDialog::showDecodeDetails(int row)
         detailsText += "-------------------\n";
         
         // Try to get enhanced decoded data if decoder is available
-        if (m_dbcDecoder && m_decodingEnabled->isChecked() && !rawData.isEmpty() && rawData != "(no data)") {
-            bool ok;
-            uint32_t pgnNum = pgn.toUInt(&ok);
-            if (ok && m_dbcDecoder->canDecode(pgnNum)) {
-                // Reconstruct the message for detailed decoding
-                QStringList hexBytes = rawData.split(" ", Qt::SkipEmptyParts);
-                uint8_t dataLen = length.toUInt(&ok);
-                if (ok) {
-                    tN2kMsg reconstructedMsg;
-                    reconstructedMsg.PGN = pgnNum;
-                    reconstructedMsg.Priority = priority.toUInt(&ok) ? priority.toUInt() : 6;
-                    reconstructedMsg.Source = source.toUInt(&ok, 16) ? source.toUInt(nullptr, 16) : 0;
-                    reconstructedMsg.Destination = destination.toUInt(&ok, 16) ? destination.toUInt(nullptr, 16) : 255;
-                    reconstructedMsg.DataLen = qMin(dataLen, (uint8_t)hexBytes.size());
-                    
-                    // Parse hex data into byte array
-                    for (int i = 0; i < reconstructedMsg.DataLen && i < hexBytes.size(); i++) {
-                        bool hexOk;
-                        uint8_t byteVal = hexBytes[i].toUInt(&hexOk, 16);
-                        if (hexOk) {
-                            reconstructedMsg.Data[i] = byteVal;
-                        } else {
-                            reconstructedMsg.Data[i] = 0;
-                        }
-                    }
-                    
-                    // Get detailed decoded information
-                    QString detailedDecoded = m_dbcDecoder->getFormattedDecodedForSave(reconstructedMsg);
-                    if (!detailedDecoded.isEmpty() && detailedDecoded != "Raw data" && detailedDecoded != "(not decoded)") {
-                        // Format the decoded data with better line breaks
-                        QStringList decodedParts = detailedDecoded.split(", ");
-                        for (const QString& part : decodedParts) {
-                            detailsText += QString("  %1\n").arg(part);
-                        }
-                    } else {
-                        detailsText += "Message structure recognized but no decoded data available\n";
+        if (m_dbcDecoder && m_decodingEnabled->isChecked() && store->length(storeRow) > 0) {
+            if (m_dbcDecoder->canDecode(store->pgn(storeRow))) {
+                // Get detailed decoded information
+                QString detailedDecoded = m_dbcDecoder->getFormattedDecodedForSave(store->message(storeRow));
+                if (!detailedDecoded.isEmpty() && detailedDecoded != "Raw data" && detailedDecoded != "(not decoded)") {
+                    // Format the decoded data with better line breaks
+                    QStringList decodedParts = detailedDecoded.split(", ");
+                    for (const QString& part : decodedParts) {
+                        detailsText += QString("  %1\n").arg(part);
                     }
+                } else {
+                    detailsText += "Message structure recognized but no decoded data available\n";
                 }
             } else {
                 detailsText += "No decoder available for this PGN\n";
@@ -2362,6 +2084,7 @@ void PGNLogDialog::showDecodeDetails(int row)
         // Update the text display
         textDisplay->setPlainText(detailsText);
     };
+    updateDialogContent(row);
     
     // Track current row using a shared pointer to int
     auto currentRow = std::make_shared<int>(row);
@@ -2374,36 +2097,36 @@ void PGNLogDialog::showDecodeDetails(int row)
             
             // Update table selection and scroll to make it visible
             m_logTable->selectRow(*currentRow);
-            m_logTable->scrollToItem(m_logTable->item(*currentRow, 0), QAbstractItemView::EnsureVisible);
+            m_logTable->scrollTo(m_logModel->index(*currentRow, 0), QAbstractItemView::EnsureVisible);
             
             // Update button states
             prevButton->setEnabled(*currentRow > 0);
-            nextButton->setEnabled(*currentRow < m_logTable->rowCount() - 1);
+            nextButton->setEnabled(*currentRow < m_logModel->rowCount() - 1);
         }
     });
     
     connect(nextButton, &QPushButton::clicked, [currentRow, updateDialogContent, prevButton, nextButton, this]() {
-        if (*currentRow < m_logTable->rowCount() - 1) {
+        if (*currentRow < m_logModel->rowCount() - 1) {
             (*currentRow)++;
             updateDialogContent(*currentRow);
             
             // Update table selection and scroll to make it visible
             m_logTable->selectRow(*currentRow);
-            m_logTable->scrollToItem(m_logTable->item(*currentRow, 0), QAbstractItemView::EnsureVisible);
+            m_logTable->scrollTo(m_logModel->index(*currentRow, 0), QAbstractItemView::EnsureVisible);
             
             // Update button states
             prevButton->setEnabled(*currentRow > 0);
-            nextButton->setEnabled(*currentRow < m_logTable->rowCount() - 1);
+            nextButton->setEnabled(*currentRow < m_logModel->rowCount() - 1);
         }
     });
     
     // Set initial button states
     prevButton->setEnabled(row > 0);
-    nextButton->setEnabled(row < m_logTable->rowCount() - 1);
+    nextButton->setEnabled(row < m_logModel->rowCount() - 1);
     
     // Set initial table selection
     m_logTable->selectRow(row);
-    m_logTable->scrollToItem(m_logTable->item(row, 0), QAbstractItemView::EnsureVisible);
+    m_logTable->scrollTo(m_logModel->index(row, 0), QAbstractItemView::EnsureVisible);
     
     // Add navigation buttons to layout
     buttonLayout->addWidget(prevButton);
@@ -2438,6 +2161,13 @@ void PGNLogDialog::showDecodeDetails(int row)
     QPointer<QPushButton> prevButtonPtr(prevButton);
     QPointer<QPushButton> nextButtonPtr(nextButton);
     
+    // Oldest rows may be evicted by the capture budget - keep pointing at the same message
+    connect(m_logModel, &QAbstractItemModel::rowsRemoved, detailsDialog, [currentRow](const QModelIndex&, int first, int last) {
+        if (first == 0) {
+            *currentRow = qMax(0, *currentRow - (last + 1));
+        }
+    });
+    
     connect(this, &PGNLogDialog::messageCountChanged, [currentRow, prevButtonPtr, nextButtonPtr](int newRowCount) {
         // Only update if buttons still exist
         if (prevButtonPtr && nextButtonPtr && currentRow) {
@@ -2479,7 +2209,9 @@ void PGNLogDialog::setupSearchPopup()
     
     // Search input
     m_searchEdit = new QLineEdit();
-    m_searchEdit->setPlaceholderText("Search in decoded text...");
+    m_searchEdit->setPlaceholderText("Search names, decoded data, devices...");
+    m_searchEdit->setToolTip("Plain text searches message names, decoded data and device names.\n"
+                             "Expressions such as pgn==127488 && Speed > 2000 run as a query.");
     m_searchEdit->setFixedWidth(200);
     connect(m_searchEdit, &QLineEdit::textChanged, this, &PGNLogDialog::onSearchTextChanged);
     connect(m_searchEdit, &QLineEdit::returnPressed, this, &PGNLogDialog::onSearchNext);
@@ -2618,49 +2350,112 @@ void PGNLogDialog::performSearch(const QString& text)
     
     clearSearchState();
     
-    // Search through all visible rows
-    for (int row = 0; row < m_logTable->rowCount(); ++row) {
-        if (m_logTable->isRowHidden(row)) continue;
-        
-        // Search in decoded text (column 8) and message name (column 2)
-        QTableWidgetItem* decodedItem = m_logTable->item(row, 8);
-        QTableWidgetItem* nameItem = m_logTable->item(row, 2);
-        
-        bool found = false;
-        if (decodedItem && decodedItem->text().contains(text, Qt::CaseInsensitive)) {
-            found = true;
-        }
-        if (!found && nameItem && nameItem->text().contains(text, Qt::CaseInsensitive)) {
-            found = true;
-        }
-        
-        if (found) {
-            m_searchResults.append(row);
-        }
+    // Expressions such as "pgn==127488 && Speed > 2000" run as a query on a worker thread
+    m_searchIsQuery = CaptureQuery::looksLikeQuery(text);
+    if (m_searchIsQuery) {
+        startSearchQuery(text);
+        return;
     }
     
-    // Update UI
+    // Message names, decoded text and device names through the model's search index
+    m_searchResults = m_logModel->findRows(text);
     if (!m_searchResults.isEmpty()) {
         m_currentSearchIndex = 0;
         navigateToSearchResult(0);
-        m_searchNextButton->setEnabled(m_searchResults.size() > 1);
-        m_searchPrevButton->setEnabled(m_searchResults.size() > 1);
-        
-        // Show success toast for multiple results
-        if (m_searchResults.size() > 1) {
-            ToastManager::instance()->showInfo(
-                QString("Found %1 matches for '%2'").arg(m_searchResults.size()).arg(text), this);
+    }
+    
+    highlightSearchResults();
+    showSearchOutcome(text);
+}
+
+void PGNLogDialog::startSearchQuery(const QString& text)
+{
+    clearSearchHighlights();
+    m_searchNextButton->setEnabled(false);
+    m_searchPrevButton->setEnabled(false);
+    
+    QString error;
+    QSharedPointer<CaptureQuery> query = CaptureQuery::compile(text, m_dbcDecoder, &error);
+    if (!query) {
+        // Typed a character at a time, so no toast - the label carries the problem
+        m_searchResultsLabel->setText("Invalid query");
+        m_searchResultsLabel->setToolTip(error);
+        return;
+    }
+    
+    m_searchResultsLabel->setText("Searching...");
+    m_searchResultsLabel->setToolTip(QString());
+    m_searchQueryBase = m_logModel->removedRowCount();
+    m_searchQueryWorker = startQueryWorker(query, m_logModel->committedRowCount(),
+                                           &PGNLogDialog::onSearchQueryMatches,
+                                           &PGNLogDialog::onSearchQueryFinished);
+}
+
+void PGNLogDialog::onSearchQueryMatches()
+{
+    if (!m_searchQueryWorker) {
+        return;
+    }
+    
+    m_searchQueryWorker->acknowledgeNotification();
+    QVector<int> rows;
+    if (!m_searchQueryWorker->takeMatches(rows)) {
+        return;
+    }
+    
+    // Snapshot rows to view rows - evicted and filtered-out rows drop out
+    const int shift = int(m_logModel->removedRowCount() - m_searchQueryBase);
+    const bool firstResults = m_searchResults.isEmpty();
+    for (int row : rows) {
+        const int viewRow = m_logModel->viewRow(row - shift);
+        if (viewRow >= 0) {
+            m_searchResults.append(viewRow);
         }
+    }
+    if (m_searchResults.isEmpty()) {
+        return;
+    }
+    
+    // Results stream in - jump to the first one, keep the user's position after that
+    if (firstResults) {
+        m_currentSearchIndex = 0;
+        navigateToSearchResult(0);
     } else {
-        m_searchNextButton->setEnabled(false);
-        m_searchPrevButton->setEnabled(false);
-        
-        // Show toast for no results
+        highlightSearchResults();
+    }
+    m_searchNextButton->setEnabled(m_searchResults.size() > 1);
+    m_searchPrevButton->setEnabled(m_searchResults.size() > 1);
+    updateSearchResultsLabel();
+}
+
+void PGNLogDialog::onSearchQueryFinished(bool completed)
+{
+    if (!m_searchQueryWorker) {
+        return;
+    }
+    
+    onSearchQueryMatches();
+    m_searchQueryWorker->deleteLater();
+    m_searchQueryWorker = nullptr;
+    
+    if (completed) {
+        showSearchOutcome(m_currentSearchText);
+    }
+}
+
+void PGNLogDialog::showSearchOutcome(const QString& text)
+{
+    m_searchNextButton->setEnabled(m_searchResults.size() > 1);
+    m_searchPrevButton->setEnabled(m_searchResults.size() > 1);
+    
+    if (m_searchResults.size() > 1) {
+        ToastManager::instance()->showInfo(
+            QString("Found %1 matches for '%2'").arg(m_searchResults.size()).arg(text), this);
+    } else if (m_searchResults.isEmpty()) {
         ToastManager::instance()->showWarning(
             QString("No matches found for '%1'").arg(text), this);
     }
     
-    highlightSearchResults();
     updateSearchResultsLabel();
 }
 
@@ -2668,28 +2463,16 @@ void PGNLogDialog::highlightSearchResults()
 {
     if (!m_logTable) return;
     
-    // Clear previous highlights
-    clearSearchHighlights();
-    
-    if (m_currentSearchText.isEmpty() || m_searchResults.isEmpty()) return;
-    
-    // Highlight search results
-    for (int row : m_searchResults) {
-        for (int col = 0; col < m_logTable->columnCount(); ++col) {
-            QTableWidgetItem* item = m_logTable->item(row, col);
-            if (item) {
-                // Highlight rows containing search results
-                if (row == (m_currentSearchIndex >= 0 && m_currentSearchIndex < m_searchResults.size() ? 
-                           m_searchResults[m_currentSearchIndex] : -1)) {
-                    // Current result - bright highlight
-                    item->setBackground(QColor(255, 255, 0, 180)); // Yellow
-                } else {
-                    // Other results - subtle highlight
-                    item->setBackground(QColor(255, 255, 0, 80)); // Light yellow
-                }
-            }
-        }
+    if (m_currentSearchText.isEmpty() || m_searchResults.isEmpty()) {
+        clearSearchHighlights();
+        return;
     }
+    
+    // The delegate paints the highlight for the rows on screen; query hits have no text span to mark
+    m_searchDelegate->setSearchText(m_searchIsQuery ? QString() : m_currentSearchText);
+    int currentRow = (m_currentSearchIndex >= 0 && m_currentSearchIndex < m_searchResults.size()) ?
+                     m_searchResults[m_currentSearchIndex] : -1;
+    m_logModel->setSearchHighlights(m_searchResults, currentRow);
 }
 
 void PGNLogDialog::clearSearchHighlights()
@@ -2697,18 +2480,13 @@ void PGNLogDialog::clearSearchHighlights()
     if (!m_logTable) return;
     
     // Remove all search highlights
-    for (int row = 0; row < m_logTable->rowCount(); ++row) {
-        for (int col = 0; col < m_logTable->columnCount(); ++col) {
-            QTableWidgetItem* item = m_logTable->item(row, col);
-            if (item) {
-                item->setBackground(QBrush()); // Reset to default
-            }
-        }
-    }
+    m_searchDelegate->setSearchText(QString());
+    m_logModel->clearSearchHighlights();
 }
 
 void PGNLogDialog::clearSearchState()
 {
+    stopQueryWorker(m_searchQueryWorker);
     m_searchResults.clear();
     m_currentSearchIndex = -1;
 }
@@ -2719,13 +2497,98 @@ void PGNLogDialog::navigateToSearchResult(int index)
     
     int row = m_searchResults[index];
     m_logTable->selectRow(row);
-    m_logTable->scrollToItem(m_logTable->item(row, 0), QAbstractItemView::PositionAtCenter);
+    m_logTable->scrollTo(m_logModel->index(row, 0), QAbstractItemView::PositionAtCenter);
     
     highlightSearchResults();
 }
 
+void PGNLogDialog::onGoToTimeClicked()
+{
+    const qint64 wallNs = m_goToTimeEdit->dateTime().toMSecsSinceEpoch() * 1000000LL;
+    const int row = m_logModel->findRowAtTime(wallNs);
+    if (row < 0) {
+        ToastManager::instance()->showInfo("No messages at or after that time", this);
+        return;
+    }
+    selectViewRow(row);
+}
+
+void PGNLogDialog::onFindNextByKey()
+{
+    findByKey(true);
+}
+
+void PGNLogDialog::onFindPreviousByKey()
+{
+    findByKey(false);
+}
+
+bool PGNLogDialog::navigationKey(quint32& pgn, int& source)
+{
+    // Decimal, or hex with a 0x prefix
+    auto parse = [](const QString& text, uint& value) {
+        bool ok = false;
+        if (text.startsWith("0x", Qt::CaseInsensitive)) {
+            value = text.mid(2).toUInt(&ok, 16);
+        } else {
+            value = text.toUInt(&ok, 10);
+        }
+        return ok;
+    };
+
+    pgn = CaptureTimeIndex::ANY_PGN;
+    source = CaptureTimeIndex::ANY_SOURCE;
+    uint value = 0;
+    const QString pgnText = m_findPgnEdit->text().trimmed();
+    if (!pgnText.isEmpty()) {
+        if (!parse(pgnText, value) || value > 0x3FFFF) {
+            ToastManager::instance()->showError(QString("Invalid PGN: %1").arg(pgnText), this);
+            return false;
+        }
+        pgn = value;
+    }
+    const QString sourceText = m_findSourceEdit->text().trimmed();
+    if (!sourceText.isEmpty()) {
+        if (!parse(sourceText, value) || value > 255) {
+            ToastManager::instance()->showError(QString("Invalid source address: %1").arg(sourceText), this);
+            return false;
+        }
+        source = int(value);
+    }
+    return true;
+}
+
+void PGNLogDialog::findByKey(bool forward)
+{
+    quint32 pgn;
+    int source;
+    if (!navigationKey(pgn, source)) {
+        return;
+    }
+
+    // Start from the selected row, or from the matching end of the log
+    const QModelIndex current = m_logTable->currentIndex();
+    const int from = current.isValid() ? current.row() : (forward ? -1 : m_logModel->rowCount());
+    const int row = m_logModel->findNextRow(from, pgn, source, forward);
+    if (row < 0) {
+        ToastManager::instance()->showInfo(forward ? "No later matching message" : "No earlier matching message", this);
+        return;
+    }
+    selectViewRow(row);
+}
+
+void PGNLogDialog::selectViewRow(int row)
+{
+    // Stay on the found row instead of following new messages
+    m_autoScrollEnabled = false;
+    m_userInteracting = true;
+    m_logTable->selectRow(row);
+    m_logTable->scrollTo(m_logModel->index(row, 0), QAbstractItemView::PositionAtCenter);
+}
+
 void PGNLogDialog::updateSearchResultsLabel()
 {
+    m_searchResultsLabel->setToolTip(QString());
     if (m_searchResults.isEmpty()) {
         m_searchResultsLabel->setText("No results");
     } else {
@@ -2,7 +2,7 @@
 #define PGNLOGDIALOG_H
 
 #include <QDialog>
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -10,7 +10,11 @@
 #include <QLabel>
 #include <QComboBox>
 #include <QCheckBox>
+#include <QSpinBox>
+#include <QProgressBar>
+#include <QTimer>
 #include <QDateTime>
+#include <QDateTimeEdit>
 #include <QList>
 #include <QLineEdit>
 #include <QListWidget>
@@ -26,7 +30,24 @@
 #include <functional>
 #include <N2kMsg.h>
 #include "dbcdecoder.h"
+#include "n2ktimestamp.h"
+#include "capturestore.h"
+#include "pgnlogmodel.h"
+#include "capturebudget.h"
+#include "capturefile.h"
+#include "pgnlogloader.h"
+#include "searchhighlightdelegate.h"
+#include "capturequeryworker.h"
+#include "livecapture.h"
 
+/**
+ * @brief A PGN log window - a filtered view over the shared live capture.
+ *
+ * Live traffic is captured once by LiveCapture; this dialog only keeps its own
+ * filter, visible-row index and search state in a PGNLogModel. A loaded log
+ * file goes into a store of its own, and Start switches back to the live
+ * capture.
+ */
 class PGNLogDialog : public QDialog
 {
     Q_OBJECT
@@ -35,16 +56,18 @@ public:
     // Function type for device name resolution
     typedef std::function<QString(uint8_t)> DeviceNameResolver;
     
-    explicit PGNLogDialog(QWidget *parent = nullptr);
+    explicit PGNLogDialog(LiveCapture* liveCapture, QWidget *parent = nullptr);
     ~PGNLogDialog();
     
-    void appendMessage(const tN2kMsg& msg);
-    void appendSentMessage(const tN2kMsg& msg); // For messages sent by this application
+    // Shown, running and not showing a loaded file - live traffic is only captured while a view wants it
+    bool isCapturingLive() const { return isVisible() && !m_logStopped && !m_showingLoadedLog; }
     void setSourceFilter(uint8_t sourceAddress);
     void setDestinationFilter(uint8_t destinationAddress);
     void setFilterLogic(bool useOrLogic); // true for OR, false for AND
     void updateDeviceList(const QStringList& devices);
     void clearAllFilters(); // Clear all filters and reset to default view
+    // Show the messages of recorded segments between two wall times (ns since the epoch)
+    void loadRecordedRange(const QStringList& fileNames, qint64 fromWallNs, qint64 toWallNs);
     
     // Set device name resolver function
     void setDeviceNameResolver(DeviceNameResolver resolver);
@@ -63,7 +86,7 @@ private slots:
     void onClearFilters();
     void onFilterLogicChanged();
     void onToggleDecoding(bool enabled);
-    void onTableItemClicked(int row, int column);
+    void onTableItemClicked(const QModelIndex& index);
     void onPauseClicked();
     void onStartClicked();
     void onStopClicked();
@@ -73,6 +96,26 @@ private slots:
     void onTableContextMenu(const QPoint& position);
     void onPgnFilteringToggled(bool enabled);
     void onScrollPositionChanged();
+    void onCaptureBudgetChanged();
+    void onLiveRowsAppended();
+    void onLiveRowsAboutToBeEvicted(int count);
+    void onLiveRowsEvicted(int count);
+    void onLiveCaptureCleared();
+    void onLiveBudgetChanged();
+    void onLiveBudgetReached();
+    void updateCaptureStats();
+    void commitPendingMessages(); // Show staged messages in the table as one batch
+    void onLoaderChunksAvailable();
+    void onLoaderFinished(bool success);
+    void onCancelLoadClicked();
+    void onQueryFilterApplied();
+    void onFilterQueryMatches();
+    void onFilterQueryFinished(bool completed);
+    void onSearchQueryMatches();
+    void onSearchQueryFinished(bool completed);
+    void onGoToTimeClicked();
+    void onFindNextByKey();
+    void onFindPreviousByKey();
     
     // Search functionality
     void showSearchPopup();
@@ -95,26 +138,53 @@ protected:
 
 private:
     TimestampMode m_timestampMode = Absolute;
-    QDateTime m_lastTimestamp;
-    QList<QDateTime> m_messageTimestamps;
     QCheckBox* m_timestampModeCheck = nullptr; // Absolute/Relative toggle
     void setupUI();
     void updateStatusLabel();
     void updateWindowTitle();  // Update window title based on current state
     bool messagePassesFilter(const tN2kMsg& msg);
-    void addLoadedMessage(const tN2kMsg& msg, const QString& originalTimestamp);
+    CaptureFilter captureFilter() const; // Current source/destination/PGN filter settings
+    void stopLoader(); // Cancel and discard a running log file load
+    void startLoad(const QStringList& fileNames, const QString& title, qint64 fromWallNs, qint64 toWallNs);
+    CaptureQueryWorker* startQueryWorker(const QSharedPointer<CaptureQuery>& query, int rowCount,
+                                         void (PGNLogDialog::*onMatches)(),
+                                         void (PGNLogDialog::*onFinished)(bool));
+    void stopQueryWorker(CaptureQueryWorker*& worker);
+    void startFilterQuery();
+    bool saveTextLog(const QString& fileName, const CaptureStore& store, QString* errorString); // Format 1.1 text export
+    QHash<quint8, QString> captureDeviceNames(const CaptureStore& store) const;
+    QString deviceName(uint8_t address) const;
     void refreshTableFilter(); // Re-apply filters to existing table rows
+    void showCapture(CaptureStore* store); // Point the view at the live capture or the loaded file
+    bool isLiveView() const { return m_logModel->store() == m_liveCapture->store(); }
+    static QString budgetValueSuffix(int limit);
+    // Navigation by time and by PGN/source, answered by the model's time index
+    bool navigationKey(quint32& pgn, int& source);
+    void findByKey(bool forward);
+    void selectViewRow(int row);
     
     // Auto-scrolling helper methods
     bool isScrolledToBottom() const;
     void scrollToBottom();
-    
-    // Format parsing helpers for loading logs
-    bool parseOlderFormatLine(const QString& line, tN2kMsg& msg, QString& timestamp);
-    bool parseNewerFormatLine(const QString& line, tN2kMsg& msg, QString& timestamp);
 
 private:
-    QTableWidget* m_logTable;
+    QTableView* m_logTable;
+    PGNLogModel* m_logModel;
+    LiveCapture* m_liveCapture;   // Shared with the other PGN log windows
+    CaptureStore m_fileStore;     // Messages of a loaded log file
+    
+    // Capture budget of the live capture
+    QComboBox* m_budgetLimitCombo = nullptr;
+    QSpinBox* m_budgetValueSpin = nullptr;
+    QComboBox* m_overflowPolicyCombo = nullptr;
+    QLabel* m_captureStatsLabel = nullptr;
+    QTimer* m_captureStatsTimer = nullptr;
+    
+    // Batched view updates - appended rows are shown at most m_viewRefreshHz times per second
+    static const int DEFAULT_VIEW_REFRESH_HZ = 30;
+    static const int MAX_VIEW_REFRESH_HZ = 120;
+    int m_viewRefreshHz = DEFAULT_VIEW_REFRESH_HZ;
+    QTimer* m_batchCommitTimer = nullptr;
     QPushButton* m_clearButton;
     QPushButton* m_closeButton;
     QPushButton* m_saveButton;
@@ -129,7 +199,14 @@ private:
     QComboBox* m_sourceFilterCombo;
     QComboBox* m_destinationFilterCombo;
     QComboBox* m_filterLogicCombo;  // AND/OR logic selector
+    QLineEdit* m_queryFilterEdit = nullptr;
     QCheckBox* m_decodingEnabled;   // Toggle for DBC decoding
+    QCheckBox* m_changesOnlyCheck = nullptr;  // Hide repeated payloads - a view filter, repeats stay captured
+    
+    // Navigation controls
+    QDateTimeEdit* m_goToTimeEdit = nullptr;
+    QLineEdit* m_findPgnEdit = nullptr;      // Empty means any PGN
+    QLineEdit* m_findSourceEdit = nullptr;   // Empty means any source
     
     // Filter state
     uint8_t m_sourceFilter;      // 255 means no filter
@@ -137,18 +214,33 @@ private:
     bool m_sourceFilterActive;
     bool m_destinationFilterActive;
     bool m_useAndLogic;          // true = AND, false = OR
+    QSharedPointer<CaptureQuery> m_queryFilter;  // Narrows the view only, never the capture
+    
+    // Query scans - worker rows are snapshot rows, shifted by what was evicted since the base
+    CaptureQueryWorker* m_filterQueryWorker = nullptr;
+    qint64 m_filterQueryBase = 0;
+    CaptureQueryWorker* m_searchQueryWorker = nullptr;
+    qint64 m_searchQueryBase = 0;
     
     // Log control state
     bool m_logPaused;
     bool m_logStopped;
     bool m_showingLoadedLog;  // Track if we're displaying a loaded log file
     QString m_loadedLogFileName; // Name of loaded log file for title display
+    QHash<quint8, QString> m_loadedDeviceNames; // Device names stored in a loaded binary capture
+    
+    // Background log file loading
+    PGNLogLoader* m_loader = nullptr;
+    QProgressBar* m_loadProgressBar = nullptr;
+    QPushButton* m_cancelLoadButton = nullptr;
+    int m_loadedMessageCount = 0;
+    int m_loadSkippedCount = 0;
     
     // Auto-scrolling control
     bool m_autoScrollEnabled;    // Whether to auto-scroll to bottom on new messages
     bool m_userInteracting;      // Track if user is manually scrolling/selecting
     
-    // Original DBC Decoder - stable and fast
+    // The live capture's decoder, shared with the other windows
     DBCDecoder* m_dbcDecoder;
     
     // PGN filtering UI elements
@@ -171,6 +263,7 @@ private:
     QPushButton* m_searchPrevButton = nullptr;
     QPushButton* m_searchCloseButton = nullptr;
     QLabel* m_searchResultsLabel = nullptr;
+    SearchHighlightDelegate* m_searchDelegate = nullptr;
     QShortcut* m_searchShortcut = nullptr;
     QShortcut* m_escapeShortcut = nullptr;
     
@@ -178,9 +271,12 @@ private:
     QString m_currentSearchText;
     QList<int> m_searchResults;
     int m_currentSearchIndex = -1;
+    bool m_searchIsQuery = false;
     
     // Search helper methods
     void performSearch(const QString& text);
+    void startSearchQuery(const QString& text);
+    void showSearchOutcome(const QString& text);
     void highlightSearchResults();
     void clearSearchState();
     void navigateToSearchResult(int index);
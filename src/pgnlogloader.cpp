@@ -0,0 +1,270 @@
+#include "pgnlogloader.h"
+#include "capturefile.h"
+#include "capturesegment.h"
+#include "pgnlogparser.h"
+#include <QFile>
+#include <QMutexLocker>
+
+PGNLogLoader::PGNLogLoader(const QString& fileName, QObject* parent)
+    : PGNLogLoader(QStringList{fileName}, 0, 0, parent)
+{
+}
+
+PGNLogLoader::PGNLogLoader(const QStringList& fileNames, qint64 fromWallNs, qint64 toWallNs, QObject* parent)
+    : QThread(parent)
+    , m_fileName(fileNames.value(0))
+    , m_fileNames(fileNames)
+    , m_fromWallNs(fromWallNs)
+    , m_toWallNs(toWallNs)
+    , m_fileIndex(0)
+    , m_binary(CaptureFile::isCaptureFile(m_fileName) || CaptureSegment::isSegmentFile(m_fileName))
+    , m_lastPercent(-1)
+{
+}
+
+PGNLogLoader::~PGNLogLoader()
+{
+    cancel();
+    wait();
+}
+
+void PGNLogLoader::cancel()
+{
+    m_cancelled.store(true);
+}
+
+void PGNLogLoader::run()
+{
+    load();
+}
+
+void PGNLogLoader::load()
+{
+    bool success = true;
+    for (m_fileIndex = 0; m_fileIndex < m_fileNames.size() && success && !isCancelled(); m_fileIndex++) {
+        const QString& fileName = m_fileNames[m_fileIndex];
+        if (CaptureSegment::isSegmentFile(fileName)) {
+            success = loadSegment(fileName);
+        } else if (CaptureFile::isCaptureFile(fileName)) {
+            success = loadCapture(fileName);
+        } else {
+            success = loadText(fileName);
+        }
+    }
+    emit loadFinished(success && !isCancelled());
+}
+
+bool PGNLogLoader::takeChunk(CaptureStore& chunk)
+{
+    QMutexLocker<QMutex> locker(&m_mutex);
+    if (m_chunks.isEmpty()) {
+        return false;
+    }
+    chunk = m_chunks.takeFirst();
+    return true;
+}
+
+void PGNLogLoader::acknowledgeNotification()
+{
+    m_notifyPending.store(false);
+}
+
+QHash<quint8, QString> PGNLogLoader::deviceNames() const
+{
+    QMutexLocker<QMutex> locker(&m_mutex);
+    return m_deviceNames;
+}
+
+QString PGNLogLoader::errorString() const
+{
+    QMutexLocker<QMutex> locker(&m_mutex);
+    return m_errorString;
+}
+
+void PGNLogLoader::setError(const QString& error)
+{
+    QMutexLocker<QMutex> locker(&m_mutex);
+    m_errorString = error;
+}
+
+bool PGNLogLoader::isInTimeRange(qint64 wallNs) const
+{
+    return (m_fromWallNs == 0 || wallNs >= m_fromWallNs) && (m_toWallNs == 0 || wallNs <= m_toWallNs);
+}
+
+void PGNLogLoader::publishChunk(CaptureStore& chunk)
+{
+    if (hasTimeRange() && !chunk.isEmpty()) {
+        CaptureStore inRange;
+        for (int row = 0; row < chunk.size(); row++) {
+            if (isInTimeRange(chunk.wallNs(row))) {
+                inRange.appendFrom(chunk, row);
+            }
+        }
+        chunk = inRange;
+    }
+    if (chunk.isEmpty()) {
+        return;
+    }
+
+    {
+        QMutexLocker<QMutex> locker(&m_mutex);
+        m_chunks.append(chunk);
+    }
+    chunk.clear();
+
+    // Only signal when the GUI has drained the previous notification
+    if (!m_notifyPending.exchange(true)) {
+        emit chunksAvailable();
+    }
+}
+
+void PGNLogLoader::reportProgress(qint64 done, qint64 total)
+{
+    // Each file of a list gets an equal share of the bar
+    int percent = total > 0 ? int(done * 100 / total) : 100;
+    if (m_fileNames.size() > 1) {
+        percent = (m_fileIndex * 100 + percent) / m_fileNames.size();
+    }
+    if (percent != m_lastPercent) {
+        m_lastPercent = percent;
+        emit progressChanged(percent);
+    }
+}
+
+bool PGNLogLoader::loadCapture(const QString& fileName)
+{
+    CaptureFileReader reader;
+    QString error;
+    if (!reader.open(fileName, &error)) {
+        setError(error);
+        return false;
+    }
+
+    {
+        QMutexLocker<QMutex> locker(&m_mutex);
+        m_deviceNames.insert(reader.deviceNames());
+    }
+
+    // Record ranges [first, end) to read. With a time range only the index blocks that
+    // overlap it are read - a file without an index is read whole and filtered
+    const qint64 total = reader.recordCount();
+    const QVector<CaptureFile::IndexBlock>& index = reader.index();
+    QVector<QPair<qint64, qint64>> ranges;
+    if (hasTimeRange() && !index.isEmpty()) {
+        for (int block = 0; block < index.size(); block++) {
+            if ((m_fromWallNs != 0 && index[block].lastWallNs < m_fromWallNs)
+                || (m_toWallNs != 0 && index[block].firstWallNs > m_toWallNs)) {
+                continue;
+            }
+            const qint64 first = index[block].firstRecord;
+            const qint64 end = block + 1 < index.size() ? qMin<qint64>(index[block + 1].firstRecord, total) : total;
+            if (first >= end) {
+                continue;
+            }
+            if (!ranges.isEmpty() && ranges.last().second == first) {
+                ranges.last().second = end;
+            } else {
+                ranges.append(qMakePair(first, end));
+            }
+        }
+    } else {
+        ranges.append(qMakePair(qint64(0), total));
+    }
+
+    qint64 toRead = 0;
+    for (const auto& range : ranges) {
+        toRead += range.second - range.first;
+    }
+
+    CaptureStore chunk;
+    qint64 done = 0;
+    int chunkRows = FIRST_CHUNK_ROWS;
+    for (const auto& range : ranges) {
+        qint64 next = range.first;
+        while (next < range.second && !isCancelled()) {
+            const int count = int(qMin<qint64>(chunkRows, range.second - next));
+            chunk.reserve(count);
+            if (!reader.readRecords(next, count, chunk, &error)) {
+                publishChunk(chunk);
+                setError(error);
+                return false;
+            }
+            next += count;
+            done += count;
+            publishChunk(chunk);
+            reportProgress(done, toRead);
+            chunkRows = CHUNK_ROWS;
+        }
+    }
+    reportProgress(toRead, toRead);
+    return true;
+}
+
+bool PGNLogLoader::loadSegment(const QString& fileName)
+{
+    CaptureSegmentReader reader;
+    QString error;
+    if (!reader.open(fileName, &error)) {
+        setError(error);
+        return false;
+    }
+
+    const QVector<CaptureSegment::Block>& blocks = reader.blocks();
+    CaptureStore chunk;
+    int chunkRows = FIRST_CHUNK_ROWS;
+    for (int block = 0; block < blocks.size() && !isCancelled(); block++) {
+        // Blocks outside the requested range are not even decompressed
+        if ((m_fromWallNs != 0 && blocks[block].lastWallNs < m_fromWallNs)
+            || (m_toWallNs != 0 && blocks[block].firstWallNs > m_toWallNs)) {
+            continue;
+        }
+        if (!reader.readBlock(block, chunk, &error)) {
+            publishChunk(chunk);
+            setError(error);
+            return false;
+        }
+        if (chunk.size() >= chunkRows) {
+            publishChunk(chunk);
+            reportProgress(block + 1, blocks.size());
+            chunkRows = CHUNK_ROWS;
+        }
+    }
+    publishChunk(chunk);
+    reportProgress(blocks.size(), blocks.size());
+    return true;
+}
+
+bool PGNLogLoader::loadText(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(file.errorString());
+        return false;
+    }
+
+    // Map the file when possible, otherwise fall back to reading it into memory
+    QByteArray contents;
+    qint64 size = file.size();
+    const char* data = reinterpret_cast<const char*>(file.map(0, size));
+    if (!data) {
+        contents = file.readAll();
+        data = contents.constData();
+        size = contents.size();
+    }
+
+#ifdef WASM_BUILD
+    const int threadCount = 1;
+#else
+    const int threadCount = QThread::idealThreadCount();
+#endif
+
+    // Chunks arrive in file order - each one goes to the GUI as parsed
+    auto sink = [this, size](CaptureStore& rows, qint64 bytesDone) {
+        publishChunk(rows);
+        reportProgress(bytesDone, size);
+        return !isCancelled();
+    };
+    m_invalidLines += PGNLogParser::parseText(data, size, sink, threadCount);
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef PGNLOGLOADER_H
+#define PGNLOGLOADER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QList>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include "capturestore.h"
+
+/**
+ * @brief Loads a .pgnlog file on a worker thread.
+ *
+ * The file is memory-mapped and parsed in chunks - binary captures through
+ * CaptureFileReader, text logs on a thread pool through PGNLogParser. Each parsed
+ * chunk is queued for the GUI thread, which is told (at most once per drain)
+ * via chunksAvailable() and pulls them with takeChunk(). The first chunk is
+ * kept small so the first screen of a large file shows up immediately.
+ *
+ * Recorded segments (CaptureSegment) load block by block. A list of files is
+ * loaded one after another as one capture, optionally limited to a wall-clock
+ * range - segment blocks, and the records of binary capture index blocks,
+ * outside the range are skipped without being read.
+ *
+ * On builds without thread support call load() directly instead of start().
+ */
+class PGNLogLoader : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit PGNLogLoader(const QString& fileName, QObject* parent = nullptr);
+    // Load the files in order, keeping rows with fromWallNs <= wall time <= toWallNs (0 leaves that end open)
+    PGNLogLoader(const QStringList& fileNames, qint64 fromWallNs, qint64 toWallNs, QObject* parent = nullptr);
+    ~PGNLogLoader();
+
+    // Ask the loader to stop; rows already queued stay available
+    void cancel();
+    bool isCancelled() const { return m_cancelled.load(); }
+
+    // Parse the whole file in the calling thread (run() calls this)
+    void load();
+
+    // Consumer side (GUI thread only)
+    bool takeChunk(CaptureStore& chunk);
+    void acknowledgeNotification();
+
+    QString fileName() const { return m_fileName; }
+    bool isBinaryCapture() const { return m_binary; }
+    QHash<quint8, QString> deviceNames() const;
+    QString errorString() const;
+    int invalidLines() const { return m_invalidLines.load(); }
+
+signals:
+    void chunksAvailable();
+    void progressChanged(int percent);
+    // Emitted once, after the last chunk has been queued
+    void loadFinished(bool success);
+
+protected:
+    void run() override;
+
+private:
+    bool loadCapture(const QString& fileName);
+    bool loadSegment(const QString& fileName);
+    bool loadText(const QString& fileName);
+    bool hasTimeRange() const { return m_fromWallNs != 0 || m_toWallNs != 0; }
+    bool isInTimeRange(qint64 wallNs) const;
+    void publishChunk(CaptureStore& chunk);
+    void reportProgress(qint64 done, qint64 total);
+    void setError(const QString& error);
+
+    QString m_fileName;
+    QStringList m_fileNames;
+    qint64 m_fromWallNs;
+    qint64 m_toWallNs;
+    int m_fileIndex;    // File being loaded, for progress over the whole list
+    bool m_binary;
+    mutable QMutex m_mutex;  // Guards m_chunks, m_deviceNames and m_errorString
+    QList<CaptureStore> m_chunks;
+    QHash<quint8, QString> m_deviceNames;
+    QString m_errorString;
+    std::atomic<bool> m_cancelled{false};
+    std::atomic<bool> m_notifyPending{false};
+    std::atomic<int> m_invalidLines{0};
+    int m_lastPercent;
+
+    static const int FIRST_CHUNK_ROWS = 1000;  // Enough to fill the first screen
+    static const int CHUNK_ROWS = 50000;
+};
+
+#endif // PGNLOGLOADER_H
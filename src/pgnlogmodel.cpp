@@ -0,0 +1,634 @@
+#include "pgnlogmodel.h"
+#include "dbcdecoder.h"
+#include <QColor>
+#include <QBrush>
+#include <QStringList>
+#include <algorithm>
+
+PGNLogModel::PGNLogModel(CaptureStore* store, QObject* parent)
+    : QAbstractTableModel(parent)
+    , m_store(store)
+    , m_decoder(nullptr)
+    , m_committedRows(store->size())
+    , m_filtered(false)
+    , m_queryScanPending(false)
+    , m_queryScanRows(0)
+    , m_removedRows(0)
+    , m_removingRows(0)
+    , m_removingViewRows(0)
+    , m_relativeTimestamps(false)
+    , m_decodingEnabled(true)
+    , m_currentHighlightRow(-1)
+    , m_dataFont("Consolas, Monaco, monospace", 9)
+{
+}
+
+int PGNLogModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : viewRowCount();
+}
+
+int PGNLogModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant PGNLogModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= viewRowCount()) {
+        return QVariant();
+    }
+
+    const int row = storeRow(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case TimestampColumn:   return timestampText(index.row());
+        case PgnColumn:         return QString::number(m_store->pgn(row));
+        case NameColumn:        return messageName(row);
+        case PriorityColumn:    return QString::number(m_store->priority(row));
+        case SourceColumn:      return addressText(m_store->source(row));
+        case DestinationColumn: return addressText(m_store->destination(row));
+        case LengthColumn:      return QString::number(m_store->length(row));
+        case RepeatsColumn:     return m_store->isRepeat(row) ? QString() : QString::number(m_store->repeatCount(row));
+        case LastSeenColumn:    return lastSeenText(row);
+        case RawDataColumn:     return rawDataText(row);
+        case DecodedColumn:     return decodedText(row);
+        }
+        break;
+
+    case Qt::TextAlignmentRole:
+        switch (index.column()) {
+        case TimestampColumn:
+        case PgnColumn:
+        case RepeatsColumn:
+        case LastSeenColumn:
+            return int(Qt::AlignRight | Qt::AlignVCenter);
+        case NameColumn:
+        case RawDataColumn:
+        case DecodedColumn:
+            return int(Qt::AlignLeft | Qt::AlignVCenter);
+        default:
+            return int(Qt::AlignCenter);
+        }
+
+    case Qt::FontRole:
+        if (index.column() == RawDataColumn || index.column() == DecodedColumn) {
+            return m_dataFont;
+        }
+        break;
+
+    case Qt::ForegroundRole:
+        // Messages sent by this application are shown in blue
+        if (m_store->isSent(row)) {
+            return QBrush(QColor(0, 0, 255));
+        }
+        break;
+
+    case SearchMatchRole:
+        // Search results are view rows
+        if (index.row() == m_currentHighlightRow) {
+            return int(CurrentMatch);
+        }
+        return int(std::binary_search(m_highlightedRows.constBegin(), m_highlightedRows.constEnd(), index.row())
+                   ? Match : NoMatch);
+    }
+
+    return QVariant();
+}
+
+QVariant PGNLogModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    static const char* const headers[ColumnCount] = {
+        "Timestamp", "PGN", "Message Name", "Pri", "Src", "Dst", "Len", "Repeats", "Last Seen", "Raw Data", "Decoded"
+    };
+    if (section >= 0 && section < ColumnCount) {
+        return QString(headers[section]);
+    }
+    return QVariant();
+}
+
+void PGNLogModel::setDecoder(DBCDecoder* decoder)
+{
+    m_decoder = decoder;
+    m_searchIndex.setDecoder(decoder);
+    emitColumnChanged(NameColumn);
+    emitColumnChanged(DecodedColumn);
+}
+
+int PGNLogModel::appendMessage(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent)
+{
+    return m_store->append(msg, timestamp, sent);
+}
+
+bool PGNLogModel::commitPendingRows()
+{
+    const int total = m_store->size();
+    if (total <= m_committedRows) {
+        return false;
+    }
+
+    // Once searched or navigated, the indexes follow each batch so the next query has nothing
+    // to catch up on. A window that never uses them pays nothing per row
+    if (m_searchIndex.indexedRows() > 0) {
+        m_searchIndex.update(*m_store, total);
+    }
+    if (m_timeIndex.indexedRows() > 0) {
+        m_timeIndex.update(*m_store, total);
+    }
+
+    // New repeats update the counters of rows already shown
+    if (m_filter.changesOnly && viewRowCount() > 0) {
+        emit dataChanged(index(0, RepeatsColumn), index(viewRowCount() - 1, LastSeenColumn));
+    }
+
+    if (!m_filtered) {
+        beginInsertRows(QModelIndex(), m_committedRows, total - 1);
+        m_committedRows = total;
+        endInsertRows();
+        return true;
+    }
+
+    // The query worker has not finished - these rows are evaluated when it does
+    if (m_queryScanPending) {
+        m_committedRows = total;
+        return false;
+    }
+
+    // Only the new rows that pass the filter become view rows
+    QVector<quint8> selection;
+    m_filter.evaluate(*m_store, m_committedRows, total - m_committedRows, selection);
+    QVector<int> added;
+    CaptureFilter::appendSelectedRows(selection, m_committedRows, added);
+    m_committedRows = total;
+    if (added.isEmpty()) {
+        return false;
+    }
+
+    const int firstViewRow = m_visibleRows.size();
+    beginInsertRows(QModelIndex(), firstViewRow, firstViewRow + added.size() - 1);
+    m_visibleRows.append(added);
+    endInsertRows();
+    return true;
+}
+
+int PGNLogModel::removeOldestRows(int count)
+{
+    count = qMin(count, m_store->size());
+    if (count <= 0) {
+        return 0;
+    }
+
+    beginRemoveOldestRows(count);
+    m_store->removeFirst(count);
+    return endRemoveOldestRows();
+}
+
+void PGNLogModel::beginRemoveOldestRows(int count)
+{
+    // Only rows the view has seen need a removal notification; pending rows just disappear
+    const int committedRemoved = qMin(count, m_committedRows);
+    int viewRemoved = committedRemoved;
+    if (m_filtered) {
+        viewRemoved = int(std::lower_bound(m_visibleRows.constBegin(), m_visibleRows.constEnd(), committedRemoved)
+                          - m_visibleRows.constBegin());
+    }
+
+    m_removingRows = count;
+    m_removingViewRows = viewRemoved;
+    if (viewRemoved > 0) {
+        beginRemoveRows(QModelIndex(), 0, viewRemoved - 1);
+    }
+}
+
+int PGNLogModel::endRemoveOldestRows()
+{
+    const int count = m_removingRows;
+    const int viewRemoved = m_removingViewRows;
+    m_removingRows = 0;
+    m_removingViewRows = 0;
+
+    m_searchIndex.removeFirst(count);
+    m_timeIndex.removeFirst(*m_store, count);
+    m_committedRows -= qMin(count, m_committedRows);
+    m_queryScanRows = qMax(0, m_queryScanRows - count);
+    m_removedRows += count;
+    if (m_filtered) {
+        m_visibleRows.remove(0, viewRemoved);
+        for (int& row : m_visibleRows) {
+            row -= count;
+        }
+    }
+
+    // Highlighted row numbers shift with the removal
+    if (!m_highlightedRows.isEmpty()) {
+        auto kept = std::lower_bound(m_highlightedRows.begin(), m_highlightedRows.end(), viewRemoved);
+        m_highlightedRows.erase(m_highlightedRows.begin(), kept);
+        for (int& row : m_highlightedRows) {
+            row -= viewRemoved;
+        }
+    }
+    m_currentHighlightRow = m_currentHighlightRow >= viewRemoved ? m_currentHighlightRow - viewRemoved : -1;
+
+    if (viewRemoved > 0) {
+        endRemoveRows();
+    }
+    return viewRemoved;
+}
+
+int PGNLogModel::insertPromotedRows()
+{
+    if (!m_filtered || !m_filter.changesOnly || m_queryScanPending) {
+        return 0;
+    }
+
+    // Few rows, each its own insertion - they are spread over the start of the view
+    int inserted = 0;
+    for (int row : m_store->promotedRows()) {
+        if (row >= m_committedRows) {
+            break;
+        }
+        if (!m_filter.matches(m_store->pgn(row), m_store->source(row), m_store->destination(row)) ||
+            (m_filter.query && !m_filter.query->matches(*m_store, row))) {
+            continue;
+        }
+        const int viewRow = int(std::lower_bound(m_visibleRows.constBegin(), m_visibleRows.constEnd(), row)
+                                - m_visibleRows.constBegin());
+        beginInsertRows(QModelIndex(), viewRow, viewRow);
+        m_visibleRows.insert(viewRow, row);
+        endInsertRows();
+        inserted++;
+    }
+
+    // Search results refer to view rows, which have moved
+    if (inserted > 0) {
+        clearSearchHighlights();
+    }
+    return inserted;
+}
+
+void PGNLogModel::setFilter(const CaptureFilter& filter)
+{
+    beginResetModel();
+    m_filter = filter;
+    m_filtered = filter.isActive();
+    rebuildVisibleRows();
+    endResetModel();
+}
+
+void PGNLogModel::setStore(CaptureStore* store)
+{
+    beginResetModel();
+    m_removedRows += m_committedRows;
+    m_store = store;
+    m_committedRows = store->size();
+    m_searchIndex.clear();
+    m_timeIndex.clear();
+    rebuildVisibleRows();
+    endResetModel();
+}
+
+void PGNLogModel::rebuildVisibleRows()
+{
+    m_visibleRows.clear();
+    m_queryScanPending = bool(m_filter.query);
+    m_queryScanRows = m_queryScanPending ? m_committedRows : 0;
+    if (m_filtered && !m_queryScanPending) {
+        QVector<quint8> selection;
+        m_filter.evaluate(*m_store, 0, m_committedRows, selection);
+        CaptureFilter::appendSelectedRows(selection, 0, m_visibleRows);
+    }
+    m_visibleRows.squeeze();
+
+    // Search results refer to view rows, which have all moved
+    m_highlightedRows.clear();
+    m_currentHighlightRow = -1;
+}
+
+void PGNLogModel::addQueryMatches(const QVector<int>& rows)
+{
+    if (!m_queryScanPending) {
+        return;
+    }
+
+    // Rows arrive in ascending order; they still have to pass the rest of the filter
+    QVector<int> added;
+    int last = m_visibleRows.isEmpty() ? -1 : m_visibleRows.last();
+    for (int row : rows) {
+        if (row > last && row < m_queryScanRows &&
+            m_filter.matches(m_store->pgn(row), m_store->source(row), m_store->destination(row)) &&
+            !(m_filter.changesOnly && m_store->isRepeat(row))) {
+            added.append(row);
+            last = row;
+        }
+    }
+    if (added.isEmpty()) {
+        return;
+    }
+
+    const int firstViewRow = m_visibleRows.size();
+    beginInsertRows(QModelIndex(), firstViewRow, firstViewRow + added.size() - 1);
+    m_visibleRows.append(added);
+    endInsertRows();
+}
+
+void PGNLogModel::finishQueryScan(const QSharedPointer<CaptureQuery>& scannedQuery)
+{
+    if (!m_queryScanPending) {
+        return;
+    }
+    m_queryScanPending = false;
+
+    // The scanned instance has already seen the time-window anchors of every scanned row
+    if (scannedQuery) {
+        m_filter.query = scannedQuery;
+    }
+
+    // Rows committed while the worker was busy
+    const int first = m_queryScanRows;
+    m_queryScanRows = 0;
+    if (first >= m_committedRows) {
+        return;
+    }
+    QVector<quint8> selection;
+    m_filter.evaluate(*m_store, first, m_committedRows - first, selection);
+    QVector<int> added;
+    CaptureFilter::appendSelectedRows(selection, first, added);
+    if (added.isEmpty()) {
+        return;
+    }
+
+    const int firstViewRow = m_visibleRows.size();
+    beginInsertRows(QModelIndex(), firstViewRow, firstViewRow + added.size() - 1);
+    m_visibleRows.append(added);
+    endInsertRows();
+}
+
+int PGNLogModel::viewRow(int storeRow) const
+{
+    if (storeRow < 0 || storeRow >= m_committedRows) {
+        return -1;
+    }
+    if (!m_filtered) {
+        return storeRow;
+    }
+    auto it = std::lower_bound(m_visibleRows.constBegin(), m_visibleRows.constEnd(), storeRow);
+    return it != m_visibleRows.constEnd() && *it == storeRow ? int(it - m_visibleRows.constBegin()) : -1;
+}
+
+void PGNLogModel::clear()
+{
+    beginResetModel();
+    m_removedRows += m_store->size();
+    m_store->clear();
+    m_searchIndex.clear();
+    m_timeIndex.clear();
+    m_committedRows = 0;
+    m_visibleRows.clear();
+    // Any query worker was scanning rows that no longer exist
+    m_queryScanPending = false;
+    m_queryScanRows = 0;
+    m_highlightedRows.clear();
+    m_currentHighlightRow = -1;
+    endResetModel();
+}
+
+void PGNLogModel::setRelativeTimestamps(bool relative)
+{
+    if (m_relativeTimestamps == relative) {
+        return;
+    }
+    m_relativeTimestamps = relative;
+    emitColumnChanged(TimestampColumn);
+    emitColumnChanged(LastSeenColumn);
+}
+
+void PGNLogModel::setDecodingEnabled(bool enabled)
+{
+    if (m_decodingEnabled == enabled) {
+        return;
+    }
+    m_decodingEnabled = enabled;
+    emitColumnChanged(DecodedColumn);
+}
+
+QList<int> PGNLogModel::findRows(const QString& text)
+{
+    m_searchIndex.update(*m_store, m_committedRows);
+    const QVector<int> rows = m_searchIndex.search(*m_store, text, m_decodingEnabled, m_deviceNameResolver);
+    if (!m_filtered) {
+        return rows;
+    }
+
+    // Both lists are ascending store rows - keep the matches that are visible
+    QList<int> viewRows;
+    int viewRow = 0;
+    for (int row : rows) {
+        while (viewRow < m_visibleRows.size() && m_visibleRows[viewRow] < row) {
+            viewRow++;
+        }
+        if (viewRow == m_visibleRows.size()) {
+            break;
+        }
+        if (m_visibleRows[viewRow] == row) {
+            viewRows.append(viewRow);
+        }
+    }
+    return viewRows;
+}
+
+void PGNLogModel::setSearchHighlights(const QList<int>& rows, int currentRow)
+{
+    m_highlightedRows = rows;
+    std::sort(m_highlightedRows.begin(), m_highlightedRows.end());
+    m_currentHighlightRow = currentRow;
+    // The view only repaints what is on screen; the delegate reads SearchMatchRole there
+    if (viewRowCount() > 0) {
+        emit dataChanged(index(0, 0), index(viewRowCount() - 1, ColumnCount - 1), {SearchMatchRole});
+    }
+}
+
+void PGNLogModel::clearSearchHighlights()
+{
+    if (m_highlightedRows.isEmpty()) {
+        return;
+    }
+    setSearchHighlights(QList<int>(), -1);
+}
+
+int PGNLogModel::findRowAtTime(qint64 wallNs)
+{
+    m_timeIndex.update(*m_store, m_committedRows);
+    const int row = m_timeIndex.rowAtTime(*m_store, wallNs);
+    if (row < 0 || !m_filtered) {
+        return row;
+    }
+
+    // The first visible row from there on
+    auto it = std::lower_bound(m_visibleRows.constBegin(), m_visibleRows.constEnd(), row);
+    return it != m_visibleRows.constEnd() ? int(it - m_visibleRows.constBegin()) : -1;
+}
+
+int PGNLogModel::findNextRow(int fromViewRow, quint32 pgn, int source, bool forward)
+{
+    m_timeIndex.update(*m_store, m_committedRows);
+    const int viewRows = viewRowCount();
+    int from;
+    if (fromViewRow < 0) {
+        from = -1;
+    } else if (fromViewRow >= viewRows) {
+        from = m_committedRows;
+    } else {
+        from = storeRow(fromViewRow);
+    }
+
+    if (!m_filtered) {
+        return m_timeIndex.nextRow(pgn, source, from, forward);
+    }
+
+    // Leapfrog between the postings and the visible rows until both land on the same row
+    while (true) {
+        const int row = m_timeIndex.nextRow(pgn, source, from, forward);
+        if (row < 0) {
+            return -1;
+        }
+        int visible;
+        if (forward) {
+            visible = int(std::lower_bound(m_visibleRows.constBegin(), m_visibleRows.constEnd(), row)
+                          - m_visibleRows.constBegin());
+            if (visible == m_visibleRows.size()) {
+                return -1;
+            }
+        } else {
+            visible = int(std::upper_bound(m_visibleRows.constBegin(), m_visibleRows.constEnd(), row)
+                          - m_visibleRows.constBegin()) - 1;
+            if (visible < 0) {
+                return -1;
+            }
+        }
+        if (m_visibleRows[visible] == row) {
+            return visible;
+        }
+        from = forward ? m_visibleRows[visible] - 1 : m_visibleRows[visible] + 1;
+    }
+}
+
+QString PGNLogModel::timestampText(int viewRow) const
+{
+    const int row = storeRow(viewRow);
+    N2kTimestamp ts = m_store->timestamp(row);
+    if (!ts.isValid()) {
+        // Loaded from a log whose timestamp column could not be parsed
+        return m_store->timestampText(row);
+    }
+
+    if (!m_relativeTimestamps) {
+        return ts.toTimeString();
+    }
+
+    qint64 deltaNs = 0;
+    if (viewRow > 0) {
+        N2kTimestamp previous = m_store->timestamp(storeRow(viewRow - 1));
+        if (previous.isValid()) {
+            deltaNs = ts.nsecsSince(previous);
+        }
+    }
+    return N2kTimestamp::formatDelta(deltaNs);
+}
+
+QString PGNLogModel::messageName(int row) const
+{
+    quint32 pgn = m_store->pgn(row);
+    if (m_decoder && m_decoder->canDecode(pgn)) {
+        return m_decoder->getCleanMessageName(pgn);
+    }
+    return QString("PGN %1").arg(pgn);
+}
+
+QString PGNLogModel::rawDataText(int row) const
+{
+    return formatRawData(m_store->payload(row), m_store->length(row));
+}
+
+QString PGNLogModel::formatRawData(const unsigned char* data, int len)
+{
+    if (len == 0) {
+        return "(no data)";
+    }
+
+    static const char hexDigits[] = "0123456789ABCDEF";
+    QString hexData(len * 3 - 1, QChar(' '));
+    for (int i = 0; i < len; i++) {
+        hexData[i * 3] = QChar(hexDigits[data[i] >> 4]);
+        hexData[i * 3 + 1] = QChar(hexDigits[data[i] & 0x0F]);
+    }
+    return hexData;
+}
+
+QString PGNLogModel::decodedText(int row) const
+{
+    quint32 pgn = m_store->pgn(row);
+    if (!m_decodingEnabled || !m_decoder || !m_decoder->canDecode(pgn)) {
+        return "(decoding disabled)";
+    }
+
+    QString decodedData = m_decoder->getFormattedDecoded(m_store->message(row));
+    if (decodedData.isEmpty() || decodedData == "Raw data" || decodedData.startsWith("PGN")) {
+        decodedData = "(not decoded)";
+    }
+    return decodedData;
+}
+
+QString PGNLogModel::lastSeenText(int row) const
+{
+    if (m_store->repeatCount(row) == 0) {
+        return QString();
+    }
+
+    // Relative mode shows how long the payload has stayed the same
+    N2kTimestamp first = m_store->timestamp(row);
+    N2kTimestamp last = m_store->timestamp(m_store->lastSeenRow(row));
+    if (!last.isValid()) {
+        return m_store->timestampText(m_store->lastSeenRow(row));
+    }
+    if (m_relativeTimestamps && first.isValid()) {
+        return N2kTimestamp::formatDelta(last.nsecsSince(first));
+    }
+    return last.toTimeString();
+}
+
+QString PGNLogModel::addressText(quint8 address)
+{
+    return QString("0x%1").arg(QString("%1").arg(uint(address), 2, 16, QChar('0')).toUpper());
+}
+
+QString PGNLogModel::logRecordLine(const CaptureStore& store, int row)
+{
+    N2kTimestamp rxTimestamp = store.timestamp(row);
+
+    QStringList fields;
+    fields << (rxTimestamp.isValid() ? rxTimestamp.toTimeString() : store.timestampText(row))  // Always absolute time
+           << QString::number(store.pgn(row))
+           << QString::number(store.priority(row))
+           << addressText(store.source(row))
+           << addressText(store.destination(row))
+           << QString::number(store.length(row))
+           << formatRawData(store.payload(row), store.length(row));
+    if (rxTimestamp.isValid()) {
+        fields << rxTimestamp.toLogField();
+    }
+    return fields.join(" | ");
+}
+
+void PGNLogModel::emitColumnChanged(int column)
+{
+    if (viewRowCount() == 0) {
+        return;
+    }
+    emit dataChanged(index(0, column), index(viewRowCount() - 1, column));
+}
@@ -0,0 +1,162 @@
+#ifndef PGNLOGMODEL_H
+#define PGNLOGMODEL_H
+
+#include <QAbstractTableModel>
+#include <QFont>
+#include "capturestore.h"
+#include "capturefilter.h"
+#include "capturesearchindex.h"
+#include "capturetimeindex.h"
+
+class DBCDecoder;
+
+/**
+ * @brief Table model presenting a CaptureStore in the PGN log.
+ *
+ * Nothing is formatted up front: cell text, message names and decoded signal
+ * strings are built in data(), which the view only calls for visible rows.
+ *
+ * Appended rows go straight into the store but stay pending until
+ * commitPendingRows() announces them to the view as one inserted range, so
+ * the view relayouts once per batch instead of once per message.
+ *
+ * While a filter is set, view rows map to store rows through a compact index
+ * of the rows that pass it. Row arguments of the text helpers below are store
+ * rows; use storeRow() to translate a view row.
+ *
+ * Search goes through a CaptureSearchIndex that catches up with new rows on
+ * each query. A CaptureTimeIndex, built on the first navigation the same way,
+ * answers jump-to-time and next/previous PGN or source lookups with binary
+ * searches. Search results are only marked through SearchMatchRole, and the
+ * view's delegate paints the highlight for the rows it draws.
+ */
+class PGNLogModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        TimestampColumn = 0,
+        PgnColumn,
+        NameColumn,
+        PriorityColumn,
+        SourceColumn,
+        DestinationColumn,
+        LengthColumn,
+        RepeatsColumn,      // Change tracking - only shown in a change-only view
+        LastSeenColumn,
+        RawDataColumn,
+        DecodedColumn,
+        ColumnCount
+    };
+
+    enum Role {
+        SearchMatchRole = Qt::UserRole + 1  // SearchMatch of the row
+    };
+
+    enum SearchMatch {
+        NoMatch = 0,
+        Match,
+        CurrentMatch
+    };
+
+    explicit PGNLogModel(CaptureStore* store, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    CaptureStore* store() const { return m_store; }
+    // Show another store - every row in it counts as committed, the filter is applied again
+    void setStore(CaptureStore* store);
+    void setDecoder(DBCDecoder* decoder);
+
+    // Append to the store - the row is pending until the next commitPendingRows()
+    int appendMessage(const tN2kMsg& msg, const N2kTimestamp& timestamp, bool sent = false);
+    bool commitPendingRows();
+    int pendingRowCount() const { return m_store->size() - m_committedRows; }
+    // Remove the oldest store rows, returns how many view rows went with them
+    int removeOldestRows(int count);
+    // The same for a store shared with other models: call begin before and end after
+    // the store drops its first count rows. end returns how many view rows went
+    void beginRemoveOldestRows(int count);
+    int endRemoveOldestRows();
+    // Show the rows the last removal promoted from repeats to change rows, when the filter
+    // hides repeats. Returns how many view rows were inserted
+    int insertPromotedRows();
+    void clear();
+
+    // Rebuild the visible-row index for a new filter. A filter with a query is
+    // scanned by a CaptureQueryWorker: the committed rows stay hidden until
+    // addQueryMatches() reports them, and rows committed meanwhile are evaluated
+    // by finishQueryScan()
+    void setFilter(const CaptureFilter& filter);
+    const CaptureFilter& filter() const { return m_filter; }
+    bool isQueryScanPending() const { return m_queryScanPending; }
+    int queryScanRows() const { return m_queryScanRows; }
+    void addQueryMatches(const QVector<int>& rows);
+    void finishQueryScan(const QSharedPointer<CaptureQuery>& scannedQuery);
+
+    int storeRow(int viewRow) const { return m_filtered ? m_visibleRows[viewRow] : viewRow; }
+    // View row showing a store row, or -1 when it is hidden or not committed yet
+    int viewRow(int storeRow) const;
+    int committedRowCount() const { return m_committedRows; }
+    // Rows evicted or cleared since the model was created - translates row numbers of older snapshots
+    qint64 removedRowCount() const { return m_removedRows; }
+
+    void setRelativeTimestamps(bool relative);
+    void setDecodingEnabled(bool enabled);
+    void setDeviceNameResolver(const CaptureSearchIndex::DeviceNameLookup& resolver) { m_deviceNameResolver = resolver; }
+
+    // View rows, ascending, whose message name, decoded text or device names contain text
+    QList<int> findRows(const QString& text);
+    void setSearchHighlights(const QList<int>& rows, int currentRow);
+    void clearSearchHighlights();
+
+    // View row of the first visible row at or after a wall clock time, -1 when there is none
+    int findRowAtTime(qint64 wallNs);
+    // Nearest visible row after fromViewRow (before it when backwards) with this PGN and
+    // source, either of which may be CaptureTimeIndex::ANY_*. -1 when there is none
+    int findNextRow(int fromViewRow, quint32 pgn, int source, bool forward);
+
+    // Cell text, shared with saving and the details dialog. The timestamp takes a view
+    // row, since a relative time is measured from the visible row above it
+    QString timestampText(int viewRow) const;
+    QString messageName(int row) const;
+    QString rawDataText(int row) const;
+    QString decodedText(int row) const;
+    QString lastSeenText(int row) const;
+    static QString addressText(quint8 address);
+    static QString formatRawData(const unsigned char* data, int len);
+
+    // One record of the text log format: TIMESTAMP | PGN | PRIORITY | SOURCE | DESTINATION | LENGTH | RAW_DATA | RX_TIME_NS
+    static QString logRecordLine(const CaptureStore& store, int row);
+
+private:
+    void emitColumnChanged(int column);
+    void rebuildVisibleRows();
+    int viewRowCount() const { return m_filtered ? m_visibleRows.size() : m_committedRows; }
+
+    CaptureStore* m_store;
+    DBCDecoder* m_decoder;
+    int m_committedRows;  // Rows the view knows about; the rest of the store is pending
+    CaptureFilter m_filter;
+    bool m_filtered;            // m_visibleRows is in use
+    QVector<int> m_visibleRows; // Committed store rows passing m_filter, ascending
+    bool m_queryScanPending;    // A worker is scanning rows [0, m_queryScanRows) for m_filter.query
+    int m_queryScanRows;
+    qint64 m_removedRows;
+    int m_removingRows;         // Store rows between beginRemoveOldestRows() and endRemoveOldestRows()
+    int m_removingViewRows;
+    bool m_relativeTimestamps;
+    bool m_decodingEnabled;
+    CaptureSearchIndex m_searchIndex;
+    CaptureTimeIndex m_timeIndex;
+    CaptureSearchIndex::DeviceNameLookup m_deviceNameResolver;
+    QVector<int> m_highlightedRows;  // View rows, ascending
+    int m_currentHighlightRow;
+    QFont m_dataFont;
+};
+
+#endif // PGNLOGMODEL_H
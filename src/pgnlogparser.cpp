@@ -0,0 +1,427 @@
+#include "pgnlogparser.h"
+#include "capturestore.h"
+#include <QThreadPool>
+#include <QDateTime>
+#include <QVector>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// A view of part of a line in the mapped file
+struct Span
+{
+    const char* begin;
+    const char* end;
+
+    bool isEmpty() const { return begin == end; }
+    qint64 size() const { return end - begin; }
+};
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+Span trimmed(Span s)
+{
+    while (s.begin < s.end && isSpace(*s.begin)) {
+        s.begin++;
+    }
+    while (s.end > s.begin && isSpace(*(s.end - 1))) {
+        s.end--;
+    }
+    return s;
+}
+
+bool contains(Span s, const char* text)
+{
+    const size_t length = strlen(text);
+    return std::search(s.begin, s.end, text, text + length) != s.end;
+}
+
+bool startsWith(Span s, char c)
+{
+    return !s.isEmpty() && *s.begin == c;
+}
+
+int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Same acceptance as QString::toUInt on a trimmed field
+bool parseUInt(Span s, int base, quint32& value)
+{
+    const char* p = s.begin;
+    if (p < s.end && *p == '+') {
+        p++;
+    }
+    if (base == 16 && s.end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+        p += 2;
+    }
+    if (p == s.end) {
+        return false;
+    }
+
+    quint64 result = 0;
+    for (; p < s.end; p++) {
+        int digit = base == 16 ? hexDigit(*p) : (*p >= '0' && *p <= '9' ? *p - '0' : -1);
+        if (digit < 0) {
+            return false;
+        }
+        result = result * base + digit;
+        if (result > 0xFFFFFFFFULL) {
+            return false;
+        }
+    }
+    value = quint32(result);
+    return true;
+}
+
+bool parseInt64(Span s, qint64& value)
+{
+    s = trimmed(s);
+    const char* p = s.begin;
+    bool negative = false;
+    if (p < s.end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p == s.end) {
+        return false;
+    }
+
+    // Nanosecond stamps have 19 digits, which qint64 only just holds
+    qint64 result = 0;
+    for (; p < s.end; p++) {
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+        const int digit = *p - '0';
+        if (result > (std::numeric_limits<qint64>::max() - digit) / 10) {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+// Hex payload bytes separated by whitespace; bytes that do not parse become 0
+int parseHexBytes(Span s, unsigned char* out, int maxBytes)
+{
+    int count = 0;
+    const char* p = s.begin;
+    while (p < s.end && count < maxBytes) {
+        while (p < s.end && isSpace(*p)) {
+            p++;
+        }
+        if (p == s.end) {
+            break;
+        }
+        const char* tokenStart = p;
+        while (p < s.end && !isSpace(*p)) {
+            p++;
+        }
+        quint32 value;
+        out[count++] = parseUInt(Span{tokenStart, p}, 16, value) ? quint8(value) : 0;
+    }
+    return count;
+}
+
+// Nanoseconds since midnight for "HH:mm:ss.zzz[uuu]", or -1
+qint64 legacyTimeOfDayNs(Span s)
+{
+    if (s.size() < 12) {
+        return -1;
+    }
+    const char* t = s.begin;
+    for (int i : {0, 1, 3, 4, 6, 7, 9, 10, 11}) {
+        if (t[i] < '0' || t[i] > '9') {
+            return -1;
+        }
+    }
+    if (t[2] != ':' || t[5] != ':' || t[8] != '.') {
+        return -1;
+    }
+
+    const int hours = (t[0] - '0') * 10 + (t[1] - '0');
+    const int minutes = (t[3] - '0') * 10 + (t[4] - '0');
+    const int seconds = (t[6] - '0') * 10 + (t[7] - '0');
+    const int millis = (t[9] - '0') * 100 + (t[10] - '0') * 10 + (t[11] - '0');
+    if (hours > 23 || minutes > 59 || seconds > 59) {
+        return -1;
+    }
+
+    qint64 ns = ((hours * 3600LL + minutes * 60LL + seconds) * 1000LL + millis) * 1000000LL;
+
+    // Pick up the microsecond digits written by N2kTimestamp::toTimeString(), if present
+    if (s.size() == 15) {
+        quint32 micros;
+        if (parseUInt(Span{t + 12, s.end}, 10, micros)) {
+            ns += qint64(micros) * 1000LL;
+        }
+    }
+    return ns;
+}
+
+// RX_TIME_NS column: "<wall ns>,<monotonic ns>" with a "K" suffix for kernel stamps
+N2kTimestamp parseLogField(Span s)
+{
+    N2kTimestamp ts;
+    s = trimmed(s);
+    if (!s.isEmpty() && *(s.end - 1) == 'K') {
+        ts.fromKernel = true;
+        s.end--;
+    }
+
+    const char* comma = std::find(s.begin, s.end, ',');
+    if (comma == s.end ||
+        !parseInt64(Span{s.begin, comma}, ts.wallNs) ||
+        !parseInt64(Span{comma + 1, s.end}, ts.monotonicNs)) {
+        return N2kTimestamp();
+    }
+    return ts;
+}
+
+N2kTimestamp legacyTimestamp(Span s, qint64 dayStartNs)
+{
+    qint64 timeOfDayNs = legacyTimeOfDayNs(s);
+    return timeOfDayNs < 0 ? N2kTimestamp() : N2kTimestamp::fromWallNs(dayStartNs + timeOfDayNs);
+}
+
+// Split a line at separator into at most maxFields spans, returns the total field count
+int splitFields(Span line, char separator, Span* fields, int maxFields)
+{
+    int count = 0;
+    const char* start = line.begin;
+    for (const char* p = line.begin; ; p++) {
+        if (p == line.end || *p == separator) {
+            if (count < maxFields) {
+                fields[count] = Span{start, p};
+            }
+            count++;
+            if (p == line.end) {
+                break;
+            }
+            start = p + 1;
+        }
+    }
+    return count;
+}
+
+// Tab-delimited export: Timestamp\tPGN\tMessage Name\tPri\tSrc\tDst\tLen\tData
+bool parseOlderFormat(Span line, qint64 dayStartNs, CaptureStore& store)
+{
+    Span parts[8];
+    int fieldCount = splitFields(line, '\t', parts, 8);
+    if (fieldCount < 7) {
+        return false;
+    }
+
+    quint32 pgn;
+    if (!parseUInt(trimmed(parts[1]), 10, pgn)) {
+        return false;
+    }
+    quint32 priority, source, destination, dataLen;
+    if (!parseUInt(trimmed(parts[3]), 10, priority)) priority = 6;
+    if (!parseUInt(trimmed(parts[4]), 16, source)) source = 0;
+    if (!parseUInt(trimmed(parts[5]), 16, destination)) destination = 255;
+    if (!parseUInt(trimmed(parts[6]), 10, dataLen)) dataLen = 0;
+
+    // Hex data is the first [..] group made only of hex digits and whitespace
+    unsigned char data[tN2kMsg::MaxDataLen] = {};
+    int hexCount = 0;
+    if (fieldCount > 7) {
+        const char* p = parts[7].begin;
+        while ((p = std::find(p, parts[7].end, '[')) != parts[7].end) {
+            const char* close = p + 1;
+            while (close < parts[7].end && (hexDigit(*close) >= 0 || isSpace(*close))) {
+                close++;
+            }
+            if (close < parts[7].end && *close == ']' && close > p + 1) {
+                hexCount = parseHexBytes(Span{p + 1, close}, data, tN2kMsg::MaxDataLen);
+                break;
+            }
+            p++;
+        }
+    }
+
+    Span timestamp = trimmed(parts[0]);
+    N2kTimestamp rxTimestamp = legacyTimestamp(timestamp, dayStartNs);
+    int row = store.appendRaw(pgn, quint8(priority), quint8(source), quint8(destination),
+                              data, qMin(int(quint8(dataLen)), hexCount),
+                              rxTimestamp.wallNs, rxTimestamp.monotonicNs, 0);
+    if (!rxTimestamp.isValid()) {
+        store.setTimestampText(row, QString::fromUtf8(timestamp.begin, timestamp.size()));
+    }
+    return true;
+}
+
+// Pipe-delimited .pgnlog text records, 7/8 fields (1.0/1.1) or 9 fields (device-name columns)
+bool parseNewerFormat(Span line, qint64 dayStartNs, CaptureStore& store)
+{
+    Span parts[9];
+    int fieldCount = splitFields(line, '|', parts, 9);
+    if (fieldCount < 7 || fieldCount > 9) {
+        return false;
+    }
+
+    // The 9-field variant has name columns after source and destination
+    const bool withNames = fieldCount == 9;
+    const Span destField = parts[withNames ? 5 : 4];
+    const Span lengthField = parts[withNames ? 7 : 5];
+    const Span dataField = parts[withNames ? 8 : 6];
+
+    quint32 pgn;
+    if (!parseUInt(trimmed(parts[1]), 10, pgn)) {
+        return false;
+    }
+    quint32 priority, source, destination, dataLen;
+    if (!parseUInt(trimmed(parts[2]), 10, priority)) priority = 6;
+    if (!parseUInt(trimmed(parts[3]), 16, source)) source = 0;
+    if (!parseUInt(trimmed(destField), 16, destination)) destination = 255;
+    if (!parseUInt(trimmed(lengthField), 10, dataLen)) dataLen = 0;
+
+    unsigned char data[tN2kMsg::MaxDataLen] = {};
+    parseHexBytes(trimmed(dataField), data, tN2kMsg::MaxDataLen);
+
+    Span timestamp = trimmed(parts[0]);
+    N2kTimestamp rxTimestamp = fieldCount == 8 ? parseLogField(parts[7]) : N2kTimestamp();
+    if (!rxTimestamp.isValid()) {
+        // Version 1.0 logs only have the millisecond time of day
+        rxTimestamp = legacyTimestamp(timestamp, dayStartNs);
+    }
+
+    quint8 flags = rxTimestamp.fromKernel ? quint8(CaptureStore::KernelTimestampFlag) : quint8(0);
+    int row = store.appendRaw(pgn, quint8(priority), quint8(source), quint8(destination),
+                              data, qMin(int(quint8(dataLen)), int(tN2kMsg::MaxDataLen)),
+                              rxTimestamp.wallNs, rxTimestamp.monotonicNs, flags);
+    if (!rxTimestamp.isValid()) {
+        store.setTimestampText(row, QString::fromUtf8(timestamp.begin, timestamp.size()));
+    }
+    return true;
+}
+
+// Start of the line following the first newline at or after pos
+qint64 nextLineStart(const char* data, qint64 size, qint64 pos)
+{
+    if (pos >= size) {
+        return size;
+    }
+    const void* newline = memchr(data + pos, '\n', size_t(size - pos));
+    return newline ? static_cast<const char*>(newline) - data + 1 : size;
+}
+
+} // namespace
+
+qint64 PGNLogParser::legacyDayStartNs()
+{
+    return QDateTime(QDate::currentDate(), QTime(0, 0)).toMSecsSinceEpoch() * 1000000LL;
+}
+
+int PGNLogParser::parseChunk(const char* begin, const char* end, qint64 dayStartNs, CaptureStore& store)
+{
+    int invalidLines = 0;
+    const char* pos = begin;
+    while (pos < end) {
+        const char* newline = static_cast<const char*>(memchr(pos, '\n', size_t(end - pos)));
+        Span line = trimmed(Span{pos, newline ? newline : end});
+        pos = newline ? newline + 1 : end;
+
+        // Skip comments and empty lines
+        if (line.isEmpty() || startsWith(line, '#') || startsWith(line, '=')) {
+            continue;
+        }
+
+        // Skip header lines
+        if (contains(line, "NMEA2000 PGN Message Log") ||
+            contains(line, "Generated by") ||
+            contains(line, "Export Time:") ||
+            contains(line, "Total Messages:") ||
+            contains(line, "Active Filters:") ||
+            contains(line, "Filter Logic:") ||
+            (contains(line, "Timestamp") && contains(line, "PGN") && contains(line, "Message Name"))) {
+            continue;
+        }
+
+        const bool hasPipe = std::find(line.begin, line.end, '|') != line.end;
+        bool parsed = false;
+        if (!hasPipe && std::find(line.begin, line.end, '\t') != line.end) {
+            parsed = parseOlderFormat(line, dayStartNs, store);
+        } else if (hasPipe) {
+            parsed = parseNewerFormat(line, dayStartNs, store);
+        }
+        if (!parsed) {
+            invalidLines++;
+        }
+    }
+    return invalidLines;
+}
+
+int PGNLogParser::parseText(const char* data, qint64 size, const ChunkSink& sink, int threadCount)
+{
+    const qint64 dayStartNs = legacyDayStartNs();
+    int invalidLines = 0;
+
+    // A small first chunk on this thread so the view has rows right away
+    qint64 pos = nextLineStart(data, size, size < FIRST_CHUNK_BYTES ? size : FIRST_CHUNK_BYTES);
+    {
+        CaptureStore rows;
+        invalidLines += parseChunk(data, data + pos, dayStartNs, rows);
+        if (!sink(rows, pos)) {
+            return invalidLines;
+        }
+    }
+
+    struct Job {
+        qint64 begin = 0;
+        qint64 end = 0;
+        CaptureStore rows;
+        int invalidLines = 0;
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, threadCount));
+
+    // Parse in waves of newline-aligned chunks, then deliver each wave in file order
+    while (pos < size) {
+        QVector<Job> jobs;
+        const int waveSize = qMax(1, threadCount) * CHUNKS_PER_THREAD;
+        while (pos < size && jobs.size() < waveSize) {
+            Job job;
+            job.begin = pos;
+            job.end = nextLineStart(data, size, pos + PARALLEL_CHUNK_BYTES);
+            pos = job.end;
+            jobs.append(job);
+        }
+
+        if (threadCount <= 1) {
+            for (Job& job : jobs) {
+                job.invalidLines = parseChunk(data + job.begin, data + job.end, dayStartNs, job.rows);
+            }
+        } else {
+            for (Job& job : jobs) {
+                Job* target = &job;
+                pool.start([target, data, dayStartNs]() {
+                    target->invalidLines = parseChunk(data + target->begin, data + target->end, dayStartNs, target->rows);
+                });
+            }
+            pool.waitForDone();
+        }
+
+        for (Job& job : jobs) {
+            invalidLines += job.invalidLines;
+            if (!sink(job.rows, job.end)) {
+                return invalidLines;
+            }
+        }
+    }
+    return invalidLines;
+}
+
@@ -0,0 +1,46 @@
+#ifndef PGNLOGPARSER_H
+#define PGNLOGPARSER_H
+
+#include <QString>
+#include <functional>
+#include <N2kMsg.h>
+#include "n2ktimestamp.h"
+
+class CaptureStore;
+
+/**
+ * @brief Line parsers for the text log formats.
+ *
+ * Handles the pipe-delimited .pgnlog text formats (1.0, 1.1 and the older
+ * variant with device-name columns) and the legacy tab-delimited export.
+ * The functions only touch their arguments, so they are safe to call from
+ * loader threads.
+ *
+ * parseText() is the bulk path used by the loader: it splits a mapped file
+ * into newline-aligned chunks, parses them on a thread pool with a byte-level
+ * tokenizer (without splitting or regular expressions), and hands the results
+ * back in file order.
+ */
+class PGNLogParser
+{
+public:
+    // Receives parsed rows in file order with the number of bytes consumed so far.
+    // Return false to stop parsing.
+    typedef std::function<bool(CaptureStore& rows, qint64 bytesDone)> ChunkSink;
+
+    // Parse a whole text log, returns the number of lines that could not be parsed
+    static int parseText(const char* data, qint64 size, const ChunkSink& sink, int threadCount);
+
+    // Parse the complete lines in [begin, end) into store, returns the number of invalid lines
+    static int parseChunk(const char* begin, const char* end, qint64 dayStartNs, CaptureStore& store);
+
+    // Local midnight today - older logs only carry a time of day and are anchored to it
+    static qint64 legacyDayStartNs();
+
+private:
+    static const qint64 FIRST_CHUNK_BYTES = 64 * 1024;         // Parsed alone so the first rows show up at once
+    static const qint64 PARALLEL_CHUNK_BYTES = 4 * 1024 * 1024;
+    static const int CHUNKS_PER_THREAD = 2;                    // Chunks in flight per thread in each wave
+};
+
+#endif // PGNLOGPARSER_H
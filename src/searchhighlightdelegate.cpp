@@ -0,0 +1,40 @@
+#include "searchhighlightdelegate.h"
+#include "pgnlogmodel.h"
+#include <QApplication>
+#include <QPainter>
+#include <QStyle>
+#include <QFontMetrics>
+
+void SearchHighlightDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    const int match = index.data(PGNLogModel::SearchMatchRole).toInt();
+    if (match == PGNLogModel::NoMatch) {
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    opt.backgroundBrush = QBrush(match == PGNLogModel::CurrentMatch ? QColor(255, 255, 0, 180) : QColor(255, 255, 0, 80));
+
+    QStyle* style = opt.widget ? opt.widget->style() : QApplication::style();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, opt.widget);
+
+    // Mark the matching text in left-aligned cells (message name and decoded data)
+    const int position = m_searchText.isEmpty() ? -1 : opt.text.indexOf(m_searchText, 0, Qt::CaseInsensitive);
+    if (position < 0 || !(opt.displayAlignment & Qt::AlignLeft)) {
+        return;
+    }
+
+    QRect textRect = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, opt.widget);
+    const int margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, opt.widget) + 1;
+    textRect.adjust(margin, 0, -margin, 0);
+
+    const QFontMetrics metrics(opt.font);
+    const int left = textRect.left() + metrics.horizontalAdvance(opt.text.left(position));
+    const int width = metrics.horizontalAdvance(opt.text.mid(position, m_searchText.size()));
+    const QRect matchRect = QRect(left, textRect.top(), width, textRect.height()).intersected(textRect);
+    if (!matchRect.isEmpty()) {
+        painter->fillRect(matchRect, QColor(255, 140, 0, 110));
+    }
+}
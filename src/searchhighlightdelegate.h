@@ -0,0 +1,31 @@
+#ifndef SEARCHHIGHLIGHTDELEGATE_H
+#define SEARCHHIGHLIGHTDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QString>
+
+/**
+ * @brief Paints PGN log search results.
+ *
+ * Rows that PGNLogModel marks through SearchMatchRole get a yellow background,
+ * which is brighter on the current result. For a text search, the matching part
+ * of the cell text is marked as well. This only runs for the cells the view
+ * paints, so the cost of a search does not grow with the number of hits.
+ */
+class SearchHighlightDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit SearchHighlightDelegate(QObject* parent = nullptr) : QStyledItemDelegate(parent) {}
+
+    void setSearchText(const QString& text) { m_searchText = text; }
+    QString searchText() const { return m_searchText; }
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+private:
+    QString m_searchText;
+};
+
+#endif // SEARCHHIGHLIGHTDELEGATE_H
@@ -0,0 +1,488 @@
+#include "signalplotdialog.h"
+#include "signalplotwidget.h"
+#include "dbcdecoder.h"
+#include "pgnlogloader.h"
+#include "pgnlogmodel.h"
+#include "toastmanager.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QSplitter>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QListWidget>
+#include <QLabel>
+#include <QPushButton>
+#include <QProgressBar>
+#include <QTimer>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QColor>
+
+SignalPlotDialog::SignalPlotDialog(QWidget* parent)
+    : QDialog(parent)
+    , m_nextSignalId(0)
+    , m_plotDirty(false)
+{
+    m_dbcDecoder = new DBCDecoder(this);
+
+    setupUI();
+
+    // Samples arrive per message; the plot repaints at most this often
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    connect(m_refreshTimer, &QTimer::timeout, this, &SignalPlotDialog::refreshPlot);
+    m_refreshTimer->start();
+
+    setWindowTitle("Signal Plot");
+    setModal(false);
+    resize(1000, 600);
+}
+
+SignalPlotDialog::~SignalPlotDialog()
+{
+    stopLoader();
+    qDeleteAll(m_traces);
+}
+
+void SignalPlotDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+
+    QHBoxLayout* controlLayout = new QHBoxLayout();
+    m_sourceLabel = new QLabel("Live traffic");
+    m_sourceLabel->setStyleSheet("font-weight: bold; padding: 5px;");
+    m_loadProgressBar = new QProgressBar();
+    m_loadProgressBar->setRange(0, 100);
+    m_loadProgressBar->setMaximumWidth(200);
+    m_loadProgressBar->setVisible(false);
+    m_loadLogButton = new QPushButton("Load Log...");
+    m_loadLogButton->setToolTip("Plot the signals from a .pgnlog file without opening it in a PGN log");
+    m_showLiveButton = new QPushButton("Show Live");
+    m_showLiveButton->setEnabled(false);
+    m_clearButton = new QPushButton("Clear");
+    m_clearButton->setToolTip("Drop the plotted samples and keep the signals");
+    m_fitButton = new QPushButton("Fit");
+    m_fitButton->setToolTip("Show the whole capture (or double-click the plot)");
+    controlLayout->addWidget(m_sourceLabel);
+    controlLayout->addWidget(m_loadProgressBar);
+    controlLayout->addStretch();
+    controlLayout->addWidget(m_loadLogButton);
+    controlLayout->addWidget(m_showLiveButton);
+    controlLayout->addWidget(m_clearButton);
+    controlLayout->addWidget(m_fitButton);
+    mainLayout->addLayout(controlLayout);
+
+    // Signal list on the left, plot on the right
+    QWidget* signalPanel = new QWidget();
+    QVBoxLayout* signalLayout = new QVBoxLayout(signalPanel);
+    signalLayout->setContentsMargins(0, 0, 0, 0);
+    m_pgnEdit = new QLineEdit();
+    m_pgnEdit->setPlaceholderText("PGN, e.g. 127488");
+    m_signalCombo = new QComboBox();
+    m_signalCombo->setEditable(true);
+    m_signalCombo->setToolTip("Field name as shown in the decoded column, e.g. Intensity or Switch 1");
+    m_addSignalButton = new QPushButton("Add Signal");
+    m_signalList = new QListWidget();
+    m_removeSignalButton = new QPushButton("Remove Signal");
+    signalLayout->addWidget(new QLabel("PGN:"));
+    signalLayout->addWidget(m_pgnEdit);
+    signalLayout->addWidget(new QLabel("Signal:"));
+    signalLayout->addWidget(m_signalCombo);
+    signalLayout->addWidget(m_addSignalButton);
+    signalLayout->addWidget(m_signalList);
+    signalLayout->addWidget(m_removeSignalButton);
+
+    m_plot = new SignalPlotWidget();
+
+    QSplitter* splitter = new QSplitter(Qt::Horizontal);
+    splitter->addWidget(signalPanel);
+    splitter->addWidget(m_plot);
+    splitter->setStretchFactor(1, 1);
+    splitter->setSizes({200, 800});
+    mainLayout->addWidget(splitter);
+
+    m_sampleCountLabel = new QLabel();
+    mainLayout->addWidget(m_sampleCountLabel);
+
+    connect(m_pgnEdit, &QLineEdit::editingFinished, this, &SignalPlotDialog::onPgnEdited);
+    connect(m_addSignalButton, &QPushButton::clicked, this, &SignalPlotDialog::onAddSignalClicked);
+    connect(m_removeSignalButton, &QPushButton::clicked, this, &SignalPlotDialog::onRemoveSignalClicked);
+    connect(m_loadLogButton, &QPushButton::clicked, this, &SignalPlotDialog::onLoadLogClicked);
+    connect(m_showLiveButton, &QPushButton::clicked, this, &SignalPlotDialog::onShowLiveClicked);
+    connect(m_clearButton, &QPushButton::clicked, this, [this]() {
+        clearSamples();
+    });
+    connect(m_fitButton, &QPushButton::clicked, m_plot, &SignalPlotWidget::fitAll);
+}
+
+void SignalPlotDialog::appendMessage(const tN2kMsg& msg, const N2kTimestamp& timestamp)
+{
+    if (!isShowingLive()) {
+        return;
+    }
+    // Same clock choice as N2kTimestamp::nsecsSince - monotonic when the interface supplies it
+    addSample(msg, timestamp.monotonicNs != 0 ? timestamp.monotonicNs : timestamp.wallNs);
+}
+
+void SignalPlotDialog::addSample(const tN2kMsg& msg, qint64 timeNs)
+{
+    auto signalIt = m_signalsByPgn.constFind(msg.PGN);
+    if (signalIt == m_signalsByPgn.constEnd()) {
+        return;
+    }
+
+    // Repeated payloads are served from the decoder's cache
+    const DecodedMessage decoded = m_dbcDecoder->decodeMessage(msg);
+    if (!decoded.isDecoded) {
+        return;
+    }
+
+    for (int index : signalIt.value()) {
+        const PlotSignal& signal = m_signals[index];
+        for (const DecodedSignal& field : decoded.signalList) {
+            if (normalizedName(field.name) != signal.key) {
+                continue;
+            }
+            Trace* fieldTrace = trace(signal, msg.Source);
+            double sample = 0.0;
+            if (sampleValue(fieldTrace, field.value, sample)) {
+                fieldTrace->series.append(timeNs, sample);
+                m_plotDirty = true;
+            }
+            break;
+        }
+    }
+}
+
+bool SignalPlotDialog::sampleValue(Trace* signalTrace, const QVariant& value, double& sample)
+{
+    // Formatted values such as "42 (16.5%)" or "3200 K" start with the number
+    static const QRegularExpression leadingNumber("^\\s*([-+]?\\d+(?:\\.\\d+)?)");
+
+    const bool isText = value.userType() == QMetaType::QString;
+    const QString text = value.toString().trimmed();
+    bool numeric = false;
+    double number = 0.0;
+    if (!isText) {
+        number = value.toDouble(&numeric);
+    } else {
+        if (text == "N/A" || text.compare("Not Available", Qt::CaseInsensitive) == 0) {
+            return false;
+        }
+        QRegularExpressionMatch match = leadingNumber.match(text);
+        if (match.hasMatch()) {
+            number = match.captured(1).toDouble(&numeric);
+        }
+    }
+
+    // The first value decides whether the field plots as a number or as states
+    if (signalTrace->series.isEmpty() && signalTrace->stateNames.isEmpty()) {
+        signalTrace->isState = !numeric;
+        if (signalTrace->isState && (text == "Off" || text == "On")) {
+            signalTrace->stateNames << "Off" << "On";
+            signalTrace->stateIds.insert("Off", 0);
+            signalTrace->stateIds.insert("On", 1);
+        }
+    }
+
+    if (!signalTrace->isState) {
+        // Text in a numeric field ("Out of range (120)") is skipped
+        if (!numeric) {
+            return false;
+        }
+        sample = number;
+        return true;
+    }
+
+    auto stateIt = signalTrace->stateIds.constFind(text);
+    if (stateIt == signalTrace->stateIds.constEnd()) {
+        stateIt = signalTrace->stateIds.insert(text, signalTrace->stateNames.size());
+        signalTrace->stateNames.append(text);
+    }
+    sample = stateIt.value();
+    return true;
+}
+
+SignalPlotDialog::Trace* SignalPlotDialog::trace(const PlotSignal& signal, quint8 source)
+{
+    const quint64 key = (quint64(signal.id) << 8) | source;
+    Trace* existing = m_traceIndex.value(key, nullptr);
+    if (existing) {
+        return existing;
+    }
+
+    Trace* created = new Trace;
+    created->signalId = signal.id;
+    created->source = source;
+    m_traces.append(created);
+    m_traceIndex.insert(key, created);
+    return created;
+}
+
+void SignalPlotDialog::rebuildLanes()
+{
+    static const QColor laneColors[] = {
+        QColor(0, 114, 189), QColor(217, 83, 25), QColor(119, 172, 48), QColor(126, 47, 142),
+        QColor(237, 177, 32), QColor(77, 190, 238), QColor(162, 20, 47)
+    };
+    static const int laneColorCount = int(sizeof(laneColors) / sizeof(laneColors[0]));
+
+    QList<SignalPlotLane> lanes;
+    for (const PlotSignal& signal : m_signals) {
+        for (Trace* signalTrace : m_traces) {
+            if (signalTrace->signalId != signal.id) {
+                continue;
+            }
+            SignalPlotLane lane;
+            QString device = deviceName(signalTrace->source);
+            lane.label = QString("%1 %2 @ %3").arg(signal.pgn).arg(signal.name)
+                         .arg(PGNLogModel::addressText(signalTrace->source));
+            if (!device.isEmpty()) {
+                lane.label += QString(" (%1)").arg(device);
+            }
+            lane.color = laneColors[lanes.size() % laneColorCount];
+            lane.series = &signalTrace->series;
+            lane.stateNames = &signalTrace->stateNames;
+            lanes.append(lane);
+        }
+    }
+    m_plot->setLanes(lanes);
+}
+
+void SignalPlotDialog::refreshPlot()
+{
+    if (!m_plotDirty || !isVisible()) {
+        return;
+    }
+    m_plotDirty = false;
+
+    qint64 samples = 0;
+    for (const Trace* signalTrace : m_traces) {
+        samples += signalTrace->series.size();
+    }
+    m_sampleCountLabel->setText(QString("%1 samples in %2 traces").arg(samples).arg(m_traces.size()));
+    rebuildLanes();
+}
+
+void SignalPlotDialog::clearSamples()
+{
+    qDeleteAll(m_traces);
+    m_traces.clear();
+    m_traceIndex.clear();
+
+    // The plot must not keep pointers to the deleted series, visible or not
+    rebuildLanes();
+    m_plot->fitAll();
+    m_sampleCountLabel->clear();
+}
+
+void SignalPlotDialog::rebuildSignalIndex()
+{
+    m_signalsByPgn.clear();
+    for (int i = 0; i < m_signals.size(); i++) {
+        m_signalsByPgn[m_signals[i].pgn].append(i);
+    }
+}
+
+void SignalPlotDialog::onPgnEdited()
+{
+    bool ok = false;
+    const quint32 pgn = m_pgnEdit->text().trimmed().toUInt(&ok, 0);
+    if (!ok) {
+        return;
+    }
+
+    const QString current = m_signalCombo->currentText();
+    m_signalCombo->clear();
+    m_signalCombo->addItems(m_dbcDecoder->getSignalNames(pgn));
+    m_signalCombo->setEditText(current);
+}
+
+void SignalPlotDialog::onAddSignalClicked()
+{
+    bool ok = false;
+    const quint32 pgn = m_pgnEdit->text().trimmed().toUInt(&ok, 0);
+    const QString name = m_signalCombo->currentText().trimmed();
+    if (!ok || name.isEmpty()) {
+        ToastManager::instance()->showWarning("Enter a PGN and a signal name", this);
+        return;
+    }
+
+    const QString key = normalizedName(name);
+    for (const PlotSignal& signal : m_signals) {
+        if (signal.pgn == pgn && signal.key == key) {
+            ToastManager::instance()->showInfo("That signal is already plotted", this);
+            return;
+        }
+    }
+
+    PlotSignal signal;
+    signal.id = m_nextSignalId++;
+    signal.pgn = pgn;
+    signal.name = name;
+    signal.key = key;
+    m_signals.append(signal);
+    rebuildSignalIndex();
+    m_signalList->addItem(QString("%1 %2").arg(pgn).arg(name));
+
+    // Live signals start from now; a log file is read again to fill the new signal in
+    if (!isShowingLive()) {
+        startLoader(m_filePath);
+    }
+    m_plotDirty = true;
+}
+
+void SignalPlotDialog::onRemoveSignalClicked()
+{
+    const int row = m_signalList->currentRow();
+    if (row < 0 || row >= m_signals.size()) {
+        return;
+    }
+
+    const int signalId = m_signals[row].id;
+    for (int i = m_traces.size() - 1; i >= 0; i--) {
+        Trace* signalTrace = m_traces[i];
+        if (signalTrace->signalId == signalId) {
+            m_traceIndex.remove((quint64(signalId) << 8) | signalTrace->source);
+            m_traces.removeAt(i);
+            delete signalTrace;
+        }
+    }
+
+    m_signals.removeAt(row);
+    rebuildSignalIndex();
+    delete m_signalList->takeItem(row);
+    rebuildLanes();
+    m_plotDirty = true;
+}
+
+void SignalPlotDialog::onLoadLogClicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(
+        this,
+        "Load PGN Log",
+        "",
+        "PGN Log Files (*.pgnlog);;Text Files (*.txt);;All Files (*)"
+    );
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+    startLoader(fileName);
+}
+
+void SignalPlotDialog::startLoader(const QString& filePath)
+{
+    // Only one load at a time
+    stopLoader();
+    clearSamples();
+    m_fileDeviceNames.clear();
+    m_filePath = filePath;
+    m_fileName = QFileInfo(filePath).fileName();
+    m_sourceLabel->setText(QString("Log file: %1").arg(m_fileName));
+    m_showLiveButton->setEnabled(true);
+
+    m_loadProgressBar->setValue(0);
+    m_loadProgressBar->setVisible(true);
+
+    m_loader = new PGNLogLoader(filePath, this);
+    connect(m_loader, &PGNLogLoader::chunksAvailable, this, &SignalPlotDialog::onLoaderChunksAvailable, Qt::QueuedConnection);
+    connect(m_loader, &PGNLogLoader::progressChanged, m_loadProgressBar, &QProgressBar::setValue, Qt::QueuedConnection);
+    connect(m_loader, &PGNLogLoader::loadFinished, this, &SignalPlotDialog::onLoaderFinished, Qt::QueuedConnection);
+#ifdef WASM_BUILD
+    // No threads in the browser - parse here, the queued signals are delivered afterwards
+    m_loader->load();
+#else
+    m_loader->start();
+#endif
+}
+
+void SignalPlotDialog::onLoaderChunksAvailable()
+{
+    if (!m_loader) {
+        return;
+    }
+
+    // Acknowledge before draining so a chunk queued meanwhile triggers a new notification
+    m_loader->acknowledgeNotification();
+
+    if (m_fileDeviceNames.isEmpty() && m_loader->isBinaryCapture()) {
+        m_fileDeviceNames = m_loader->deviceNames();
+    }
+
+    // Only rows of plotted PGNs are turned back into messages and decoded
+    CaptureStore chunk;
+    while (m_loader->takeChunk(chunk)) {
+        for (int row = 0; row < chunk.size(); row++) {
+            if (!m_signalsByPgn.contains(chunk.pgn(row))) {
+                continue;
+            }
+            const qint64 timeNs = chunk.monotonicNs(row) != 0 ? chunk.monotonicNs(row) : chunk.wallNs(row);
+            addSample(chunk.message(row), timeNs);
+        }
+    }
+}
+
+void SignalPlotDialog::onLoaderFinished(bool success)
+{
+    if (!m_loader) {
+        return;
+    }
+
+    // Pick up anything queued after the last notification
+    onLoaderChunksAvailable();
+
+    bool cancelled = m_loader->isCancelled();
+    QString errorString = m_loader->errorString();
+    m_loader->deleteLater();
+    m_loader = nullptr;
+    m_loadProgressBar->setVisible(false);
+
+    if (!success && !cancelled) {
+        ToastManager::instance()->showError(
+            QString("Could not load log file: %1").arg(errorString), this);
+    }
+
+    m_plotDirty = true;
+    refreshPlot();
+}
+
+void SignalPlotDialog::onShowLiveClicked()
+{
+    stopLoader();
+    m_fileName.clear();
+    m_filePath.clear();
+    m_fileDeviceNames.clear();
+    m_sourceLabel->setText("Live traffic");
+    m_showLiveButton->setEnabled(false);
+    clearSamples();
+}
+
+void SignalPlotDialog::stopLoader()
+{
+    if (!m_loader) {
+        return;
+    }
+
+    // The destructor cancels and waits for the thread
+    disconnect(m_loader, nullptr, this, nullptr);
+    delete m_loader;
+    m_loader = nullptr;
+    m_loadProgressBar->setVisible(false);
+}
+
+QString SignalPlotDialog::deviceName(quint8 source) const
+{
+    if (!isShowingLive()) {
+        return m_fileDeviceNames.value(source);
+    }
+    return m_deviceNameResolver ? m_deviceNameResolver(source) : QString();
+}
+
+QString SignalPlotDialog::normalizedName(const QString& name)
+{
+    // Same matching as DBCDecoder::findSignals - case, spaces and underscores don't count
+    QString key = name;
+    return key.remove(QChar('_')).remove(QChar(' ')).toLower();
+}
@@ -0,0 +1,125 @@
+#ifndef SIGNALPLOTDIALOG_H
+#define SIGNALPLOTDIALOG_H
+
+#include <QDialog>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <functional>
+#include <N2kMsg.h>
+#include "n2ktimestamp.h"
+#include "signalseries.h"
+
+class QLineEdit;
+class QComboBox;
+class QListWidget;
+class QLabel;
+class QPushButton;
+class QProgressBar;
+class QTimer;
+class DBCDecoder;
+class PGNLogLoader;
+class CaptureStore;
+class SignalPlotWidget;
+
+/**
+ * @brief Plots decoded signal values over time.
+ *
+ * A plotted signal is a PGN and a field name as shown in the decoded column.
+ * Messages of that PGN are decoded through DBCDecoder and the field value is
+ * appended to a SignalSeries, one per source address. Numeric fields plot as
+ * numbers (a leading number is taken from formatted text such as "42 (16.5%)");
+ * text fields such as switch states plot as numbered states.
+ *
+ * Fed with live traffic by DeviceMainWindow, or from a log file loaded here.
+ */
+class SignalPlotDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<QString(quint8)> DeviceNameLookup;
+
+    explicit SignalPlotDialog(QWidget* parent = nullptr);
+    ~SignalPlotDialog();
+
+    void setDeviceNameResolver(const DeviceNameLookup& resolver) { m_deviceNameResolver = resolver; }
+    bool isShowingLive() const { return m_fileName.isEmpty(); }
+
+    // Live traffic - ignored while a log file is shown
+    void appendMessage(const tN2kMsg& msg, const N2kTimestamp& timestamp);
+
+private slots:
+    void onPgnEdited();
+    void onAddSignalClicked();
+    void onRemoveSignalClicked();
+    void onLoadLogClicked();
+    void onShowLiveClicked();
+    void onLoaderChunksAvailable();
+    void onLoaderFinished(bool success);
+    void refreshPlot();
+
+private:
+    struct PlotSignal {
+        int id;
+        quint32 pgn;
+        QString name;
+        QString key;    // Normalized name matched against decoded fields
+    };
+
+    struct Trace {
+        int signalId;
+        quint8 source;
+        SignalSeries series;
+        bool isState = false;  // Set by the first value - text fields plot as numbered states
+        QStringList stateNames;
+        QHash<QString, int> stateIds;
+    };
+
+    void setupUI();
+    void addSample(const tN2kMsg& msg, qint64 timeNs);
+    bool sampleValue(Trace* signalTrace, const QVariant& value, double& sample);
+    Trace* trace(const PlotSignal& signal, quint8 source);
+    void clearSamples();
+    void rebuildSignalIndex();
+    void rebuildLanes();
+    void startLoader(const QString& filePath);
+    void stopLoader();
+    QString deviceName(quint8 source) const;
+    static QString normalizedName(const QString& name);
+
+    DBCDecoder* m_dbcDecoder;
+    QList<PlotSignal> m_signals;
+    QHash<quint32, QList<int>> m_signalsByPgn;  // PGN -> indexes into m_signals
+    QList<Trace*> m_traces;
+    QHash<quint64, Trace*> m_traceIndex;        // (signal id << 8 | source) -> trace
+    int m_nextSignalId;
+    bool m_plotDirty;
+
+    QString m_fileName;  // Shown log file, empty for live traffic
+    QString m_filePath;
+    QHash<quint8, QString> m_fileDeviceNames;
+    DeviceNameLookup m_deviceNameResolver;
+    PGNLogLoader* m_loader = nullptr;
+
+    QLineEdit* m_pgnEdit;
+    QComboBox* m_signalCombo;
+    QPushButton* m_addSignalButton;
+    QPushButton* m_removeSignalButton;
+    QListWidget* m_signalList;
+    QPushButton* m_loadLogButton;
+    QPushButton* m_showLiveButton;
+    QPushButton* m_clearButton;
+    QPushButton* m_fitButton;
+    QLabel* m_sourceLabel;
+    QLabel* m_sampleCountLabel;
+    QProgressBar* m_loadProgressBar;
+    SignalPlotWidget* m_plot;
+    QTimer* m_refreshTimer;
+
+    static const int REFRESH_INTERVAL_MS = 100;
+};
+
+#endif // SIGNALPLOTDIALOG_H
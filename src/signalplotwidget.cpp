@@ -0,0 +1,357 @@
+#include "signalplotwidget.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QFontMetrics>
+#include <QLineF>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+
+SignalPlotWidget::SignalPlotWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_viewMode(FitAllView)
+    , m_viewStartNs(0)
+    , m_viewSpanNs(0)
+    , m_dragging(false)
+    , m_dragStartX(0)
+    , m_dragStartNs(0)
+{
+    setMinimumSize(400, 200);
+    setMouseTracking(false);
+}
+
+void SignalPlotWidget::setLanes(const QList<SignalPlotLane>& lanes)
+{
+    m_lanes = lanes;
+    update();
+}
+
+void SignalPlotWidget::fitAll()
+{
+    m_viewMode = FitAllView;
+    update();
+}
+
+bool SignalPlotWidget::dataExtent(qint64& firstNs, qint64& lastNs) const
+{
+    bool found = false;
+    for (const SignalPlotLane& lane : m_lanes) {
+        if (!lane.series || lane.series->isEmpty()) {
+            continue;
+        }
+        if (!found) {
+            firstNs = lane.series->firstTimeNs();
+            lastNs = lane.series->lastTimeNs();
+            found = true;
+        } else {
+            firstNs = qMin(firstNs, lane.series->firstTimeNs());
+            lastNs = qMax(lastNs, lane.series->lastTimeNs());
+        }
+    }
+    return found;
+}
+
+void SignalPlotWidget::viewRange(qint64& startNs, qint64& spanNs) const
+{
+    qint64 firstNs = 0;
+    qint64 lastNs = 0;
+    const bool hasData = dataExtent(firstNs, lastNs);
+
+    switch (m_viewMode) {
+    case FitAllView:
+        startNs = firstNs;
+        spanNs = lastNs - firstNs;
+        break;
+    case FollowView:
+        spanNs = m_viewSpanNs;
+        startNs = hasData ? lastNs - spanNs : m_viewStartNs;
+        break;
+    case ManualView:
+        startNs = m_viewStartNs;
+        spanNs = m_viewSpanNs;
+        break;
+    }
+
+    if (spanNs < MIN_VIEW_SPAN_NS) {
+        spanNs = MIN_VIEW_SPAN_NS;
+    }
+}
+
+void SignalPlotWidget::setManualView(qint64 startNs, qint64 spanNs)
+{
+    m_viewStartNs = startNs;
+    m_viewSpanNs = qMax(spanNs, qint64(MIN_VIEW_SPAN_NS));
+
+    // Reaching the newest sample pins the view to it again
+    qint64 firstNs = 0;
+    qint64 lastNs = 0;
+    m_viewMode = dataExtent(firstNs, lastNs) && startNs + m_viewSpanNs >= lastNs ? FollowView : ManualView;
+    update();
+}
+
+QRect SignalPlotWidget::plotArea() const
+{
+    return rect().adjusted(LABEL_WIDTH, 4, -8, -AXIS_HEIGHT);
+}
+
+void SignalPlotWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+    painter.setPen(palette().color(QPalette::Text));
+
+    if (m_lanes.isEmpty()) {
+        painter.drawText(rect(), Qt::AlignCenter, "Add a signal to plot it");
+        return;
+    }
+
+    qint64 firstNs = 0;
+    qint64 lastNs = 0;
+    dataExtent(firstNs, lastNs);
+    qint64 startNs = 0;
+    qint64 spanNs = 0;
+    viewRange(startNs, spanNs);
+
+    const QRect area = plotArea();
+    if (area.width() <= 0 || area.height() <= 0) {
+        return;
+    }
+
+    const int laneHeight = area.height() / m_lanes.size();
+    for (int i = 0; i < m_lanes.size(); i++) {
+        const QRect laneRect(area.left(), area.top() + i * laneHeight, area.width(), laneHeight);
+        paintLane(painter, m_lanes[i], laneRect, startNs, spanNs);
+    }
+
+    paintTimeAxis(painter, area, startNs, spanNs, firstNs);
+}
+
+void SignalPlotWidget::paintLane(QPainter& painter, const SignalPlotLane& lane, const QRect& laneRect,
+                                 qint64 startNs, qint64 spanNs) const
+{
+    const QColor gridColor = palette().color(QPalette::Mid);
+    const QColor textColor = palette().color(QPalette::Text);
+    const QFontMetrics metrics(font());
+
+    painter.setPen(gridColor);
+    painter.drawLine(0, laneRect.bottom(), width(), laneRect.bottom());
+
+    painter.setPen(lane.color);
+    const QRect labelRect(4, laneRect.top() + 2, LABEL_WIDTH - 8, metrics.height());
+    painter.drawText(labelRect, Qt::AlignLeft | Qt::AlignVCenter,
+                     metrics.elidedText(lane.label, Qt::ElideRight, labelRect.width()));
+
+    const SignalSeries* series = lane.series;
+    if (!series || series->isEmpty()) {
+        return;
+    }
+
+    // The sample before the view still holds its value at the left edge
+    const qint64 endNs = startNs + spanNs;
+    const int firstVisible = series->lowerBound(startNs);
+    const int firstHeld = firstVisible > 0 ? firstVisible - 1 : 0;
+    const int endVisible = series->lowerBound(endNs + 1);
+
+    double minimum = 0.0;
+    double maximum = 0.0;
+    if (!series->valueRange(firstHeld, endVisible, minimum, maximum)) {
+        return;
+    }
+
+    const bool isState = lane.stateNames && !lane.stateNames->isEmpty();
+    if (isState) {
+        minimum -= 0.5;
+        maximum += 0.5;
+    } else if (maximum - minimum < 1e-12) {
+        const double pad = qAbs(maximum) > 1e-12 ? qAbs(maximum) * 0.05 : 1.0;
+        minimum -= pad;
+        maximum += pad;
+    } else {
+        const double pad = (maximum - minimum) * 0.05;
+        minimum -= pad;
+        maximum += pad;
+    }
+
+    const QRect plotRect = laneRect.adjusted(0, metrics.height() + 2, 0, -3);
+    const double yScale = plotRect.height() / (maximum - minimum);
+    auto mapY = [&](double value) {
+        return plotRect.bottom() - (value - minimum) * yScale;
+    };
+
+    // Value labels in the margin
+    painter.setPen(textColor);
+    if (isState) {
+        const int firstState = int(std::ceil(minimum));
+        const int lastState = int(std::floor(maximum));
+        if (lastState - firstState < plotRect.height() / metrics.height()) {
+            for (int state = qMax(firstState, 0); state <= lastState && state < lane.stateNames->size(); state++) {
+                const int y = int(mapY(state));
+                painter.drawText(QRect(4, y - metrics.height() / 2, LABEL_WIDTH - 8, metrics.height()),
+                                 Qt::AlignRight | Qt::AlignVCenter,
+                                 metrics.elidedText(lane.stateNames->at(state), Qt::ElideRight, LABEL_WIDTH - 8));
+            }
+        }
+    } else {
+        painter.drawText(QRect(4, plotRect.top(), LABEL_WIDTH - 8, metrics.height()),
+                         Qt::AlignRight | Qt::AlignTop, QString::number(maximum, 'g', 6));
+        painter.drawText(QRect(4, plotRect.bottom() - metrics.height(), LABEL_WIDTH - 8, metrics.height()),
+                         Qt::AlignRight | Qt::AlignBottom, QString::number(minimum, 'g', 6));
+    }
+
+    // One min/max bar per pixel column, joined by sample-and-hold steps
+    QVector<QLineF> lines;
+    const int columns = plotRect.width();
+    lines.reserve(columns * 3);
+
+    bool havePrevious = false;
+    double previousX = plotRect.left();
+    double previousY = 0.0;
+    if (firstVisible > 0) {
+        previousY = mapY(series->value(firstVisible - 1));
+        havePrevious = true;
+    }
+
+    int columnStart = firstVisible;
+    for (int column = 0; column < columns && columnStart < endVisible; column++) {
+        const qint64 columnEndNs = startNs + qint64(double(spanNs) * (column + 1) / columns);
+        const int columnEnd = column + 1 == columns ? endVisible : series->lowerBound(columnEndNs);
+        if (columnEnd <= columnStart) {
+            continue;
+        }
+
+        double low = 0.0;
+        double high = 0.0;
+        series->valueRange(columnStart, columnEnd, low, high);
+        const double x = plotRect.left() + column;
+        const double firstY = mapY(series->value(columnStart));
+        if (havePrevious) {
+            lines.append(QLineF(previousX, previousY, x, previousY));
+            lines.append(QLineF(x, previousY, x, firstY));
+        }
+        lines.append(QLineF(x, mapY(low), x, mapY(high)));
+
+        previousX = x;
+        previousY = mapY(series->value(columnEnd - 1));
+        havePrevious = true;
+        columnStart = columnEnd;
+    }
+
+    // Hold the last value to the right edge while later samples exist
+    if (havePrevious && endVisible < series->size()) {
+        lines.append(QLineF(previousX, previousY, plotRect.right(), previousY));
+    }
+
+    painter.save();
+    painter.setClipRect(plotRect.adjusted(0, -1, 0, 1));
+    painter.setPen(QPen(lane.color, 1));
+    painter.drawLines(lines);
+    painter.restore();
+}
+
+void SignalPlotWidget::paintTimeAxis(QPainter& painter, const QRect& area, qint64 startNs, qint64 spanNs,
+                                     qint64 originNs) const
+{
+    const QFontMetrics metrics(font());
+    const QColor gridColor = palette().color(QPalette::Mid);
+    const QColor textColor = palette().color(QPalette::Text);
+
+    // 1-2-5 steps about TICK_SPACING_PX apart
+    const double rawStep = double(spanNs) * TICK_SPACING_PX / qMax(area.width(), 1);
+    double magnitude = std::pow(10.0, std::floor(std::log10(rawStep)));
+    double step = magnitude;
+    if (rawStep > magnitude * 5) {
+        step = magnitude * 10;
+    } else if (rawStep > magnitude * 2) {
+        step = magnitude * 5;
+    } else if (rawStep > magnitude) {
+        step = magnitude * 2;
+    }
+    const qint64 stepNs = qMax(qint64(step), qint64(1));
+
+    int decimals = 0;
+    for (qint64 unit = 1000000000; unit > stepNs && decimals < 6; unit /= 10) {
+        decimals++;
+    }
+
+    const qint64 offsetNs = startNs - originNs;
+    qint64 tickNs = (offsetNs / stepNs) * stepNs;
+    if (tickNs < offsetNs) {
+        tickNs += stepNs;
+    }
+
+    for (; tickNs <= offsetNs + spanNs; tickNs += stepNs) {
+        const int x = area.left() + int(double(tickNs - offsetNs) * area.width() / spanNs);
+        painter.setPen(gridColor);
+        painter.drawLine(x, area.top(), x, area.bottom() + 3);
+        painter.setPen(textColor);
+        const QString text = QString("%1 s").arg(double(tickNs) / 1e9, 0, 'f', decimals);
+        const int textWidth = metrics.horizontalAdvance(text);
+        painter.drawText(QRect(x - textWidth / 2, area.bottom() + 4, textWidth, metrics.height()),
+                         Qt::AlignCenter, text);
+    }
+}
+
+void SignalPlotWidget::wheelEvent(QWheelEvent* event)
+{
+    const QRect area = plotArea();
+    if (area.width() <= 0) {
+        return;
+    }
+
+    qint64 startNs = 0;
+    qint64 spanNs = 0;
+    viewRange(startNs, spanNs);
+
+    // Zoom around the time under the cursor
+    const double fraction = qBound(0.0, (event->position().x() - area.left()) / area.width(), 1.0);
+    const qint64 anchorNs = startNs + qint64(spanNs * fraction);
+    const double factor = std::pow(0.8, event->angleDelta().y() / 120.0);
+    const qint64 newSpanNs = qMax(qint64(spanNs * factor), qint64(MIN_VIEW_SPAN_NS));
+    setManualView(anchorNs - qint64(newSpanNs * fraction), newSpanNs);
+    event->accept();
+}
+
+void SignalPlotWidget::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    qint64 spanNs = 0;
+    viewRange(m_dragStartNs, spanNs);
+    m_dragging = true;
+    m_dragStartX = int(event->position().x());
+    setCursor(Qt::ClosedHandCursor);
+}
+
+void SignalPlotWidget::mouseMoveEvent(QMouseEvent* event)
+{
+    const QRect area = plotArea();
+    if (!m_dragging || area.width() <= 0) {
+        return;
+    }
+
+    qint64 startNs = 0;
+    qint64 spanNs = 0;
+    viewRange(startNs, spanNs);
+    const double dx = event->position().x() - m_dragStartX;
+    setManualView(m_dragStartNs - qint64(dx * spanNs / area.width()), spanNs);
+}
+
+void SignalPlotWidget::mouseReleaseEvent(QMouseEvent* event)
+{
+    Q_UNUSED(event);
+    m_dragging = false;
+    unsetCursor();
+}
+
+void SignalPlotWidget::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    Q_UNUSED(event);
+    fitAll();
+}
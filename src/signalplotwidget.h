@@ -0,0 +1,80 @@
+#ifndef SIGNALPLOTWIDGET_H
+#define SIGNALPLOTWIDGET_H
+
+#include <QWidget>
+#include <QList>
+#include <QColor>
+#include <QString>
+#include <QStringList>
+#include "signalseries.h"
+
+// One lane of the plot - the series and state names belong to the caller
+struct SignalPlotLane {
+    QString label;
+    QColor color;
+    const SignalSeries* series = nullptr;
+    const QStringList* stateNames = nullptr;  // Value n is stateNames->at(n) for text signals
+};
+
+/**
+ * @brief Plots signal series in stacked lanes over a shared time axis.
+ *
+ * Each lane gets its own value range. Samples hold their value until the next
+ * one, and every pixel column is drawn from the min/max of the samples it
+ * covers (read from the series pyramid), so the cost of a repaint follows the
+ * widget width rather than the number of samples.
+ *
+ * The wheel zooms around the cursor, dragging pans and a double click fits
+ * the whole capture. While the view reaches the newest sample it follows live
+ * appends.
+ */
+class SignalPlotWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SignalPlotWidget(QWidget* parent = nullptr);
+
+    void setLanes(const QList<SignalPlotLane>& lanes);
+    // Show every sample and keep doing so as data arrives
+    void fitAll();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+
+private:
+    enum ViewMode {
+        FitAllView,     // The whole capture, growing with it
+        FollowView,     // Fixed span ending at the newest sample
+        ManualView
+    };
+
+    bool dataExtent(qint64& firstNs, qint64& lastNs) const;
+    // Visible time range for the current mode
+    void viewRange(qint64& startNs, qint64& spanNs) const;
+    void setManualView(qint64 startNs, qint64 spanNs);
+    QRect plotArea() const;
+    void paintLane(QPainter& painter, const SignalPlotLane& lane, const QRect& laneRect,
+                   qint64 startNs, qint64 spanNs) const;
+    void paintTimeAxis(QPainter& painter, const QRect& area, qint64 startNs, qint64 spanNs, qint64 originNs) const;
+
+    QList<SignalPlotLane> m_lanes;
+    ViewMode m_viewMode;
+    qint64 m_viewStartNs;
+    qint64 m_viewSpanNs;
+    bool m_dragging;
+    int m_dragStartX;
+    qint64 m_dragStartNs;
+
+    static const int LABEL_WIDTH = 150;
+    static const int AXIS_HEIGHT = 22;
+    static const int TICK_SPACING_PX = 100;
+    static const qint64 MIN_VIEW_SPAN_NS = 1000000;  // 1 ms
+};
+
+#endif // SIGNALPLOTWIDGET_H
@@ -0,0 +1,80 @@
+#include "signalseries.h"
+#include <algorithm>
+
+SignalSeries::SignalSeries()
+    : m_levels(LEVEL_COUNT)
+{
+}
+
+void SignalSeries::append(qint64 timeNs, double value)
+{
+    if (!m_timeNs.isEmpty() && timeNs < m_timeNs.last()) {
+        timeNs = m_timeNs.last();
+    }
+
+    const int index = m_timeNs.size();
+    m_timeNs.append(timeNs);
+    m_values.append(value);
+
+    // Widen the block holding the new sample on every level
+    for (int level = 0; level < LEVEL_COUNT; level++) {
+        QVector<Extent>& blocks = m_levels[level];
+        const int block = index >> (LEVEL_BITS * (level + 1));
+        if (block == blocks.size()) {
+            blocks.append(Extent{value, value});
+        } else {
+            Extent& extent = blocks[block];
+            extent.minimum = qMin(extent.minimum, value);
+            extent.maximum = qMax(extent.maximum, value);
+        }
+    }
+}
+
+void SignalSeries::clear()
+{
+    m_timeNs.clear();
+    m_values.clear();
+    for (QVector<Extent>& blocks : m_levels) {
+        blocks.clear();
+    }
+}
+
+int SignalSeries::lowerBound(qint64 timeNs) const
+{
+    return int(std::lower_bound(m_timeNs.constBegin(), m_timeNs.constEnd(), timeNs) - m_timeNs.constBegin());
+}
+
+bool SignalSeries::valueRange(int first, int last, double& minimum, double& maximum) const
+{
+    first = qMax(first, 0);
+    last = qMin(last, size());
+    if (first >= last) {
+        return false;
+    }
+
+    minimum = m_values[first];
+    maximum = minimum;
+
+    // Take the largest complete, aligned block that starts here, or a single sample
+    int index = first;
+    while (index < last) {
+        int step = 1;
+        double low = m_values[index];
+        double high = low;
+        for (int level = LEVEL_COUNT - 1; level >= 0; level--) {
+            const int shift = LEVEL_BITS * (level + 1);
+            const int span = 1 << shift;
+            if ((index & (span - 1)) == 0 && index + span <= last) {
+                const Extent& extent = m_levels[level][index >> shift];
+                low = extent.minimum;
+                high = extent.maximum;
+                step = span;
+                break;
+            }
+        }
+        minimum = qMin(minimum, low);
+        maximum = qMax(maximum, high);
+        index += step;
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+#ifndef SIGNALSERIES_H
+#define SIGNALSERIES_H
+
+#include <QtGlobal>
+#include <QVector>
+
+/**
+ * @brief Time-series column of one decoded signal, with a min/max pyramid.
+ *
+ * Samples are kept in two flat arrays in time order. Level k of the pyramid
+ * holds the min and max of each block of 8^(k+1) samples and is updated as
+ * samples are appended, so the extent of any range of samples is read from a
+ * few dozen blocks instead of every sample. That keeps per-pixel min/max
+ * downsampling cheap when one pixel covers thousands of samples.
+ */
+class SignalSeries
+{
+public:
+    SignalSeries();
+
+    // Samples must arrive in time order; an earlier time is clamped to the last one
+    void append(qint64 timeNs, double value);
+    void clear();
+
+    int size() const { return m_timeNs.size(); }
+    bool isEmpty() const { return m_timeNs.isEmpty(); }
+    qint64 timeNs(int index) const { return m_timeNs[index]; }
+    double value(int index) const { return m_values[index]; }
+    qint64 firstTimeNs() const { return m_timeNs.isEmpty() ? 0 : m_timeNs.first(); }
+    qint64 lastTimeNs() const { return m_timeNs.isEmpty() ? 0 : m_timeNs.last(); }
+
+    // Index of the first sample at or after timeNs (size() when there is none)
+    int lowerBound(qint64 timeNs) const;
+
+    // Smallest and largest value of the samples [first, last); false for an empty range
+    bool valueRange(int first, int last, double& minimum, double& maximum) const;
+
+private:
+    struct Extent {
+        double minimum;
+        double maximum;
+    };
+
+    QVector<qint64> m_timeNs;
+    QVector<double> m_values;
+    QVector<QVector<Extent>> m_levels;
+
+    static const int LEVEL_BITS = 3;  // Each level groups 8 blocks of the one below
+    static const int LEVEL_COUNT = 7; // Coarsest blocks hold 8^7 (2M) samples
+};
+
+#endif // SIGNALSERIES_H
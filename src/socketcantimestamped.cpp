@@ -0,0 +1,76 @@
+#include "socketcantimestamped.h"
+#include <QDebug>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/can.h>
+#include <time.h>
+
+tNMEA2000_SocketCANTimestamped::tNMEA2000_SocketCANTimestamped(char* CANport)
+    : tNMEA2000_SocketCAN(CANport)
+{
+}
+
+bool tNMEA2000_SocketCANTimestamped::CANOpen()
+{
+    if (!tNMEA2000_SocketCAN::CANOpen()) {
+        return false;
+    }
+
+    int enable = 1;
+    m_kernelTimestamps = (setsockopt(skt, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) == 0);
+    if (!m_kernelTimestamps) {
+        qWarning() << "SO_TIMESTAMPNS not available on CAN socket, falling back to user-space timestamps:"
+                   << strerror(errno);
+    }
+    return true;
+}
+
+bool tNMEA2000_SocketCANTimestamped::CANGetFrame(unsigned long &id, unsigned char &len, unsigned char *buf)
+{
+    struct can_frame frame;
+    struct iovec iov;
+    iov.iov_base = &frame;
+    iov.iov_len = sizeof(frame);
+
+    char control[CMSG_SPACE(sizeof(struct timespec))];
+    struct msghdr hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+
+    ssize_t bytesRead = recvmsg(skt, &hdr, MSG_DONTWAIT);
+    if (bytesRead < static_cast<ssize_t>(sizeof(struct can_frame))) {
+        return false;
+    }
+
+    // Error and remote frames carry no NMEA2000 payload
+    if (frame.can_id & (CAN_ERR_FLAG | CAN_RTR_FLAG)) {
+        return false;
+    }
+
+    N2kTimestamp stamp = N2kTimestamp::now();
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            struct timespec kernelTime;
+            memcpy(&kernelTime, CMSG_DATA(cmsg), sizeof(kernelTime));
+            qint64 kernelWallNs = qint64(kernelTime.tv_sec) * 1000000000LL + kernelTime.tv_nsec;
+
+            // The kernel stamps on CLOCK_REALTIME - carry the frame's age over to the monotonic clock
+            qint64 ageNs = stamp.wallNs - kernelWallNs;
+            stamp.monotonicNs -= ageNs;
+            stamp.wallNs = kernelWallNs;
+            stamp.fromKernel = true;
+            break;
+        }
+    }
+    m_lastFrameTimestamp = stamp;
+
+    id = frame.can_id & CAN_EFF_MASK;
+    len = frame.can_dlc > 8 ? 8 : frame.can_dlc;
+    memcpy(buf, frame.data, len);
+    return true;
+}
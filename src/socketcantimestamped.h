@@ -0,0 +1,34 @@
+#ifndef SOCKETCANTIMESTAMPED_H
+#define SOCKETCANTIMESTAMPED_H
+
+#include "NMEA2000_SocketCAN.h"
+#include "n2ktimestamp.h"
+
+/**
+ * @brief SocketCAN interface that records the kernel receive time of each frame.
+ *
+ * The socket is switched to SO_TIMESTAMPNS after it is opened and frames are
+ * read with recvmsg() so the SCM_TIMESTAMPNS control message can be picked up.
+ * The stamp of the most recent frame is available from lastFrameTimestamp()
+ * while tNMEA2000 is dispatching the message that frame completed, i.e. inside
+ * the message handler. If the kernel refuses the option, a user-space stamp
+ * taken right after recvmsg() is used instead.
+ */
+class tNMEA2000_SocketCANTimestamped : public tNMEA2000_SocketCAN
+{
+public:
+    explicit tNMEA2000_SocketCANTimestamped(char* CANport);
+
+    N2kTimestamp lastFrameTimestamp() const { return m_lastFrameTimestamp; }
+    bool kernelTimestampsEnabled() const { return m_kernelTimestamps; }
+
+protected:
+    bool CANOpen() override;
+    bool CANGetFrame(unsigned long &id, unsigned char &len, unsigned char *buf) override;
+
+private:
+    N2kTimestamp m_lastFrameTimestamp;
+    bool m_kernelTimestamps = false;
+};
+
+#endif // SOCKETCANTIMESTAMPED_H
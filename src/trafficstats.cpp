@@ -0,0 +1,166 @@
+#include "trafficstats.h"
+#include "capturestore.h"
+#include <QtAlgorithms>
+#include <cmath>
+#include <cstring>
+
+TrafficStats::TrafficStats()
+    : m_lastKey(0)
+    , m_lastIndex(-1)
+    , m_totalMessages(0)
+    , m_totalBytes(0)
+{
+}
+
+void TrafficStats::add(const tN2kMsg& msg, const N2kTimestamp& timestamp)
+{
+    // Same clock choice as N2kTimestamp::nsecsSince - monotonic when the interface supplies it
+    const qint64 timeNs = timestamp.monotonicNs != 0 ? timestamp.monotonicNs : timestamp.wallNs;
+    add(msg.PGN, msg.Source, msg.Data, msg.DataLen, timeNs);
+}
+
+void TrafficStats::add(const CaptureStore& store, int row)
+{
+    const qint64 timeNs = store.monotonicNs(row) != 0 ? store.monotonicNs(row) : store.wallNs(row);
+    add(store.pgn(row), store.source(row), store.payload(row), store.length(row), timeNs);
+}
+
+void TrafficStats::add(quint32 pgn, quint8 source, const unsigned char* data, int len, qint64 timeNs)
+{
+    const quint32 key = (quint32(source) << 24) | (pgn & 0xFFFFFF);
+    if (key != m_lastKey || m_lastIndex < 0) {
+        auto it = m_index.constFind(key);
+        if (it == m_index.constEnd()) {
+            Stream stream;
+            stream.pgn = pgn;
+            stream.source = source;
+            m_streams.append(stream);
+            it = m_index.insert(key, m_streams.size() - 1);
+        }
+        m_lastKey = key;
+        m_lastIndex = it.value();
+    }
+
+    Stream& stream = m_streams[m_lastIndex];
+    len = qBound(0, len, int(MAX_PAYLOAD_BYTES));
+
+    if (stream.messages == 0) {
+        stream.firstNs = timeNs;
+    } else {
+        // Time can step backwards in merged or hand-edited logs - count the message, not the gap
+        const qint64 gapNs = timeNs - stream.lastNs;
+        if (gapNs >= 0) {
+            if (stream.gaps == 0 || gapNs < stream.minGapNs) {
+                stream.minGapNs = gapNs;
+            }
+            if (gapNs > stream.maxGapNs) {
+                stream.maxGapNs = gapNs;
+            }
+            stream.gaps++;
+            const double delta = double(gapNs) - stream.meanGapNs;
+            stream.meanGapNs += delta / double(stream.gaps);
+            stream.gapM2 += delta * (double(gapNs) - stream.meanGapNs);
+            stream.histogram[histogramBucket(gapNs / 1000)]++;
+        }
+
+        if (len != stream.lastLength || (len > 0 && std::memcmp(data, stream.lastPayload, size_t(len)) != 0)) {
+            stream.changes++;
+        }
+    }
+
+    stream.messages++;
+    stream.bytes += quint64(len);
+    stream.lastNs = timeNs;
+    stream.lastLength = len;
+    if (len > 0) {
+        std::memcpy(stream.lastPayload, data, size_t(len));
+    }
+
+    m_totalMessages++;
+    m_totalBytes += quint64(len);
+}
+
+void TrafficStats::clear()
+{
+    m_streams.clear();
+    m_index.clear();
+    m_lastKey = 0;
+    m_lastIndex = -1;
+    m_totalMessages = 0;
+    m_totalBytes = 0;
+}
+
+double TrafficStats::byteShare(int index) const
+{
+    return m_totalBytes > 0 ? double(m_streams[index].bytes) / double(m_totalBytes) : 0.0;
+}
+
+int TrafficStats::histogramBucket(qint64 gapUs)
+{
+    if (gapUs < HISTOGRAM_LINEAR_BUCKETS) {
+        return gapUs < 0 ? 0 : int(gapUs);
+    }
+
+    // Octave from the leading bit, sub-bucket from the three bits below it
+    const int octave = 63 - qCountLeadingZeroBits(quint64(gapUs));
+    const int sub = int(gapUs >> (octave - 3)) & (HISTOGRAM_SUB_BUCKETS - 1);
+    const int bucket = HISTOGRAM_LINEAR_BUCKETS + (octave - 4) * HISTOGRAM_SUB_BUCKETS + sub;
+    return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+qint64 TrafficStats::bucketLowerUs(int bucket)
+{
+    if (bucket < HISTOGRAM_LINEAR_BUCKETS) {
+        return bucket;
+    }
+    const int octave = 4 + (bucket - HISTOGRAM_LINEAR_BUCKETS) / HISTOGRAM_SUB_BUCKETS;
+    const int sub = (bucket - HISTOGRAM_LINEAR_BUCKETS) % HISTOGRAM_SUB_BUCKETS;
+    return qint64(HISTOGRAM_SUB_BUCKETS + sub) << (octave - 3);
+}
+
+qint64 TrafficStats::bucketWidthUs(int bucket)
+{
+    if (bucket < HISTOGRAM_LINEAR_BUCKETS) {
+        return 1;
+    }
+    const int octave = 4 + (bucket - HISTOGRAM_LINEAR_BUCKETS) / HISTOGRAM_SUB_BUCKETS;
+    return qint64(1) << (octave - 3);
+}
+
+double TrafficStats::Stream::rate() const
+{
+    if (messages < 2 || lastNs <= firstNs) {
+        return 0.0;
+    }
+    return double(messages - 1) * 1e9 / double(lastNs - firstNs);
+}
+
+double TrafficStats::Stream::jitterNs() const
+{
+    return gaps > 1 ? std::sqrt(gapM2 / double(gaps - 1)) : 0.0;
+}
+
+qint64 TrafficStats::Stream::gapPercentileNs(double fraction) const
+{
+    if (gaps == 0) {
+        return 0;
+    }
+
+    // Walk the buckets to the one holding the requested rank and report its midpoint,
+    // clamped to the exact extremes
+    const quint64 rank = quint64(std::ceil(qBound(0.0, fraction, 1.0) * double(gaps)));
+    quint64 seen = 0;
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        seen += histogram[bucket];
+        if (seen >= rank && seen > 0) {
+            const qint64 midNs = (bucketLowerUs(bucket) * 2 + bucketWidthUs(bucket)) * 500;
+            return qBound(minGapNs, midNs, maxGapNs);
+        }
+    }
+    return maxGapNs;
+}
+
+double TrafficStats::Stream::changeRatio() const
+{
+    return messages > 1 ? double(changes) / double(messages - 1) : 0.0;
+}
@@ -0,0 +1,88 @@
+#ifndef TRAFFICSTATS_H
+#define TRAFFICSTATS_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QHash>
+#include <N2kMsg.h>
+#include "n2ktimestamp.h"
+
+class CaptureStore;
+
+/**
+ * @brief Streaming traffic statistics per (source, PGN) stream.
+ *
+ * Each message costs one hash lookup and a constant amount of arithmetic: the
+ * counters, min/max and running mean/variance of the inter-arrival time are
+ * updated in place, and the gap is counted in a fixed log-linear histogram that
+ * percentiles are read from. A stream takes the same memory no matter how long
+ * the capture runs. Fed from live traffic and from loaded logs alike.
+ */
+class TrafficStats
+{
+public:
+    // Gaps are counted in microseconds: exact below 16 us, then 8 buckets per
+    // power of two (12.5% resolution) up to 2^36 us, about 19 hours
+    static const int HISTOGRAM_LINEAR_BUCKETS = 16;
+    static const int HISTOGRAM_SUB_BUCKETS = 8;
+    static const int HISTOGRAM_OCTAVES = 32;
+    static const int HISTOGRAM_BUCKETS = HISTOGRAM_LINEAR_BUCKETS + HISTOGRAM_OCTAVES * HISTOGRAM_SUB_BUCKETS;
+    static const int MAX_PAYLOAD_BYTES = tN2kMsg::MaxDataLen;
+
+    struct Stream {
+        quint32 pgn = 0;
+        quint8 source = 0;
+        quint64 messages = 0;
+        quint64 bytes = 0;
+        quint64 changes = 0;        // Messages whose payload differed from the one before
+        qint64 firstNs = 0;
+        qint64 lastNs = 0;
+        qint64 minGapNs = 0;
+        qint64 maxGapNs = 0;
+        quint64 gaps = 0;           // Inter-arrival times counted (negative gaps are skipped)
+        double meanGapNs = 0.0;
+        double gapM2 = 0.0;         // Sum of squared deviations from the mean (Welford)
+        quint32 histogram[HISTOGRAM_BUCKETS] = {};
+        int lastLength = 0;
+        unsigned char lastPayload[MAX_PAYLOAD_BYTES] = {};
+
+        // Messages per second over the time the stream has been seen
+        double rate() const;
+        // Standard deviation of the inter-arrival time
+        double jitterNs() const;
+        // Inter-arrival time below which the given fraction (0..1) of gaps fall
+        qint64 gapPercentileNs(double fraction) const;
+        // Fraction (0..1) of messages that changed the payload
+        double changeRatio() const;
+    };
+
+    TrafficStats();
+
+    void add(const tN2kMsg& msg, const N2kTimestamp& timestamp);
+    void add(const CaptureStore& store, int row);
+    void add(quint32 pgn, quint8 source, const unsigned char* data, int len, qint64 timeNs);
+    void clear();
+
+    // Streams keep their index until clear(), new ones are appended
+    int size() const { return m_streams.size(); }
+    const Stream& stream(int index) const { return m_streams[index]; }
+
+    quint64 totalMessages() const { return m_totalMessages; }
+    quint64 totalBytes() const { return m_totalBytes; }
+    // Share (0..1) of all payload bytes carried by a stream
+    double byteShare(int index) const;
+
+    static int histogramBucket(qint64 gapUs);
+    static qint64 bucketLowerUs(int bucket);
+    static qint64 bucketWidthUs(int bucket);
+
+private:
+    QVector<Stream> m_streams;
+    QHash<quint32, int> m_index;    // (source << 24 | PGN) -> stream
+    quint32 m_lastKey;              // Consecutive frames of one stream skip the hash lookup
+    int m_lastIndex;
+    quint64 m_totalMessages;
+    quint64 m_totalBytes;
+};
+
+#endif // TRAFFICSTATS_H
@@ -0,0 +1,256 @@
+#include "trafficstatsdialog.h"
+#include "dbcdecoder.h"
+#include "pgnlogloader.h"
+#include "toastmanager.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QTableView>
+#include <QHeaderView>
+#include <QSortFilterProxyModel>
+#include <QLabel>
+#include <QPushButton>
+#include <QProgressBar>
+#include <QTimer>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFontMetrics>
+
+TrafficStatsDialog::TrafficStatsDialog(TrafficStats* liveStats, QWidget* parent)
+    : QDialog(parent)
+    , m_liveStats(liveStats)
+    , m_shownStats(liveStats)
+{
+    m_model = new TrafficStatsModel(this);
+    m_proxyModel = new QSortFilterProxyModel(this);
+    m_proxyModel->setSourceModel(m_model);
+    m_proxyModel->setSortRole(TrafficStatsModel::SortRole);
+    m_proxyModel->setDynamicSortFilter(true);
+
+    m_dbcDecoder = new DBCDecoder(this);
+    m_model->setDecoder(m_dbcDecoder);
+
+    setupUI();
+    showStats(m_liveStats);
+
+    // Counters change per message; the view follows at a readable pace
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    connect(m_refreshTimer, &QTimer::timeout, this, &TrafficStatsDialog::refresh);
+    m_refreshTimer->start();
+
+    setWindowTitle("Traffic Statistics");
+    setModal(false);
+    resize(1100, 600);
+}
+
+TrafficStatsDialog::~TrafficStatsDialog()
+{
+    stopLoader();
+}
+
+void TrafficStatsDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+
+    QHBoxLayout* controlLayout = new QHBoxLayout();
+    m_sourceLabel = new QLabel();
+    m_sourceLabel->setStyleSheet("font-weight: bold; padding: 5px;");
+    m_loadLogButton = new QPushButton("Load Log...");
+    m_loadLogButton->setToolTip("Count the traffic of a .pgnlog file without opening it in a PGN log");
+    m_showLiveButton = new QPushButton("Show Live");
+    m_resetButton = new QPushButton("Reset");
+    m_resetButton->setToolTip("Start counting again from now");
+    m_loadProgressBar = new QProgressBar();
+    m_loadProgressBar->setRange(0, 100);
+    m_loadProgressBar->setMaximumWidth(200);
+    m_loadProgressBar->setVisible(false);
+    controlLayout->addWidget(m_sourceLabel);
+    controlLayout->addWidget(m_loadProgressBar);
+    controlLayout->addStretch();
+    controlLayout->addWidget(m_loadLogButton);
+    controlLayout->addWidget(m_showLiveButton);
+    controlLayout->addWidget(m_resetButton);
+    mainLayout->addLayout(controlLayout);
+
+    m_tableView = new QTableView();
+    m_tableView->setModel(m_proxyModel);
+    m_tableView->setSortingEnabled(true);
+    m_tableView->sortByColumn(TrafficStatsModel::ByteShareColumn, Qt::DescendingOrder);
+    m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_tableView->setAlternatingRowColors(true);
+    m_tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    m_tableView->horizontalHeader()->setStretchLastSection(true);
+    QFontMetrics metrics(m_tableView->font());
+    m_tableView->verticalHeader()->setVisible(false);
+    m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_tableView->verticalHeader()->setDefaultSectionSize(metrics.height() + 6);
+    m_tableView->setColumnWidth(TrafficStatsModel::SourceColumn, 50);
+    m_tableView->setColumnWidth(TrafficStatsModel::DeviceColumn, 140);
+    m_tableView->setColumnWidth(TrafficStatsModel::NameColumn, 200);
+    mainLayout->addWidget(m_tableView);
+
+    m_summaryLabel = new QLabel();
+    mainLayout->addWidget(m_summaryLabel);
+
+    connect(m_loadLogButton, &QPushButton::clicked, this, &TrafficStatsDialog::onLoadLogClicked);
+    connect(m_showLiveButton, &QPushButton::clicked, this, &TrafficStatsDialog::onShowLiveClicked);
+    connect(m_resetButton, &QPushButton::clicked, this, &TrafficStatsDialog::onResetClicked);
+}
+
+void TrafficStatsDialog::setDeviceNameResolver(const TrafficStatsModel::DeviceNameLookup& resolver)
+{
+    m_deviceNameResolver = resolver;
+    if (m_shownStats == m_liveStats) {
+        m_model->setDeviceNameResolver(resolver);
+    }
+}
+
+void TrafficStatsDialog::showStats(TrafficStats* stats)
+{
+    m_shownStats = stats;
+    m_model->setStats(stats);
+
+    if (stats == m_liveStats) {
+        m_model->setDeviceNameResolver(m_deviceNameResolver);
+        m_sourceLabel->setText("Live traffic");
+        m_resetButton->setToolTip("Start counting again from now");
+    } else {
+        // Loaded captures carry their own address claims; text logs have none
+        m_model->setDeviceNameResolver([this](quint8 address) {
+            return m_fileDeviceNames.value(address);
+        });
+        m_sourceLabel->setText(QString("Log file: %1").arg(m_fileName));
+        m_resetButton->setToolTip("Drop the loaded statistics and go back to live traffic");
+    }
+    m_showLiveButton->setEnabled(stats != m_liveStats);
+    updateSummary();
+}
+
+void TrafficStatsDialog::refresh()
+{
+    if (!isVisible()) {
+        return;
+    }
+    m_model->refresh();
+    updateSummary();
+}
+
+void TrafficStatsDialog::updateSummary()
+{
+    const TrafficStats* stats = m_shownStats;
+    m_summaryLabel->setText(QString("%1 streams, %2 messages, %3 bytes")
+                            .arg(stats ? stats->size() : 0)
+                            .arg(stats ? stats->totalMessages() : 0)
+                            .arg(stats ? stats->totalBytes() : 0));
+}
+
+void TrafficStatsDialog::onLoadLogClicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(
+        this,
+        "Load PGN Log",
+        "",
+        "PGN Log Files (*.pgnlog);;Text Files (*.txt);;All Files (*)"
+    );
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    // Only one load at a time
+    stopLoader();
+    m_fileStats.clear();
+    m_fileDeviceNames.clear();
+    m_fileName = QFileInfo(fileName).fileName();
+    showStats(&m_fileStats);
+
+    m_loadProgressBar->setValue(0);
+    m_loadProgressBar->setVisible(true);
+
+    m_loader = new PGNLogLoader(fileName, this);
+    connect(m_loader, &PGNLogLoader::chunksAvailable, this, &TrafficStatsDialog::onLoaderChunksAvailable, Qt::QueuedConnection);
+    connect(m_loader, &PGNLogLoader::progressChanged, m_loadProgressBar, &QProgressBar::setValue, Qt::QueuedConnection);
+    connect(m_loader, &PGNLogLoader::loadFinished, this, &TrafficStatsDialog::onLoaderFinished, Qt::QueuedConnection);
+#ifdef WASM_BUILD
+    // No threads in the browser - parse here, the queued signals are delivered afterwards
+    m_loader->load();
+#else
+    m_loader->start();
+#endif
+}
+
+void TrafficStatsDialog::onLoaderChunksAvailable()
+{
+    if (!m_loader) {
+        return;
+    }
+
+    // Acknowledge before draining so a chunk queued meanwhile triggers a new notification
+    m_loader->acknowledgeNotification();
+
+    if (m_fileDeviceNames.isEmpty() && m_loader->isBinaryCapture()) {
+        m_fileDeviceNames = m_loader->deviceNames();
+    }
+
+    CaptureStore chunk;
+    while (m_loader->takeChunk(chunk)) {
+        for (int row = 0; row < chunk.size(); row++) {
+            m_fileStats.add(chunk, row);
+        }
+    }
+}
+
+void TrafficStatsDialog::onLoaderFinished(bool success)
+{
+    if (!m_loader) {
+        return;
+    }
+
+    // Pick up anything queued after the last notification
+    onLoaderChunksAvailable();
+
+    bool cancelled = m_loader->isCancelled();
+    QString errorString = m_loader->errorString();
+    m_loader->deleteLater();
+    m_loader = nullptr;
+    m_loadProgressBar->setVisible(false);
+
+    if (!success && !cancelled) {
+        ToastManager::instance()->showError(
+            QString("Could not load log file: %1").arg(errorString), this);
+    }
+
+    m_model->refresh();
+    updateSummary();
+}
+
+void TrafficStatsDialog::onShowLiveClicked()
+{
+    stopLoader();
+    m_fileStats.clear();
+    showStats(m_liveStats);
+}
+
+void TrafficStatsDialog::onResetClicked()
+{
+    if (m_shownStats == &m_fileStats) {
+        onShowLiveClicked();
+        return;
+    }
+    m_liveStats->clear();
+    m_model->refresh();
+    updateSummary();
+}
+
+void TrafficStatsDialog::stopLoader()
+{
+    if (!m_loader) {
+        return;
+    }
+
+    // The destructor cancels and waits for the thread
+    disconnect(m_loader, nullptr, this, nullptr);
+    delete m_loader;
+    m_loader = nullptr;
+    m_loadProgressBar->setVisible(false);
+}
@@ -0,0 +1,74 @@
+#ifndef TRAFFICSTATSDIALOG_H
+#define TRAFFICSTATSDIALOG_H
+
+#include <QDialog>
+#include <QHash>
+#include <QString>
+#include "trafficstats.h"
+#include "trafficstatsmodel.h"
+
+class QTableView;
+class QSortFilterProxyModel;
+class QLabel;
+class QPushButton;
+class QProgressBar;
+class QTimer;
+class DBCDecoder;
+class PGNLogLoader;
+
+/**
+ * @brief Sortable per-(source, PGN) traffic statistics.
+ *
+ * Shows either the live engine owned by DeviceMainWindow or one filled from a
+ * log file loaded here through PGNLogLoader. The file is only counted, so a
+ * PGN log dialog is neither needed nor changed.
+ */
+class TrafficStatsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit TrafficStatsDialog(TrafficStats* liveStats, QWidget* parent = nullptr);
+    ~TrafficStatsDialog();
+
+    void setDeviceNameResolver(const TrafficStatsModel::DeviceNameLookup& resolver);
+
+private slots:
+    void refresh();
+    void onLoadLogClicked();
+    void onShowLiveClicked();
+    void onResetClicked();
+    void onLoaderChunksAvailable();
+    void onLoaderFinished(bool success);
+
+private:
+    void setupUI();
+    void showStats(TrafficStats* stats);
+    void stopLoader();
+    void updateSummary();
+
+    TrafficStats* m_liveStats;
+    TrafficStats m_fileStats;
+    TrafficStats* m_shownStats;
+    QString m_fileName;
+    QHash<quint8, QString> m_fileDeviceNames;
+    TrafficStatsModel::DeviceNameLookup m_deviceNameResolver;
+
+    TrafficStatsModel* m_model;
+    QSortFilterProxyModel* m_proxyModel;
+    DBCDecoder* m_dbcDecoder;
+    PGNLogLoader* m_loader = nullptr;
+
+    QTableView* m_tableView;
+    QLabel* m_sourceLabel;
+    QLabel* m_summaryLabel;
+    QPushButton* m_loadLogButton;
+    QPushButton* m_showLiveButton;
+    QPushButton* m_resetButton;
+    QProgressBar* m_loadProgressBar;
+    QTimer* m_refreshTimer;
+
+    static const int REFRESH_INTERVAL_MS = 1000;
+};
+
+#endif // TRAFFICSTATSDIALOG_H
@@ -0,0 +1,186 @@
+#include "trafficstatsmodel.h"
+#include "pgnlogmodel.h"
+#include "dbcdecoder.h"
+#include "n2ktimestamp.h"
+
+TrafficStatsModel::TrafficStatsModel(QObject* parent)
+    : QAbstractTableModel(parent)
+    , m_stats(nullptr)
+    , m_decoder(nullptr)
+    , m_rowCount(0)
+    , m_dataFont("Consolas, Monaco, monospace", 9)
+{
+}
+
+int TrafficStatsModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+int TrafficStatsModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant TrafficStatsModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || !m_stats || index.row() >= m_rowCount) {
+        return QVariant();
+    }
+
+    const TrafficStats::Stream& stream = m_stats->stream(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return displayValue(stream, index.row(), index.column());
+
+    case SortRole:
+        return sortValue(stream, index.row(), index.column());
+
+    case Qt::TextAlignmentRole:
+        switch (index.column()) {
+        case DeviceColumn:
+        case NameColumn:
+        case LastPayloadColumn:
+            return int(Qt::AlignLeft | Qt::AlignVCenter);
+        case SourceColumn:
+            return int(Qt::AlignCenter);
+        default:
+            return int(Qt::AlignRight | Qt::AlignVCenter);
+        }
+
+    case Qt::FontRole:
+        if (index.column() == LastPayloadColumn) {
+            return m_dataFont;
+        }
+        break;
+    }
+
+    return QVariant();
+}
+
+QVariant TrafficStatsModel::displayValue(const TrafficStats::Stream& stream, int row, int column) const
+{
+    const bool hasGaps = stream.gaps > 0;
+
+    switch (column) {
+    case SourceColumn:      return PGNLogModel::addressText(stream.source);
+    case DeviceColumn:      return m_deviceNameResolver ? m_deviceNameResolver(stream.source) : QString();
+    case PgnColumn:         return QString::number(stream.pgn);
+    case NameColumn:        return messageName(stream.pgn);
+    case MessagesColumn:    return QString::number(stream.messages);
+    case RateColumn:        return QString::number(stream.rate(), 'f', 2);
+    case MeanGapColumn:     return hasGaps ? N2kTimestamp::formatDelta(qint64(stream.meanGapNs)) : QString("-");
+    case MinGapColumn:      return hasGaps ? N2kTimestamp::formatDelta(stream.minGapNs) : QString("-");
+    case MaxGapColumn:      return hasGaps ? N2kTimestamp::formatDelta(stream.maxGapNs) : QString("-");
+    case JitterColumn:      return hasGaps ? N2kTimestamp::formatDelta(qint64(stream.jitterNs())) : QString("-");
+    case P50GapColumn:      return hasGaps ? N2kTimestamp::formatDelta(stream.gapPercentileNs(0.50)) : QString("-");
+    case P95GapColumn:      return hasGaps ? N2kTimestamp::formatDelta(stream.gapPercentileNs(0.95)) : QString("-");
+    case P99GapColumn:      return hasGaps ? N2kTimestamp::formatDelta(stream.gapPercentileNs(0.99)) : QString("-");
+    case ChangeColumn:      return QString("%1%").arg(stream.changeRatio() * 100.0, 0, 'f', 1);
+    case BytesColumn:       return QString::number(stream.bytes);
+    case ByteShareColumn:   return QString("%1%").arg(m_stats->byteShare(row) * 100.0, 0, 'f', 2);
+    case LastPayloadColumn: return PGNLogModel::formatRawData(stream.lastPayload, stream.lastLength);
+    }
+    return QVariant();
+}
+
+QVariant TrafficStatsModel::sortValue(const TrafficStats::Stream& stream, int row, int column) const
+{
+    switch (column) {
+    case SourceColumn:      return uint(stream.source);
+    case PgnColumn:         return uint(stream.pgn);
+    case MessagesColumn:    return quint64(stream.messages);
+    case RateColumn:        return stream.rate();
+    case MeanGapColumn:     return stream.meanGapNs;
+    case MinGapColumn:      return qint64(stream.minGapNs);
+    case MaxGapColumn:      return qint64(stream.maxGapNs);
+    case JitterColumn:      return stream.jitterNs();
+    case P50GapColumn:      return qint64(stream.gapPercentileNs(0.50));
+    case P95GapColumn:      return qint64(stream.gapPercentileNs(0.95));
+    case P99GapColumn:      return qint64(stream.gapPercentileNs(0.99));
+    case ChangeColumn:      return stream.changeRatio();
+    case BytesColumn:       return quint64(stream.bytes);
+    case ByteShareColumn:   return m_stats->byteShare(row);
+    default:
+        // Text columns sort by what they show
+        return displayValue(stream, row, column);
+    }
+}
+
+QVariant TrafficStatsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    static const char* const headers[ColumnCount] = {
+        "Src", "Device", "PGN", "Message Name", "Messages", "Rate (Hz)",
+        "Mean Gap", "Min Gap", "Max Gap", "Jitter", "P50 Gap", "P95 Gap", "P99 Gap",
+        "Changed", "Bytes", "Byte Share", "Last Payload"
+    };
+    if (section >= 0 && section < ColumnCount) {
+        return QString(headers[section]);
+    }
+    return QVariant();
+}
+
+void TrafficStatsModel::setStats(const TrafficStats* stats)
+{
+    beginResetModel();
+    m_stats = stats;
+    m_rowCount = stats ? stats->size() : 0;
+    endResetModel();
+}
+
+void TrafficStatsModel::setDecoder(DBCDecoder* decoder)
+{
+    m_decoder = decoder;
+    m_messageNames.clear();
+    if (m_rowCount > 0) {
+        emit dataChanged(index(0, NameColumn), index(m_rowCount - 1, NameColumn), {Qt::DisplayRole});
+    }
+}
+
+void TrafficStatsModel::setDeviceNameResolver(const DeviceNameLookup& resolver)
+{
+    m_deviceNameResolver = resolver;
+    if (m_rowCount > 0) {
+        emit dataChanged(index(0, DeviceColumn), index(m_rowCount - 1, DeviceColumn), {Qt::DisplayRole});
+    }
+}
+
+void TrafficStatsModel::refresh()
+{
+    const int streams = m_stats ? m_stats->size() : 0;
+
+    // The engine was cleared under us - start over
+    if (streams < m_rowCount) {
+        beginResetModel();
+        m_rowCount = streams;
+        endResetModel();
+        return;
+    }
+
+    if (streams > m_rowCount) {
+        beginInsertRows(QModelIndex(), m_rowCount, streams - 1);
+        m_rowCount = streams;
+        endInsertRows();
+    }
+
+    if (m_rowCount > 0) {
+        emit dataChanged(index(0, 0), index(m_rowCount - 1, ColumnCount - 1));
+    }
+}
+
+QString TrafficStatsModel::messageName(quint32 pgn) const
+{
+    auto it = m_messageNames.constFind(pgn);
+    if (it != m_messageNames.constEnd()) {
+        return it.value();
+    }
+
+    QString name = m_decoder ? m_decoder->getCleanMessageName(pgn) : QString();
+    m_messageNames.insert(pgn, name);
+    return name;
+}
@@ -0,0 +1,80 @@
+#ifndef TRAFFICSTATSMODEL_H
+#define TRAFFICSTATSMODEL_H
+
+#include <QAbstractTableModel>
+#include <QFont>
+#include <QHash>
+#include <functional>
+#include "trafficstats.h"
+
+class DBCDecoder;
+
+/**
+ * @brief Table model presenting the streams of a TrafficStats engine.
+ *
+ * The engine is updated per message without telling the model. refresh()
+ * announces new streams and marks all cells changed, so a view refreshes at
+ * the timer rate rather than the message rate. SortRole carries the number
+ * behind each formatted cell for a QSortFilterProxyModel.
+ */
+class TrafficStatsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        SourceColumn = 0,
+        DeviceColumn,
+        PgnColumn,
+        NameColumn,
+        MessagesColumn,
+        RateColumn,
+        MeanGapColumn,
+        MinGapColumn,
+        MaxGapColumn,
+        JitterColumn,
+        P50GapColumn,
+        P95GapColumn,
+        P99GapColumn,
+        ChangeColumn,
+        BytesColumn,
+        ByteShareColumn,
+        LastPayloadColumn,
+        ColumnCount
+    };
+
+    enum Role {
+        SortRole = Qt::UserRole + 1
+    };
+
+    typedef std::function<QString(quint8)> DeviceNameLookup;
+
+    explicit TrafficStatsModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    void setStats(const TrafficStats* stats);
+    const TrafficStats* stats() const { return m_stats; }
+    void setDecoder(DBCDecoder* decoder);
+    void setDeviceNameResolver(const DeviceNameLookup& resolver);
+
+    // Pick up streams and counters changed since the last refresh
+    void refresh();
+
+private:
+    QVariant displayValue(const TrafficStats::Stream& stream, int row, int column) const;
+    QVariant sortValue(const TrafficStats::Stream& stream, int row, int column) const;
+    QString messageName(quint32 pgn) const;
+
+    const TrafficStats* m_stats;
+    DBCDecoder* m_decoder;
+    DeviceNameLookup m_deviceNameResolver;
+    int m_rowCount;  // Streams the view knows about
+    mutable QHash<quint32, QString> m_messageNames;
+    QFont m_dataFont;
+};
+
+#endif // TRAFFICSTATSMODEL_H